@@ -21,7 +21,9 @@
 
 #include "audio/chip.h"
 #include "audio/mixer.h"
+#include "audio/renderahead.h"
 
+#include "common/config-manager.h"
 #include "common/timer.h"
 
 namespace Audio {
@@ -93,11 +95,47 @@ void RealChip::onTimer() {
 			(*_callback)();
 }
 
+class EmulatedChip::ChipRenderAhead : public RenderAhead::Renderer {
+public:
+	ChipRenderAhead(EmulatedChip *chip, int frames) : _chip(chip) {
+		_renderAhead = new RenderAhead(this, chip->isStereo(), frames);
+	}
+
+	~ChipRenderAhead() {
+		// This applies the writes still queued
+		delete _renderAhead;
+	}
+
+	RenderAhead *get() { return _renderAhead; }
+
+	// RenderAhead::Renderer API
+	int renderFrames(int16 *buffer, int frames) override {
+		return _chip->renderFrames(buffer, frames);
+	}
+
+	bool isCallbackDue() const override {
+		return _chip->isCallbackDue();
+	}
+
+	void runCallback() override {
+		_chip->runCallback();
+	}
+
+	void applyQueuedWrite(int type, int address, int value) override {
+		_chip->applyQueuedWrite(type, address, value);
+	}
+
+private:
+	EmulatedChip *_chip;
+	RenderAhead *_renderAhead;
+};
+
 EmulatedChip::EmulatedChip() :
 	_nextTick(0),
 	_samplesPerTick(0),
 	_baseFreq(0),
-	_handle(new Audio::SoundHandle()) { }
+	_handle(new Audio::SoundHandle()),
+	_renderAhead(nullptr) { }
 
 EmulatedChip::~EmulatedChip() {
 	// Stop callbacks, just in case. If it's still playing at this
@@ -110,24 +148,19 @@ EmulatedChip::~EmulatedChip() {
 }
 
 int EmulatedChip::readBuffer(int16 *buffer, const int numSamples) {
+	if (_renderAhead) {
+		_renderAhead->get()->read(buffer, numSamples);
+		return numSamples;
+	}
+
 	const int stereoFactor = isStereo() ? 2 : 1;
 	int len = numSamples / stereoFactor;
 	int step;
 
 	do {
-		step = len;
-		if (step > (_nextTick >> FIXP_SHIFT))
-			step = (_nextTick >> FIXP_SHIFT);
-
-		generateSamples(buffer, step * stereoFactor);
-
-		_nextTick -= step << FIXP_SHIFT;
-		if (!(_nextTick >> FIXP_SHIFT)) {
-			if (_callback && _callback->isValid())
-				(*_callback)();
-
-			_nextTick += _samplesPerTick;
-		}
+		step = renderFrames(buffer, len);
+		if (isCallbackDue())
+			runCallback();
 
 		buffer += step * stereoFactor;
 		len -= step;
@@ -136,17 +169,57 @@ int EmulatedChip::readBuffer(int16 *buffer, const int numSamples) {
 	return numSamples;
 }
 
+int EmulatedChip::renderFrames(int16 *buffer, int frames) {
+	int step = frames;
+	if (step > (_nextTick >> FIXP_SHIFT))
+		step = (_nextTick >> FIXP_SHIFT);
+
+	generateSamples(buffer, step * (isStereo() ? 2 : 1));
+
+	_nextTick -= step << FIXP_SHIFT;
+	return step;
+}
+
+bool EmulatedChip::isCallbackDue() const {
+	return !(_nextTick >> FIXP_SHIFT);
+}
+
+void EmulatedChip::runCallback() {
+	if (_callback && _callback->isValid())
+		(*_callback)();
+
+	_nextTick += _samplesPerTick;
+}
+
+bool EmulatedChip::queueWrite(int type, int address, int value) {
+	if (!_renderAhead)
+		return false;
+
+	_renderAhead->get()->queueWrite(type, address, value);
+	return true;
+}
+
 int EmulatedChip::getRate() const {
 	return g_system->getMixer()->getOutputRate();
 }
 
 void EmulatedChip::startCallbacks(int timerFrequency) {
 	setCallbackFrequency(timerFrequency);
+
+	int renderAheadMs = ConfMan.hasKey("emulated_chip_render_ahead") ? ConfMan.getInt("emulated_chip_render_ahead") : 0;
+	if (renderAheadMs > 0 && supportsRenderAhead()) {
+		_renderAhead = new ChipRenderAhead(this, getRate() * renderAheadMs / 1000);
+		_renderAhead->get()->start();
+	}
+
 	g_system->getMixer()->playStream(Audio::Mixer::kPlainSoundType, _handle, this, -1, Audio::Mixer::kMaxChannelVolume, 0, DisposeAfterUse::NO, true);
 }
 
 void EmulatedChip::stopCallbacks() {
 	g_system->getMixer()->stopHandle(*_handle);
+
+	delete _renderAhead;
+	_renderAhead = nullptr;
 }
 
 void EmulatedChip::setCallbackFrequency(int timerFrequency) {
@@ -108,6 +108,12 @@ private:
  *
  * This will send callbacks based on the number of samples
  * decoded in readBuffer().
+ *
+ * Chips which pass all their writes through queueWrite() can be rendered
+ * ahead of playback from the timer thread, see RenderAhead. This is enabled
+ * with the "emulated_chip_render_ahead" setting, which is the number of
+ * milliseconds to render ahead. It delays the writes done outside of the
+ * timer callbacks by as much.
  */
 class EmulatedChip : virtual public Chip, protected Audio::AudioStream {
 protected:
@@ -142,13 +148,38 @@ protected:
 	 */
 	virtual void generateSamples(int16 *buffer, int numSamples) = 0;
 
+	/**
+	 * Return whether all the writes changing the state of the chip go
+	 * through queueWrite(), which allows rendering it ahead.
+	 */
+	virtual bool supportsRenderAhead() const { return false; }
+
+	/**
+	 * Queue a write for the renderer when the chip is rendered ahead, to be
+	 * done with applyQueuedWrite(). Returns false when the chip isn't
+	 * rendered ahead, in which case the write is to be done right away.
+	 */
+	bool queueWrite(int type, int address, int value);
+
+	/**
+	 * Do a write queued with queueWrite().
+	 */
+	virtual void applyQueuedWrite(int type, int address, int value) {}
+
 private:
+	class ChipRenderAhead;
+
+	int renderFrames(int16 *buffer, int frames);
+	bool isCallbackDue() const;
+	void runCallback();
+
 	int _baseFreq;
 
 	int _nextTick;
 	int _samplesPerTick;
 
 	Audio::SoundHandle *_handle;
+	ChipRenderAhead *_renderAhead;
 };
 
 } // End of namespace Audio
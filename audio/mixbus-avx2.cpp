@@ -0,0 +1,125 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+#include "common/scummsys.h"
+
+#include "audio/mixbus.h"
+
+#include <immintrin.h>
+
+#if defined(__clang__)
+#pragma clang attribute push (__attribute__((target("avx2"))), apply_to=function)
+#elif defined(__GNUC__)
+#pragma GCC push_options
+#pragma GCC target("avx2")
+#endif
+
+namespace Audio {
+
+// Divides by Mixer::kMaxMixerVolume, rounding towards zero like the
+// generic code does.
+static inline __m256i scaleDown(__m256i product) {
+	const __m256i bias = _mm256_srli_epi32(_mm256_srai_epi32(product, 31), 24);
+	return _mm256_srai_epi32(_mm256_add_epi32(product, bias), 8);
+}
+
+// Multiplies eight samples by eight volumes and adds the result to the bus
+static inline void mixEight(int32 *dst, __m128i samples, __m256i vol) {
+	const __m256i product = _mm256_mullo_epi32(_mm256_cvtepi16_epi32(samples), vol);
+	const __m256i d = _mm256_loadu_si256((const __m256i *)dst);
+	_mm256_storeu_si256((__m256i *)dst, _mm256_add_epi32(d, scaleDown(product)));
+}
+
+void MixBus::mixStereoAVX2(int32 *dst, const st_sample_t *src, uint frames, st_volume_t volL, st_volume_t volR) {
+	const __m256i vol = _mm256_set_epi32(volR, volL, volR, volL, volR, volL, volR, volL);
+
+	for (; frames >= 8; frames -= 8) {
+		mixEight(dst, _mm_loadu_si128((const __m128i *)src), vol);
+		mixEight(dst + 8, _mm_loadu_si128((const __m128i *)(src + 8)), vol);
+		src += 16;
+		dst += 16;
+	}
+
+	mixStereoGeneric(dst, src, frames, volL, volR);
+}
+
+void MixBus::mixMonoToStereoAVX2(int32 *dst, const st_sample_t *src, uint frames, st_volume_t volL, st_volume_t volR) {
+	const __m256i vol = _mm256_set_epi32(volR, volL, volR, volL, volR, volL, volR, volL);
+
+	for (; frames >= 8; frames -= 8) {
+		const __m128i samples = _mm_loadu_si128((const __m128i *)src);
+		mixEight(dst, _mm_unpacklo_epi16(samples, samples), vol);
+		mixEight(dst + 8, _mm_unpackhi_epi16(samples, samples), vol);
+		src += 8;
+		dst += 16;
+	}
+
+	mixMonoToStereoGeneric(dst, src, frames, volL, volR);
+}
+
+void MixBus::saturateAVX2(st_sample_t *dst, const int32 *src, uint numSamples) {
+	for (; numSamples >= 16; numSamples -= 16) {
+		const __m256i s0 = _mm256_loadu_si256((const __m256i *)src);
+		const __m256i s1 = _mm256_loadu_si256((const __m256i *)(src + 8));
+		// packs works within 128-bit lanes, so restore the sample order afterwards
+		const __m256i packed = _mm256_permute4x64_epi64(_mm256_packs_epi32(s0, s1), 0xD8);
+		_mm256_storeu_si256((__m256i *)dst, packed);
+		src += 16;
+		dst += 16;
+	}
+
+	saturateGeneric(dst, src, numSamples);
+}
+
+int32 MixBus::convolveAVX2(const st_sample_t *samples, const int16 *coeffs, uint count) {
+	__m256i sum = _mm256_setzero_si256();
+
+	for (; count >= 16; count -= 16) {
+		const __m256i s = _mm256_loadu_si256((const __m256i *)samples);
+		const __m256i c = _mm256_loadu_si256((const __m256i *)coeffs);
+		sum = _mm256_add_epi32(sum, _mm256_madd_epi16(s, c));
+		samples += 16;
+		coeffs += 16;
+	}
+
+	__m128i sum128 = _mm_add_epi32(_mm256_castsi256_si128(sum), _mm256_extracti128_si256(sum, 1));
+	if (count >= 8) {
+		const __m128i s = _mm_loadu_si128((const __m128i *)samples);
+		const __m128i c = _mm_loadu_si128((const __m128i *)coeffs);
+		sum128 = _mm_add_epi32(sum128, _mm_madd_epi16(s, c));
+		samples += 8;
+		coeffs += 8;
+		count -= 8;
+	}
+
+	sum128 = _mm_add_epi32(sum128, _mm_shuffle_epi32(sum128, _MM_SHUFFLE(1, 0, 3, 2)));
+	sum128 = _mm_add_epi32(sum128, _mm_shuffle_epi32(sum128, _MM_SHUFFLE(2, 3, 0, 1)));
+	return _mm_cvtsi128_si32(sum128) + convolveGeneric(samples, coeffs, count);
+}
+
+} // End of namespace Audio
+
+#if defined(__clang__)
+#pragma clang attribute pop
+#elif defined(__GNUC__)
+#pragma GCC pop_options
+#endif
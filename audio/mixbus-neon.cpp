@@ -0,0 +1,129 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+#include "common/scummsys.h"
+
+#ifdef SCUMMVM_NEON
+
+#include "audio/mixbus.h"
+
+#include <arm_neon.h>
+
+#if !defined(__aarch64__) && !defined(__ARM_NEON)
+
+#if defined(__clang__)
+#pragma clang attribute push (__attribute__((target("neon"))), apply_to=function)
+#elif defined(__GNUC__)
+#pragma GCC push_options
+#pragma GCC target("fpu=neon")
+#endif
+
+#endif // !defined(__aarch64__) && !defined(__ARM_NEON)
+
+namespace Audio {
+
+// Divides by Mixer::kMaxMixerVolume, rounding towards zero like the
+// generic code does.
+static inline int32x4_t scaleDown(int32x4_t product) {
+	const int32x4_t bias = vreinterpretq_s32_u32(vshrq_n_u32(vreinterpretq_u32_s32(vshrq_n_s32(product, 31)), 24));
+	return vshrq_n_s32(vaddq_s32(product, bias), 8);
+}
+
+// Multiplies four samples by four volumes and adds the result to the bus
+static inline void mixFour(int32 *dst, int16x4_t samples, int16x4_t vol) {
+	vst1q_s32(dst, vaddq_s32(vld1q_s32(dst), scaleDown(vmull_s16(samples, vol))));
+}
+
+static inline int16x4_t stereoVolume(st_volume_t volL, st_volume_t volR) {
+	const int16 vol[4] = { (int16)volL, (int16)volR, (int16)volL, (int16)volR };
+	return vld1_s16(vol);
+}
+
+void MixBus::mixStereoNEON(int32 *dst, const st_sample_t *src, uint frames, st_volume_t volL, st_volume_t volR) {
+	const int16x4_t vol = stereoVolume(volL, volR);
+
+	for (; frames >= 4; frames -= 4) {
+		const int16x8_t samples = vld1q_s16(src);
+		mixFour(dst, vget_low_s16(samples), vol);
+		mixFour(dst + 4, vget_high_s16(samples), vol);
+		src += 8;
+		dst += 8;
+	}
+
+	mixStereoGeneric(dst, src, frames, volL, volR);
+}
+
+void MixBus::mixMonoToStereoNEON(int32 *dst, const st_sample_t *src, uint frames, st_volume_t volL, st_volume_t volR) {
+	const int16x4_t vol = stereoVolume(volL, volR);
+
+	for (; frames >= 4; frames -= 4) {
+		const int16x4_t samples = vld1_s16(src);
+		const int16x4x2_t dup = vzip_s16(samples, samples);
+		mixFour(dst, dup.val[0], vol);
+		mixFour(dst + 4, dup.val[1], vol);
+		src += 4;
+		dst += 8;
+	}
+
+	mixMonoToStereoGeneric(dst, src, frames, volL, volR);
+}
+
+void MixBus::saturateNEON(st_sample_t *dst, const int32 *src, uint numSamples) {
+	for (; numSamples >= 8; numSamples -= 8) {
+		const int16x8_t packed = vcombine_s16(vqmovn_s32(vld1q_s32(src)), vqmovn_s32(vld1q_s32(src + 4)));
+		vst1q_s16(dst, packed);
+		src += 8;
+		dst += 8;
+	}
+
+	saturateGeneric(dst, src, numSamples);
+}
+
+int32 MixBus::convolveNEON(const st_sample_t *samples, const int16 *coeffs, uint count) {
+	int32x4_t sum = vdupq_n_s32(0);
+
+	for (; count >= 8; count -= 8) {
+		const int16x8_t s = vld1q_s16(samples);
+		const int16x8_t c = vld1q_s16(coeffs);
+		sum = vmlal_s16(sum, vget_low_s16(s), vget_low_s16(c));
+		sum = vmlal_s16(sum, vget_high_s16(s), vget_high_s16(c));
+		samples += 8;
+		coeffs += 8;
+	}
+
+	const int32x2_t pair = vadd_s32(vget_low_s32(sum), vget_high_s32(sum));
+	return vget_lane_s32(vpadd_s32(pair, pair), 0) + convolveGeneric(samples, coeffs, count);
+}
+
+} // End of namespace Audio
+
+#if !defined(__aarch64__) && !defined(__ARM_NEON)
+
+#if defined(__clang__)
+#pragma clang attribute pop
+#elif defined(__GNUC__)
+#pragma GCC pop_options
+#endif
+
+#endif // !defined(__aarch64__) && !defined(__ARM_NEON)
+
+#endif // SCUMMVM_NEON
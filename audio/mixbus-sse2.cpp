@@ -0,0 +1,126 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+#include "common/scummsys.h"
+
+#include "audio/mixbus.h"
+
+#include <emmintrin.h>
+
+#if !defined(__x86_64__)
+
+#if defined(__clang__)
+#pragma clang attribute push (__attribute__((target("sse2"))), apply_to=function)
+#elif defined(__GNUC__)
+#pragma GCC push_options
+#pragma GCC target("sse2")
+#endif
+
+#endif // !defined(__x86_64__)
+
+namespace Audio {
+
+// Divides by Mixer::kMaxMixerVolume, rounding towards zero like the
+// generic code does.
+static inline __m128i scaleDown(__m128i product) {
+	const __m128i bias = _mm_srli_epi32(_mm_srai_epi32(product, 31), 24);
+	return _mm_srai_epi32(_mm_add_epi32(product, bias), 8);
+}
+
+// Multiplies eight samples by eight volumes and adds the result to the bus
+static inline void mixEight(int32 *dst, __m128i samples, __m128i vol) {
+	const __m128i lo = _mm_mullo_epi16(samples, vol);
+	const __m128i hi = _mm_mulhi_epi16(samples, vol);
+
+	__m128i d0 = _mm_loadu_si128((const __m128i *)dst);
+	__m128i d1 = _mm_loadu_si128((const __m128i *)(dst + 4));
+	d0 = _mm_add_epi32(d0, scaleDown(_mm_unpacklo_epi16(lo, hi)));
+	d1 = _mm_add_epi32(d1, scaleDown(_mm_unpackhi_epi16(lo, hi)));
+	_mm_storeu_si128((__m128i *)dst, d0);
+	_mm_storeu_si128((__m128i *)(dst + 4), d1);
+}
+
+void MixBus::mixStereoSSE2(int32 *dst, const st_sample_t *src, uint frames, st_volume_t volL, st_volume_t volR) {
+	const __m128i vol = _mm_set_epi16(volR, volL, volR, volL, volR, volL, volR, volL);
+
+	for (; frames >= 4; frames -= 4) {
+		mixEight(dst, _mm_loadu_si128((const __m128i *)src), vol);
+		src += 8;
+		dst += 8;
+	}
+
+	mixStereoGeneric(dst, src, frames, volL, volR);
+}
+
+void MixBus::mixMonoToStereoSSE2(int32 *dst, const st_sample_t *src, uint frames, st_volume_t volL, st_volume_t volR) {
+	const __m128i vol = _mm_set_epi16(volR, volL, volR, volL, volR, volL, volR, volL);
+
+	for (; frames >= 8; frames -= 8) {
+		const __m128i samples = _mm_loadu_si128((const __m128i *)src);
+		mixEight(dst, _mm_unpacklo_epi16(samples, samples), vol);
+		mixEight(dst + 8, _mm_unpackhi_epi16(samples, samples), vol);
+		src += 8;
+		dst += 16;
+	}
+
+	mixMonoToStereoGeneric(dst, src, frames, volL, volR);
+}
+
+void MixBus::saturateSSE2(st_sample_t *dst, const int32 *src, uint numSamples) {
+	for (; numSamples >= 8; numSamples -= 8) {
+		const __m128i s0 = _mm_loadu_si128((const __m128i *)src);
+		const __m128i s1 = _mm_loadu_si128((const __m128i *)(src + 4));
+		_mm_storeu_si128((__m128i *)dst, _mm_packs_epi32(s0, s1));
+		src += 8;
+		dst += 8;
+	}
+
+	saturateGeneric(dst, src, numSamples);
+}
+
+int32 MixBus::convolveSSE2(const st_sample_t *samples, const int16 *coeffs, uint count) {
+	__m128i sum = _mm_setzero_si128();
+
+	for (; count >= 8; count -= 8) {
+		const __m128i s = _mm_loadu_si128((const __m128i *)samples);
+		const __m128i c = _mm_loadu_si128((const __m128i *)coeffs);
+		sum = _mm_add_epi32(sum, _mm_madd_epi16(s, c));
+		samples += 8;
+		coeffs += 8;
+	}
+
+	sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, _MM_SHUFFLE(1, 0, 3, 2)));
+	sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, _MM_SHUFFLE(2, 3, 0, 1)));
+	return _mm_cvtsi128_si32(sum) + convolveGeneric(samples, coeffs, count);
+}
+
+} // End of namespace Audio
+
+#if !defined(__x86_64__)
+
+#if defined(__clang__)
+#pragma clang attribute pop
+#elif defined(__GNUC__)
+#pragma GCC pop_options
+#endif
+
+#endif // !defined(__x86_64__)
@@ -0,0 +1,128 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+#include "audio/mixbus.h"
+#include "audio/mixer.h"
+
+#include "common/system.h"
+
+namespace Audio {
+
+MixBus::Funcs MixBus::_funcs = { nullptr, nullptr, nullptr, nullptr };
+
+void MixBus::selectFuncs() {
+	Funcs funcs = { mixStereoGeneric, mixMonoToStereoGeneric, saturateGeneric, convolveGeneric };
+#ifdef SCUMMVM_NEON
+	if (g_system->hasFeature(OSystem::kFeatureCpuNEON)) {
+		funcs.mixStereo = mixStereoNEON;
+		funcs.mixMonoToStereo = mixMonoToStereoNEON;
+		funcs.saturate = saturateNEON;
+		funcs.convolve = convolveNEON;
+	}
+#endif
+#ifdef SCUMMVM_SSE2
+	if (g_system->hasFeature(OSystem::kFeatureCpuSSE2)) {
+		funcs.mixStereo = mixStereoSSE2;
+		funcs.mixMonoToStereo = mixMonoToStereoSSE2;
+		funcs.saturate = saturateSSE2;
+		funcs.convolve = convolveSSE2;
+	}
+#endif
+#ifdef SCUMMVM_AVX2
+	if (g_system->hasFeature(OSystem::kFeatureCpuAVX2)) {
+		funcs.mixStereo = mixStereoAVX2;
+		funcs.mixMonoToStereo = mixMonoToStereoAVX2;
+		funcs.saturate = saturateAVX2;
+		funcs.convolve = convolveAVX2;
+	}
+#endif
+#ifdef OUTPUT_UNSIGNED_AUDIO
+	// The SIMD kernels only produce signed output
+	funcs.saturate = saturateGeneric;
+#endif
+	_funcs = funcs;
+}
+
+void MixBus::mixStereo(int32 *dst, const st_sample_t *src, uint frames, st_volume_t volL, st_volume_t volR) {
+	if (!_funcs.mixStereo)
+		selectFuncs();
+	_funcs.mixStereo(dst, src, frames, volL, volR);
+}
+
+void MixBus::mixMonoToStereo(int32 *dst, const st_sample_t *src, uint frames, st_volume_t volL, st_volume_t volR) {
+	if (!_funcs.mixMonoToStereo)
+		selectFuncs();
+	_funcs.mixMonoToStereo(dst, src, frames, volL, volR);
+}
+
+void MixBus::saturate(st_sample_t *dst, const int32 *src, uint numSamples) {
+	if (!_funcs.saturate)
+		selectFuncs();
+	_funcs.saturate(dst, src, numSamples);
+}
+
+int32 MixBus::convolve(const st_sample_t *samples, const int16 *coeffs, uint count) {
+	if (!_funcs.convolve)
+		selectFuncs();
+	return _funcs.convolve(samples, coeffs, count);
+}
+
+void MixBus::mixStereoGeneric(int32 *dst, const st_sample_t *src, uint frames, st_volume_t volL, st_volume_t volR) {
+	while (frames--) {
+		*dst++ += (*src++ * (int)volL) / Mixer::kMaxMixerVolume;
+		*dst++ += (*src++ * (int)volR) / Mixer::kMaxMixerVolume;
+	}
+}
+
+void MixBus::mixMonoToStereoGeneric(int32 *dst, const st_sample_t *src, uint frames, st_volume_t volL, st_volume_t volR) {
+	while (frames--) {
+		const int sample = *src++;
+		*dst++ += (sample * (int)volL) / Mixer::kMaxMixerVolume;
+		*dst++ += (sample * (int)volR) / Mixer::kMaxMixerVolume;
+	}
+}
+
+void MixBus::saturateGeneric(st_sample_t *dst, const int32 *src, uint numSamples) {
+	while (numSamples--) {
+		int32 val = *src++;
+
+		if (val > ST_SAMPLE_MAX)
+			val = ST_SAMPLE_MAX;
+		else if (val < ST_SAMPLE_MIN)
+			val = ST_SAMPLE_MIN;
+
+#ifdef OUTPUT_UNSIGNED_AUDIO
+		*dst++ = ((int16)val) ^ 0x8000;
+#else
+		*dst++ = val;
+#endif
+	}
+}
+
+int32 MixBus::convolveGeneric(const st_sample_t *samples, const int16 *coeffs, uint count) {
+	int32 sum = 0;
+	while (count--)
+		sum += *samples++ * (int32)*coeffs++;
+	return sum;
+}
+
+} // End of namespace Audio
@@ -0,0 +1,140 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef AUDIO_MIXBUS_H
+#define AUDIO_MIXBUS_H
+
+#include "common/scummsys.h"
+#include "audio/rate.h"
+
+class MixBusTestSuite;
+class RateConverterTestSuite;
+
+namespace Audio {
+
+/**
+ * @defgroup audio_mixbus Mix bus
+ * @ingroup audio
+ *
+ * @brief Kernels for accumulating channels into a wide mixing bus.
+ * @{
+ */
+
+/**
+ * The mixer accumulates all channels into a 32-bit bus and only saturates
+ * the result to 16 bits once, after every channel has been mixed. The inner
+ * loops are selected at runtime depending on the SIMD extensions the CPU
+ * supports.
+ */
+class MixBus {
+public:
+	/**
+	 * Scale interleaved stereo samples by the channel volumes and add them
+	 * to the bus.
+	 *
+	 * @param dst     The bus, holding 2 * @p frames samples.
+	 * @param src     The source samples, holding 2 * @p frames samples.
+	 * @param frames  Number of sample pairs to mix.
+	 * @param volL    Volume of the left channel, in the range 0 - Mixer::kMaxMixerVolume.
+	 * @param volR    Volume of the right channel, in the range 0 - Mixer::kMaxMixerVolume.
+	 */
+	static void mixStereo(int32 *dst, const st_sample_t *src, uint frames, st_volume_t volL, st_volume_t volR);
+
+	/**
+	 * Scale mono samples by the channel volumes and add them to both sides
+	 * of a stereo bus.
+	 *
+	 * @param dst     The bus, holding 2 * @p frames samples.
+	 * @param src     The source samples, holding @p frames samples.
+	 * @param frames  Number of samples to mix.
+	 * @param volL    Volume of the left channel, in the range 0 - Mixer::kMaxMixerVolume.
+	 * @param volR    Volume of the right channel, in the range 0 - Mixer::kMaxMixerVolume.
+	 */
+	static void mixMonoToStereo(int32 *dst, const st_sample_t *src, uint frames, st_volume_t volL, st_volume_t volR);
+
+	/**
+	 * Clip the bus to the 16-bit output range.
+	 *
+	 * @param dst         The output buffer.
+	 * @param src         The bus.
+	 * @param numSamples  Number of samples (not sample pairs) to convert.
+	 */
+	static void saturate(st_sample_t *dst, const int32 *src, uint numSamples);
+
+	/**
+	 * Compute the dot product of a run of samples with a set of filter
+	 * coefficients, as used by the FIR rate converters.
+	 *
+	 * @param samples  The source samples, holding @p count samples.
+	 * @param coeffs   The filter coefficients, holding @p count values.
+	 * @param count    Number of taps, a multiple of 8.
+	 *
+	 * @return The sum of the products, without any scaling applied.
+	 */
+	static int32 convolve(const st_sample_t *samples, const int16 *coeffs, uint count);
+
+private:
+	typedef void (*MixFunc)(int32 *, const st_sample_t *, uint, st_volume_t, st_volume_t);
+	typedef void (*SaturateFunc)(st_sample_t *, const int32 *, uint);
+	typedef int32 (*ConvolveFunc)(const st_sample_t *, const int16 *, uint);
+
+	struct Funcs {
+		MixFunc mixStereo;
+		MixFunc mixMonoToStereo;
+		SaturateFunc saturate;
+		ConvolveFunc convolve;
+	};
+
+	static Funcs _funcs;
+	static void selectFuncs();
+
+	static void mixStereoGeneric(int32 *dst, const st_sample_t *src, uint frames, st_volume_t volL, st_volume_t volR);
+	static void mixMonoToStereoGeneric(int32 *dst, const st_sample_t *src, uint frames, st_volume_t volL, st_volume_t volR);
+	static void saturateGeneric(st_sample_t *dst, const int32 *src, uint numSamples);
+	static int32 convolveGeneric(const st_sample_t *samples, const int16 *coeffs, uint count);
+
+#ifdef SCUMMVM_NEON
+	static void mixStereoNEON(int32 *dst, const st_sample_t *src, uint frames, st_volume_t volL, st_volume_t volR);
+	static void mixMonoToStereoNEON(int32 *dst, const st_sample_t *src, uint frames, st_volume_t volL, st_volume_t volR);
+	static void saturateNEON(st_sample_t *dst, const int32 *src, uint numSamples);
+	static int32 convolveNEON(const st_sample_t *samples, const int16 *coeffs, uint count);
+#endif
+#ifdef SCUMMVM_SSE2
+	static void mixStereoSSE2(int32 *dst, const st_sample_t *src, uint frames, st_volume_t volL, st_volume_t volR);
+	static void mixMonoToStereoSSE2(int32 *dst, const st_sample_t *src, uint frames, st_volume_t volL, st_volume_t volR);
+	static void saturateSSE2(st_sample_t *dst, const int32 *src, uint numSamples);
+	static int32 convolveSSE2(const st_sample_t *samples, const int16 *coeffs, uint count);
+#endif
+#ifdef SCUMMVM_AVX2
+	static void mixStereoAVX2(int32 *dst, const st_sample_t *src, uint frames, st_volume_t volL, st_volume_t volR);
+	static void mixMonoToStereoAVX2(int32 *dst, const st_sample_t *src, uint frames, st_volume_t volL, st_volume_t volR);
+	static void saturateAVX2(st_sample_t *dst, const int32 *src, uint numSamples);
+	static int32 convolveAVX2(const st_sample_t *samples, const int16 *coeffs, uint count);
+#endif
+
+	friend class ::MixBusTestSuite;
+	friend class ::RateConverterTestSuite;
+};
+
+/** @} */
+} // End of namespace Audio
+
+#endif
@@ -25,10 +25,13 @@
 #include "common/textconsole.h"
 
 #include "audio/mixer_intern.h"
+#include "audio/mixbus.h"
 #include "audio/rate.h"
 #include "audio/audiostream.h"
 #include "audio/timestamp.h"
 
+#include <atomic>
+
 
 namespace Audio {
 
@@ -42,24 +45,35 @@ namespace Audio {
  */
 class Channel {
 public:
-	Channel(Mixer *mixer, Mixer::SoundType type, AudioStream *stream, DisposeAfterUse::Flag autofreeStream, bool reverseStereo, int id, bool permanent);
+	Channel(Mixer *mixer, Mixer::SoundType type, AudioStream *stream, DisposeAfterUse::Flag autofreeStream, bool reverseStereo, RateConverterType converterType, int id, bool permanent);
 	~Channel();
 
 	/**
-	 * Mixes the channel's samples into the given buffer.
+	 * Mixes the channel's samples into the given mixing bus.
 	 *
-	 * @param data buffer where to mix the data
+	 * @param data bus where to mix the data
 	 * @param len  number of sample *pairs*. So a value of
-	 *             10 means that the buffer contains twice 10 sample, each
-	 *             16 bits, for a total of 40 bytes.
+	 *             10 means that the bus contains twice 10 samples, each
+	 *             32 bits, for a total of 80 bytes.
 	 * @return number of sample pairs processed (which can still be silence!)
 	 */
-	int mix(int16 *data, uint len);
+	int mix(int32 *data, uint len);
 
 	/**
 	 * Queries whether the channel is still playing or not.
 	 */
-	bool isFinished() const { return _stream->endOfStream() && !_converter->needsDraining(); }
+	bool isFinished() const { return _mixStream.load(std::memory_order_acquire)->endOfStream() && !_converter->needsDraining(); }
+
+	/**
+	 * Marks the channel as finished, so that it gets deleted from the engine
+	 * side. Used by the mixer callback in lock-free mode.
+	 */
+	void retire() { _retired.store(true, std::memory_order_release); }
+
+	/**
+	 * Queries whether the channel was marked as finished by the mixer callback.
+	 */
+	bool isRetired() const { return _retired.load(std::memory_order_acquire); }
 
 	/**
 	 * Queries whether the channel is a permanent channel.
@@ -86,6 +100,11 @@ public:
 	 */
 	bool isPaused() const { return (_pauseLevel != 0); }
 
+	/**
+	 * Queries whether the mixer callback should skip the channel.
+	 */
+	bool isMixPaused() const { return _mixPaused.load(std::memory_order_relaxed); }
+
 	/**
 	 * Sets the channel's own volume.
 	 *
@@ -208,31 +227,54 @@ private:
 	uint8 _faderR;
 
 	void updateChannelVolumes();
-	st_volume_t _volL, _volR;
+
+	// The parameters used by mix(). They are set from the engine side and
+	// read by the mixer callback without locking.
+	std::atomic<uint32> _mixVolumes; // Left volume in the high word, right volume in the low word
+	std::atomic<uint32> _mixRate;
+	std::atomic<bool> _mixPaused;
+	std::atomic<bool> _retired;
 
 	Mixer *_mixer;
 
-	uint32 _samplesConsumed;
+	// The samples consumed before the last mix() in the high word, and the
+	// time of that mix() in the low word. Set by the mixer callback and read
+	// by getElapsedTime() without locking.
+	std::atomic<uint64> _mixPosition;
+
 	uint32 _samplesDecoded;
-	uint32 _mixerTimeStamp;
 	uint32 _pauseStartTime;
 	uint32 _pauseTime;
+	uint32 _resumeTime;
 
 	RateConverter *_converter;
 	Common::DisposablePtr<AudioStream> _stream;
+
+	// The looping stream set up by loop(), which reads from _stream
+	Common::ScopedPtr<AudioStream> _loopStream;
+
+	// The stream mix() reads from: _stream, or _loopStream once the channel
+	// loops
+	std::atomic<AudioStream *> _mixStream;
 };
 
 #pragma mark -
 #pragma mark --- Mixer ---
 #pragma mark -
 
-MixerImpl::MixerImpl(uint sampleRate, bool stereo, uint outBufSize)
-	: _mutex(), _sampleRate(sampleRate), _stereo(stereo), _outBufSize(outBufSize), _mixerReady(false), _handleSeed(0), _soundTypeSettings() {
+MixerImpl::MixerImpl(uint sampleRate, bool stereo, uint outBufSize, bool lockFree)
+	: _mutex(), _channelMutex(), _sampleRate(sampleRate), _stereo(stereo), _outBufSize(outBufSize), _lockFree(lockFree),
+	  _rateConverterType(kRateConverterDefault), _mixerReady(false), _handleSeed(0), _soundTypeSettings() {
 
 	assert(sampleRate > 0);
 
 	for (int i = 0; i != NUM_CHANNELS; i++)
 		_channels[i] = nullptr;
+
+	// Backends which don't know the size of their buffers get a bus for
+	// MIX_BUFFER_FRAMES frames, and longer buffers are mixed in parts
+	const uint busLen = outBufSize ? outBufSize : (uint)MIX_BUFFER_FRAMES;
+	_mixBuffer.resize(busLen * (stereo ? 2 : 1));
 }
 
 MixerImpl::~MixerImpl() {
@@ -246,6 +288,12 @@ void MixerImpl::setReady(bool ready) {
 	_mixerReady = ready;
 }
 
+void MixerImpl::setRateConverterType(RateConverterType type) {
+	Common::StackLock lock(_mutex);
+
+	_rateConverterType = type;
+}
+
 uint MixerImpl::getOutputRate() const {
 	return _sampleRate;
 }
@@ -258,6 +306,25 @@ uint MixerImpl::getOutputBufSize() const {
 	return _outBufSize;
 }
 
+Channel *MixerImpl::findChannel(SoundHandle handle) const {
+	const int index = handle._val % NUM_CHANNELS;
+	Channel *chan = _channels[index];
+	if (!chan || chan->getHandle()._val != handle._val || chan->isRetired())
+		return nullptr;
+
+	return chan;
+}
+
+void MixerImpl::releaseFinishedChannels() {
+	// Both the mixer and the channel mutex must be held here
+	for (int i = 0; i != NUM_CHANNELS; i++) {
+		if (_channels[i] != nullptr && _channels[i]->isRetired()) {
+			delete _channels[i];
+			_channels[i] = nullptr;
+		}
+	}
+}
+
 void MixerImpl::insertChannel(SoundHandle *handle, Channel *chan) {
 	int index = -1;
 	for (int i = 0; i != NUM_CHANNELS; i++) {
@@ -292,6 +359,7 @@ void MixerImpl::playStream(
 			bool permanent,
 			bool reverseStereo) {
 	Common::StackLock lock(_mutex);
+	Common::StackLock channelLock(_channelMutex);
 
 	if (stream == nullptr) {
 		warning("stream is 0");
@@ -301,6 +369,8 @@ void MixerImpl::playStream(
 
 	assert(_mixerReady);
 
+	releaseFinishedChannels();
+
 	// Prevent duplicate sounds
 	if (id != -1) {
 		for (int i = 0; i != NUM_CHANNELS; i++)
@@ -322,7 +392,7 @@ void MixerImpl::playStream(
 #endif
 
 	// Create the channel
-	Channel *chan = new Channel(this, type, stream, autofreeStream, reverseStereo, id, permanent);
+	Channel *chan = new Channel(this, type, stream, autofreeStream, reverseStereo, _rateConverterType, id, permanent);
 	chan->setVolume(volume);
 	chan->setBalance(balance);
 	insertChannel(handle, chan);
@@ -338,9 +408,6 @@ int MixerImpl::mixCallback(byte *samples, uint len) {
 	// Since the mixer callback has been called, the mixer must be ready...
 	_mixerReady = true;
 
-	//  zero the buf
-	memset(buf, 0, len);
-
 	// we store 16-bit samples
 	if (_stereo) {
 		assert(len % 4 == 0);
@@ -350,26 +417,49 @@ int MixerImpl::mixCallback(byte *samples, uint len) {
 		len >>= 1;
 	}
 
-	// mix all channels
-	int res = 0, tmp;
-	for (int i = 0; i != NUM_CHANNELS; i++)
-		if (_channels[i]) {
-			if (_channels[i]->isFinished()) {
-				delete _channels[i];
-				_channels[i] = nullptr;
-			} else if (!_channels[i]->isPaused()) {
-				tmp = _channels[i]->mix(buf, len);
-
-				if (tmp > res)
-					res = tmp;
+	// All channels are added up in a 32-bit bus, which only gets clipped
+	// once at the end. Buffers longer than the bus are mixed in parts.
+	const uint channels = _stereo ? 2 : 1;
+	const uint busLen = _mixBuffer.size() / channels;
+	int32 *bus = _mixBuffer.data();
+
+	int res = 0;
+	for (uint offset = 0; offset < len; offset += busLen) {
+		const uint partLen = MIN(len - offset, busLen);
+		const uint numSamples = partLen * channels;
+		memset(bus, 0, numSamples * sizeof(int32));
+
+		// mix all channels
+		int partRes = 0, tmp;
+		for (int i = 0; i != NUM_CHANNELS; i++)
+			if (_channels[i] && !_channels[i]->isRetired()) {
+				if (_channels[i]->isFinished()) {
+					// In lock-free mode, engine-side commands may still be looking
+					// at the channel, so it gets deleted from the engine side
+					if (_lockFree) {
+						_channels[i]->retire();
+					} else {
+						delete _channels[i];
+						_channels[i] = nullptr;
+					}
+				} else if (!_channels[i]->isMixPaused()) {
+					tmp = _channels[i]->mix(bus, partLen);
+
+					if (tmp > partRes)
+						partRes = tmp;
+				}
 			}
-		}
+
+		MixBus::saturate(buf + offset * channels, bus, numSamples);
+		res += partRes;
+	}
 
 	return res;
 }
 
 void MixerImpl::stopAll() {
 	Common::StackLock lock(_mutex);
+	Common::StackLock channelLock(_channelMutex);
 	for (int i = 0; i != NUM_CHANNELS; i++) {
 		if (_channels[i] != nullptr && !_channels[i]->isPermanent()) {
 			delete _channels[i];
@@ -380,6 +470,7 @@ void MixerImpl::stopAll() {
 
 void MixerImpl::stopID(int id) {
 	Common::StackLock lock(_mutex);
+	Common::StackLock channelLock(_channelMutex);
 	for (int i = 0; i != NUM_CHANNELS; i++) {
 		if (_channels[i] != nullptr && _channels[i]->getId() == id) {
 			delete _channels[i];
@@ -390,6 +481,7 @@ void MixerImpl::stopID(int id) {
 
 void MixerImpl::stopHandle(SoundHandle handle) {
 	Common::StackLock lock(_mutex);
+	Common::StackLock channelLock(_channelMutex);
 
 	// Simply ignore stop requests for handles of sounds that already terminated
 	const int index = handle._val % NUM_CHANNELS;
@@ -404,6 +496,7 @@ void MixerImpl::muteSoundType(SoundType type, bool mute) {
 	assert(0 <= (int)type && (int)type < ARRAYSIZE(_soundTypeSettings));
 	_soundTypeSettings[type].mute = mute;
 
+	Common::StackLock lock(_channelMutex);
 	for (int i = 0; i != NUM_CHANNELS; ++i) {
 		if (_channels[i] && _channels[i]->getType() == type)
 			_channels[i]->notifyGlobalVolChange();
@@ -416,103 +509,91 @@ bool MixerImpl::isSoundTypeMuted(SoundType type) const {
 }
 
 void MixerImpl::setChannelVolume(SoundHandle handle, byte volume) {
-	Common::StackLock lock(_mutex);
-
-	const int index = handle._val % NUM_CHANNELS;
-	if (!_channels[index] || _channels[index]->getHandle()._val != handle._val)
-		return;
+	Common::StackLock lock(channelMutex());
 
-	_channels[index]->setVolume(volume);
+	Channel *chan = findChannel(handle);
+	if (chan)
+		chan->setVolume(volume);
 }
 
 byte MixerImpl::getChannelVolume(SoundHandle handle) {
-	const int index = handle._val % NUM_CHANNELS;
-	if (!_channels[index] || _channels[index]->getHandle()._val != handle._val)
+	Channel *chan = findChannel(handle);
+	if (!chan)
 		return 0;
 
-	return _channels[index]->getVolume();
+	return chan->getVolume();
 }
 
 void MixerImpl::setChannelBalance(SoundHandle handle, int8 balance) {
-	Common::StackLock lock(_mutex);
-
-	const int index = handle._val % NUM_CHANNELS;
-	if (!_channels[index] || _channels[index]->getHandle()._val != handle._val)
-		return;
+	Common::StackLock lock(channelMutex());
 
-	_channels[index]->setBalance(balance);
+	Channel *chan = findChannel(handle);
+	if (chan)
+		chan->setBalance(balance);
 }
 
 int8 MixerImpl::getChannelBalance(SoundHandle handle) {
-	const int index = handle._val % NUM_CHANNELS;
-	if (!_channels[index] || _channels[index]->getHandle()._val != handle._val)
+	Channel *chan = findChannel(handle);
+	if (!chan)
 		return 0;
 
-	return _channels[index]->getBalance();
+	return chan->getBalance();
 }
 
 void MixerImpl::setChannelFaderL(SoundHandle handle, uint8 faderL) {
-	Common::StackLock lock(_mutex);
+	Common::StackLock lock(channelMutex());
 
-	const int index = handle._val % NUM_CHANNELS;
-	if (!_channels[index] || _channels[index]->getHandle()._val != handle._val)
-		return;
-
-	_channels[index]->setFaderL(faderL);
+	Channel *chan = findChannel(handle);
+	if (chan)
+		chan->setFaderL(faderL);
 }
 
 uint8 MixerImpl::getChannelFaderL(SoundHandle handle) {
-	const int index = handle._val % NUM_CHANNELS;
-	if (!_channels[index] || _channels[index]->getHandle()._val != handle._val)
+	Channel *chan = findChannel(handle);
+	if (!chan)
 		return 0;
 
-	return _channels[index]->getFaderL();
+	return chan->getFaderL();
 }
 
 void MixerImpl::setChannelFaderR(SoundHandle handle, uint8 faderR) {
-	Common::StackLock lock(_mutex);
+	Common::StackLock lock(channelMutex());
 
-	const int index = handle._val % NUM_CHANNELS;
-	if (!_channels[index] || _channels[index]->getHandle()._val != handle._val)
-		return;
-
-	_channels[index]->setFaderR(faderR);
+	Channel *chan = findChannel(handle);
+	if (chan)
+		chan->setFaderR(faderR);
 }
 
 uint8 MixerImpl::getChannelFaderR(SoundHandle handle) {
-	const int index = handle._val % NUM_CHANNELS;
-	if (!_channels[index] || _channels[index]->getHandle()._val != handle._val)
+	Channel *chan = findChannel(handle);
+	if (!chan)
 		return 0;
 
-	return _channels[index]->getFaderR();
+	return chan->getFaderR();
 }
 
 void MixerImpl::setChannelRate(SoundHandle handle, uint32 rate) {
-	Common::StackLock lock(_mutex);
-
-	const int index = handle._val % NUM_CHANNELS;
-	if (!_channels[index] || _channels[index]->getHandle()._val != handle._val)
-		return;
+	Common::StackLock lock(channelMutex());
 
-	_channels[index]->setRate(rate);
+	Channel *chan = findChannel(handle);
+	if (chan)
+		chan->setRate(rate);
 }
 
 uint32 MixerImpl::getChannelRate(SoundHandle handle) {
-	const int index = handle._val % NUM_CHANNELS;
-	if (!_channels[index] || _channels[index]->getHandle()._val != handle._val)
+	Channel *chan = findChannel(handle);
+	if (!chan)
 		return 0;
 
-	return _channels[index]->getRate();
+	return chan->getRate();
 }
 
 void MixerImpl::resetChannelRate(SoundHandle handle) {
-	Common::StackLock lock(_mutex);
+	Common::StackLock lock(channelMutex());
 
-	const int index = handle._val % NUM_CHANNELS;
-	if (!_channels[index] || _channels[index]->getHandle()._val != handle._val)
-		return;
-
-	_channels[index]->resetRate();
+	Channel *chan = findChannel(handle);
+	if (chan)
+		chan->resetRate();
 }
 
 uint32 MixerImpl::getSoundElapsedTime(SoundHandle handle) {
@@ -520,27 +601,25 @@ uint32 MixerImpl::getSoundElapsedTime(SoundHandle handle) {
 }
 
 Timestamp MixerImpl::getElapsedTime(SoundHandle handle) {
-	Common::StackLock lock(_mutex);
+	Common::StackLock lock(channelMutex());
 
-	const int index = handle._val % NUM_CHANNELS;
-	if (!_channels[index] || _channels[index]->getHandle()._val != handle._val)
+	Channel *chan = findChannel(handle);
+	if (!chan)
 		return Timestamp(0, _sampleRate);
 
-	return _channels[index]->getElapsedTime();
+	return chan->getElapsedTime();
 }
 
 void MixerImpl::loopChannel(SoundHandle handle) {
-	Common::StackLock lock(_mutex);
+	Common::StackLock lock(channelMutex());
 
-	const int index = handle._val % NUM_CHANNELS;
-	if (!_channels[index] || _channels[index]->getHandle()._val != handle._val)
-		return;
-
-	_channels[index]->loop();
+	Channel *chan = findChannel(handle);
+	if (chan)
+		chan->loop();
 }
 
 void MixerImpl::pauseAll(bool paused) {
-	Common::StackLock lock(_mutex);
+	Common::StackLock lock(channelMutex());
 	for (int i = 0; i != NUM_CHANNELS; i++) {
 		if (_channels[i] != nullptr) {
 			_channels[i]->pause(paused);
@@ -549,7 +628,7 @@ void MixerImpl::pauseAll(bool paused) {
 }
 
 void MixerImpl::pauseID(int id, bool paused) {
-	Common::StackLock lock(_mutex);
+	Common::StackLock lock(channelMutex());
 	for (int i = 0; i != NUM_CHANNELS; i++) {
 		if (_channels[i] != nullptr && _channels[i]->getId() == id) {
 			_channels[i]->pause(paused);
@@ -559,52 +638,50 @@ void MixerImpl::pauseID(int id, bool paused) {
 }
 
 void MixerImpl::pauseHandle(SoundHandle handle, bool paused) {
-	Common::StackLock lock(_mutex);
+	Common::StackLock lock(channelMutex());
 
 	// Simply ignore (un)pause requests for sounds that already terminated
-	const int index = handle._val % NUM_CHANNELS;
-	if (!_channels[index] || _channels[index]->getHandle()._val != handle._val)
-		return;
-
-	_channels[index]->pause(paused);
+	Channel *chan = findChannel(handle);
+	if (chan)
+		chan->pause(paused);
 }
 
 bool MixerImpl::isSoundIDActive(int id) {
-	Common::StackLock lock(_mutex);
+	Common::StackLock lock(channelMutex());
 
 #ifdef ENABLE_EVENTRECORDER
 	g_eventRec.updateSubsystems();
 #endif
 
 	for (int i = 0; i != NUM_CHANNELS; i++)
-		if (_channels[i] && _channels[i]->getId() == id)
+		if (_channels[i] && _channels[i]->getId() == id && !_channels[i]->isRetired())
 			return true;
 	return false;
 }
 
 int MixerImpl::getSoundID(SoundHandle handle) {
-	Common::StackLock lock(_mutex);
-	const int index = handle._val % NUM_CHANNELS;
-	if (_channels[index] && _channels[index]->getHandle()._val == handle._val)
-		return _channels[index]->getId();
+	Common::StackLock lock(channelMutex());
+
+	Channel *chan = findChannel(handle);
+	if (chan)
+		return chan->getId();
 	return 0;
 }
 
 bool MixerImpl::isSoundHandleActive(SoundHandle handle) {
-	Common::StackLock lock(_mutex);
+	Common::StackLock lock(channelMutex());
 
 #ifdef ENABLE_EVENTRECORDER
 	g_eventRec.updateSubsystems();
 #endif
 
-	const int index = handle._val % NUM_CHANNELS;
-	return _channels[index] && _channels[index]->getHandle()._val == handle._val;
+	return findChannel(handle) != nullptr;
 }
 
 bool MixerImpl::hasActiveChannelOfType(SoundType type) {
-	Common::StackLock lock(_mutex);
+	Common::StackLock lock(channelMutex());
 	for (int i = 0; i != NUM_CHANNELS; i++)
-		if (_channels[i] && _channels[i]->getType() == type)
+		if (_channels[i] && _channels[i]->getType() == type && !_channels[i]->isRetired())
 			return true;
 	return false;
 }
@@ -618,7 +695,7 @@ void MixerImpl::setVolumeForSoundType(SoundType type, int volume) {
 	// TODO: Maybe we should do logarithmic (not linear) volume
 	// scaling? See also Player_V2::setMasterVolume
 
-	Common::StackLock lock(_mutex);
+	Common::StackLock lock(channelMutex());
 	_soundTypeSettings[type].volume = volume;
 
 	for (int i = 0; i != NUM_CHANNELS; ++i) {
@@ -639,16 +716,18 @@ int MixerImpl::getVolumeForSoundType(SoundType type) const {
 #pragma mark -
 
 Channel::Channel(Mixer *mixer, Mixer::SoundType type, AudioStream *stream,
-				 DisposeAfterUse::Flag autofreeStream, bool reverseStereo, int id, bool permanent)
+				 DisposeAfterUse::Flag autofreeStream, bool reverseStereo, RateConverterType converterType, int id, bool permanent)
 	: _type(type), _mixer(mixer), _id(id), _permanent(permanent), _volume(Mixer::kMaxChannelVolume),
-	  _balance(0), _faderL(255), _faderR(255), _pauseLevel(0), _samplesConsumed(0), _samplesDecoded(0), _mixerTimeStamp(0),
-	  _pauseStartTime(0), _pauseTime(0), _converter(nullptr), _volL(0), _volR(0),
-	  _stream(stream, autofreeStream) {
+	  _balance(0), _faderL(255), _faderR(255), _pauseLevel(0), _mixPosition(0), _samplesDecoded(0),
+	  _pauseStartTime(0), _pauseTime(0), _resumeTime(0), _converter(nullptr), _mixVolumes(0), _mixRate(0),
+	  _mixPaused(false), _retired(false), _stream(stream, autofreeStream), _mixStream(stream) {
 	assert(mixer);
 	assert(stream);
 
+	_mixRate.store(_stream->getRate(), std::memory_order_relaxed);
+
 	// Get a rate converter instance
-	_converter = makeRateConverter(_stream->getRate(), mixer->getOutputRate(), _stream->isStereo(), mixer->getOutputStereo(), reverseStereo);
+	_converter = makeRateConverter(_stream->getRate(), mixer->getOutputRate(), _stream->isStereo(), mixer->getOutputStereo(), reverseStereo, converterType);
 }
 
 Channel::~Channel() {
@@ -692,21 +771,17 @@ uint8 Channel::getFaderR() {
 }
 
 void Channel::setRate(uint32 rate) {
-	if (_converter)
-		_converter->setInputRate(rate);
+	// The converter picks up the new rate in mix()
+	_mixRate.store(rate, std::memory_order_relaxed);
 }
 
 uint32 Channel::getRate() {
-	if (_converter)
-		return _converter->getInputRate();
-
-	return 0;
+	return _mixRate.load(std::memory_order_relaxed);
 }
 
 void Channel::resetRate() {
-	if (_converter && _stream) {
-		_converter->setInputRate(_stream->getRate());
-	}
+	if (_stream)
+		_mixRate.store(_stream->getRate(), std::memory_order_relaxed);
 }
 
 void Channel::updateChannelVolumes() {
@@ -718,24 +793,28 @@ void Channel::updateChannelVolumes() {
 	// volume is in the range 0 - kMaxMixerVolume.
 	// Hence, the vol_l/vol_r values will be in that range, too
 
+	st_volume_t volL, volR;
+
 	if (!_mixer->isSoundTypeMuted(_type)) {
 		int vol = _mixer->getVolumeForSoundType(_type) * _volume;
 
 		if (_balance == 0) {
-			_volL = vol / Mixer::kMaxChannelVolume;
-			_volR = vol / Mixer::kMaxChannelVolume;
+			volL = vol / Mixer::kMaxChannelVolume;
+			volR = vol / Mixer::kMaxChannelVolume;
 		} else if (_balance < 0) {
-			_volL = vol / Mixer::kMaxChannelVolume;
-			_volR = ((127 + _balance) * vol) / (Mixer::kMaxChannelVolume * 127);
+			volL = vol / Mixer::kMaxChannelVolume;
+			volR = ((127 + _balance) * vol) / (Mixer::kMaxChannelVolume * 127);
 		} else {
-			_volL = ((127 - _balance) * vol) / (Mixer::kMaxChannelVolume * 127);
-			_volR = vol / Mixer::kMaxChannelVolume;
+			volL = ((127 - _balance) * vol) / (Mixer::kMaxChannelVolume * 127);
+			volR = vol / Mixer::kMaxChannelVolume;
 		}
-		_volL = (st_volume_t)((int)_volL * (int)_faderL / 255);
-		_volR = (st_volume_t)((int)_volR * (int)_faderR / 255);
+		volL = (st_volume_t)((int)volL * (int)_faderL / 255);
+		volR = (st_volume_t)((int)volR * (int)_faderR / 255);
 	} else {
-		_volL = _volR = 0;
+		volL = volR = 0;
 	}
+
+	_mixVolumes.store(((uint32)volL << 16) | volR, std::memory_order_relaxed);
 }
 
 void Channel::pause(bool paused) {
@@ -744,14 +823,18 @@ void Channel::pause(bool paused) {
 	if (paused) {
 		_pauseLevel++;
 
-		if (_pauseLevel == 1)
+		if (_pauseLevel == 1) {
 			_pauseStartTime = g_system->getMillis(true);
+			_mixPaused.store(true, std::memory_order_relaxed);
+		}
 	} else if (_pauseLevel > 0) {
 		_pauseLevel--;
 
 		if (!_pauseLevel) {
-			_pauseTime = (g_system->getMillis(true) - _pauseStartTime);
+			_resumeTime = g_system->getMillis(true);
+			_pauseTime = _resumeTime - _pauseStartTime;
 			_pauseStartTime = 0;
+			_mixPaused.store(false, std::memory_order_relaxed);
 		}
 	}
 }
@@ -762,17 +845,26 @@ Timestamp Channel::getElapsedTime() {
 
 	Audio::Timestamp ts(0, rate);
 
-	if (_mixerTimeStamp == 0)
+	const uint64 position = _mixPosition.load(std::memory_order_acquire);
+	const uint32 samplesConsumed = position >> 32;
+	const uint32 mixerTimeStamp = position & 0xFFFFFFFF;
+
+	if (mixerTimeStamp == 0)
 		return ts;
 
-	if (isPaused())
-		delta = _pauseStartTime - _mixerTimeStamp;
-	else
-		delta = g_system->getMillis(true) - _mixerTimeStamp - _pauseTime;
+	if (isPaused()) {
+		delta = _pauseStartTime - mixerTimeStamp;
+	} else {
+		delta = g_system->getMillis(true) - mixerTimeStamp;
+
+		// Only a pause that ended after the last mix() affects the estimate
+		if (_resumeTime > mixerTimeStamp)
+			delta -= _pauseTime;
+	}
 
 	// Convert the number of samples into a time duration.
 
-	ts = ts.addFrames(_samplesConsumed);
+	ts = ts.addFrames(samplesConsumed);
 	ts = ts.addMsecs(delta);
 
 	// In theory it would seem like a good idea to limit the approximation
@@ -787,22 +879,31 @@ Timestamp Channel::getElapsedTime() {
 void Channel::loop() {
 	assert(_stream);
 
-	if (_stream.isDynamicallyCastable<RewindableAudioStream>()) {
-		Audio::LoopingAudioStream *loopingStream = new Audio::LoopingAudioStream(Common::move(_stream.moveAndDynamicCast<RewindableAudioStream>()), 0, false);
-		_stream.reset(loopingStream, DisposeAfterUse::YES);
-	}
+	if (_loopStream || !_stream.isDynamicallyCastable<RewindableAudioStream>())
+		return;
+
+	// The channel keeps owning the stream, so that mix() can switch over to
+	// the looping stream while the stream is in use
+	RewindableAudioStream *stream = dynamic_cast<RewindableAudioStream *>(_stream.get());
+	_loopStream.reset(new LoopingAudioStream(stream, 0, DisposeAfterUse::NO, false));
+	_mixStream.store(_loopStream.get(), std::memory_order_release);
 }
 
-int Channel::mix(int16 *data, uint len) {
-	assert(_stream);
+int Channel::mix(int32 *data, uint len) {
+	AudioStream *stream = _mixStream.load(std::memory_order_acquire);
+	assert(stream);
 	assert(_converter);
 
+	const uint32 rate = _mixRate.load(std::memory_order_relaxed);
+	if (rate != _converter->getInputRate())
+		_converter->setInputRate(rate);
+
 	int res = 0;
-	if (!_stream->endOfData() || _converter->needsDraining()) {
-		_samplesConsumed = _samplesDecoded;
-		_mixerTimeStamp = g_system->getMillis(true);
-		_pauseTime = 0;
-		res = _converter->convert(*_stream, data, len, _volL, _volR);
+	if (!stream->endOfData() || _converter->needsDraining()) {
+		const uint32 volumes = _mixVolumes.load(std::memory_order_relaxed);
+
+		_mixPosition.store(((uint64)_samplesDecoded << 32) | g_system->getMillis(true), std::memory_order_release);
+		res = _converter->convert(*stream, data, len, volumes >> 16, volumes & 0xFFFF);
 		_samplesDecoded += res;
 	}
 
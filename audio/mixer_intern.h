@@ -23,8 +23,10 @@
 #define AUDIO_MIXER_INTERN_H
 
 #include "common/scummsys.h"
+#include "common/array.h"
 #include "common/mutex.h"
 #include "audio/mixer.h"
+#include "audio/rate.h"
 
 namespace Audio {
 
@@ -53,19 +55,31 @@ namespace Audio {
  * (partial) alternative implementations of the mixer, e.g. to make
  * better use of native sound mixing support on low-end devices.
  *
+ * In lock-free mode, the engine-side channel commands (volume, balance,
+ * faders, rate, pausing, looping) and the channel queries, including the
+ * elapsed time, do not take the mixer mutex. They are serialized among each other by a separate mutex and hand
+ * their parameters over to mixCallback() through atomic per-channel values.
+ * Finished channels are then released on the engine side instead of in the
+ * audio callback. Starting and stopping sounds, as well as any engine code
+ * that explicitly synchronizes on mutex(), still locks the mixer mutex.
+ *
  * @see OSystem::getMixer()
  */
 class MixerImpl : public Mixer {
 private:
 	enum {
-		NUM_CHANNELS = 32
+		NUM_CHANNELS = 32,
+		MIX_BUFFER_FRAMES = 4096
 	};
 
 	Common::Mutex _mutex;
+	Common::Mutex _channelMutex;
 
 	const uint _sampleRate;
 	const bool _stereo;
 	const uint _outBufSize;
+	const bool _lockFree;
+	RateConverterType _rateConverterType;
 	bool _mixerReady;
 	uint32 _handleSeed;
 
@@ -79,10 +93,27 @@ private:
 	SoundTypeSettings _soundTypeSettings[4];
 	Channel *_channels[NUM_CHANNELS];
 
+	/**
+	 * The 32-bit bus all channels get mixed into. It is allocated up front,
+	 * so that the audio callback never allocates.
+	 */
+	Common::Array<int32> _mixBuffer;
+
+	/**
+	 * The mutex guarding channel commands and queries: the mixer mutex in
+	 * the default mode, a mutex not shared with mixCallback() in lock-free mode.
+	 */
+	Common::Mutex &channelMutex() { return _lockFree ? _channelMutex : _mutex; }
+
+	/** Return the channel for a handle, or nullptr if it is no longer playing. */
+	Channel *findChannel(SoundHandle handle) const;
+
+	/** Delete the channels mixCallback() marked as finished in lock-free mode. */
+	void releaseFinishedChannels();
 
 public:
 
-	MixerImpl(uint sampleRate, bool stereo = true, uint outBufSize = 0);
+	MixerImpl(uint sampleRate, bool stereo = true, uint outBufSize = 0, bool lockFree = false);
 	~MixerImpl();
 
 	bool isReady() const override { Common::StackLock lock(_mutex); return _mixerReady; }
@@ -140,6 +171,15 @@ public:
 	bool getOutputStereo() const override;
 	uint getOutputBufSize() const override;
 
+	/** Whether channel commands bypass the mixer mutex. */
+	bool isLockFree() const { return _lockFree; }
+
+	/**
+	 * Set the resampling algorithm used by channels started from now on.
+	 */
+	void setRateConverterType(RateConverterType type);
+	RateConverterType getRateConverterType() const { return _rateConverterType; }
+
 protected:
 	void insertChannel(SoundHandle *handle, Channel *chan);
 
@@ -21,12 +21,14 @@ MODULE_OBJS := \
 	midiplayer.o \
 	miles_adlib.o \
 	miles_midi.o \
+	mixbus.o \
 	mixer.o \
 	mpu401.o \
 	mt32gm.o \
 	musicplugin.o \
 	null.o \
 	rate.o \
+	renderahead.o \
 	sid.o \
 	timestamp.o \
 	decoders/3do.o \
@@ -61,6 +63,7 @@ MODULE_OBJS := \
 	mods/soundfx.o \
 	mods/tfmx.o \
 	softsynth/cms.o \
+	softsynth/emumidi.o \
 	softsynth/opl/dbopl.o \
 	softsynth/opl/dosbox.o \
 	softsynth/opl/mame.o \
@@ -136,5 +139,18 @@ MODULE_OBJS += \
 	soundfont/vab/vab.o
 endif
 
+ifdef SCUMMVM_NEON
+MODULE_OBJS += \
+	mixbus-neon.o
+endif
+ifdef SCUMMVM_SSE2
+MODULE_OBJS += \
+	mixbus-sse2.o
+endif
+ifdef SCUMMVM_AVX2
+MODULE_OBJS += \
+	mixbus-avx2.o
+endif
+
 # Include common rules
 include $(srcdir)/rules.mk
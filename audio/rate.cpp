@@ -28,10 +28,15 @@
  */
 
 #include "audio/audiostream.h"
+#include "audio/mixbus.h"
 #include "audio/rate.h"
 #include "audio/mixer.h"
+#include "common/algorithm.h"
+#include "common/array.h"
 #include "common/util.h"
 
+#include <math.h>
+
 namespace Audio {
 
 /**
@@ -45,6 +50,42 @@ enum {
 	FRAC_HALF_LOW = (1L << (FRAC_BITS_LOW-1))
 };
 
+/**
+ * Adds a sample to the output. 16-bit outputs are clipped right away, while
+ * the 32-bit mixing bus is only clipped by the mixer once all channels have
+ * been added up.
+ */
+static inline void mixSample(st_sample_t &out, int sample) {
+	clampedAdd(out, sample);
+}
+
+static inline void mixSample(int32 &out, int sample) {
+	out += sample;
+}
+
+/**
+ * Mixes whole blocks of unconverted samples at once, for the output formats
+ * that have a vectorized MixBus kernel.
+ */
+template<typename T, bool inStereo, bool outStereo, bool reverseStereo>
+struct BlockMixer {
+	static const bool kSupported = false;
+
+	static void mix(T *outBuffer, const st_sample_t *inBuffer, st_size_t frames, st_volume_t volL, st_volume_t volR) {}
+};
+
+template<bool inStereo>
+struct BlockMixer<int32, inStereo, true, false> {
+	static const bool kSupported = true;
+
+	static void mix(int32 *outBuffer, const st_sample_t *inBuffer, st_size_t frames, st_volume_t volL, st_volume_t volR) {
+		if (inStereo)
+			MixBus::mixStereo(outBuffer, inBuffer, frames, volL, volR);
+		else
+			MixBus::mixMonoToStereo(outBuffer, inBuffer, frames, volL, volR);
+	}
+};
+
 template<bool inStereo, bool outStereo, bool reverseStereo>
 class RateConverter_Impl : public RateConverter {
 private:
@@ -76,15 +117,26 @@ private:
 	/** Current sample(s) in the input stream (left/right channel) */
 	st_sample_t _inCurL, _inCurR;
 
-	int copyConvert(AudioStream &input, st_sample_t *outBuffer, st_size_t numSamples, st_volume_t vol_l, st_volume_t vol_r);
-	int simpleConvert(AudioStream &input, st_sample_t *outBuffer, st_size_t numSamples, st_volume_t vol_l, st_volume_t vol_r);
-	int interpolateConvert(AudioStream &input, st_sample_t *outBuffer, st_size_t numSamples, st_volume_t vol_l, st_volume_t vol_r);
+	template<typename T>
+	int copyConvert(AudioStream &input, T *outBuffer, st_size_t numSamples, st_volume_t vol_l, st_volume_t vol_r);
+	template<typename T>
+	int simpleConvert(AudioStream &input, T *outBuffer, st_size_t numSamples, st_volume_t vol_l, st_volume_t vol_r);
+	template<typename T>
+	int interpolateConvert(AudioStream &input, T *outBuffer, st_size_t numSamples, st_volume_t vol_l, st_volume_t vol_r);
+	template<typename T>
+	int convertT(AudioStream &input, T *outBuffer, st_size_t numSamples, st_volume_t vol_l, st_volume_t vol_r);
 
 public:
 	RateConverter_Impl(st_rate_t inputRate, st_rate_t outputRate);
 	virtual ~RateConverter_Impl() {}
 
-	int convert(AudioStream &input, st_sample_t *outBuffer, st_size_t numSamples, st_volume_t vol_l, st_volume_t vol_r) override;
+	int convert(AudioStream &input, st_sample_t *outBuffer, st_size_t numSamples, st_volume_t vol_l, st_volume_t vol_r) override {
+		return convertT(input, outBuffer, numSamples, vol_l, vol_r);
+	}
+
+	int convert(AudioStream &input, int32 *outBuffer, st_size_t numSamples, st_volume_t vol_l, st_volume_t vol_r) override {
+		return convertT(input, outBuffer, numSamples, vol_l, vol_r);
+	}
 
 	void setInputRate(st_rate_t inputRate) override { _inRate = inputRate; }
 	void setOutputRate(st_rate_t outputRate) override { _outRate = outputRate; }
@@ -96,8 +148,9 @@ public:
 };
 
 template<bool inStereo, bool outStereo, bool reverseStereo>
-int RateConverter_Impl<inStereo, outStereo, reverseStereo>::copyConvert(AudioStream &input, st_sample_t *outBuffer, st_size_t numSamples, st_volume_t volL, st_volume_t volR) {
-	st_sample_t *outStart, *outEnd;
+template<typename T>
+int RateConverter_Impl<inStereo, outStereo, reverseStereo>::copyConvert(AudioStream &input, T *outBuffer, st_size_t numSamples, st_volume_t volL, st_volume_t volR) {
+	T *outStart, *outEnd;
 
 	outStart = outBuffer;
 	outEnd = outBuffer + numSamples * (outStereo ? 2 : 1);
@@ -112,6 +165,17 @@ int RateConverter_Impl<inStereo, outStereo, reverseStereo>::copyConvert(AudioStr
 				return (outBuffer - outStart) / (outStereo ? 2 : 1);
 		}
 
+		if (BlockMixer<T, inStereo, outStereo, reverseStereo>::kSupported) {
+			// Mix as much of the buffered data as fits into the output in one go
+			const st_size_t frames = MIN<st_size_t>(_bufferSize / (inStereo ? 2 : 1), (outEnd - outBuffer) / 2);
+			BlockMixer<T, inStereo, outStereo, reverseStereo>::mix(outBuffer, _bufferPos, frames, volL, volR);
+
+			_bufferPos += frames * (inStereo ? 2 : 1);
+			_bufferSize -= frames * (inStereo ? 2 : 1);
+			outBuffer += frames * 2;
+			continue;
+		}
+
 		// Mix the data into the output buffer
 		st_sample_t inL, inR;
 		inL = *_bufferPos++;
@@ -124,15 +188,15 @@ int RateConverter_Impl<inStereo, outStereo, reverseStereo>::copyConvert(AudioStr
 
 		if (outStereo) {
 			// Output left channel
-			clampedAdd(outBuffer[reverseStereo    ], outL);
+			mixSample(outBuffer[reverseStereo    ], outL);
 
 			// Output right channel
-			clampedAdd(outBuffer[reverseStereo ^ 1], outR);
+			mixSample(outBuffer[reverseStereo ^ 1], outR);
 
 			outBuffer += 2;
 		} else {
 			// Output mono channel
-			clampedAdd(outBuffer[0], (outL + outR) / 2);
+			mixSample(outBuffer[0], (outL + outR) / 2);
 
 			outBuffer += 1;
 		}
@@ -142,11 +206,12 @@ int RateConverter_Impl<inStereo, outStereo, reverseStereo>::copyConvert(AudioStr
 }
 
 template<bool inStereo, bool outStereo, bool reverseStereo>
-int RateConverter_Impl<inStereo, outStereo, reverseStereo>::simpleConvert(AudioStream &input, st_sample_t *outBuffer, st_size_t numSamples, st_volume_t volL, st_volume_t volR) {
+template<typename T>
+int RateConverter_Impl<inStereo, outStereo, reverseStereo>::simpleConvert(AudioStream &input, T *outBuffer, st_size_t numSamples, st_volume_t volL, st_volume_t volR) {
 	// How much to increment _outPos by
 	frac_t outPos_inc = _inRate / _outRate;
 
-	st_sample_t *outStart, *outEnd;
+	T *outStart, *outEnd;
 
 	outStart = outBuffer;
 	outEnd = outBuffer + numSamples * (outStereo ? 2 : 1);
@@ -184,15 +249,15 @@ int RateConverter_Impl<inStereo, outStereo, reverseStereo>::simpleConvert(AudioS
 
 		if (outStereo) {
 			// output left channel
-			clampedAdd(outBuffer[reverseStereo    ], outL);
+			mixSample(outBuffer[reverseStereo    ], outL);
 
 			// output right channel
-			clampedAdd(outBuffer[reverseStereo ^ 1], outR);
+			mixSample(outBuffer[reverseStereo ^ 1], outR);
 
 			outBuffer += 2;
 		} else {
 			// output mono channel
-			clampedAdd(outBuffer[0], (outL + outR) / 2);
+			mixSample(outBuffer[0], (outL + outR) / 2);
 
 			outBuffer += 1;
 		}
@@ -201,11 +266,12 @@ int RateConverter_Impl<inStereo, outStereo, reverseStereo>::simpleConvert(AudioS
 }
 
 template<bool inStereo, bool outStereo, bool reverseStereo>
-int RateConverter_Impl<inStereo, outStereo, reverseStereo>::interpolateConvert(AudioStream &input, st_sample_t *outBuffer, st_size_t numSamples, st_volume_t volL, st_volume_t volR) {
+template<typename T>
+int RateConverter_Impl<inStereo, outStereo, reverseStereo>::interpolateConvert(AudioStream &input, T *outBuffer, st_size_t numSamples, st_volume_t volL, st_volume_t volR) {
 	// How much to increment _outPosFrac by
 	frac_t outPos_inc = (_inRate << FRAC_BITS_LOW) / _outRate;
 
-	st_sample_t *outStart, *outEnd;
+	T *outStart, *outEnd;
 	outStart = outBuffer;
 	outEnd = outBuffer + numSamples * (outStereo ? 2 : 1);
 
@@ -249,15 +315,15 @@ int RateConverter_Impl<inStereo, outStereo, reverseStereo>::interpolateConvert(A
 
 			if (outStereo) {
 				// Output left channel
-				clampedAdd(outBuffer[reverseStereo    ], outL);
+				mixSample(outBuffer[reverseStereo    ], outL);
 
 				// Output right channel
-				clampedAdd(outBuffer[reverseStereo ^ 1], outR);
+				mixSample(outBuffer[reverseStereo ^ 1], outR);
 
 				outBuffer += 2;
 			} else {
 				// Output mono channel
-				clampedAdd(outBuffer[0], (outL + outR) / 2);
+				mixSample(outBuffer[0], (outL + outR) / 2);
 
 				outBuffer += 1;
 			}
@@ -283,7 +349,8 @@ RateConverter_Impl<inStereo, outStereo, reverseStereo>::RateConverter_Impl(st_ra
 	_bufferPos(nullptr) {}
 
 template<bool inStereo, bool outStereo, bool reverseStereo>
-int RateConverter_Impl<inStereo, outStereo, reverseStereo>::convert(AudioStream &input, st_sample_t *outBuffer, st_size_t numSamples, st_volume_t volL, st_volume_t volR) {
+template<typename T>
+int RateConverter_Impl<inStereo, outStereo, reverseStereo>::convertT(AudioStream &input, T *outBuffer, st_size_t numSamples, st_volume_t volL, st_volume_t volR) {
 	assert(input.isStereo() == inStereo);
 
 	if (_inRate == _outRate) {
@@ -297,20 +364,342 @@ int RateConverter_Impl<inStereo, outStereo, reverseStereo>::convert(AudioStream
 	}
 }
 
-RateConverter *makeRateConverter(st_rate_t inRate, st_rate_t outRate, bool inStereo, bool outStereo, bool reverseStereo) {
+/**
+ * Parameters of the polyphase sinc filter. The coefficient table holds
+ * kSincMaxPhases filters at most; conversions that need more phases use
+ * the nearest one. Coefficients are stored with kSincCoeffBits fractional
+ * bits.
+ */
+enum {
+	kSincTaps = 16,
+	kSincMaxTaps = 128,
+	kSincMaxPhases = 512,
+	kSincCoeffBits = 14,
+	kSincHistorySize = 1024
+};
+
+/** Zeroth order modified Bessel function of the first kind, for the Kaiser window */
+static double besselI0(double x) {
+	double sum = 1.0, term = 1.0;
+	for (int k = 1; k < 32 && term > sum * 1e-12; k++) {
+		const double t = x / (2 * k);
+		term *= t * t;
+		sum += term;
+	}
+	return sum;
+}
+
+/**
+ * Band-limited rate converter, using a Kaiser-windowed sinc filter that is
+ * split into one polyphase branch per output phase. The coefficients are
+ * computed once per rate pair, leaving a fixed-point dot product per output
+ * sample and channel, which is done by MixBus::convolve().
+ *
+ * Input samples are kept in a separate history buffer per channel. The
+ * buffers start with half a filter of silence so that the first output
+ * sample is centered on the first input sample, and half a filter of
+ * silence is appended once the stream has ended to flush the tail.
+ */
+template<bool inStereo, bool outStereo, bool reverseStereo>
+class SincRateConverter_Impl : public RateConverter {
+private:
+	/** Input and output rates */
+	st_rate_t _inRate, _outRate;
+
+	/** The conversion ratio in lowest terms, as _upFactor / _downFactor */
+	uint32 _upFactor, _downFactor;
+
+	/** Position between two input samples, in units of 1 / _upFactor */
+	uint32 _phase;
+
+	/** Number of taps per phase, a multiple of 8 */
+	uint _numTaps;
+
+	/** Number of phases in the coefficient table */
+	uint _numPhases;
+
+	/**
+	 * _numPhases + 1 filters of _numTaps coefficients each. The last one is
+	 * centered on the next input sample, for positions which are rounded up
+	 * to it when there are fewer phases than _upFactor.
+	 */
+	Common::Array<int16> _coeffs;
+
+	/** De-interleaved input history for the left/right channel */
+	st_sample_t _historyL[kSincHistorySize];
+	st_sample_t _historyR[kSincHistorySize];
+
+	/** Start of the current filter window inside the history */
+	uint _pos;
+
+	/** Number of valid samples in the history */
+	uint _end;
+
+	/** Input samples to drop, after the filter stepped past the history */
+	uint _skip;
+
+	/** Whether the end of the stream has been padded with silence */
+	bool _flushed;
+
+	void setRates(st_rate_t inputRate, st_rate_t outputRate);
+	void buildCoefficients();
+	bool refill(AudioStream &input);
+
+	template<typename T>
+	int convertT(AudioStream &input, T *outBuffer, st_size_t numSamples, st_volume_t vol_l, st_volume_t vol_r);
+
+	st_sample_t filter(const st_sample_t *history, const int16 *coeffs) const {
+		const int32 sum = MixBus::convolve(history, coeffs, _numTaps) + (1 << (kSincCoeffBits - 1));
+		return (st_sample_t)CLIP<int32>(sum >> kSincCoeffBits, ST_SAMPLE_MIN, ST_SAMPLE_MAX);
+	}
+
+public:
+	SincRateConverter_Impl(st_rate_t inputRate, st_rate_t outputRate);
+	virtual ~SincRateConverter_Impl() {}
+
+	int convert(AudioStream &input, st_sample_t *outBuffer, st_size_t numSamples, st_volume_t vol_l, st_volume_t vol_r) override {
+		return convertT(input, outBuffer, numSamples, vol_l, vol_r);
+	}
+
+	int convert(AudioStream &input, int32 *outBuffer, st_size_t numSamples, st_volume_t vol_l, st_volume_t vol_r) override {
+		return convertT(input, outBuffer, numSamples, vol_l, vol_r);
+	}
+
+	void setInputRate(st_rate_t inputRate) override { setRates(inputRate, _outRate); }
+	void setOutputRate(st_rate_t outputRate) override { setRates(_inRate, outputRate); }
+
+	st_rate_t getInputRate() const override { return _inRate; }
+	st_rate_t getOutputRate() const override { return _outRate; }
+
+	bool needsDraining() const override {
+		// Before the stream is flushed, any input at or after the filter
+		// center still has to be output. Afterwards, only complete windows.
+		if (!_flushed)
+			return _end > _pos + _numTaps / 2 - 1;
+		return _end >= _pos + _numTaps;
+	}
+};
+
+template<bool inStereo, bool outStereo, bool reverseStereo>
+SincRateConverter_Impl<inStereo, outStereo, reverseStereo>::SincRateConverter_Impl(st_rate_t inputRate, st_rate_t outputRate) :
+	_inRate(0),
+	_outRate(0),
+	_upFactor(1),
+	_downFactor(1),
+	_phase(0),
+	_numPhases(0),
+	_pos(0),
+	_skip(0),
+	_flushed(false) {
+
+	// Downsampling needs a wider filter for the same transition band. The
+	// filter length is fixed from here on: later rate changes only move
+	// the cutoff frequency.
+	const uint ratio = (inputRate + outputRate - 1) / outputRate;
+	_numTaps = MIN<uint>((kSincTaps * MAX<uint>(ratio, 1) + 7) & ~7, kSincMaxTaps);
+
+	memset(_historyL, 0, sizeof(_historyL));
+	memset(_historyR, 0, sizeof(_historyR));
+	_end = _numTaps / 2 - 1;
+
+	setRates(inputRate, outputRate);
+}
+
+template<bool inStereo, bool outStereo, bool reverseStereo>
+void SincRateConverter_Impl<inStereo, outStereo, reverseStereo>::setRates(st_rate_t inputRate, st_rate_t outputRate) {
+	if (inputRate == _inRate && outputRate == _outRate)
+		return;
+
+	const bool cutoffChanged = (inputRate > outputRate || _inRate > _outRate) &&
+		(uint64)inputRate * _outRate != (uint64)_inRate * outputRate;
+
+	_inRate = inputRate;
+	_outRate = outputRate;
+
+	const uint32 divisor = Common::gcd<uint32>(_inRate, _outRate);
+	const uint32 upFactor = _outRate / divisor;
+
+	// Keep the position between the current input samples
+	_phase = (uint32)(((uint64)_phase * upFactor) / _upFactor);
+	_upFactor = upFactor;
+	_downFactor = _inRate / divisor;
+
+	const uint numPhases = MIN<uint32>(_upFactor, kSincMaxPhases);
+	if (numPhases != _numPhases || cutoffChanged) {
+		_numPhases = numPhases;
+		buildCoefficients();
+	}
+}
+
+template<bool inStereo, bool outStereo, bool reverseStereo>
+void SincRateConverter_Impl<inStereo, outStereo, reverseStereo>::buildCoefficients() {
+	// Band-limit to the lower of both Nyquist frequencies, with a little
+	// headroom for the transition band
+	const double cutoff = 0.95 * MIN<double>(1.0, (double)_outRate / _inRate);
+	const double beta = 8.0;
+	const double window = besselI0(beta);
+	const int halfTaps = _numTaps / 2;
+
+	_coeffs.resize((_numPhases + 1) * _numTaps);
+
+	double taps[kSincMaxTaps];
+	for (uint phase = 0; phase <= _numPhases; phase++) {
+		const double frac = (double)phase / _numPhases;
+
+		double sum = 0.0;
+		for (int i = 0; i < (int)_numTaps; i++) {
+			// Distance of the output sample from input sample i of the window
+			const double t = frac + (halfTaps - 1) - i;
+			const double x = M_PI * cutoff * t;
+			const double sinc = (x == 0.0) ? 1.0 : sin(x) / x;
+			const double w = t / halfTaps;
+			const double kaiser = (w <= -1.0 || w >= 1.0) ? 0.0 : besselI0(beta * sqrt(1.0 - w * w)) / window;
+
+			taps[i] = sinc * kaiser;
+			sum += taps[i];
+		}
+
+		// Normalize each phase to unity gain, so that no phase modulates
+		// a constant signal
+		int16 *coeffs = &_coeffs[phase * _numTaps];
+		for (uint i = 0; i < _numTaps; i++)
+			coeffs[i] = (int16)floor(taps[i] / sum * (1 << kSincCoeffBits) + 0.5);
+	}
+}
+
+template<bool inStereo, bool outStereo, bool reverseStereo>
+bool SincRateConverter_Impl<inStereo, outStereo, reverseStereo>::refill(AudioStream &input) {
+	// Move the samples which are still needed to the start of the history
+	if (_pos > _end) {
+		_skip += _pos - _end;
+		_pos = _end;
+	}
+	if (_pos > 0) {
+		memmove(_historyL, _historyL + _pos, (_end - _pos) * sizeof(st_sample_t));
+		if (inStereo)
+			memmove(_historyR, _historyR + _pos, (_end - _pos) * sizeof(st_sample_t));
+		_end -= _pos;
+		_pos = 0;
+	}
+
+	st_sample_t buffer[512];
+	const int channels = inStereo ? 2 : 1;
+	const uint frames = MIN<uint>(kSincHistorySize - _end, ARRAYSIZE(buffer) / channels);
+	const int read = input.readBuffer(buffer, frames * channels);
+
+	if (read > 0) {
+		const st_sample_t *src = buffer;
+		uint count = read / channels;
+
+		const uint skip = MIN(_skip, count);
+		src += skip * channels;
+		count -= skip;
+		_skip -= skip;
+
+		for (uint i = 0; i < count; i++) {
+			_historyL[_end + i] = *src++;
+			if (inStereo)
+				_historyR[_end + i] = *src++;
+		}
+		_end += count;
+		_flushed = false;
+		return true;
+	}
+
+	if (!_flushed && input.endOfStream()) {
+		// Flush the samples still inside the filter with silence
+		const uint pad = _numTaps / 2;
+		memset(_historyL + _end, 0, pad * sizeof(st_sample_t));
+		if (inStereo)
+			memset(_historyR + _end, 0, pad * sizeof(st_sample_t));
+		_end += pad;
+		_flushed = true;
+		return true;
+	}
+
+	return false;
+}
+
+template<bool inStereo, bool outStereo, bool reverseStereo>
+template<typename T>
+int SincRateConverter_Impl<inStereo, outStereo, reverseStereo>::convertT(AudioStream &input, T *outBuffer, st_size_t numSamples, st_volume_t volL, st_volume_t volR) {
+	assert(input.isStereo() == inStereo);
+
+	T *outStart, *outEnd;
+	outStart = outBuffer;
+	outEnd = outBuffer + numSamples * (outStereo ? 2 : 1);
+
+	while (outBuffer < outEnd) {
+		// Make sure a whole filter window is available
+		if (_end < _pos + _numTaps) {
+			if (!refill(input))
+				break;
+			continue;
+		}
+
+		// Round to the nearest phase of the table
+		const uint phase = (_numPhases == _upFactor) ? _phase : (uint)(((uint64)_phase * _numPhases + _upFactor / 2) / _upFactor);
+		const int16 *coeffs = &_coeffs[phase * _numTaps];
+
+		st_sample_t inL, inR;
+		inL = filter(_historyL + _pos, coeffs);
+		inR = (inStereo ? filter(_historyR + _pos, coeffs) : inL);
+
+		st_sample_t outL, outR;
+		outL = (inL * (int)volL) / Audio::Mixer::kMaxMixerVolume;
+		outR = (inR * (int)volR) / Audio::Mixer::kMaxMixerVolume;
+
+		if (outStereo) {
+			// Output left channel
+			mixSample(outBuffer[reverseStereo    ], outL);
+
+			// Output right channel
+			mixSample(outBuffer[reverseStereo ^ 1], outR);
+
+			outBuffer += 2;
+		} else {
+			// Output mono channel
+			mixSample(outBuffer[0], (outL + outR) / 2);
+
+			outBuffer += 1;
+		}
+
+		// Advance to the next output position
+		_phase += _downFactor;
+		_pos += _phase / _upFactor;
+		_phase %= _upFactor;
+	}
+
+	return (outBuffer - outStart) / (outStereo ? 2 : 1);
+}
+
+template<bool inStereo, bool outStereo, bool reverseStereo>
+static RateConverter *makeRateConverterImpl(st_rate_t inRate, st_rate_t outRate, RateConverterType type) {
+	if (type == kRateConverterSinc)
+		return new SincRateConverter_Impl<inStereo, outStereo, reverseStereo>(inRate, outRate);
+	return new RateConverter_Impl<inStereo, outStereo, reverseStereo>(inRate, outRate);
+}
+
+RateConverterType parseRateConverterType(const char *name) {
+	if (!scumm_stricmp(name, "sinc"))
+		return kRateConverterSinc;
+	return kRateConverterDefault;
+}
+
+RateConverter *makeRateConverter(st_rate_t inRate, st_rate_t outRate, bool inStereo, bool outStereo, bool reverseStereo, RateConverterType type) {
 	if (inStereo) {
 		if (outStereo) {
 			if (reverseStereo)
-				return new RateConverter_Impl<true, true, true>(inRate, outRate);
+				return makeRateConverterImpl<true, true, true>(inRate, outRate, type);
 			else
-				return new RateConverter_Impl<true, true, false>(inRate, outRate);
+				return makeRateConverterImpl<true, true, false>(inRate, outRate, type);
 		} else
-			return new RateConverter_Impl<true, false, false>(inRate, outRate);
+			return makeRateConverterImpl<true, false, false>(inRate, outRate, type);
 	} else {
 		if (outStereo) {
-			return new RateConverter_Impl<false, true, false>(inRate, outRate);
+			return makeRateConverterImpl<false, true, false>(inRate, outRate, type);
 		} else
-			return new RateConverter_Impl<false, false, false>(inRate, outRate);
+			return makeRateConverterImpl<false, false, false>(inRate, outRate, type);
 	}
 }
 
@@ -90,6 +90,22 @@ public:
 	 */
 	virtual int convert(AudioStream &input, st_sample_t *outBuffer, st_size_t numSamples, st_volume_t vol_l, st_volume_t vol_r) = 0;
 
+	/**
+	 * Convert the provided AudioStream to the target sample rate, adding the
+	 * result to a 32-bit mixing bus. Unlike the 16-bit variant, no clipping
+	 * takes place, so that the caller can saturate once after all channels
+	 * have been mixed.
+	 *
+	 * @param input			The AudioStream to read data from.
+	 * @param outBuffer		The bus that the resampled audio will be added to. Must have size of at least @p numSamples.
+	 * @param numSamples	The desired number of samples to be written into the buffer.
+	 * @param vol_l			Volume for left channel.
+	 * @param vol_r			Volume for right channel.
+	 *
+	 * @return Number of sample pairs written into the buffer.
+	 */
+	virtual int convert(AudioStream &input, int32 *outBuffer, st_size_t numSamples, st_volume_t vol_l, st_volume_t vol_r) = 0;
+
 	virtual void setInputRate(st_rate_t inputRate) = 0;
 	virtual void setOutputRate(st_rate_t outputRate) = 0;
 
@@ -104,7 +120,23 @@ public:
 	virtual bool needsDraining() const = 0;
 };
 
-RateConverter *makeRateConverter(st_rate_t inRate, st_rate_t outRate, bool inStereo, bool outStereo, bool reverseStereo);
+/**
+ * The resampling algorithms a RateConverter can use.
+ */
+enum RateConverterType {
+	/** Sample copying, dropping, or linear interpolation. Fast, but aliases. */
+	kRateConverterDefault,
+	/** Polyphase windowed-sinc filter. Slower, but band-limited. */
+	kRateConverterSinc
+};
+
+/**
+ * Parse the name of a resampler as used by the "audio_resampler" config
+ * key ("default" or "sinc"). Unknown names map to kRateConverterDefault.
+ */
+RateConverterType parseRateConverterType(const char *name);
+
+RateConverter *makeRateConverter(st_rate_t inRate, st_rate_t outRate, bool inStereo, bool outStereo, bool reverseStereo, RateConverterType type = kRateConverterDefault);
 
 /** @} */
 } // End of namespace Audio
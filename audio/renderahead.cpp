@@ -0,0 +1,279 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "audio/renderahead.h"
+#include "audio/mixer.h"
+
+#include "common/system.h"
+#include "common/timer.h"
+#include "common/util.h"
+
+namespace Audio {
+
+// Interval of the timer filling the buffers (in microseconds)
+static const int32 kFillInterval = 10000;
+
+// Frames rendered by the timer thread at a time. The mixer thread waits for
+// as many at most when its buffer runs dry.
+static const uint32 kRenderChunk = 256;
+
+// The timer manager only takes a callback once, so a single timer fills the
+// buffers of all the synths being rendered ahead. The list is kept once
+// allocated, since the timer only removes itself after the last synth is
+// gone.
+struct RenderAheadList {
+	RenderAheadList() : timerManager(nullptr) {}
+
+	Common::Mutex mutex;
+	Common::Array<RenderAhead *> list;
+
+	// The timer manager the timer is installed in, if any
+	Common::TimerManager *timerManager;
+};
+
+static RenderAheadList *s_renderAheadList = nullptr;
+
+RenderAhead::RenderAhead(Renderer *renderer, bool stereo, int frames) :
+	_renderer(renderer),
+	_channels(stereo ? 2 : 1),
+	_capacity(MAX(frames, 1)),
+	_writePos(0),
+	_readPos(0),
+	_underruns(0),
+	_hasQueuedWrites(false),
+	_started(false) {
+	_buffer = new int16[_capacity * _channels];
+}
+
+RenderAhead::~RenderAhead() {
+	stop();
+
+	Common::StackLock lock(_renderMutex);
+	applyQueuedWrites();
+
+	delete[] _buffer;
+}
+
+void RenderAhead::start() {
+	if (_started)
+		return;
+
+	if (!s_renderAheadList)
+		s_renderAheadList = new RenderAheadList();
+
+	Common::TimerManager *timerManager = nullptr;
+	{
+		Common::StackLock lock(s_renderAheadList->mutex);
+		s_renderAheadList->list.push_back(this);
+
+		if (s_renderAheadList->timerManager != g_system->getTimerManager()) {
+			timerManager = g_system->getTimerManager();
+			s_renderAheadList->timerManager = timerManager;
+		}
+	}
+
+	// Installing the timer waits for the timer thread, so it's done without
+	// holding the list
+	if (timerManager)
+		timerManager->installTimerProc(timerProc, kFillInterval, s_renderAheadList, "RenderAhead");
+
+	_started = true;
+}
+
+void RenderAhead::stop() {
+	if (!_started)
+		return;
+
+	// Once we're out of the list, the timer doesn't start rendering another
+	// chunk, since it looks us up each time. The timer isn't removed here,
+	// since waiting for it while the mixer mutex is held would deadlock with
+	// a timer waiting for the mixer mutex to run a callback.
+	{
+		Common::StackLock lock(s_renderAheadList->mutex);
+		for (uint i = 0; i < s_renderAheadList->list.size(); i++) {
+			if (s_renderAheadList->list[i] == this) {
+				s_renderAheadList->list.remove_at(i);
+				break;
+			}
+		}
+	}
+
+	// Wait for the chunk being rendered, if any
+	Common::StackLock lock(_renderMutex);
+	_started = false;
+}
+
+uint32 RenderAhead::copyRendered(int16 *buffer, uint32 frames) {
+	uint32 readPos = _readPos.load(std::memory_order_relaxed);
+	uint32 writePos = _writePos.load(std::memory_order_acquire);
+	frames = MIN(frames, writePos - readPos);
+
+	uint32 copied = 0;
+	while (copied < frames) {
+		uint32 index = (readPos + copied) % _capacity;
+		uint32 run = MIN(frames - copied, _capacity - index);
+		memcpy(buffer + copied * _channels, _buffer + index * _channels, run * _channels * sizeof(int16));
+		copied += run;
+	}
+
+	_readPos.store(readPos + frames, std::memory_order_release);
+	return frames;
+}
+
+void RenderAhead::read(int16 *buffer, int numSamples) {
+	uint32 frames = numSamples / _channels;
+
+	uint32 copied = copyRendered(buffer, frames);
+	if (copied == frames)
+		return;
+
+	Common::StackLock mixerLock(g_system->getMixer()->mutex());
+	Common::StackLock lock(_renderMutex);
+
+	// The timer may have rendered more while we waited for it
+	copied += copyRendered(buffer + copied * _channels, frames - copied);
+	if (copied == frames)
+		return;
+
+	// The buffer is empty, and stays so while we hold the lock, so the
+	// missing samples come right after the ones we copied
+	render(buffer + copied * _channels, frames - copied);
+	_underruns.fetch_add(1, std::memory_order_relaxed);
+}
+
+void RenderAhead::render(int16 *buffer, uint32 frames) {
+	while (frames) {
+		applyQueuedWrites();
+
+		uint32 rendered = _renderer->renderFrames(buffer, frames);
+		buffer += rendered * _channels;
+		frames -= rendered;
+
+		if (_renderer->isCallbackDue())
+			_renderer->runCallback();
+	}
+}
+
+bool RenderAhead::renderChunk() {
+	uint32 writePos = _writePos.load(std::memory_order_relaxed);
+	uint32 readPos = _readPos.load(std::memory_order_acquire);
+	uint32 space = _capacity - (writePos - readPos);
+	if (!space)
+		return false;
+
+	uint32 index = writePos % _capacity;
+	uint32 frames = MIN(MIN(space, _capacity - index), kRenderChunk);
+
+	// Writes queued by now, including the ones of the last callback, go
+	// right before the next samples
+	applyQueuedWrites();
+	frames = _renderer->renderFrames(_buffer + index * _channels, frames);
+
+	_writePos.store(writePos + frames, std::memory_order_release);
+	return true;
+}
+
+void RenderAhead::queueWrite(int type, int address, int value) {
+	QueuedWrite write;
+	write.type = type;
+	write.address = address;
+	write.value = value;
+
+	Common::StackLock lock(_writeMutex);
+	_queuedWrites.push_back(write);
+	_hasQueuedWrites.store(true, std::memory_order_release);
+}
+
+void RenderAhead::applyQueuedWrites() {
+	if (!_hasQueuedWrites.load(std::memory_order_acquire))
+		return;
+
+	{
+		Common::StackLock lock(_writeMutex);
+		_queuedWrites.swap(_applyingWrites);
+		_hasQueuedWrites.store(false, std::memory_order_relaxed);
+	}
+
+	for (uint i = 0; i < _applyingWrites.size(); i++)
+		_renderer->applyQueuedWrite(_applyingWrites[i].type, _applyingWrites[i].address, _applyingWrites[i].value);
+	_applyingWrites.resize(0);
+}
+
+bool RenderAhead::lockIfStarted(RenderAhead *renderAhead) {
+	// Only dereference it while it's in the list. Once it holds the render
+	// mutex, stop() waits for it.
+	Common::StackLock lock(s_renderAheadList->mutex);
+	for (uint i = 0; i < s_renderAheadList->list.size(); i++) {
+		if (s_renderAheadList->list[i] == renderAhead) {
+			renderAhead->_renderMutex.lock();
+			return true;
+		}
+	}
+	return false;
+}
+
+void RenderAhead::fill(RenderAhead *renderAhead) {
+	// The synth may be stopped and deleted whenever the render mutex isn't
+	// held, so it's looked up again each time it's taken
+	while (lockIfStarted(renderAhead)) {
+		if (!renderAhead->_renderer->isCallbackDue()) {
+			bool rendered = renderAhead->renderChunk();
+			renderAhead->_renderMutex.unlock();
+			if (!rendered)
+				return;
+			continue;
+		}
+		renderAhead->_renderMutex.unlock();
+
+		// The timer callbacks of some synths lock the mixer mutex, which is
+		// taken before the render mutex, like the mixer thread does
+		Common::StackLock mixerLock(g_system->getMixer()->mutex());
+		if (!lockIfStarted(renderAhead))
+			return;
+
+		// The mixer thread may have run it in the meantime
+		if (renderAhead->_renderer->isCallbackDue())
+			renderAhead->_renderer->runCallback();
+		renderAhead->_renderMutex.unlock();
+	}
+}
+
+void RenderAhead::timerProc(void *refCon) {
+	RenderAheadList *renderAheadList = static_cast<RenderAheadList *>(refCon);
+
+	Common::Array<RenderAhead *> list;
+	{
+		Common::StackLock lock(renderAheadList->mutex);
+		if (renderAheadList->list.empty()) {
+			// Nothing is rendered ahead anymore, and the mixer may be gone
+			// already
+			g_system->getTimerManager()->removeTimerProc(timerProc);
+			renderAheadList->timerManager = nullptr;
+			return;
+		}
+		list = renderAheadList->list;
+	}
+
+	for (uint i = 0; i < list.size(); i++)
+		fill(list[i]);
+}
+
+} // End of namespace Audio
@@ -0,0 +1,177 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef AUDIO_RENDERAHEAD_H
+#define AUDIO_RENDERAHEAD_H
+
+#include "common/array.h"
+#include "common/mutex.h"
+
+#include <atomic>
+
+class RenderAheadTestSuite;
+
+namespace Audio {
+
+/**
+ * Renders the output of an emulated synth ahead of playback, from the
+ * timer thread, so that the mixer thread mostly copies samples which are
+ * already there.
+ *
+ * Everything changing the state of the synth has to go through
+ * queueWrite() while rendering ahead. The writes are applied by the
+ * renderer, in order, at the position it has rendered up to, so they are
+ * heard after the samples already rendered ahead. Writes done by the timer
+ * callbacks of the synth, which run inside the renderer, keep happening at
+ * the exact sample positions of the callbacks.
+ *
+ * When the timer thread falls behind, the mixer thread renders the missing
+ * samples itself, so the output is the same either way.
+ *
+ * The timer thread renders without the mixer mutex, a chunk at a time, so
+ * the mixer thread waits for one chunk at most when it runs dry. Only the
+ * timer callbacks of the synth are run with the mixer mutex held, like the
+ * mixer thread does, since they may lock it too. The timer is not removed by
+ * stop(), which may be called with the mixer mutex held, but removes itself
+ * once nothing is rendered ahead.
+ */
+class RenderAhead {
+	friend class ::RenderAheadTestSuite;
+
+public:
+	class Renderer {
+	public:
+		virtual ~Renderer() {}
+
+		/**
+		 * Render frames, stopping at the next timer callback of the synth.
+		 * Returns the number of frames rendered.
+		 */
+		virtual int renderFrames(int16 *buffer, int frames) = 0;
+
+		/**
+		 * Return whether the synth has rendered up to its next timer callback.
+		 */
+		virtual bool isCallbackDue() const = 0;
+
+		/**
+		 * Run the timer callback which is due. This is done with the mixer
+		 * mutex held.
+		 */
+		virtual void runCallback() = 0;
+
+		/**
+		 * Apply a write passed to RenderAhead::queueWrite().
+		 */
+		virtual void applyQueuedWrite(int type, int address, int value) = 0;
+	};
+
+	/**
+	 * @param renderer  The synth to render.
+	 * @param stereo    Whether the synth renders interleaved stereo samples.
+	 * @param frames    Number of frames to keep rendered ahead.
+	 */
+	RenderAhead(Renderer *renderer, bool stereo, int frames);
+
+	/**
+	 * Stop rendering from the timer thread if needed, and apply the writes
+	 * still in the queue, so the synth is left in the state the writes
+	 * asked for.
+	 */
+	~RenderAhead();
+
+	/**
+	 * Start rendering ahead from the timer thread. This may install the
+	 * timer, so it must not be called with the mixer mutex held.
+	 */
+	void start();
+
+	/**
+	 * Stop rendering ahead from the timer thread. Once it returns, the
+	 * timer thread is done with the synth. This may be called with the
+	 * mixer mutex held, and waits for the chunk being rendered, if any.
+	 */
+	void stop();
+
+	/**
+	 * Read interleaved samples, rendering the ones which aren't ready yet.
+	 * This is meant for the readBuffer() of the synth's audio stream, which
+	 * the mixer calls with its mutex held.
+	 */
+	void read(int16 *buffer, int numSamples);
+
+	/**
+	 * Queue a write for the renderer. This doesn't wait for any rendering
+	 * going on.
+	 */
+	void queueWrite(int type, int address, int value);
+
+	/**
+	 * Return the number of times the mixer thread had to render samples
+	 * itself, because the timer thread had not rendered them in time.
+	 */
+	uint32 getUnderruns() const { return _underruns.load(std::memory_order_relaxed); }
+
+private:
+	struct QueuedWrite {
+		int type;
+		int address;
+		int value;
+	};
+
+	Renderer *_renderer;
+	int _channels;
+	uint32 _capacity;
+
+	// Ring buffer of the rendered frames. The positions keep increasing,
+	// wrapping around at 2^32, and are taken modulo the capacity. Only the
+	// renderer moves the write position, and only the reader moves the
+	// read position.
+	int16 *_buffer;
+	std::atomic<uint32> _writePos;
+	std::atomic<uint32> _readPos;
+	std::atomic<uint32> _underruns;
+
+	// Held while rendering. The mixer mutex, when needed, is taken first.
+	Common::Mutex _renderMutex;
+
+	// Only held to add a write, or to take the ones added so far
+	Common::Mutex _writeMutex;
+	Common::Array<QueuedWrite> _queuedWrites;
+	Common::Array<QueuedWrite> _applyingWrites;
+	std::atomic<bool> _hasQueuedWrites;
+
+	bool _started;
+
+	uint32 copyRendered(int16 *buffer, uint32 frames);
+	void render(int16 *buffer, uint32 frames);
+	bool renderChunk();
+	void applyQueuedWrites();
+
+	static bool lockIfStarted(RenderAhead *renderAhead);
+	static void fill(RenderAhead *renderAhead);
+
+	static void timerProc(void *refCon);
+};
+
+} // End of namespace Audio
+
+#endif
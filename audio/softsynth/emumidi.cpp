@@ -0,0 +1,136 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "audio/softsynth/emumidi.h"
+#include "audio/renderahead.h"
+
+#include "common/config-manager.h"
+
+class MidiDriver_Emulated::EmulatedRenderAhead : public Audio::RenderAhead::Renderer {
+public:
+	EmulatedRenderAhead(MidiDriver_Emulated *driver, int frames) : _driver(driver) {
+		_renderAhead = new Audio::RenderAhead(this, driver->isStereo(), frames);
+	}
+
+	~EmulatedRenderAhead() {
+		// This applies the writes still queued
+		delete _renderAhead;
+	}
+
+	Audio::RenderAhead *get() { return _renderAhead; }
+
+	// RenderAhead::Renderer API
+	int renderFrames(int16 *buffer, int frames) override {
+		return _driver->renderFrames(buffer, frames);
+	}
+
+	bool isCallbackDue() const override {
+		return _driver->isCallbackDue();
+	}
+
+	void runCallback() override {
+		_driver->runCallback();
+	}
+
+	void applyQueuedWrite(int type, int address, int value) override {
+		_driver->applyQueuedWrite(type, address, value);
+	}
+
+private:
+	MidiDriver_Emulated *_driver;
+	Audio::RenderAhead *_renderAhead;
+};
+
+MidiDriver_Emulated::~MidiDriver_Emulated() {
+	// The subclass needs to call stopRenderAhead(), or its synth can still
+	// be rendered from the timer thread while it's destroyed
+	stopRenderAhead();
+}
+
+int MidiDriver_Emulated::readBuffer(int16 *data, const int numSamples) {
+	if (_renderAhead) {
+		_renderAhead->get()->read(data, numSamples);
+		return numSamples;
+	}
+
+	const int stereoFactor = isStereo() ? 2 : 1;
+	int len = numSamples / stereoFactor;
+	int step;
+
+	do {
+		step = renderFrames(data, len);
+		if (isCallbackDue())
+			runCallback();
+
+		data += step * stereoFactor;
+		len -= step;
+	} while (len);
+
+	return numSamples;
+}
+
+int MidiDriver_Emulated::renderFrames(int16 *data, int len) {
+	int step = len;
+	if (step > (_nextTick >> FIXP_SHIFT))
+		step = (_nextTick >> FIXP_SHIFT);
+
+	generateSamples(data, step);
+
+	_nextTick -= step << FIXP_SHIFT;
+	return step;
+}
+
+bool MidiDriver_Emulated::isCallbackDue() const {
+	return !(_nextTick >> FIXP_SHIFT);
+}
+
+void MidiDriver_Emulated::runCallback() {
+	if (_timerProc)
+		(*_timerProc)(_timerParam);
+
+	onTimer();
+
+	_nextTick += _samplesPerTick;
+}
+
+bool MidiDriver_Emulated::queueWrite(int type, int address, int value) {
+	if (!_renderAhead)
+		return false;
+
+	_renderAhead->get()->queueWrite(type, address, value);
+	return true;
+}
+
+void MidiDriver_Emulated::startRenderAhead() {
+	if (_renderAhead)
+		return;
+
+	int renderAheadMs = ConfMan.hasKey("emulated_chip_render_ahead") ? ConfMan.getInt("emulated_chip_render_ahead") : 0;
+	if (renderAheadMs > 0 && supportsRenderAhead()) {
+		_renderAhead = new EmulatedRenderAhead(this, getRate() * renderAheadMs / 1000);
+		_renderAhead->get()->start();
+	}
+}
+
+void MidiDriver_Emulated::stopRenderAhead() {
+	delete _renderAhead;
+	_renderAhead = nullptr;
+}
@@ -26,6 +26,17 @@
 #include "audio/mididrv.h"
 #include "audio/mixer.h"
 
+/**
+ * A MidiDriver rendering an emulated synth as an audio stream. The timer
+ * callback and onTimer() are called based on the number of samples
+ * generated in readBuffer().
+ *
+ * Synths which synchronize all the writes changing their state with
+ * generateSamples(), or pass them through queueWrite(), can be rendered
+ * ahead of playback from the timer thread, see Audio::RenderAhead. This is
+ * enabled with the "emulated_chip_render_ahead" setting, like for
+ * Audio::EmulatedChip.
+ */
 class MidiDriver_Emulated : public Audio::AudioStream, public MidiDriver {
 protected:
 	bool _isOpen;
@@ -43,12 +54,45 @@ private:
 	int _nextTick;
 	int _samplesPerTick;
 
+	class EmulatedRenderAhead;
+	EmulatedRenderAhead *_renderAhead;
+
+	void startRenderAhead();
+	int renderFrames(int16 *data, int len);
+	bool isCallbackDue() const;
+	void runCallback();
+
 protected:
 	int _baseFreq;
 
 	virtual void generateSamples(int16 *buf, int len) = 0;
 	virtual void onTimer() {}
 
+	/**
+	 * Return whether all the writes changing the state of the synth are
+	 * synchronized with generateSamples(), or go through queueWrite(), which
+	 * allows rendering it ahead. Subclasses doing so have to call
+	 * stopRenderAhead() before they shut the synth down.
+	 */
+	virtual bool supportsRenderAhead() const { return false; }
+
+	/**
+	 * Queue a write for the renderer when the synth is rendered ahead, to be
+	 * done with applyQueuedWrite(). Returns false when the synth isn't
+	 * rendered ahead, in which case the write is to be done right away.
+	 */
+	bool queueWrite(int type, int address, int value);
+
+	/**
+	 * Do a write queued with queueWrite().
+	 */
+	virtual void applyQueuedWrite(int type, int address, int value) {}
+
+	/**
+	 * Stop rendering ahead, if enabled by open().
+	 */
+	void stopRenderAhead();
+
 public:
 	MidiDriver_Emulated(Audio::Mixer *mixer) :
 		_mixer(mixer),
@@ -57,9 +101,12 @@ public:
 		_timerParam(0),
 		_nextTick(0),
 		_samplesPerTick(0),
+		_renderAhead(nullptr),
 		_baseFreq(250) {
 	}
 
+	virtual ~MidiDriver_Emulated();
+
 	// MidiDriver API
 	virtual int open() {
 		_isOpen = true;
@@ -72,6 +119,8 @@ public:
 
 		_samplesPerTick = (d << FIXP_SHIFT) + (r << FIXP_SHIFT) / _baseFreq;
 
+		startRenderAhead();
+
 		return 0;
 	}
 
@@ -87,34 +136,8 @@ public:
 	}
 
 	// AudioStream API
-	virtual int readBuffer(int16 *data, const int numSamples) {
-		const int stereoFactor = isStereo() ? 2 : 1;
-		int len = numSamples / stereoFactor;
-		int step;
 
-		do {
-			step = len;
-			if (step > (_nextTick >> FIXP_SHIFT))
-				step = (_nextTick >> FIXP_SHIFT);
-
-			generateSamples(data, step);
-
-			_nextTick -= step << FIXP_SHIFT;
-			if (!(_nextTick >> FIXP_SHIFT)) {
-				if (_timerProc)
-					(*_timerProc)(_timerParam);
-
-				onTimer();
-
-				_nextTick += _samplesPerTick;
-			}
-
-			data += step * stereoFactor;
-			len -= step;
-		} while (len);
-
-		return numSamples;
-	}
+	virtual int readBuffer(int16 *data, const int numSamples);
 
 	virtual bool endOfData() const {
 		return false;
@@ -121,6 +121,9 @@ private:
 protected:
 	void generateSamples(int16 *buf, int len) override;
 
+	// Everything accessing the synth holds _mutex
+	bool supportsRenderAhead() const override { return true; }
+
 public:
 	MidiDriver_MT32(Audio::Mixer *mixer);
 	virtual ~MidiDriver_MT32();
@@ -272,6 +275,7 @@ void MidiDriver_MT32::close() {
 	setTimerCallback(nullptr, nullptr);
 	// Detach the mixer callback handler
 	_mixer->stopHandle(_mixerSoundHandle);
+	stopRenderAhead();
 
 	Common::StackLock lock(_mutex);
 	_service.closeSynth();
@@ -548,16 +548,16 @@ static void OPL3_EnvelopeKeyOff(opl3_slot *slot, uint8_t type)
     Phase Generator
 */
 
-static void OPL3_PhaseGenerate(opl3_slot *slot)
+/*
+    The phase increment only changes with the registers and the vibrato
+    position, so it is kept in the slot, and updated for all the slots
+    after these changed.
+*/
+static void OPL3_PhaseUpdateInc(opl3_slot *slot)
 {
-    opl3_chip *chip;
     uint16_t f_num;
     uint32_t basefreq;
-    uint8_t rm_xor, n_bit;
-    uint32_t noise;
-    uint16_t phase;
 
-    chip = slot->chip;
     f_num = slot->channel->f_num;
     if (slot->reg_vib)
     {
@@ -584,12 +584,23 @@ static void OPL3_PhaseGenerate(opl3_slot *slot)
         f_num += range;
     }
     basefreq = (f_num << slot->channel->block) >> 1;
+    slot->pg_inc = (basefreq * mt[slot->reg_mult]) >> 1;
+}
+
+static void OPL3_PhaseGenerate(opl3_slot *slot)
+{
+    opl3_chip *chip;
+    uint8_t rm_xor, n_bit;
+    uint32_t noise;
+    uint16_t phase;
+
+    chip = slot->chip;
     phase = (uint16_t)(slot->pg_phase >> 9);
     if (slot->pg_reset)
     {
         slot->pg_phase = 0;
     }
-    slot->pg_phase += (basefreq * mt[slot->reg_mult]) >> 1;
+    slot->pg_phase += slot->pg_inc;
     /* Rhythm mode */
     noise = chip->noise;
     slot->pg_phase_out = phase;
@@ -633,9 +644,26 @@ static void OPL3_PhaseGenerate(opl3_slot *slot)
         default:
             break;
         }
+        n_bit = ((noise >> 14) ^ noise) & 0x01;
+        chip->noise = (noise >> 1) | (n_bit << 22);
     }
-    n_bit = ((noise >> 14) ^ noise) & 0x01;
-    chip->noise = (noise >> 1) | (n_bit << 22);
+}
+
+/*
+    Out of rhythm mode, nothing reads the noise while the slots are
+    processed, so its steps for all the slots are done at once.
+*/
+static void OPL3_NoiseAdvance(opl3_chip *chip)
+{
+    uint32_t noise = chip->noise;
+    uint8_t ii;
+
+    /* The first 9 new bits only depend on the current ones */
+    for (ii = 0; ii < 4; ii++)
+    {
+        noise = (noise >> 9) | (((noise ^ (noise >> 14)) & 0x1ff) << 14);
+    }
+    chip->noise = noise;
 }
 
 /*
@@ -1103,10 +1131,64 @@ static int16_t OPL3_ClipSample(int32_t sample)
     return (int16_t)sample;
 }
 
+/*
+    A slot which is keyed off and done releasing stays so until the next
+    register write. Its envelope attenuation is high enough for all the
+    waveforms to come out as 0, or as -1 in their negative half, so it
+    only needs the phase generator. This gives the same results as the
+    full processing, which only has to be done for the sounding slots.
+*/
+static uint8_t OPL3_SlotIsOff(const opl3_slot *slot)
+{
+    return !slot->key && slot->eg_gen == envelope_gen_num_release && slot->eg_rout == 0x1ff;
+}
+
+static void OPL3_SlotGenerateOff(opl3_slot *slot)
+{
+    uint16_t phase = (uint16_t)(slot->pg_phase_out + *slot->mod);
+    uint8_t neg;
+    switch (slot->reg_wf)
+    {
+    case 0:
+    case 6:
+    case 7:
+        neg = (phase & 0x200) != 0;
+        break;
+    case 4:
+        neg = (phase & 0x300) == 0x100;
+        break;
+    default:
+        neg = 0;
+        break;
+    }
+    slot->out = neg ? -1 : 0;
+}
+
 static void OPL3_ProcessSlot(opl3_slot *slot)
 {
     OPL3_SlotCalcFB(slot);
-    OPL3_EnvelopeCalc(slot);
+    if (OPL3_SlotIsOff(slot))
+    {
+        /* What OPL3_EnvelopeCalc() does in this state */
+        slot->eg_out = slot->eg_rout + (slot->reg_tl << 2)
+                     + (slot->eg_ksl >> kslshift[slot->reg_ksl]) + *slot->trem;
+        slot->pg_reset = 0;
+        OPL3_PhaseGenerate(slot);
+        OPL3_SlotGenerateOff(slot);
+        return;
+    }
+    if (slot->key && slot->eg_gen == envelope_gen_num_sustain && slot->reg_type
+        && (slot->eg_rout & 0x1f8) != 0x1f8)
+    {
+        /* A sustained note keeps its envelope level */
+        slot->eg_out = slot->eg_rout + (slot->reg_tl << 2)
+                     + (slot->eg_ksl >> kslshift[slot->reg_ksl]) + *slot->trem;
+        slot->pg_reset = 0;
+    }
+    else
+    {
+        OPL3_EnvelopeCalc(slot);
+    }
     OPL3_PhaseGenerate(slot);
     OPL3_SlotGenerate(slot);
 }
@@ -1121,6 +1203,15 @@ inline void OPL3_Generate4Ch(opl3_chip *chip, int16_t *buf4)
     int16_t accm;
     uint8_t shift = 0;
 
+    if (chip->pg_inc_dirty)
+    {
+        for (ii = 0; ii < 36; ii++)
+        {
+            OPL3_PhaseUpdateInc(&chip->slot[ii]);
+        }
+        chip->pg_inc_dirty = 0;
+    }
+
     buf4[1] = OPL3_ClipSample(chip->mixbuff[1]);
     buf4[3] = OPL3_ClipSample(chip->mixbuff[3]);
 
@@ -1189,6 +1280,11 @@ inline void OPL3_Generate4Ch(opl3_chip *chip, int16_t *buf4)
     }
 #endif
 
+    if (!(chip->rhy & 0x20))
+    {
+        OPL3_NoiseAdvance(chip);
+    }
+
     if ((chip->timer & 0x3f) == 0x3f)
     {
         chip->tremolopos = (chip->tremolopos + 1) % 210;
@@ -1205,6 +1301,7 @@ inline void OPL3_Generate4Ch(opl3_chip *chip, int16_t *buf4)
     if ((chip->timer & 0x3ff) == 0x3ff)
     {
         chip->vibpos = (chip->vibpos + 1) & 7;
+        chip->pg_inc_dirty = 1;
     }
 
     chip->timer++;
@@ -1348,6 +1445,7 @@ void OPL3_Reset(opl3_chip *chip, uint32_t samplerate)
     chip->rateratio = (samplerate << RSM_FRAC) / 49716;
     chip->tremoloshift = 4;
     chip->vibshift = 1;
+    chip->pg_inc_dirty = 1;
 
 #if OPL_ENABLE_STEREOEXT
     if (!panpot_lut_build)
@@ -1366,6 +1464,7 @@ void OPL3_WriteReg(opl3_chip *chip, uint16_t reg, uint8_t v)
 {
     uint8_t high = (reg >> 8) & 0x01;
     uint8_t regm = reg & 0xff;
+    chip->pg_inc_dirty = 1;
     switch (regm & 0xf0)
     {
     case 0x00:
@@ -1551,10 +1650,16 @@ bool OPL::init() {
 }
 
 void OPL::reset() {
-	OPL3_Reset(&chip, _rate);
+	if (!queueWrite(kQueuedReset, 0, 0))
+		OPL3_Reset(&chip, _rate);
 }
 
 void OPL::write(int port, int val) {
+	if (!queueWrite(kQueuedWrite, port, val))
+		writePort(port, val);
+}
+
+void OPL::writePort(int port, int val) {
 	if (port & 1) {
 		switch (_type) {
 		case Config::kOpl2:
@@ -1603,7 +1708,24 @@ void OPL::write(int port, int val) {
 
 
 void OPL::writeReg(int r, int v) {
-	OPL3_WriteRegBuffered(&chip, (uint16_t)r, (uint8_t)v);
+	if (!queueWrite(kQueuedWriteReg, r, v))
+		OPL3_WriteRegBuffered(&chip, (uint16_t)r, (uint8_t)v);
+}
+
+void OPL::applyQueuedWrite(int type, int a, int v) {
+	switch (type) {
+	case kQueuedReset:
+		OPL3_Reset(&chip, _rate);
+		break;
+	case kQueuedWrite:
+		writePort(a, v);
+		break;
+	case kQueuedWriteReg:
+		OPL3_WriteRegBuffered(&chip, (uint16_t)a, (uint8_t)v);
+		break;
+	default:
+		break;
+	}
 }
 
 void OPL::dualWrite(uint8 index, uint8 reg, uint8 val) {
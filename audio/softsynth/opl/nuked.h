@@ -76,6 +76,7 @@ struct _opl3_slot {
     uint8_t key;
     uint32_t pg_reset;
     uint32_t pg_phase;
+    uint32_t pg_inc;
     uint16_t pg_phase_out;
     uint8_t slot_num;
 };
@@ -123,6 +124,7 @@ struct _opl3_chip {
     uint8_t rhy;
     uint8_t vibpos;
     uint8_t vibshift;
+    uint8_t pg_inc_dirty;
     uint8_t tremolo;
     uint8_t tremolopos;
     uint8_t tremoloshift;
@@ -171,6 +173,13 @@ private:
 	opl3_chip chip;
 	uint address[2];
 	void dualWrite(uint8 index, uint8 reg, uint8 val);
+	void writePort(int port, int val);
+
+	enum QueuedWriteType {
+		kQueuedReset,
+		kQueuedWrite,
+		kQueuedWriteReg
+	};
 
 public:
 	OPL(Config::OplType type);
@@ -187,6 +196,9 @@ public:
 
 protected:
 	void generateSamples(int16 *buffer, int length);
+
+	bool supportsRenderAhead() const override { return true; }
+	void applyQueuedWrite(int type, int a, int v) override;
 };
 
 }
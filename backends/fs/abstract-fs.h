@@ -172,6 +172,18 @@ public:
 	 */
 	virtual bool isWritable() const = 0;
 
+	/**
+	 * Retrieves the size and the last modification time of the file referred
+	 * by this node, without opening it. The modification time is only meant
+	 * to be compared against an earlier value, its unit is backend specific.
+	 *
+	 * @param size             receives the size of the file in bytes
+	 * @param modificationTime receives the last modification time
+	 *
+	 * @return bool true if the values could be retrieved, false if the node is
+	 *         not a readable file or the backend does not support this.
+	 */
+	virtual bool getFileStats(int64 &size, int64 &modificationTime) const { return false; }
 
 	/**
 	 * Creates a SeekableReadStream instance corresponding to the file
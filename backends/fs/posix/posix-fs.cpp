@@ -55,6 +55,12 @@
 #include <os2.h>
 #endif
 
+#ifdef HAS_MMAP
+// Files at least this large are mapped into memory instead of being read
+// through stdio
+static const int64 kMinMappedFileSize = 64 * 1024;
+#endif
+
 bool POSIXFilesystemNode::exists() const {
 	return access(_path.c_str(), F_OK) == 0;
 }
@@ -67,6 +73,17 @@ bool POSIXFilesystemNode::isWritable() const {
 	return access(_path.c_str(), W_OK) == 0;
 }
 
+bool POSIXFilesystemNode::getFileStats(int64 &size, int64 &modificationTime) const {
+	struct stat st;
+
+	if (stat(_path.c_str(), &st) != 0 || S_ISDIR(st.st_mode))
+		return false;
+
+	size = st.st_size;
+	modificationTime = st.st_mtime;
+	return true;
+}
+
 void POSIXFilesystemNode::setFlags() {
 	struct stat st;
 
@@ -276,6 +293,14 @@ AbstractFSNode *POSIXFilesystemNode::getParent() const {
 }
 
 Common::SeekableReadStream *POSIXFilesystemNode::createReadStream() {
+#ifdef HAS_MMAP
+	// Map large files into memory, so that they can be read without going
+	// through the stdio buffers. Small files are cheaper to read than to map.
+	Common::SeekableReadStream *mapped = PosixMappedReadStream::makeFromPath(getPath(), kMinMappedFileSize);
+	if (mapped)
+		return mapped;
+#endif
+
 	return PosixIoStream::makeFromPath(getPath(), StdioStream::WriteMode_Read);
 }
 
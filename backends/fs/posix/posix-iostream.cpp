@@ -24,6 +24,11 @@
 #include "backends/fs/posix/posix-iostream.h"
 
 #include <sys/stat.h>
+#ifdef HAS_MMAP
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
 
 PosixIoStream::PosixIoStream(void *handle) :
 		StdioStream(handle) {
@@ -44,3 +49,46 @@ int64 PosixIoStream::size() const {
 
 	return st.st_size;
 }
+
+#ifdef HAS_MMAP
+
+PosixMappedReadStream *PosixMappedReadStream::makeFromPath(const Common::String &path, int64 minSize) {
+	int fd = open(path.c_str(), O_RDONLY);
+	if (fd == -1)
+		return nullptr;
+
+	struct stat st;
+	if (fstat(fd, &st) == -1 || !S_ISREG(st.st_mode) || st.st_size < minSize) {
+		close(fd);
+		return nullptr;
+	}
+
+	// MemoryReadStream is limited to 32-bit sizes, and large mappings could
+	// exhaust the address space of 32-bit systems
+	const int64 maxSize = sizeof(void *) >= 8 ? 0x7FFFFFFF : 0x4000000;
+	if (st.st_size > maxSize) {
+		close(fd);
+		return nullptr;
+	}
+
+	void *mapping = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+	// The mapping stays valid after the descriptor has been closed
+	close(fd);
+
+	if (mapping == MAP_FAILED)
+		return nullptr;
+
+	return new PosixMappedReadStream(mapping, st.st_size);
+}
+
+PosixMappedReadStream::PosixMappedReadStream(void *mapping, uint32 size) :
+		Common::MemoryReadStream((const byte *)mapping, size),
+		_mapping(mapping),
+		_mappingSize(size) {
+}
+
+PosixMappedReadStream::~PosixMappedReadStream() {
+	munmap(_mapping, _mappingSize);
+}
+
+#endif
@@ -23,6 +23,7 @@
 #define BACKENDS_FS_POSIX_POSIXIOSTREAM_H
 
 #include "backends/fs/stdiostream.h"
+#include "common/memstream.h"
 
 /**
  * A file input / output stream using POSIX interfaces
@@ -39,4 +40,35 @@ public:
 	int64 size() const override;
 };
 
+#ifdef HAS_MMAP
+
+/**
+ * A read-only file stream backed by a memory mapping of the file. Reads are
+ * plain memory copies, and getData() gives access to the whole file in place.
+ */
+class PosixMappedReadStream final : public Common::MemoryReadStream {
+public:
+	/**
+	 * Map a file into memory.
+	 *
+	 * @param path     The file to map.
+	 * @param minSize  The smallest file size worth mapping. Smaller files are
+	 *                 better served by a buffered stream.
+	 *
+	 * @return The stream, or nullptr if the file is too small or too large to
+	 *         be mapped, or could not be mapped.
+	 */
+	static PosixMappedReadStream *makeFromPath(const Common::String &path, int64 minSize);
+
+	~PosixMappedReadStream();
+
+private:
+	PosixMappedReadStream(void *mapping, uint32 size);
+
+	void *_mapping;
+	uint32 _mappingSize;
+};
+
+#endif
+
 #endif
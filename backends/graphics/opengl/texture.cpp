@@ -27,6 +27,7 @@
 #include "graphics/opengl/debug.h"
 
 #include "common/algorithm.h"
+#include "common/config-manager.h"
 #include "common/endian.h"
 #include "common/rect.h"
 #include "common/textconsole.h"
@@ -470,6 +471,8 @@ void ScaledTextureSurface::setScaler(uint scalerIndex, int scaleFactor) {
 
 	if (!_scaler) {
 		_scaler = scalerPlugin.createInstance(_format);
+		if (ConfMan.hasKey("scaler_band_height"))
+			_scaler->setBandHeight(ConfMan.getInt("scaler_band_height"));
 	}
 	_scaler->setFactor(scaleFactor);
 
@@ -718,6 +718,8 @@ void SurfaceSdlGraphicsManager::setGraphicsModeIntern() {
 
 		_scalerPlugin = &_scalerPlugins[_videoMode.scalerIndex]->get<ScalerPluginObject>();
 		_scaler = _scalerPlugin->createInstance(format);
+		if (ConfMan.hasKey("scaler_band_height"))
+			_scaler->setBandHeight(ConfMan.getInt("scaler_band_height"));
 
 		if (_mouseScaler != nullptr) {
 			delete _mouseScaler;
@@ -1360,9 +1362,13 @@ void SurfaceSdlGraphicsManager::internUpdateScreen() {
 		actualDirtyRects += _numPrevDirtyRects;
 	}
 
+	_dirtyRectStats.frames++;
+	_dirtyRectStats.screenArea += width * height;
+
 	// Force a full redraw if requested.
 	// If _useOldSrc, the scaler will do its own partial updates.
 	if (doRedraw) {
+		_dirtyRectStats.fullRedraws++;
 		actualDirtyRects = 1;
 		_dirtyRectList[0].x = 0;
 		_dirtyRectList[0].y = 0;
@@ -1455,6 +1461,7 @@ void SurfaceSdlGraphicsManager::internUpdateScreen() {
 
 				_scaler->scale((byte *)srcSurf->pixels + (src_x + _maxExtraPixels) * bpp + (src_y + _maxExtraPixels) * srcPitch, srcPitch,
 						(byte *)_hwScreen->pixels + dst_x * bpp + dst_y * dstPitch, dstPitch, dst_w, dst_h, src_x, src_y);
+				_dirtyRectStats.redrawnArea += dst_w * dst_h;
 
 				r->x = dst_x;
 				r->y = dst_y;
@@ -1591,6 +1598,8 @@ void SurfaceSdlGraphicsManager::internUpdateScreen() {
 	_forceRedraw = false;
 	_cursorNeedsRedraw = false;
 
+	logDirtyRectStats();
+
 #if SDL_VERSION_ATLEAST(2, 0, 0)
 
 #if defined(USE_IMGUI) && (defined(USE_IMGUI_SDLRENDERER2) || defined(USE_IMGUI_SDLRENDERER3))
@@ -1730,13 +1739,29 @@ void SurfaceSdlGraphicsManager::copyRectToScreen(const void *buf, int pitch, int
 	assert(h > 0 && y + h <= _videoMode.screenHeight);
 	assert(w > 0 && x + w <= _videoMode.screenWidth);
 
-	addDirtyRect(x, y, w, h, false);
-
 	// Try to lock the screen surface
 	if (!lockSurface(_screen))
 		error("SDL_LockSurface failed: %s", SDL_GetError());
 
 	byte *dst = (byte *)_screen->pixels + y * _screen->pitch + x * _screenFormat.bytesPerPixel;
+
+	// Only mark the rows whose pixels actually change as dirty. Engines
+	// often copy unchanged areas back to the screen.
+	const uint rowSize = w * _screenFormat.bytesPerPixel;
+	int firstRow = 0, lastRow = h - 1;
+	while (firstRow <= lastRow && !memcmp(dst + firstRow * _screen->pitch, (const byte *)buf + firstRow * pitch, rowSize))
+		firstRow++;
+	while (lastRow > firstRow && !memcmp(dst + lastRow * _screen->pitch, (const byte *)buf + lastRow * pitch, rowSize))
+		lastRow--;
+
+	if (firstRow > lastRow) {
+		_dirtyRectStats.unchangedRects++;
+		SDL_UnlockSurface(_screen);
+		return;
+	}
+
+	addDirtyRect(x, y + firstRow, w, lastRow - firstRow + 1, false);
+
 	if (_videoMode.screenWidth == w && pitch == _screen->pitch) {
 		memcpy(dst, buf, h*pitch);
 	} else {
@@ -1806,11 +1831,6 @@ void SurfaceSdlGraphicsManager::addDirtyRect(int x, int y, int w, int h, bool in
 	if (_forceRedraw)
 		return;
 
-	if (_numDirtyRects == NUM_DIRTY_RECT) {
-		_forceRedraw = true;
-		return;
-	}
-
 	int height, width;
 
 	if (!inOverlay && !realCoordinates) {
@@ -1862,15 +1882,97 @@ void SurfaceSdlGraphicsManager::addDirtyRect(int x, int y, int w, int h, bool in
 	}
 
 	if (w > 0 && h > 0) {
-		SDL_Rect *r = &_dirtyRectList[_numDirtyRects++];
+		SDL_Rect r;
+		r.x = x;
+		r.y = y;
+		r.w = w;
+		r.h = h;
 
-		r->x = x;
-		r->y = y;
-		r->w = w;
-		r->h = h;
+		_dirtyRectStats.addedRects++;
+		mergeDirtyRect(r);
 	}
 }
 
+static inline int rectArea(const SDL_Rect &r) {
+	return r.w * r.h;
+}
+
+static inline SDL_Rect rectUnion(const SDL_Rect &a, const SDL_Rect &b) {
+	SDL_Rect r;
+	r.x = MIN(a.x, b.x);
+	r.y = MIN(a.y, b.y);
+	r.w = MAX(a.x + a.w, b.x + b.w) - r.x;
+	r.h = MAX(a.y + a.h, b.y + b.h) - r.y;
+	return r;
+}
+
+static inline int rectOverlapArea(const SDL_Rect &a, const SDL_Rect &b) {
+	int w = MIN(a.x + a.w, b.x + b.w) - MAX(a.x, b.x);
+	int h = MIN(a.y + a.h, b.y + b.h) - MAX(a.y, b.y);
+	return (w > 0 && h > 0) ? w * h : 0;
+}
+
+static inline bool rectsTouch(const SDL_Rect &a, const SDL_Rect &b) {
+	return a.x <= b.x + b.w && b.x <= a.x + a.w && a.y <= b.y + b.h && b.y <= a.y + a.h;
+}
+
+void SurfaceSdlGraphicsManager::mergeDirtyRect(SDL_Rect rect) {
+	// Merge the rect with every overlapping or adjacent rect, as long as
+	// the merged rect does not cover much more than the two of them do.
+	bool merged;
+	do {
+		merged = false;
+		for (int i = 0; i < _numDirtyRects; i++) {
+			const SDL_Rect &r = _dirtyRectList[i];
+			if (!rectsTouch(r, rect))
+				continue;
+
+			SDL_Rect u = rectUnion(r, rect);
+			int covered = rectArea(r) + rectArea(rect) - rectOverlapArea(r, rect);
+			if ((rectArea(u) - covered) * 4 <= rectArea(u)) {
+				rect = u;
+				_dirtyRectList[i] = _dirtyRectList[--_numDirtyRects];
+				_dirtyRectStats.mergedRects++;
+				merged = true;
+				break;
+			}
+		}
+	} while (merged);
+
+	if (_numDirtyRects == NUM_DIRTY_RECT) {
+		// The list is full, so grow the rect which needs the least extra
+		// area instead of redrawing the whole screen.
+		int best = 0;
+		int bestGrowth = INT_MAX;
+		for (int i = 0; i < _numDirtyRects; i++) {
+			int growth = rectArea(rectUnion(_dirtyRectList[i], rect)) - rectArea(_dirtyRectList[i]);
+			if (growth < bestGrowth) {
+				best = i;
+				bestGrowth = growth;
+			}
+		}
+
+		rect = rectUnion(_dirtyRectList[best], rect);
+		_dirtyRectList[best] = _dirtyRectList[--_numDirtyRects];
+		_dirtyRectStats.mergedRects++;
+		mergeDirtyRect(rect);
+		return;
+	}
+
+	_dirtyRectList[_numDirtyRects++] = rect;
+}
+
+void SurfaceSdlGraphicsManager::logDirtyRectStats() {
+	if (_dirtyRectStats.frames < 1000)
+		return;
+
+	debug(4, "Dirty rects over %u frames: %u full redraws, %u rects added, %u merged, %u skipped as unchanged, %.1f%% of the screen area redrawn",
+	      _dirtyRectStats.frames, _dirtyRectStats.fullRedraws, _dirtyRectStats.addedRects,
+	      _dirtyRectStats.mergedRects, _dirtyRectStats.unchangedRects,
+	      _dirtyRectStats.screenArea ? 100.0 * _dirtyRectStats.redrawnArea / _dirtyRectStats.screenArea : 0.0);
+	_dirtyRectStats.reset();
+}
+
 int16 SurfaceSdlGraphicsManager::getHeight() const {
 	return _videoMode.screenHeight;
 }
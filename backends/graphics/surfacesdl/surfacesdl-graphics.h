@@ -366,6 +366,25 @@ protected:
 	SDL_Rect _prevDirtyRectList[NUM_DIRTY_RECT];
 	int _numPrevDirtyRects;
 
+	// Damage tracking statistics, logged periodically to measure how much
+	// of the screen actually goes through the scaler.
+	struct DirtyRectStats {
+		uint32 frames;
+		uint32 fullRedraws;
+		uint32 addedRects;
+		uint32 mergedRects;
+		uint32 unchangedRects;
+		uint64 redrawnArea;
+		uint64 screenArea;
+
+		DirtyRectStats() { reset(); }
+		void reset() {
+			frames = fullRedraws = addedRects = mergedRects = unchangedRects = 0;
+			redrawnArea = screenArea = 0;
+		}
+	};
+	DirtyRectStats _dirtyRectStats;
+
 	struct MousePos {
 		// The size and hotspot of the original cursor image.
 		int16 w, h;
@@ -429,6 +448,8 @@ protected:
 #endif
 
 	virtual void addDirtyRect(int x, int y, int w, int h, bool inOverlay, bool realCoordinates = false);
+	void mergeDirtyRect(SDL_Rect rect);
+	void logDirtyRectStats();
 
 	virtual void drawMouse();
 	virtual void undrawMouse();
@@ -142,8 +142,14 @@ void SdlMixerManager::init() {
 	desiredSamples = desired.samples;
 #endif
 
-	_mixer = new Audio::MixerImpl(_obtained.freq, _obtained.channels >= 2, desiredSamples);
+	// Let channel commands from the engine bypass the mixer mutex, so that they
+	// never hold up the audio thread
+	bool lockFree = ConfMan.hasKey("lockfree_mixer") && ConfMan.getBool("lockfree_mixer");
+
+	_mixer = new Audio::MixerImpl(_obtained.freq, _obtained.channels >= 2, desiredSamples, lockFree);
 	assert(_mixer);
+	if (ConfMan.hasKey("audio_resampler"))
+		_mixer->setRateConverterType(Audio::parseRateConverterType(ConfMan.get("audio_resampler").c_str()));
 	_mixer->setReady(true);
 
 	startAudio();
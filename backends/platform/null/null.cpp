@@ -50,14 +50,16 @@ typedef void (*sighandler_t)(int);
 #include "backends/modular-backend.h"
 #include "backends/mutex/null/null-mutex.h"
 #include "base/main.h"
+#include "backends/timer/default/default-timer.h"
+#include "backends/mixer/null/null-mixer.h"
 
 #ifndef NULL_DRIVER_USE_FOR_TEST
 #include "backends/saves/default/default-saves.h"
-#include "backends/timer/default/default-timer.h"
 #include "backends/events/default/default-events.h"
-#include "backends/mixer/null/null-mixer.h"
 #include "backends/graphics/null/null-graphics.h"
 #include "gui/debugger.h"
+#else
+#include "common/savefile.h"
 #endif
 
 /*
@@ -95,6 +97,13 @@ public:
 
 	virtual void addSysArchivesToSearchSet(Common::SearchSet &s, int priority);
 
+#ifdef NULL_DRIVER_USE_FOR_TEST
+	void setSavefileManager(Common::SaveFileManager *saveFileMan) {
+		delete _savefileManager;
+		_savefileManager = saveFileMan;
+	}
+#endif
+
 private:
 #ifdef POSIX
 	timeval _startTime;
@@ -154,9 +163,14 @@ void OSystem_NULL::initBackend() {
 	_mixerManager = new NullMixerManager();
 	// Setup and start mixer
 	_mixerManager->init();
-#endif
 
 	BaseBackend::initBackend();
+#else
+	// Tests only get the timer and the mixer, which nothing drives on its own
+	_timerManager = new DefaultTimerManager();
+	_mixerManager = new NullMixerManager();
+	_mixerManager->init();
+#endif
 }
 
 bool OSystem_NULL::pollEvent(Common::Event &event) {
@@ -37,6 +37,8 @@
 #include "common/archive.h"
 #include "common/config-manager.h"
 #include "common/compression/deflate.h"
+#include "common/memstream.h"
+#include "common/ptr.h"
 
 #include <errno.h>	// for removeSavefile()
 
@@ -44,13 +46,20 @@
 const char *const DefaultSaveFileManager::TIMESTAMPS_FILENAME = "timestamps";
 #endif
 
-DefaultSaveFileManager::DefaultSaveFileManager() {
+static const uint32 kMetaDataIndexId = MKTAG('S', 'V', 'M', 'I');
+static const uint32 kMetaDataIndexVersion = 1;
+
+DefaultSaveFileManager::DefaultSaveFileManager() : _cacheRevision(0), _lastRevision(0), _metaDataChanged(false) {
 }
 
-DefaultSaveFileManager::DefaultSaveFileManager(const Common::Path &defaultSavepath) {
+DefaultSaveFileManager::DefaultSaveFileManager(const Common::Path &defaultSavepath) : _cacheRevision(0), _lastRevision(0), _metaDataChanged(false) {
 	ConfMan.registerDefault("savepath", defaultSavepath);
 }
 
+DefaultSaveFileManager::~DefaultSaveFileManager() {
+	flushSavefileMetaData();
+}
+
 
 void DefaultSaveFileManager::checkPath(const Common::FSNode &dir) {
 	clearError();
@@ -171,6 +180,7 @@ Common::OutSaveFile *DefaultSaveFileManager::openForSaving(const Common::String
 
 	// Add file to cache now that it exists.
 	_saveFileCache[filename] = Common::FSNode(fileNode.getPath());
+	touchSavefile(filename);
 
 	return result;
 }
@@ -200,6 +210,7 @@ bool DefaultSaveFileManager::removeSavefile(const Common::String &filename) {
 		// Remove from cache, this invalidates the 'file' iterator.
 		_saveFileCache.erase(file);
 		file = _saveFileCache.end();
+		touchSavefile(filename);
 
 		Common::ErrorCode result = removeFile(fileNode);
 		if (result == Common::kNoError)
@@ -235,6 +246,244 @@ bool DefaultSaveFileManager::exists(const Common::String &filename) {
 	return _saveFileCache.contains(filename);
 }
 
+uint32 DefaultSaveFileManager::getSavefileRevision(const Common::String &filename) {
+	// Assure the savefile name cache is up-to-date.
+	assureCached(getSavePath());
+	if (getError().getCode() != Common::kNoError)
+		return 0;
+
+	// Locked files are about to change
+	for (const auto &lockedFile : _lockedFiles) {
+		if (filename == lockedFile)
+			return 0;
+	}
+
+	SaveFileRevisions::iterator revision = _fileRevisions.find(filename);
+	SaveFileCache::const_iterator file = _saveFileCache.find(filename);
+	int64 size, modificationTime;
+	if (file == _saveFileCache.end() || !file->_value.getFileStats(size, modificationTime)) {
+		if (revision == _fileRevisions.end())
+			return _cacheRevision;
+
+		// The file was there when it was checked last
+		if (revision->_value.hasStats)
+			revision->_value = SaveFileRevision(++_lastRevision);
+		return revision->_value.revision;
+	}
+
+	// Saves can also be changed outside of ScummVM, which only shows in
+	// their size and modification time
+	if (revision == _fileRevisions.end()) {
+		_fileRevisions[filename] = SaveFileRevision(_cacheRevision);
+		revision = _fileRevisions.find(filename);
+	} else if (revision->_value.hasStats && (revision->_value.size != size || revision->_value.modificationTime != modificationTime)) {
+		revision->_value.revision = ++_lastRevision;
+	}
+
+	revision->_value.hasStats = true;
+	revision->_value.size = size;
+	revision->_value.modificationTime = modificationTime;
+	return revision->_value.revision;
+}
+
+void DefaultSaveFileManager::touchSavefile(const Common::String &filename) {
+	_fileRevisions[filename] = SaveFileRevision(++_lastRevision);
+
+	// The file may change again before its modification time does
+	_touchedFiles[filename] = true;
+	SaveFileMetaDataIndex::iterator entry = _metaData.find(filename);
+	if (entry != _metaData.end()) {
+		_metaData.erase(entry);
+		_metaDataChanged = true;
+	}
+}
+
+Common::SeekableReadStream *DefaultSaveFileManager::openSavefileMetaData(const Common::String &index, const Common::String &filename) {
+	// Assure the savefile name cache is up-to-date.
+	assureCached(getSavePath());
+	if (getError().getCode() != Common::kNoError)
+		return nullptr;
+
+	for (const auto &lockedFile : _lockedFiles) {
+		if (filename == lockedFile)
+			return nullptr;
+	}
+
+	loadMetaDataIndex(index);
+	SaveFileMetaDataIndex::iterator entry = _metaData.find(filename);
+	if (entry == _metaData.end())
+		return nullptr;
+
+	// The data is only valid as long as the file did not change
+	SaveFileCache::const_iterator file = _saveFileCache.find(filename);
+	int64 size, modificationTime;
+	if (file == _saveFileCache.end() || !file->_value.getFileStats(size, modificationTime) ||
+		size != entry->_value.size || modificationTime != entry->_value.modificationTime) {
+		_metaData.erase(entry);
+		_metaDataChanged = true;
+		return nullptr;
+	}
+
+	if (entry->_value.offset == 0) {
+		byte *data = (byte *)malloc(entry->_value.length);
+		if (!data)
+			return nullptr;
+		memcpy(data, entry->_value.data.data(), entry->_value.length);
+		return new Common::MemoryReadStream(data, entry->_value.length, DisposeAfterUse::YES);
+	}
+
+	Common::ScopedPtr<Common::SeekableReadStream> in(getMetaDataIndexFile(_metaDataDirectory, _metaDataIndex).createReadStream());
+	if (!in || !in->seek(entry->_value.offset))
+		return nullptr;
+
+	Common::SeekableReadStream *data = in->readStream(entry->_value.length);
+	if (data && data->size() != entry->_value.length) {
+		delete data;
+		return nullptr;
+	}
+	return data;
+}
+
+void DefaultSaveFileManager::storeSavefileMetaData(const Common::String &index, const Common::String &filename, const byte *data, uint32 size) {
+	// Assure the savefile name cache is up-to-date.
+	assureCached(getSavePath());
+	if (getError().getCode() != Common::kNoError)
+		return;
+
+	for (const auto &lockedFile : _lockedFiles) {
+		if (filename == lockedFile)
+			return;
+	}
+
+	SaveFileCache::const_iterator file = _saveFileCache.find(filename);
+	int64 fileSize, modificationTime;
+	if (file == _saveFileCache.end() || !file->_value.getFileStats(fileSize, modificationTime))
+		return;
+
+	loadMetaDataIndex(index);
+	SaveFileMetaData &entry = _metaData[filename];
+	entry.size = fileSize;
+	entry.modificationTime = modificationTime;
+	entry.offset = 0;
+	entry.length = size;
+	entry.data = Common::Array<byte>(data, size);
+	_metaDataChanged = true;
+	_touchedFiles.erase(filename);
+}
+
+void DefaultSaveFileManager::flushSavefileMetaData() {
+	if (!_metaDataChanged)
+		return;
+	_metaDataChanged = false;
+
+	const Common::FSNode indexFile = getMetaDataIndexFile(_metaDataDirectory, _metaDataIndex);
+
+	// Drop the data of the save files which are gone, and read the data
+	// which is kept from the current index file, since it is replaced
+	Common::ScopedPtr<Common::SeekableReadStream> in;
+	Common::StringArray dropped;
+	for (auto &entry : _metaData) {
+		if (_cachedDirectory == _metaDataDirectory && !_saveFileCache.contains(entry._key)) {
+			dropped.push_back(entry._key);
+			continue;
+		}
+		if (entry._value.offset == 0)
+			continue;
+
+		if (!in && indexFile.exists())
+			in.reset(indexFile.createReadStream());
+		entry._value.data.resize(entry._value.length);
+		if (!in || !in->seek(entry._value.offset) || in->read(entry._value.data.data(), entry._value.length) != entry._value.length)
+			dropped.push_back(entry._key);
+		entry._value.offset = 0;
+	}
+	in.reset();
+
+	for (const auto &filename : dropped)
+		_metaData.erase(filename);
+
+	if (_metaData.empty()) {
+		if (indexFile.exists())
+			removeFile(indexFile);
+		_saveFileCache.erase(indexFile.getName());
+		return;
+	}
+
+	Common::ScopedPtr<Common::SeekableWriteStream> out(indexFile.createWriteStream());
+	if (!out) {
+		warning("DefaultSaveFileManager: failed to open '%s' to save the metadata index", indexFile.getPath().toString(Common::Path::kNativeSeparator).c_str());
+		return;
+	}
+
+	out->writeUint32BE(kMetaDataIndexId);
+	out->writeUint32LE(kMetaDataIndexVersion);
+	out->writeUint32LE(_metaData.size());
+	for (auto &entry : _metaData) {
+		out->writeString(entry._key);
+		out->writeByte(0);
+		out->writeSint64LE(entry._value.size);
+		out->writeSint64LE(entry._value.modificationTime);
+		out->writeUint32LE(entry._value.length);
+		entry._value.offset = out->pos();
+		out->write(entry._value.data.data(), entry._value.length);
+		entry._value.data.clear();
+	}
+
+	if (!out->flush() || out->err()) {
+		warning("DefaultSaveFileManager: failed to write the metadata index into '%s'", indexFile.getPath().toString(Common::Path::kNativeSeparator).c_str());
+		out.reset();
+		_metaData.clear();
+		removeFile(indexFile);
+	}
+}
+
+void DefaultSaveFileManager::loadMetaDataIndex(const Common::String &index) {
+	const Common::Path directory = getSavePath();
+	if (index == _metaDataIndex && directory == _metaDataDirectory)
+		return;
+
+	flushSavefileMetaData();
+	_metaData.clear();
+	_metaDataIndex = index;
+	_metaDataDirectory = directory;
+
+	const Common::FSNode indexFile = getMetaDataIndexFile(directory, index);
+	if (!indexFile.exists())
+		return;
+
+	Common::ScopedPtr<Common::SeekableReadStream> in(indexFile.createReadStream());
+	if (!in || in->readUint32BE() != kMetaDataIndexId || in->readUint32LE() != kMetaDataIndexVersion)
+		return;
+
+	// Only the data is kept in the file, and read when it is needed
+	const uint32 count = in->readUint32LE();
+	for (uint32 i = 0; i < count; i++) {
+		const Common::String filename = in->readString();
+		SaveFileMetaData entry;
+		entry.size = in->readSint64LE();
+		entry.modificationTime = in->readSint64LE();
+		entry.length = in->readUint32LE();
+		entry.offset = in->pos();
+
+		if (in->err() || in->eos() || entry.offset + (int64)entry.length > in->size()) {
+			// Write what could be read back, without the damaged part
+			_metaDataChanged = true;
+			break;
+		}
+
+		in->skip(entry.length);
+		if (_touchedFiles.contains(filename))
+			_metaDataChanged = true;
+		else
+			_metaData[filename] = entry;
+	}
+}
+
+Common::FSNode DefaultSaveFileManager::getMetaDataIndexFile(const Common::Path &directory, const Common::String &index) {
+	// The leading dot keeps the file out of the cloud sync
+	return Common::FSNode(directory).getChild("." + index + ".metadata");
+}
+
 Common::Path DefaultSaveFileManager::getSavePath() const {
 
 	Common::Path dir;
@@ -270,6 +519,22 @@ void DefaultSaveFileManager::assureCached(const Common::Path &savePathName) {
 	_saveFileCache.clear();
 	_cachedDirectory.clear();
 
+	// Everything read from the files before has to be read again, except
+	// for the files of the same directory which are checked with their
+	// size and modification time
+	if (_fileRevisionsDirectory != savePathName) {
+		_fileRevisions.clear();
+		_fileRevisionsDirectory = savePathName;
+	} else {
+		for (SaveFileRevisions::iterator i = _fileRevisions.begin(); i != _fileRevisions.end();) {
+			if (i->_value.hasStats)
+				++i;
+			else
+				_fileRevisions.erase(i++);
+		}
+	}
+	_cacheRevision = ++_lastRevision;
+
 	if (getError().getCode() != Common::kNoError) {
 		warning("DefaultSaveFileManager::assureCached: Can not cache path '%s': '%s'", savePathName.toString(Common::Path::kNativeSeparator).c_str(), getErrorDesc().c_str());
 		return;
@@ -26,6 +26,7 @@
 #include "common/savefile.h"
 #include "common/str.h"
 #include "common/fs.h"
+#include "common/array.h"
 #include "common/hash-str.h"
 
 /**
@@ -35,6 +36,7 @@ class DefaultSaveFileManager : public Common::SaveFileManager {
 public:
 	DefaultSaveFileManager();
 	DefaultSaveFileManager(const Common::Path &defaultSavepath);
+	~DefaultSaveFileManager() override;
 
 	void updateSavefilesList(Common::StringArray &lockedFiles) override;
 	Common::StringArray listSavefiles(const Common::String &pattern) override;
@@ -43,6 +45,10 @@ public:
 	Common::OutSaveFile *openForSaving(const Common::String &filename, bool compress = true) override;
 	bool removeSavefile(const Common::String &filename) override;
 	bool exists(const Common::String &filename) override;
+	uint32 getSavefileRevision(const Common::String &filename) override;
+	Common::SeekableReadStream *openSavefileMetaData(const Common::String &index, const Common::String &filename) override;
+	void storeSavefileMetaData(const Common::String &index, const Common::String &filename, const byte *data, uint32 size) override;
+	void flushSavefileMetaData() override;
 
 #ifdef USE_CLOUD
 
@@ -99,11 +105,102 @@ protected:
 	 */
 	Common::StringArray _lockedFiles;
 
+	struct SaveFileRevision {
+		SaveFileRevision(uint32 rev = 0) : revision(rev), hasStats(false), size(0), modificationTime(0) {}
+
+		uint32 revision;
+
+		// The size and modification time of the file when the revision was
+		// last checked, if known
+		bool hasStats;
+		int64 size;
+		int64 modificationTime;
+	};
+
+	typedef Common::HashMap<Common::String, SaveFileRevision, Common::IgnoreCase_Hash, Common::IgnoreCase_EqualTo> SaveFileRevisions;
+
+	/**
+	 * Revisions of the save files checked, written or removed since the
+	 * directory was cached. All other files have the revision of the cache
+	 * itself. The checked files are kept when the same directory is cached
+	 * again.
+	 */
+	SaveFileRevisions _fileRevisions;
+
+	/**
+	 * Assign a new revision to the given save file, and forget the metadata
+	 * stored for it.
+	 */
+	void touchSavefile(const Common::String &filename);
+
+	struct SaveFileMetaData {
+		SaveFileMetaData() : size(0), modificationTime(0), offset(0), length(0) {}
+
+		// The size and modification time of the save file when the data
+		// was stored
+		int64 size;
+		int64 modificationTime;
+
+		// Position of the data in the index file, unless it was stored
+		// since the index was written
+		uint32 offset;
+		uint32 length;
+		Common::Array<byte> data;
+	};
+
+	typedef Common::HashMap<Common::String, SaveFileMetaData, Common::IgnoreCase_Hash, Common::IgnoreCase_EqualTo> SaveFileMetaDataIndex;
+
+	/**
+	 * Load the metadata index of the given name from the save directory,
+	 * after writing the one loaded before if it changed.
+	 */
+	void loadMetaDataIndex(const Common::String &index);
+
+	/**
+	 * Get the file which holds the metadata index of the given name.
+	 */
+	static Common::FSNode getMetaDataIndexFile(const Common::Path &directory, const Common::String &index);
+
 private:
 	/**
 	 * The currently cached directory.
 	 */
 	Common::Path _cachedDirectory;
+
+	/**
+	 * The directory the save file revisions belong to.
+	 */
+	Common::Path _fileRevisionsDirectory;
+
+	/**
+	 * The revision of the currently cached directory.
+	 */
+	uint32 _cacheRevision;
+
+	/**
+	 * The last revision handed out.
+	 */
+	uint32 _lastRevision;
+
+	/**
+	 * The metadata of the save files in the currently loaded index, which
+	 * is kept in the save directory it was loaded from.
+	 */
+	SaveFileMetaDataIndex _metaData;
+	Common::String _metaDataIndex;
+	Common::Path _metaDataDirectory;
+
+	/**
+	 * Whether the loaded index changed since it was written.
+	 */
+	bool _metaDataChanged;
+
+	/**
+	 * The save files written or removed in this session, whose metadata
+	 * was not stored since. Their data in the index files can't be trusted,
+	 * since a file may be written again before its modification time changes.
+	 */
+	Common::HashMap<Common::String, bool, Common::IgnoreCase_Hash, Common::IgnoreCase_EqualTo> _touchedFiles;
 };
 
 #endif
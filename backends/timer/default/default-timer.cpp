@@ -30,87 +30,117 @@ struct TimerSlot {
 	Common::String id;
 	uint32 interval;	// in microseconds
 
-	uint32 nextFireTime;	// in milliseconds
-	uint32 nextFireTimeMicro;	// microseconds part of nextFire
-
-	TimerSlot *next;
-
-	TimerSlot() : callback(nullptr), refCon(nullptr), interval(0), nextFireTime(0), nextFireTimeMicro(0), next(nullptr) {}
+	uint64 nextFireTime;	// in microseconds
+	uint32 order;	// position among timers due at the same time
+	uint32 installCount;	// tells apart the timers a pooled slot is used for
+
+	// Statistics, see Common::TimerManager::TimerStats
+	uint32 fireCount;
+	uint32 lateCount;
+	uint32 maxLateness;	// in microseconds
+	uint32 totalCallbackTime;	// in milliseconds
+	uint32 maxCallbackTime;	// in milliseconds
+
+	TimerSlot() : callback(nullptr), refCon(nullptr), interval(0), nextFireTime(0), order(0), installCount(0),
+		fireCount(0), lateCount(0), maxLateness(0), totalCallbackTime(0), maxCallbackTime(0) {}
 };
 
-void insertPrioQueue(TimerSlot *head, TimerSlot *newSlot) {
-	// The head points to a fake anchor TimerSlot; this common
-	// trick allows us to get rid of many special cases.
+bool DefaultTimerManager::firesBefore(const TimerSlot *a, const TimerSlot *b) {
+	if (a->nextFireTime != b->nextFireTime)
+		return a->nextFireTime < b->nextFireTime;
+	// The serial numbers may wrap around, but timers due at the same time
+	// are never that far apart.
+	return (int32)(a->order - b->order) < 0;
+}
 
-	const uint32 nextFireTime = newSlot->nextFireTime;
-	TimerSlot *slot = head;
-	newSlot->next = nullptr;
+void DefaultTimerManager::siftUp(uint index) {
+	TimerSlot *slot = _queue[index];
+	while (index > 0) {
+		uint parent = (index - 1) / 2;
+		if (!firesBefore(slot, _queue[parent]))
+			break;
+		_queue[index] = _queue[parent];
+		index = parent;
+	}
+	_queue[index] = slot;
+}
 
-	// Insert the new slot into the sorted list of already scheduled
-	// timers in such a way that the list stays sorted...
+void DefaultTimerManager::siftDown(uint index) {
+	TimerSlot *slot = _queue[index];
+	const uint size = _queue.size();
 	while (true) {
-		assert(slot);
-		if (slot->next == nullptr || nextFireTime < slot->next->nextFireTime) {
-			newSlot->next = slot->next;
-			slot->next = newSlot;
-			return;
-		}
-		slot = slot->next;
+		uint child = index * 2 + 1;
+		if (child >= size)
+			break;
+		if (child + 1 < size && firesBefore(_queue[child + 1], _queue[child]))
+			child++;
+		if (!firesBefore(_queue[child], slot))
+			break;
+		_queue[index] = _queue[child];
+		index = child;
 	}
+	_queue[index] = slot;
 }
 
+void DefaultTimerManager::queueSlot(TimerSlot *slot) {
+	// Timers due at the same time fire in the order they were queued
+	slot->order = _queueSerial++;
+	_queue.push_back(slot);
+	siftUp(_queue.size() - 1);
+}
 
-DefaultTimerManager::DefaultTimerManager() :
-	_timerCallbackNext(0),
-	_head(nullptr) {
 
-	_head = new TimerSlot();
+DefaultTimerManager::DefaultTimerManager() :
+	_queueSerial(0),
+	_timerCallbackNext(0) {
 }
 
 DefaultTimerManager::~DefaultTimerManager() {
 	Common::StackLock lock(_mutex);
 
-	TimerSlot *slot = _head;
-	while (slot) {
-		TimerSlot *next = slot->next;
-		delete slot;
-		slot = next;
-	}
-	_head = nullptr;
+	for (uint i = 0; i < _queue.size(); i++)
+		delete _queue[i];
+	for (uint i = 0; i < _freeSlots.size(); i++)
+		delete _freeSlots[i];
+	_queue.clear();
+	_freeSlots.clear();
 }
 
 void DefaultTimerManager::handler() {
 	Common::StackLock lock(_mutex);
 
 	uint32 curTime = g_system->getMillis(true);
-
-	// On slow systems this could still be run after destructor
-	if (!_head)
-		return;
+	const uint64 curTimeMicro = (uint64)curTime * 1000;
 
 	// Repeat as long as there is a TimerSlot that is scheduled to fire.
-	TimerSlot *slot = _head->next;
-	while (slot && slot->nextFireTime < curTime) {
-		// Remove the slot from the priority queue
-		_head->next = slot->next;
-
-		// Update the fire time and reinsert the TimerSlot into the priority
-		// queue.
+	while (!_queue.empty() && _queue[0]->nextFireTime < curTimeMicro) {
+		TimerSlot *slot = _queue[0];
+		uint32 startTime = g_system->getMillis(true);
+
+		uint64 lateness = (uint64)startTime * 1000 - slot->nextFireTime;
+		slot->fireCount++;
+		if (lateness >= slot->interval)
+			slot->lateCount++;
+		slot->maxLateness = MAX<uint32>(slot->maxLateness, MIN<uint64>(lateness, 0xFFFFFFFF));
+
+		// Update the fire time and requeue the TimerSlot. Late timers keep
+		// firing until they caught up with the missed intervals.
 		assert(slot->interval > 0);
-		slot->nextFireTime += (slot->interval / 1000);
-		slot->nextFireTimeMicro += (slot->interval % 1000);
-		if (slot->nextFireTimeMicro > 1000) {
-			slot->nextFireTime += slot->nextFireTimeMicro / 1000;
-			slot->nextFireTimeMicro %= 1000;
-		}
-		insertPrioQueue(_head, slot);
+		slot->nextFireTime += slot->interval;
+		slot->order = _queueSerial++;
+		siftDown(0);
 
 		// Invoke the timer callback
 		assert(slot->callback);
+		const uint32 installCount = slot->installCount;
 		slot->callback(slot->refCon);
 
-		// Look at the next scheduled timer
-		slot = _head->next;
+		// The callback may have removed its timer
+		if (slot->installCount == installCount) {
+			uint32 callbackTime = g_system->getMillis(true) - startTime;
+			slot->totalCallbackTime += callbackTime;
+			slot->maxCallbackTime = MAX(slot->maxCallbackTime, callbackTime);
+		}
 	}
 }
 
@@ -141,16 +171,25 @@ bool DefaultTimerManager::installTimerProc(TimerProc callback, int32 interval, v
 	}
 	_callbacks[id] = callback;
 
-	TimerSlot *slot = new TimerSlot;
+	TimerSlot *slot;
+	if (_freeSlots.empty()) {
+		slot = new TimerSlot;
+	} else {
+		slot = _freeSlots.back();
+		_freeSlots.pop_back();
+
+		uint32 installCount = slot->installCount;
+		*slot = TimerSlot();
+		slot->installCount = installCount + 1;
+	}
+
 	slot->callback = callback;
 	slot->refCon = refCon;
 	slot->id = id;
 	slot->interval = interval;
-	slot->nextFireTime = g_system->getMillis() + interval / 1000;
-	slot->nextFireTimeMicro = interval % 1000;
-	slot->next = nullptr;
+	slot->nextFireTime = (uint64)g_system->getMillis() * 1000 + interval;
 
-	insertPrioQueue(_head, slot);
+	queueSlot(slot);
 
 	return true;
 }
@@ -158,18 +197,25 @@ bool DefaultTimerManager::installTimerProc(TimerProc callback, int32 interval, v
 void DefaultTimerManager::removeTimerProc(TimerProc callback) {
 	Common::StackLock lock(_mutex);
 
-	TimerSlot *slot = _head;
-
-	while (slot->next) {
-		if (slot->next->callback == callback) {
-			TimerSlot *next = slot->next->next;
-			delete slot->next;
-			slot->next = next;
+	uint kept = 0;
+	for (uint i = 0; i < _queue.size(); i++) {
+		TimerSlot *slot = _queue[i];
+		if (slot->callback == callback) {
+			slot->callback = nullptr;
+			slot->installCount++;
+			_freeSlots.push_back(slot);
 		} else {
-			slot = slot->next;
+			_queue[kept++] = slot;
 		}
 	}
 
+	if (kept != _queue.size()) {
+		// Timers are rarely removed, so simply rebuild the heap
+		_queue.resize(kept);
+		for (uint i = kept / 2; i-- > 0; )
+			siftDown(i);
+	}
+
 	// We need to remove all names referencing the timer proc here.
 	//
 	// Else we run into troubles, when the client code removes and readds timer
@@ -187,3 +233,24 @@ void DefaultTimerManager::removeTimerProc(TimerProc callback) {
 			_callbacks.erase(i);
 	}
 }
+
+Common::TimerManager::TimerStatsList DefaultTimerManager::getTimerStats() {
+	Common::StackLock lock(_mutex);
+
+	TimerStatsList list;
+	for (uint i = 0; i < _queue.size(); i++) {
+		const TimerSlot *slot = _queue[i];
+
+		TimerStats stats;
+		stats.id = slot->id;
+		stats.interval = slot->interval;
+		stats.fireCount = slot->fireCount;
+		stats.lateCount = slot->lateCount;
+		stats.maxLateness = slot->maxLateness;
+		stats.totalCallbackTime = slot->totalCallbackTime;
+		stats.maxCallbackTime = slot->maxCallbackTime;
+		list.push_back(stats);
+	}
+
+	return list;
+}
@@ -23,6 +23,7 @@
 #define BACKENDS_TIMER_DEFAULT_H
 
 #include "common/str.h"
+#include "common/array.h"
 #include "common/hash-str.h"
 #include "common/timer.h"
 #include "common/mutex.h"
@@ -34,16 +35,28 @@ private:
 	typedef Common::HashMap<Common::String, TimerProc, Common::IgnoreCase_Hash, Common::IgnoreCase_EqualTo> TimerSlotMap;
 
 	Common::Mutex _mutex;
-	TimerSlot *_head;
 	TimerSlotMap _callbacks;
 
+	/** Installed timers, as a binary min-heap ordered by their next fire time. */
+	Common::Array<TimerSlot *> _queue;
+	/** Slots of removed timers, kept for reuse. */
+	Common::Array<TimerSlot *> _freeSlots;
+	/** Keeps timers due at the same time in the order they were queued. */
+	uint32 _queueSerial;
+
 	uint32 _timerCallbackNext;
 
+	static bool firesBefore(const TimerSlot *a, const TimerSlot *b);
+	void queueSlot(TimerSlot *slot);
+	void siftUp(uint index);
+	void siftDown(uint index);
+
 public:
 	DefaultTimerManager();
 	virtual ~DefaultTimerManager();
 	virtual bool installTimerProc(TimerProc proc, int32 interval, void *refCon, const Common::String &id);
 	virtual void removeTimerProc(TimerProc proc);
+	virtual TimerStatsList getTimerStats();
 
 	/**
 	 * Timer callback, to be invoked at regular time intervals by the backend.
@@ -329,6 +329,7 @@ void registerDefaults() {
 	ConfMan.registerDefault("dump_midi", false);
 	ConfMan.registerDefault("enable_gs", false);
 	ConfMan.registerDefault("midi_gain", 100);
+	ConfMan.registerDefault("audio_resampler", "default");
 
 	ConfMan.registerDefault("music_driver", "auto");
 	ConfMan.registerDefault("mt32_device", "null");
@@ -381,6 +382,8 @@ void registerDefaults() {
 	ConfMan.registerDefault("confirm_exit", false);
 	ConfMan.registerDefault("disable_sdl_parachute", false);
 	ConfMan.registerDefault("disable_sdl_audio", false);
+	ConfMan.registerDefault("lockfree_mixer", false);
+	ConfMan.registerDefault("detection_cache", true);
 
 #ifdef ENABLE_EVENTRECORDER
 	ConfMan.registerDefault("disable_display", false);
@@ -1674,6 +1677,7 @@ static Common::String detectGames(const Common::Path &path, const Common::String
 	//Current directory
 	Common::FSNode dir(path);
 	DetectedGames candidates = recListGames(dir, engineId, gameId, recursive);
+	ADCacheMan.flushPersistentCache(true);
 
 	if (candidates.empty()) {
 		printf("WARNING: ScummVM could not find any game in %s\n", dir.getPath().toString(Common::Path::kNativeSeparator).c_str());
@@ -1815,6 +1819,7 @@ static bool addGames(const Common::Path &path, const Common::String &engineId, c
 	//Current directory
 	Common::FSNode dir(path);
 	int added = recAddGames(dir, engineId, gameId, recursive);
+	ADCacheMan.flushPersistentCache(true);
 	printf("Added %d games\n", added);
 	if (added == 0 && !recursive) {
 		printf("Consider using --recursive to search inside subdirectories\n");
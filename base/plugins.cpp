@@ -679,6 +679,10 @@ DetectionResults EngineManager::detectGames(const Common::FSList &fslist, uint32
 	// Clear md5 cache before each detection starts, just in case.
 	ADCacheMan.clear();
 
+	// All the engines look at the same files, so the ones scanning them the
+	// same way can share their file maps
+	ADCacheMan.setFileMapSharing(true);
+
 	// Iterate over all known games and for each check if it might be
 	// the game in the presented directory.
 	for (const auto &plugin : plugins) {
@@ -694,8 +698,12 @@ DetectionResults EngineManager::detectGames(const Common::FSList &fslist, uint32
 		}
 	}
 
-	// Close all archives that were opened during detection
+	// Close all archives that were opened during detection, and drop the
+	// directory listings shared by the engines
+	ADCacheMan.setFileMapSharing(false);
 	ADCacheMan.clearArchives();
+	ADCacheMan.clearDirectories();
+	ADCacheMan.flushPersistentCache();
 
 	return DetectionResults(candidates);
 }
@@ -340,10 +340,86 @@ void SearchSet::insert(const Node &node) {
 	_list.insert(it, node);
 }
 
+void SearchSet::indexArchive(const Node &node) const {
+	if (!node._indexed)
+		return;
+
+	ArchiveMemberList members;
+	node._arc->listMembers(members);
+
+	for (const ArchiveMemberPtr &member : members) {
+		const Path path = member->getPathInArchive();
+
+		// Archives of equal priority are searched in insertion order
+		MemberIndex::iterator it = _index.find(path);
+		if (it == _index.end() || it->_value._priority < node._priority) {
+			IndexEntry &entry = _index[path];
+			entry._arc = node._arc;
+			entry._priority = node._priority;
+		}
+	}
+}
+
+void SearchSet::unindexArchive(const Archive *arc) {
+	Array<Path> orphans;
+	for (const auto &entry : _index) {
+		if (entry._value._arc == arc)
+			orphans.push_back(entry._key);
+	}
+
+	for (const Path &path : orphans) {
+		_index.erase(path);
+
+		for (const auto &node : _list) {
+			if (node._indexed && node._arc != arc && node._arc->hasFile(path)) {
+				IndexEntry &entry = _index[path];
+				entry._arc = node._arc;
+				entry._priority = node._priority;
+				break;
+			}
+		}
+	}
+}
+
+const SearchSet::IndexEntry *SearchSet::lookupIndex(const Path &path) const {
+	if (!_indexValid) {
+		_index.clear();
+		for (const auto &node : _list)
+			indexArchive(node);
+		_indexValid = true;
+	}
+
+	MemberIndex::const_iterator it = _index.find(path);
+	if (it == _index.end())
+		return nullptr;
+
+	return &it->_value;
+}
+
+bool SearchSet::skippedByIndex(const Node &node, const IndexEntry *entry) {
+	// The indexed archives other than the first one with the file don't
+	// have it, or come after that one
+	return node._indexed && (!entry || node._arc != entry->_arc);
+}
+
+void SearchSet::setIndexEnabled(bool enabled) {
+	_useIndex = enabled;
+	invalidateIndex();
+}
+
+void SearchSet::invalidateIndex() {
+	_indexValid = false;
+	_index.clear(true);
+}
+
 void SearchSet::add(const String &name, Archive *archive, int priority, bool autoFree) {
 	if (_ignoreClashes || (find(name) == _list.end())) {
 		Node node(priority, name, archive, autoFree);
+		node._indexed = dynamic_cast<FSDirectory *>(archive) != nullptr;
 		insert(node);
+
+		if (_indexValid)
+			indexArchive(node);
 	} else {
 		if (autoFree)
 			delete archive;
@@ -431,6 +507,8 @@ void SearchSet::addSubDirectoriesMatching(const FSNode &directory, String origPa
 void SearchSet::remove(const String &name) {
 	ArchiveNodeList::iterator it = find(name);
 	if (it != _list.end()) {
+		if (_indexValid)
+			unindexArchive(it->_arc);
 		if (it->_autoFree)
 			delete it->_arc;
 		_list.erase(it);
@@ -457,6 +535,7 @@ void SearchSet::clear() {
 	}
 
 	_list.clear();
+	invalidateIndex();
 }
 
 void SearchSet::setPriority(const String &name, int priority) {
@@ -473,12 +552,28 @@ void SearchSet::setPriority(const String &name, int priority) {
 	_list.erase(it);
 	node._priority = priority;
 	insert(node);
+	invalidateIndex();
 }
 
 bool SearchSet::hasFile(const Path &path) const {
 	if (path.empty())
 		return false;
 
+	if (_useIndex) {
+		const IndexEntry *entry = lookupIndex(path);
+		for (const auto &archive : _list) {
+			if (skippedByIndex(archive, entry))
+				continue;
+			if (archive._arc->hasFile(path))
+				return true;
+			if (archive._indexed)
+				break; // The file is gone since the archive was indexed
+		}
+
+		if (!entry)
+			return false;
+	}
+
 	for (const auto &archive : _list) {
 		if (archive._arc->hasFile(path))
 			return true;
@@ -559,6 +654,25 @@ const ArchiveMemberPtr SearchSet::getMember(const Path &path, Archive **containe
 	if (path.empty())
 		return ArchiveMemberPtr();
 
+	if (_useIndex) {
+		const IndexEntry *entry = lookupIndex(path);
+		for (const auto &archive : _list) {
+			if (skippedByIndex(archive, entry))
+				continue;
+			if (archive._arc->hasFile(path)) {
+				if (container) {
+					*container = archive._arc;
+				}
+				return archive._arc->getMember(path);
+			}
+			if (archive._indexed)
+				break; // The file is gone since the archive was indexed
+		}
+
+		if (!entry)
+			return ArchiveMemberPtr();
+	}
+
 	for (const auto &archive : _list) {
 		if (archive._arc->hasFile(path)) {
 			if (container) {
@@ -579,6 +693,22 @@ SeekableReadStream *SearchSet::createReadStreamForMember(const Path &path) const
 	if (path.empty())
 		return nullptr;
 
+	if (_useIndex) {
+		const IndexEntry *entry = lookupIndex(path);
+		for (const auto &archive : _list) {
+			if (skippedByIndex(archive, entry))
+				continue;
+			SeekableReadStream *stream = archive._arc->createReadStreamForMember(path);
+			if (stream)
+				return stream;
+			if (archive._indexed)
+				break; // Let the other archives with the file have a go
+		}
+
+		if (!entry)
+			return nullptr;
+	}
+
 	for (const auto &archive : _list) {
 		SeekableReadStream *stream = archive._arc->createReadStreamForMember(path);
 		if (stream)
@@ -592,6 +722,22 @@ SeekableReadStream *SearchSet::createReadStreamForMemberAltStream(const Path &pa
 	if (path.empty())
 		return nullptr;
 
+	if (_useIndex) {
+		const IndexEntry *entry = lookupIndex(path);
+		for (const auto &archive : _list) {
+			if (skippedByIndex(archive, entry))
+				continue;
+			SeekableReadStream *stream = archive._arc->createReadStreamForMemberAltStream(path, altStreamType);
+			if (stream)
+				return stream;
+			if (archive._indexed)
+				break; // Let the other archives with the file have a go
+		}
+
+		if (!entry)
+			return nullptr;
+	}
+
 	for (const auto &archive : _list) {
 		SeekableReadStream *stream = archive._arc->createReadStreamForMemberAltStream(path, altStreamType);
 		if (stream)
@@ -621,6 +767,8 @@ SeekableReadStream *SearchSet::createReadStreamForMemberNext(const Path &path, c
 }
 
 SearchManager::SearchManager() {
+	// Engines look up many files which are in none of the directories
+	setIndexEnabled(true);
 	clear(); // Force a reset
 }
 
@@ -333,8 +333,9 @@ class SearchSet : public Archive {
 		String	_name;
 		Archive	*_arc;
 		bool	_autoFree;
+		bool	_indexed; //!< Whether the archive is a directory, whose members are all in the member index.
 		Node(int priority, const String &name, Archive *arc, bool autoFree)
-			: _priority(priority), _name(name), _arc(arc), _autoFree(autoFree) {
+			: _priority(priority), _name(name), _arc(arc), _autoFree(autoFree), _indexed(false) {
 		}
 	};
 	typedef List<Node> ArchiveNodeList;
@@ -347,8 +348,25 @@ class SearchSet : public Archive {
 
 	bool _ignoreClashes;
 
+	struct IndexEntry {
+		Archive	*_arc;
+		int		_priority;
+	};
+	// Keyed like the caches of FSDirectory, so that the index finds all the
+	// files the directories themselves would
+	typedef HashMap<Path, IndexEntry, Path::IgnoreCaseAndMac_Hash, Path::IgnoreCaseAndMac_EqualTo> MemberIndex;
+
+	bool _useIndex;
+	mutable bool _indexValid;
+	mutable MemberIndex _index;
+
+	void indexArchive(const Node &node) const; //!< Add the members of an archive to the index, unless an archive with a higher priority already provides them.
+	void unindexArchive(const Archive *arc); //!< Hand the members of an archive about to be removed over to the next archive providing them.
+	const IndexEntry *lookupIndex(const Path &path) const;
+	static bool skippedByIndex(const Node &node, const IndexEntry *entry); //!< Whether a lookup through the index can skip an archive.
+
 public:
-	SearchSet() : _ignoreClashes(false) { }
+	SearchSet() : _ignoreClashes(false), _useIndex(false), _indexValid(false) { }
 	virtual ~SearchSet() { clear(); }
 
 	char getPathSeparator() const override { return '/'; }
@@ -476,6 +494,25 @@ public:
 	 */
 	void setIgnoreClashes(bool ignoreClashes) { _ignoreClashes = ignoreClashes; }
 
+	/**
+	 * Enable or disable the member index. When enabled, hasFile(), getMember()
+	 * and the createReadStreamForMember() variants look the path up in a single
+	 * case-insensitive index of the members of all the directories in the set,
+	 * instead of asking every directory in turn. Other archives are still
+	 * asked in turn, in priority order with the directories.
+	 *
+	 * The index is built on first use and updated when archives are added or
+	 * removed. Directories list their files only once anyway. Files which are
+	 * gone since then are looked up without the index, so the results are
+	 * the same as without it. The index is enabled for SearchMan.
+	 */
+	void setIndexEnabled(bool enabled);
+
+	/**
+	 * Rebuild the member index on the next lookup.
+	 */
+	void invalidateIndex();
+
 	bool getChildren(const Common::Path &path, Common::Array<Common::String> &list, ListMode mode = kListDirectoriesOnly, bool hidden = true) const override;
 };
 
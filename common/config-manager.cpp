@@ -50,6 +50,8 @@ char const *const ConfigManager::kCloudDomain = "cloud";
 #pragma mark -
 
 
+uint32 ConfigManager::_generation = 1;
+
 ConfigManager::ConfigManager() : _activeDomain(nullptr) {
 }
 
@@ -75,6 +77,7 @@ void ConfigManager::copyFrom(ConfigManager &source) {
 	_activeDomainName = source._activeDomainName;
 	_activeDomain = &_gameDomains[_activeDomainName];
 	_filename = source._filename;
+	++_generation;
 }
 
 
@@ -138,6 +141,8 @@ bool ConfigManager::loadFallbackConfigFile(const Path &filename) {
 void ConfigManager::addDomain(const String &domainName, const ConfigManager::Domain &domain) {
 	if (domainName.empty())
 		return;
+
+	++_generation;
 	if (domainName == kApplicationDomain) {
 		_appDomain = domain;
 	} else if (domainName == kKeymapperDomain) {
@@ -716,6 +721,7 @@ void ConfigManager::setActiveDomain(const String &domName) {
 		_activeDomain = &_gameDomains[domName];
 	}
 	_activeDomainName = domName;
+	++_generation;
 }
 
 void ConfigManager::addGameDomain(const String &domName) {
@@ -747,6 +753,7 @@ void ConfigManager::removeGameDomain(const String &domName) {
 		_activeDomain = nullptr;
 	}
 	_gameDomains.erase(domName);
+	++_generation;
 }
 
 void ConfigManager::removeMiscDomain(const String &domName) {
@@ -762,6 +769,7 @@ void ConfigManager::renameGameDomain(const String &oldName, const String &newNam
 		_activeDomainName = newName;
 		_activeDomain = &_gameDomains[newName];
 	}
+	++_generation;
 }
 
 void ConfigManager::renameMiscDomain(const String &oldName, const String &newName) {
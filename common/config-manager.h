@@ -76,14 +76,15 @@ public:
 		 */
 		const String &operator[](const String &key) const { return _entries[key]; }
 
-		void           setVal(const String &key, const String &value) { _entries.setVal(key, value); } /*!< Assign a @p value to a @p key. */
+		void           setVal(const String &key, const String &value) { _entries.setVal(key, value); ++_generation; } /*!< Assign a @p value to a @p key. */
 
-		/** Return the configuration value for the given key.
+		/** Return the configuration value for the given key, to be written to.
 		 *  If no entry exists for the given key in the configuration, it is created.
+		 *  @note This counts as a change of the configuration, since the value can
+		 *  be changed through the returned reference.
 		 */
-		String &getOrCreateVal(const String &key) { return _entries.getOrCreateVal(key); }
-		String        &getVal(const String &key) { return _entries.getVal(key); } /*!< Retrieve the value of a @p key. */
-		const String  &getVal(const String &key) const { return _entries.getVal(key); } /*!< @overload */
+		String &getOrCreateVal(const String &key) { ++_generation; return _entries.getOrCreateVal(key); }
+		const String  &getVal(const String &key) const { return _entries.getVal(key); } /*!< Retrieve the value of a @p key. */
 		 /**
 		  * Retrieve the value of @p key if it exists and leave the referenced variable unchanged if the key does not exist.
 		  * @return True if the key exists, false otherwise.
@@ -92,9 +93,9 @@ public:
 		bool tryGetVal(const String &key, String &out) const { return _entries.tryGetVal(key, out); }
 		const String &getValOrDefault(const String &key) const { return _entries.getValOrDefault(key); }
 
-		void           clear() { _entries.clear(); } /*!< Clear all configuration entries in the domain. */
+		void           clear() { _entries.clear(); ++_generation; } /*!< Clear all configuration entries in the domain. */
 
-		void           erase(const String &key) { _entries.erase(key); } /*!< Remove a key from the domain. */
+		void           erase(const String &key) { _entries.erase(key); ++_generation; } /*!< Remove a key from the domain. */
 
 		void           setDomainComment(const String &comment); /*!< Add a @p comment for this configuration domain. */
 		const String  &getDomainComment() const; /*!< Retrieve the comment of this configuration domain. */
@@ -227,6 +228,16 @@ public:
 	const Path              &getCustomConfigFileName() { return _filename; } /*!< Return the custom config file being used, or an empty string when using the default config file */
 
 	static void              defragment(); /*!< Move the configuration in memory to reduce fragmentation. */
+
+	/**
+	 * Return a number which changes whenever a configuration value may
+	 * have changed, including switching the active domain. Values read
+	 * before can be reused while it stays the same.
+	 *
+	 * @see ConfigValue
+	 */
+	static uint32            getGeneration() { return _generation; }
+
 	void                     copyFrom(ConfigManager &source); /*!< Copy from a ConfigManager instance. */
 	/** @} */
 private:
@@ -259,8 +270,49 @@ private:
 	Domain *		_activeDomain;
 
 	Path			_filename;
+
+	static uint32	_generation;
 };
 
+/**
+ * A configuration value which is only looked up and parsed again after the
+ * configuration changed, so that reading it repeatedly costs a single
+ * comparison. It is looked up like ConfigManager::get() without a domain
+ * name does. Supported types are int, bool, float, String and Path.
+ */
+template<typename T>
+class ConfigValue {
+public:
+	explicit ConfigValue(const String &key) : _key(key), _generation(0), _value() {}
+
+	const String &getKey() const { return _key; }
+
+	/** Get the current value of the key. */
+	T get() const {
+		const uint32 generation = ConfigManager::getGeneration();
+		if (_generation != generation) {
+			_value = read();
+			_generation = generation;
+		}
+		return _value;
+	}
+
+	operator T() const { return get(); }
+
+private:
+	T read() const;
+
+	String _key;
+	mutable uint32 _generation;
+	mutable T _value;
+};
+
+template<> inline int ConfigValue<int>::read() const { return ConfigManager::instance().getInt(_key); }
+template<> inline bool ConfigValue<bool>::read() const { return ConfigManager::instance().getBool(_key); }
+template<> inline float ConfigValue<float>::read() const { return ConfigManager::instance().getFloat(_key); }
+template<> inline String ConfigValue<String>::read() const { return ConfigManager::instance().get(_key); }
+template<> inline Path ConfigValue<Path>::read() const { return ConfigManager::instance().getPath(_key); }
+
 /** @} */
 
 } // End of namespace Common
@@ -252,6 +252,19 @@ public:
 	 */
 	bool isWritable() const;
 
+	/**
+	 * Retrieve the size and the last modification time of the file referred
+	 * by this node, without opening it. The modification time is only
+	 * meaningful when compared to an earlier value for the same node.
+	 *
+	 * @param size              Receives the size of the file in bytes.
+	 * @param modificationTime  Receives the last modification time.
+	 *
+	 * @return True if the values could be retrieved, false if the node is not
+	 *         a file or the backend does not support this.
+	 */
+	bool getFileStats(int64 &size, int64 &modificationTime) const;
+
 	/**
 	 * Create a SeekableReadStream instance corresponding to the file
 	 * referred by this node. This assumes that the node actually refers
@@ -93,6 +93,12 @@ public:
 	int64 size() const { return _size; }
 
 	bool seek(int64 offs, int whence = SEEK_SET);
+
+	/**
+	 * Return the memory buffer the stream reads from, so that data can be
+	 * parsed in place instead of being copied out with read().
+	 */
+	const byte *getData() const { return _ptr - _pos; }
 };
 
 
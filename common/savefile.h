@@ -276,6 +276,52 @@ public:
 	 * @return true if the file exists. false otherwise.
 	 */
 	virtual bool exists(const String &name) = 0;
+
+	/**
+	 * Get a number that changes whenever the given save file is written or
+	 * removed, or when the list of save files is refreshed. Backends which
+	 * can retrieve the size and modification time of the file also change
+	 * it when these do. This allows callers to cache data read from save
+	 * files, such as their metadata.
+	 *
+	 * @param name Name of the save file.
+	 *
+	 * @return The revision of the file, or 0 if changes are not tracked,
+	 *         in which case nothing read from the file should be cached.
+	 */
+	virtual uint32 getSavefileRevision(const String &name) { return 0; }
+
+	/**
+	 * Open the data which was stored for the given save file with
+	 * storeSavefileMetaData(), as long as the save file did not change since.
+	 * The data is kept on disk, so that it can be used instead of reading
+	 * the save file in later sessions as well.
+	 *
+	 * @param index Name of the index the data is kept in, such as the
+	 *              target the save file belongs to.
+	 * @param name  Name of the save file.
+	 *
+	 * @return The stored data, or nullptr if there is none or the save file
+	 *         changed since it was stored.
+	 */
+	virtual SeekableReadStream *openSavefileMetaData(const String &index, const String &name) { return nullptr; }
+
+	/**
+	 * Store data read from the given save file, such as its metadata, in
+	 * the given index. The data is written to disk by flushSavefileMetaData().
+	 *
+	 * @param index Name of the index to keep the data in.
+	 * @param name  Name of the save file.
+	 * @param data  The data to store.
+	 * @param size  Size of the data in bytes.
+	 */
+	virtual void storeSavefileMetaData(const String &index, const String &name, const byte *data, uint32 size) {}
+
+	/**
+	 * Write the data stored with storeSavefileMetaData() to disk. This also
+	 * drops the data of save files which do not exist anymore.
+	 */
+	virtual void flushSavefileMetaData() {}
 };
 
 /** @} */
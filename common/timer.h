@@ -23,6 +23,7 @@
 #define COMMON_TIMER_H
 
 #include "common/scummsys.h"
+#include "common/array.h"
 #include "common/str.h"
 #include "common/noncopyable.h"
 
@@ -69,6 +70,28 @@ public:
 	 * of this callback will be running anymore.
 	 */
 	virtual void removeTimerProc(TimerProc proc) = 0;
+
+	/**
+	 * Statistics gathered for an installed timer, since it was installed.
+	 */
+	struct TimerStats {
+		String id;                /*!< ID the timer was installed with. */
+		int32 interval;           /*!< Interval of the timer (in microseconds). */
+		uint32 fireCount;         /*!< Number of times the callback was invoked. */
+		uint32 lateCount;         /*!< Number of invocations happening a full interval or more after their time. */
+		uint32 maxLateness;       /*!< Largest delay of an invocation (in microseconds). */
+		uint32 totalCallbackTime; /*!< Time spent in the callback (in milliseconds). */
+		uint32 maxCallbackTime;   /*!< Longest invocation of the callback (in milliseconds). */
+	};
+
+	typedef Array<TimerStats> TimerStatsList;
+
+	/**
+	 * Return the statistics of all installed timers.
+	 *
+	 * The list is empty if the timer manager does not keep track of them.
+	 */
+	virtual TimerStatsList getTimerStats() { return TimerStatsList(); }
 };
 
 /** @} */
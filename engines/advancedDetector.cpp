@@ -21,6 +21,7 @@
 
 #define FORBIDDEN_SYMBOL_EXCEPTION_printf
 
+#include "common/algorithm.h"
 #include "common/debug.h"
 #include "common/util.h"
 #include "common/file.h"
@@ -28,6 +29,7 @@
 #include "common/md5.h"
 #include "common/config-manager.h"
 #include "common/punycode.h"
+#include "common/ptr.h"
 #include "common/system.h"
 #include "common/textconsole.h"
 #include "common/tokenizer.h"
@@ -253,8 +255,6 @@ bool AdvancedMetaEngineDetectionBase::cleanupPirated(ADDetectedGames &matched) c
 }
 
 DetectedGames AdvancedMetaEngineDetectionBase::detectGames(const Common::FSList &fslist, uint32 skipADFlags, bool skipIncomplete) {
-	FileMap allFiles;
-
 	if (fslist.empty())
 		return DetectedGames();
 
@@ -262,8 +262,20 @@ DetectedGames AdvancedMetaEngineDetectionBase::detectGames(const Common::FSList
 	// the _directoryGlobsMap
 	preprocessDescriptions();
 
-	// Compose a hashmap of all files in fslist.
-	composeFileHashMap(allFiles, fslist, (_maxScanDepth == 0 ? 1 : _maxScanDepth));
+	// Compose a hashmap of all files in fslist, unless an engine scanning
+	// the same way already did during this detection run
+	const Common::String fileMapKey = getFileMapKey();
+	const FileMap *sharedFiles = ADCacheMan.getFileMap(fslist, fileMapKey);
+	FileMap ownFiles;
+	if (!sharedFiles) {
+		FileMap *files = ADCacheMan.addFileMap(fslist, fileMapKey);
+		if (!files)
+			files = &ownFiles;
+
+		composeFileHashMap(*files, fslist, (_maxScanDepth == 0 ? 1 : _maxScanDepth));
+		sharedFiles = files;
+	}
+	const FileMap &allFiles = *sharedFiles;
 
 	// Run the detector on this
 	ADDetectedGames matches = detectGame(fslist.begin()->getParent(), allFiles, Common::UNK_LANG, Common::kPlatformUnknown, "", skipADFlags, skipIncomplete);
@@ -413,8 +425,10 @@ Common::Error AdvancedMetaEngineDetectionBase::identifyGame(DetectedGame &game,
 		}
 	}
 
-	// Detection is done, no need to keep archives in memory anymore
+	// Detection is done, no need to keep archives and listings in memory anymore
 	ADCacheMan.clearArchives();
+	ADCacheMan.clearDirectories();
+	ADCacheMan.flushPersistentCache();
 
 	if (!agdDesc.desc)
 		return Common::kNoGameDataFoundError;
@@ -434,6 +448,28 @@ Common::Error AdvancedMetaEngineDetectionBase::identifyGame(DetectedGame &game,
 	return Common::kNoError;
 }
 
+Common::String AdvancedMetaEngineDetectionBase::getFileMapKey() const {
+	const uint32 depth = (_maxScanDepth == 0 ? 1 : _maxScanDepth);
+	Common::String key = Common::String::format("%u:%d", depth, (_flags & kADFlagMatchFullPaths) ? 1 : 0);
+
+	// Subdirectories are only scanned below the top level
+	if (depth > 1) {
+		Common::StringArray globs;
+		for (const auto &glob : _globsMap) {
+			globs.push_back(glob._key);
+			globs.back().toLowercase();
+		}
+		Common::sort(globs.begin(), globs.end());
+
+		for (const auto &glob : globs) {
+			key += ':';
+			key += glob;
+		}
+	}
+
+	return key;
+}
+
 void AdvancedMetaEngineDetectionBase::composeFileHashMap(FileMap &allFiles, const Common::FSList &fslist, int depth, const Common::Path &parentName) const {
 	if (depth <= 0)
 		return;
@@ -442,18 +478,19 @@ void AdvancedMetaEngineDetectionBase::composeFileHashMap(FileMap &allFiles, cons
 		return;
 
 	for (const auto &file : fslist) {
-		Common::String efname = Common::punycode_encodefilename(file.getName());
+		Common::String efname = ADCacheMan.getEncodedFileName(file.getName());
 		Common::Path tstr = (_flags & kADFlagMatchFullPaths) ? parentName.appendComponent(efname) : Common::Path(efname, Common::Path::kNoSeparator);
 
 		if (file.isDirectory()) {
 			if (!_globsMap.contains(efname))
 				continue;
 
-			Common::FSList files;
-			if (!file.getChildren(files, Common::FSNode::kListAll))
+			// Listings are shared between all engines of a detection run
+			const Common::FSList *files = ADCacheMan.getDirectoryChildren(file);
+			if (!files)
 				continue;
 
-			composeFileHashMap(allFiles, files, depth - 1, tstr);
+			composeFileHashMap(allFiles, *files, depth - 1, tstr);
 			continue;
 		}
 
@@ -476,6 +513,55 @@ namespace Common {
 	DECLARE_SINGLETON(AdvancedDetectorCacheManager);
 }
 
+const Common::String &AdvancedDetectorCacheManager::getEncodedFileName(const Common::String &name) {
+	EncodedNameHashMap::iterator i = encodedNameHashMap.find(name);
+	if (i != encodedNameHashMap.end())
+		return i->_value;
+
+	return encodedNameHashMap[name] = Common::punycode_encodefilename(name);
+}
+
+const AdvancedDetectorCacheManager::FileMap *AdvancedDetectorCacheManager::getFileMap(const Common::FSList &fslist, const Common::String &key) const {
+	if (&fslist != fileMapList)
+		return nullptr;
+
+	return fileMapHashMap.getValOrDefault(key, nullptr);
+}
+
+AdvancedDetectorCacheManager::FileMap *AdvancedDetectorCacheManager::addFileMap(const Common::FSList &fslist, const Common::String &key) {
+	if (!fileMapSharing)
+		return nullptr;
+
+	// The maps of another list are of no use anymore
+	if (&fslist != fileMapList) {
+		clearFileMaps();
+		fileMapList = &fslist;
+	}
+
+	FileMap *&fileMap = fileMapHashMap[key];
+	if (!fileMap)
+		fileMap = new FileMap();
+	return fileMap;
+}
+
+const Common::FSList *AdvancedDetectorCacheManager::getDirectoryChildren(const Common::FSNode &node) {
+	const Common::Path path = node.getPath();
+
+	DirectoryHashMap::iterator i = directoryHashMap.find(path);
+	if (i != directoryHashMap.end())
+		return i->_value;
+
+	Common::FSList *files = new Common::FSList();
+	if (!node.getChildren(*files, Common::FSNode::kListAll)) {
+		delete files;
+		files = nullptr;
+	}
+
+	// Failures are remembered as well
+	directoryHashMap[path] = files;
+	return files;
+}
+
 
 static MD5Properties gameFileToMD5Props(const ADGameFileDescription *fileEntry, uint32 gameFlags) {
 	MD5Properties ret = kMD5Head;
@@ -536,6 +622,46 @@ Common::String md5PropToGameFile(MD5Properties flags) {
 
 static bool getFilePropertiesIntern(uint md5Bytes, const AdvancedMetaEngineBase::FileMap &allFiles, MD5Properties md5prop, const Common::Path &fname, FileProperties &fileProps);
 
+/**
+ * Compose the key of a file in the persistent MD5 cache, and get the size and
+ * modification time the cached entry gets validated against. Only plain files
+ * and archive members are cached: Mac forks may be read from companion files,
+ * and changes to those would go unnoticed.
+ */
+static bool getPersistentCacheKey(const AdvancedMetaEngineBase::FileMap &allFiles, MD5Properties md5prop, const Common::Path &fname, uint md5Bytes,
+								  Common::String &key, int64 &fileSize, int64 &modificationTime) {
+	if (md5prop & (kMD5MacResFork | kMD5MacDataFork))
+		return false;
+
+	Common::Path nodeName = fname;
+	Common::String member;
+
+	if (md5prop & kMD5Archive) {
+		Common::StringTokenizer tok(fname.toString(), ":");
+		member = tok.nextToken();
+		nodeName = Common::Path(tok.nextToken());
+		member += ':';
+		member += tok.nextToken();
+	}
+
+	if (!allFiles.contains(nodeName))
+		return false;
+
+	const Common::FSNode &node = allFiles[nodeName];
+	if (!node.getFileStats(fileSize, modificationTime))
+		return false;
+
+	key = md5PropToCachePrefix(md5prop);
+	key += ':';
+	key += node.getPath().toString(Common::Path::kNativeSeparator);
+	if (!member.empty()) {
+		key += ':';
+		key += member;
+	}
+	key += Common::String::format(":%u", md5Bytes);
+	return true;
+}
+
 bool AdvancedMetaEngineDetectionBase::getFileProperties(const FileMap &allFiles, MD5Properties md5prop, const Common::Path &fname, FileProperties &fileProps) const {
 	Common::String hashname = md5PropToCachePrefix(md5prop);
 		hashname += ':';
@@ -549,11 +675,25 @@ bool AdvancedMetaEngineDetectionBase::getFileProperties(const FileMap &allFiles,
 		return true;
 	}
 
+	Common::String persistentKey;
+	int64 fileSize = 0, modificationTime = 0;
+	const bool persistent = getPersistentCacheKey(allFiles, md5prop, fname, _md5Bytes, persistentKey, fileSize, modificationTime);
+
+	if (persistent && ADCacheMan.getPersistentMD5(persistentKey, fileSize, modificationTime, fileProps.md5, fileProps.size)) {
+		fileProps.md5prop = (MD5Properties)(md5prop & kMD5Tail);
+		ADCacheMan.setMD5(hashname, fileProps.md5);
+		ADCacheMan.setSize(hashname, fileProps.size);
+		return true;
+	}
+
 	bool res = getFilePropertiesIntern(_md5Bytes, allFiles, md5prop, fname, fileProps);
 
 	if (res) {
 		ADCacheMan.setMD5(hashname, fileProps.md5);
 		ADCacheMan.setSize(hashname, fileProps.size);
+
+		if (persistent)
+			ADCacheMan.setPersistentMD5(persistentKey, fileSize, modificationTime, fileProps.md5, fileProps.size);
 	}
 
 	return res;
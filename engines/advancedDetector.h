@@ -22,6 +22,7 @@
 #ifndef ENGINES_ADVANCED_DETECTOR_H
 #define ENGINES_ADVANCED_DETECTOR_H
 
+#include "engines/advancedDetectorCache.h"
 #include "engines/metaengine.h"
 #include "engines/engine.h"
 
@@ -595,6 +596,12 @@ protected:
 	 */
 	void composeFileHashMap(FileMap &allFiles, const Common::FSList &fslist, int depth, const Common::Path &parentName = Common::Path()) const;
 
+	/**
+	 * Return a key telling how composeFileHashMap() composes the file map:
+	 * engines with the same key get the same map out of the same file list.
+	 */
+	Common::String getFileMapKey() const;
+
 	/** Get the properties (size and MD5) of this file. */
 	bool getFileProperties(const FileMap &allFiles, MD5Properties md5prop, const Common::Path &fname, FileProperties &fileProps) const;
 
@@ -761,6 +768,21 @@ public:
 		return (md5HashMap.contains(fname) && sizeHashMap.contains(fname));
 	}
 
+	/** See ADPersistentCache::getMD5(). */
+	bool getPersistentMD5(const Common::String &key, int64 fileSize, int64 modificationTime, Common::String &md5, int64 &size) {
+		return persistentCache.getMD5(key, fileSize, modificationTime, md5, size);
+	}
+
+	/** See ADPersistentCache::setMD5(). */
+	void setPersistentMD5(const Common::String &key, int64 fileSize, int64 modificationTime, const Common::String &md5, int64 size) {
+		persistentCache.setMD5(key, fileSize, modificationTime, md5, size);
+	}
+
+	/** See ADPersistentCache::flush(). */
+	void flushPersistentCache(bool force = false) {
+		persistentCache.flush(force);
+	}
+
 	void addArchive(const Common::FSNode &node, Common::Archive *archivePtr) {
 		if (!archivePtr)
 			return;
@@ -778,7 +800,48 @@ public:
 		return archiveHashMap.getValOrDefault(node.getPath(), nullptr);
 	}
 
-	AdvancedDetectorCacheManager() {
+	/**
+	 * Return the punycode-encoded form of a file name. The result is kept
+	 * until the next clear(), so that engines running detection on the same
+	 * set of files do not encode every name again.
+	 */
+	const Common::String &getEncodedFileName(const Common::String &name);
+
+	/**
+	 * Return the contents of a directory, or nullptr if it cannot be listed.
+	 * Listings are kept until the next clear() or clearDirectories(), so that
+	 * every engine scanning the same subdirectory shares a single listing.
+	 */
+	const Common::FSList *getDirectoryChildren(const Common::FSNode &node);
+
+	/** Same as AdvancedMetaEngineDetectionBase::FileMap. */
+	typedef Common::HashMap<Common::Path, Common::FSNode, Common::Path::IgnoreCase_Hash, Common::Path::IgnoreCase_EqualTo> FileMap;
+
+	/**
+	 * Return the file map composed out of @p fslist for the engines with
+	 * the given key, see AdvancedMetaEngineDetectionBase::getFileMapKey(),
+	 * or nullptr if it hasn't been composed yet.
+	 */
+	const FileMap *getFileMap(const Common::FSList &fslist, const Common::String &key) const;
+
+	/**
+	 * Return a new file map, to be composed out of @p fslist for the engines
+	 * with the given key and shared with them, or nullptr if file maps aren't
+	 * shared.
+	 */
+	FileMap *addFileMap(const Common::FSList &fslist, const Common::String &key);
+
+	/**
+	 * Enable or disable sharing file maps between engines. File lists are
+	 * told apart by their address, so maps are only shared while detection
+	 * runs over a single list, and they are dropped when sharing is disabled.
+	 */
+	void setFileMapSharing(bool enable) {
+		fileMapSharing = enable;
+		clearFileMaps();
+	}
+
+	AdvancedDetectorCacheManager() : fileMapList(nullptr), fileMapSharing(false) {
 		clear();
 	}
 
@@ -789,10 +852,28 @@ public:
 		archiveHashMap.clear(true);
 	}
 
+	void clearDirectories() {
+		for (auto &entry : directoryHashMap) {
+			delete entry._value;
+		}
+		directoryHashMap.clear(true);
+		encodedNameHashMap.clear(true);
+		clearFileMaps();
+	}
+
+	void clearFileMaps() {
+		for (auto &entry : fileMapHashMap) {
+			delete entry._value;
+		}
+		fileMapHashMap.clear(true);
+		fileMapList = nullptr;
+	}
+
 	void clear() {
 		md5HashMap.clear(true);
 		sizeHashMap.clear(true);
 		clearArchives();
+		clearDirectories();
 	}
 
 private:
@@ -804,6 +885,18 @@ private:
 	FileHashMap md5HashMap;
 	SizeHashMap sizeHashMap;
 	ArchiveHashMap archiveHashMap;
+
+	typedef Common::HashMap<Common::Path, Common::FSList *, Common::Path::Hash, Common::Path::EqualTo> DirectoryHashMap;
+	typedef Common::HashMap<Common::String, Common::String> EncodedNameHashMap;
+	DirectoryHashMap directoryHashMap;
+	EncodedNameHashMap encodedNameHashMap;
+
+	typedef Common::HashMap<Common::String, FileMap *> FileMapHashMap;
+	FileMapHashMap fileMapHashMap;
+	const Common::FSList *fileMapList;
+	bool fileMapSharing;
+
+	ADPersistentCache persistentCache;
 };
 
 /** Convenience shortcut for accessing the MD5CacheManager. */
@@ -0,0 +1,221 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "common/algorithm.h"
+#include "common/config-manager.h"
+#include "common/debug.h"
+#include "common/fs.h"
+#include "common/ptr.h"
+#include "common/str-array.h"
+#include "common/stream.h"
+#include "common/system.h"
+#include "common/textconsole.h"
+
+#include "engines/advancedDetectorCache.h"
+
+enum {
+	/** Minimum time between two unforced writes of the persistent MD5 cache, in milliseconds */
+	kFlushInterval = 30000,
+	/** Maximum number of entries kept in the persistent MD5 cache */
+	kMaxEntries = 20000
+};
+
+static const char *const kHeader = "# ScummVM detection cache v2";
+
+ADPersistentCache::ADPersistentCache() : _generation(0), _loaded(false), _dirty(false), _flushTime(0), _hits(0), _misses(0) {
+}
+
+Common::Path ADPersistentCache::getPath() const {
+	if (!_path.empty())
+		return _path;
+
+	Common::Path configFile = ConfMan.getCustomConfigFileName();
+	if (configFile.empty())
+		configFile = g_system->getDefaultConfigFileName();
+
+	return configFile.getParent().appendComponent("detection-cache.txt");
+}
+
+void ADPersistentCache::setPath(const Common::Path &path) {
+	_path = path;
+	_entries.clear();
+	_generation = 0;
+	_loaded = false;
+	_dirty = false;
+	_flushTime = 0;
+}
+
+bool ADPersistentCache::isEnabled() const {
+	return !ConfMan.hasKey("detection_cache") || ConfMan.getBool("detection_cache");
+}
+
+void ADPersistentCache::load() {
+	_loaded = true;
+	_generation = 1;
+
+	Common::FSNode node(getPath());
+	if (!node.exists())
+		return;
+
+	Common::ScopedPtr<Common::SeekableReadStream> stream(node.createReadStream());
+	if (!stream)
+		return;
+
+	if (stream->readLine() != kHeader) {
+		debugC(2, kDebugGlobalDetection, "Ignoring detection cache '%s' with unknown format", node.getPath().toString(Common::Path::kNativeSeparator).c_str());
+		return;
+	}
+
+	while (!stream->eos() && !stream->err()) {
+		Common::String line = stream->readLine();
+
+		// Each line holds the file size, modification time, size and MD5
+		// of the hashed data, and the generation of the cache the entry
+		// was last used in, followed by the key
+		long long fileSize, modificationTime, size;
+		unsigned int lastUsed;
+		char md5[33];
+		int keyPos = -1;
+		if (sscanf(line.c_str(), "%lld\t%lld\t%lld\t%u\t%32s\t%n", &fileSize, &modificationTime, &size, &lastUsed, md5, &keyPos) != 5 || keyPos <= 0 || (uint)keyPos >= line.size())
+			continue;
+
+		Entry &entry = _entries[line.c_str() + keyPos];
+		entry.fileSize = fileSize;
+		entry.modificationTime = modificationTime;
+		entry.size = size;
+		entry.lastUsed = lastUsed;
+		entry.md5 = md5;
+
+		// Entries used in this session are marked with a new generation
+		_generation = MAX<uint32>(_generation, lastUsed + 1);
+	}
+
+	debugC(2, kDebugGlobalDetection, "Loaded %u entries from detection cache '%s'", _entries.size(), node.getPath().toString(Common::Path::kNativeSeparator).c_str());
+}
+
+bool ADPersistentCache::getMD5(const Common::String &key, int64 fileSize, int64 modificationTime, Common::String &md5, int64 &size) {
+	if (!isEnabled())
+		return false;
+
+	if (!_loaded)
+		load();
+
+	EntryHashMap::iterator i = _entries.find(key);
+	if (i == _entries.end() || i->_value.fileSize != fileSize || i->_value.modificationTime != modificationTime) {
+		_misses++;
+		return false;
+	}
+
+	// Hits alone do not cause a write, the new generation is stored along
+	// with the next change to the cache
+	i->_value.lastUsed = _generation;
+
+	md5 = i->_value.md5;
+	size = i->_value.size;
+	_hits++;
+	return true;
+}
+
+void ADPersistentCache::setMD5(const Common::String &key, int64 fileSize, int64 modificationTime, const Common::String &md5, int64 size) {
+	if (!isEnabled())
+		return;
+
+	if (!_loaded)
+		load();
+
+	Entry &entry = _entries[key];
+	entry.fileSize = fileSize;
+	entry.modificationTime = modificationTime;
+	entry.size = size;
+	entry.lastUsed = _generation;
+	entry.md5 = md5;
+	_dirty = true;
+}
+
+void ADPersistentCache::prune() {
+	if (_entries.size() <= kMaxEntries)
+		return;
+
+	// Entries of files which were moved or deleted are not used anymore,
+	// so they are the first ones to go
+	Common::Array<uint32> generations;
+	generations.reserve(_entries.size());
+	for (const auto &entry : _entries)
+		generations.push_back(entry._value.lastUsed);
+	Common::sort(generations.begin(), generations.end());
+
+	uint toRemove = _entries.size() - kMaxEntries;
+	const uint32 oldestKept = generations[toRemove];
+
+	Common::StringArray keys;
+	for (const auto &entry : _entries) {
+		if (entry._value.lastUsed < oldestKept)
+			keys.push_back(entry._key);
+	}
+	for (const auto &entry : _entries) {
+		if (keys.size() >= toRemove)
+			break;
+		if (entry._value.lastUsed == oldestKept)
+			keys.push_back(entry._key);
+	}
+
+	for (const auto &key : keys)
+		_entries.erase(key);
+
+	debugC(2, kDebugGlobalDetection, "Dropped %u entries from detection cache", keys.size());
+}
+
+void ADPersistentCache::flush(bool force) {
+	if (_hits || _misses) {
+		debugC(2, kDebugGlobalDetection, "Detection cache: %u hits, %u misses", _hits, _misses);
+		_hits = _misses = 0;
+	}
+
+	if (!_dirty)
+		return;
+
+	const uint32 now = g_system->getMillis();
+	if (!force && _flushTime != 0 && now - _flushTime < kFlushInterval)
+		return;
+	_flushTime = MAX<uint32>(now, 1);
+
+	prune();
+
+	// The new file replaces the old one only once it is complete
+	Common::FSNode node(getPath());
+	Common::ScopedPtr<Common::SeekableWriteStream> stream(node.createWriteStream(true));
+	if (!stream) {
+		warning("Unable to write detection cache '%s'", node.getPath().toString(Common::Path::kNativeSeparator).c_str());
+		return;
+	}
+
+	stream->writeString(kHeader);
+	stream->writeByte('\n');
+
+	for (const auto &entry : _entries) {
+		stream->writeString(Common::String::format("%lld\t%lld\t%lld\t%u\t%s\t%s\n",
+			(long long)entry._value.fileSize, (long long)entry._value.modificationTime, (long long)entry._value.size,
+			entry._value.lastUsed, entry._value.md5.c_str(), entry._key.c_str()));
+	}
+
+	stream->finalize();
+	_dirty = stream->err();
+}
@@ -0,0 +1,102 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+#ifndef ENGINES_ADVANCED_DETECTOR_CACHE_H
+#define ENGINES_ADVANCED_DETECTOR_CACHE_H
+
+#include "common/hashmap.h"
+#include "common/hash-str.h"
+#include "common/path.h"
+#include "common/str.h"
+
+/**
+ * @addtogroup engines_advdetector
+ * @{
+ */
+
+/**
+ * Cache of the MD5s computed during detection, which is stored in the
+ * configuration directory and survives between runs.
+ *
+ * Entries are validated against the size and modification time the file
+ * had when they were stored. Once the cache holds more than a fixed number
+ * of entries, the ones used least recently are dropped, so entries of files
+ * which were moved or deleted do not pile up.
+ */
+class ADPersistentCache {
+public:
+	ADPersistentCache();
+
+	/**
+	 * Look up a file in the cache. An entry is only returned if the file
+	 * still has the size and modification time it had when the entry was
+	 * stored.
+	 */
+	bool getMD5(const Common::String &key, int64 fileSize, int64 modificationTime, Common::String &md5, int64 &size);
+
+	/** Store a computed MD5 in the cache. */
+	void setMD5(const Common::String &key, int64 fileSize, int64 modificationTime, const Common::String &md5, int64 size);
+
+	/**
+	 * Write the cache to disk if it has been modified, and report the
+	 * hit/miss counters on the detection debug channel. Unless @p force is
+	 * set, writes are rate-limited, so that this can be called after every
+	 * directory of a mass-add.
+	 */
+	void flush(bool force = false);
+
+	/**
+	 * Use the given file instead of detection-cache.txt in the configuration
+	 * directory, or go back to it if @p path is empty. Any entries loaded so
+	 * far are dropped without being written, and the file is loaded again on
+	 * the next lookup.
+	 */
+	void setPath(const Common::Path &path);
+
+private:
+	struct Entry {
+		int64 fileSize;
+		int64 modificationTime;
+		int64 size;
+		uint32 lastUsed; ///< Generation of the cache the entry was last looked up or stored in
+		Common::String md5;
+	};
+
+	typedef Common::HashMap<Common::String, Entry> EntryHashMap;
+	EntryHashMap _entries;
+	Common::Path _path;
+	uint32 _generation;
+	bool _loaded;
+	bool _dirty;
+	uint32 _flushTime;
+	uint _hits;
+	uint _misses;
+
+	Common::Path getPath() const;
+	bool isEnabled() const;
+	void load();
+	void prune();
+};
+
+/** @} */
+
+#endif
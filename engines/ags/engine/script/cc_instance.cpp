@@ -166,6 +166,16 @@ void script_commands_free() {
 	delete g_commands;
 }
 
+// Internal instruction codes, only produced when decoding the byte-code
+// ahead of running it; some of these stand for a pair of instructions.
+enum ScriptDecodedCommand {
+	kScCmdIntToReg = CC_NUM_SCCMDS, // LITTOREG without a fixup
+	kScCmdValueMemRead,             // LITTOREG MAR, <fixed-up value> + MEMREAD
+	kScCmdValueMemWrite,            // LITTOREG MAR, <fixed-up value> + MEMWRITE
+	kScCmdStackMemRead,             // LOADSPOFFS + MEMREAD
+	kScCmdStackMemWrite             // LOADSPOFFS + MEMWRITE
+};
+
 const char *regnames[] = { "null", "sp", "mar", "ax", "bx", "cx", "op", "dx" };
 const char *fixupnames[] = { "null", "fix_gldata", "fix_func", "fix_string", "fix_import", "fix_datadata", "fix_stack" };
 
@@ -253,6 +263,8 @@ ccInstance::ccInstance() {
 	numimports = 0;
 	resolved_imports = nullptr;
 	code_fixups         = nullptr;
+	decoded_code        = nullptr;
+	decoded_values      = nullptr;
 
 	memset(callStackLineNumber, 0, sizeof(callStackLineNumber));
 	memset(callStackAddr, 0, sizeof(callStackAddr));
@@ -560,7 +572,10 @@ int ccInstance::Run(int32_t curpc) {
 	thisbase[0] = 0;
 	funcstart[0] = pc;
 	ccInstance *codeInst = runningInst;
-	ScriptOperation codeOp;
+	const ScriptDecodedOp *decodedCode = codeInst->decoded_code;
+	const RuntimeScriptValue *decodedValues = codeInst->decoded_values;
+	ScriptDecodedOp runtimeOp; // for the instructions which were not decoded ahead
+	const ScriptDecodedOp *codeOp;
 	FunctionCallStack func_callstack;
 #if DEBUG_CC_EXEC
 	const bool dump_opcodes = (ccGetOption(SCOPT_DEBUGRUN) != 0) ||
@@ -583,33 +598,39 @@ int ccInstance::Run(int32_t curpc) {
 		//
 		/* Read operation */
 		//=====================================================================
-		codeOp.Instruction.Code         = codeInst->code[pc];
-		codeOp.Instruction.InstanceId   = (codeOp.Instruction.Code >> INSTANCE_ID_SHIFT) & INSTANCE_ID_MASK;
-		codeOp.Instruction.Code        &= INSTANCE_ID_REMOVEMASK; // now this is pure instruction code
-
-		CC_ERROR_IF_RETCODE((codeOp.Instruction.Code < 0 || codeOp.Instruction.Code >= CC_NUM_SCCMDS),
-							"invalid instruction %d found in code stream", codeOp.Instruction.Code);
-
-		codeOp.ArgCount = (*g_commands)[codeOp.Instruction.Code].ArgCount;
-
-		CC_ERROR_IF_RETCODE(pc + codeOp.ArgCount >= codeInst->codesize,
-							"unexpected end of code data (%d; %d)", pc + codeOp.ArgCount, codeInst->codesize);
-
-
-		// Read arguments; use switch as it proved to be faster than the loop
-
-		switch (codeOp.ArgCount) {
-		case 3:
-			codeOp.Args[2].SetInt32(static_cast<int32_t>(codeInst->code[pc + 3]));
-			/* fall-through */
-		case 2:
-			codeOp.Args[1].SetInt32(static_cast<int32_t>(codeInst->code[pc + 2]));
-			/* fall-through */
-		case 1:
-			codeOp.Args[0].SetInt32(static_cast<int32_t>(codeInst->code[pc + 1]));
-			break;
-		default:
-			break;
+		codeOp = decodedCode ? &decodedCode[pc] : nullptr;
+		if (!codeOp || codeOp->Code < 0) {
+			int32_t instr = static_cast<int32_t>(codeInst->code[pc]);
+			runtimeOp.InstanceId   = (instr >> INSTANCE_ID_SHIFT) & INSTANCE_ID_MASK;
+			runtimeOp.Code         = instr & INSTANCE_ID_REMOVEMASK; // now this is pure instruction code
+
+			CC_ERROR_IF_RETCODE((runtimeOp.Code < 0 || runtimeOp.Code >= CC_NUM_SCCMDS),
+								"invalid instruction %d found in code stream", runtimeOp.Code);
+
+			runtimeOp.ArgCount = (*g_commands)[runtimeOp.Code].ArgCount;
+			runtimeOp.Length = runtimeOp.ArgCount + 1;
+			runtimeOp.Value = -1;
+
+			CC_ERROR_IF_RETCODE(pc + runtimeOp.ArgCount >= codeInst->codesize,
+								"unexpected end of code data (%d; %d)", pc + runtimeOp.ArgCount, codeInst->codesize);
+
+
+			// Read arguments; use switch as it proved to be faster than the loop
+
+			switch (runtimeOp.ArgCount) {
+			case 3:
+				runtimeOp.Args[2] = static_cast<int32_t>(codeInst->code[pc + 3]);
+				/* fall-through */
+			case 2:
+				runtimeOp.Args[1] = static_cast<int32_t>(codeInst->code[pc + 2]);
+				/* fall-through */
+			case 1:
+				runtimeOp.Args[0] = static_cast<int32_t>(codeInst->code[pc + 1]);
+				break;
+			default:
+				break;
+			}
+			codeOp = &runtimeOp;
 		}
 		//---------------------------------------------------------------------
 		/* End read operation */
@@ -617,22 +638,29 @@ int ccInstance::Run(int32_t curpc) {
 
 #if (DEBUG_CC_EXEC)
 		if (dump_opcodes) {
-			DumpInstruction(codeOp);
+			ScriptOperation dumpOp;
+			dumpOp.Instruction = ScriptInstruction(codeOp->Code, codeOp->InstanceId);
+			dumpOp.ArgCount = codeOp->ArgCount;
+			for (int i = 0; i < codeOp->ArgCount; ++i)
+				dumpOp.Args[i].SetInt32(codeOp->Args[i]);
+			if (codeOp->Value >= 0)
+				dumpOp.Args[1] = decodedValues[codeOp->Value];
+			DumpInstruction(dumpOp);
 		}
 #endif
 
 		/* Perform operation */
 		//=====================================================================
-		switch (codeOp.Instruction.Code) {
+		switch (codeOp->Code) {
 		case SCMD_LINENUM:
-			line_number = codeOp.Arg1i();
+			line_number = codeOp->Arg1i();
 			_G(currentline) = line_number;
 			if (_G(new_line_hook))
 				_G(new_line_hook)(this, _G(currentline));
 			break;
 		case SCMD_ADD: {
-			const auto arg_reg = codeOp.Arg1i();
-			const auto arg_lit = codeOp.Arg2i();
+			const auto arg_reg = codeOp->Arg1i();
+			const auto arg_lit = codeOp->Arg2i();
 			auto &reg1 = registers[arg_reg];
 			// If the register is SREG_SP, we are allocating new variable on the stack
 			if (arg_reg == SREG_SP) {
@@ -656,8 +684,8 @@ int ccInstance::Run(int32_t curpc) {
 			break;
 		}
 		case SCMD_SUB: {
-			const auto arg_reg = codeOp.Arg1i();
-			const auto arg_lit = codeOp.Arg2i();
+			const auto arg_reg = codeOp->Arg1i();
+			const auto arg_lit = codeOp->Arg2i();
 			auto &reg1 = registers[arg_reg];
 			if (reg1.Type == kScValStackPtr) {
 				// If this is SREG_SP, this is stack pop, which frees local variables;
@@ -679,8 +707,8 @@ int ccInstance::Run(int32_t curpc) {
 			break;
 		}
 		case SCMD_REGTOREG: {
-			const auto &reg1 = registers[codeOp.Arg1i()];
-			auto &reg2 = registers[codeOp.Arg2i()];
+			const auto &reg1 = registers[codeOp->Arg1i()];
+			auto &reg2 = registers[codeOp->Arg2i()];
 			reg2 = reg1;
 			break;
 		}
@@ -691,10 +719,15 @@ int ccInstance::Run(int32_t curpc) {
 			// long, or rather int32 due x32 build), written value may normally
 			// be only up to 4 bytes large;
 			// I guess that's an obsolete way to do WRITE, WRITEW and WRITEB
-			const auto arg_size = codeOp.Arg1i();
-			FixupArgument(codeOp.Args[1], codeInst->code_fixups[pc + 2], codeInst->code[pc + 2], this->stack, codeInst->strings);
-			ASSERT_CC_ERROR();
-			const auto &arg_value = codeOp.Arg2();
+			const auto arg_size = codeOp->Arg1i();
+			RuntimeScriptValue arg_value;
+			if (codeOp->Value >= 0) {
+				arg_value = decodedValues[codeOp->Value];
+			} else {
+				arg_value.SetInt32(codeOp->Arg2i());
+				FixupArgument(arg_value, codeInst->code_fixups[pc + 2], codeInst->code[pc + 2], this->stack, codeInst->strings);
+				ASSERT_CC_ERROR();
+			}
 			switch (arg_size) {
 			case sizeof(char):
 				registers[SREG_MAR].WriteByte(arg_value.IValue);
@@ -728,40 +761,74 @@ int ccInstance::Run(int32_t curpc) {
 			continue; // continue so that the PC doesn't get overwritten
 		}
 		case SCMD_LITTOREG: {
-			auto &reg1 = registers[codeOp.Arg1i()];
-			FixupArgument(codeOp.Args[1], codeInst->code_fixups[pc + 2], codeInst->code[pc + 2], this->stack, codeInst->strings);
+			auto &reg1 = registers[codeOp->Arg1i()];
+			if (codeOp->Value >= 0) {
+				reg1 = decodedValues[codeOp->Value];
+			} else {
+				RuntimeScriptValue arg_value;
+				arg_value.SetInt32(codeOp->Arg2i());
+				FixupArgument(arg_value, codeInst->code_fixups[pc + 2], codeInst->code[pc + 2], this->stack, codeInst->strings);
+				ASSERT_CC_ERROR();
+				reg1 = arg_value;
+			}
+			break;
+		}
+		case kScCmdIntToReg:
+			registers[codeOp->Arg1i()].SetInt32(codeOp->Arg2i());
+			break;
+		case kScCmdValueMemRead: {
+			registers[SREG_MAR] = decodedValues[codeOp->Value];
+			auto &reg1 = registers[codeOp->Arg2i()];
+			reg1 = registers[SREG_MAR].ReadValue();
+			break;
+		}
+		case kScCmdValueMemWrite: {
+			registers[SREG_MAR] = decodedValues[codeOp->Value];
+			const auto &reg1 = registers[codeOp->Arg2i()];
+			registers[SREG_MAR].WriteValue(reg1);
+			break;
+		}
+		case kScCmdStackMemRead: {
+			registers[SREG_MAR] = GetStackPtrOffsetRw(codeOp->Arg1i());
 			ASSERT_CC_ERROR();
-			const auto &arg_value = codeOp.Arg2();
-			reg1 = arg_value;
+			auto &reg1 = registers[codeOp->Arg2i()];
+			reg1 = registers[SREG_MAR].ReadValue();
+			break;
+		}
+		case kScCmdStackMemWrite: {
+			registers[SREG_MAR] = GetStackPtrOffsetRw(codeOp->Arg1i());
+			ASSERT_CC_ERROR();
+			const auto &reg1 = registers[codeOp->Arg2i()];
+			registers[SREG_MAR].WriteValue(reg1);
 			break;
 		}
 		case SCMD_MEMREAD: {
 			// Take the data address from reg[MAR] and copy int32_t to reg[arg1]
-			auto &reg1 = registers[codeOp.Arg1i()];
+			auto &reg1 = registers[codeOp->Arg1i()];
 			reg1 = registers[SREG_MAR].ReadValue();
 			break;
 		}
 		case SCMD_MEMWRITE: {
 			// Take the data address from reg[MAR] and copy there int32_t from reg[arg1]
-			const auto &reg1 = registers[codeOp.Arg1i()];
+			const auto &reg1 = registers[codeOp->Arg1i()];
 			registers[SREG_MAR].WriteValue(reg1);
 			break;
 		}
 		case SCMD_LOADSPOFFS: {
-			const auto arg_off = codeOp.Arg1i();
+			const auto arg_off = codeOp->Arg1i();
 			registers[SREG_MAR] = GetStackPtrOffsetRw(arg_off);
 			ASSERT_CC_ERROR();
 			break;
 		}
 		case SCMD_MULREG: {
-			auto &reg1 = registers[codeOp.Arg1i()];
-			const auto &reg2 = registers[codeOp.Arg2i()];
+			auto &reg1 = registers[codeOp->Arg1i()];
+			const auto &reg2 = registers[codeOp->Arg2i()];
 			reg1.SetInt32(reg1.IValue * reg2.IValue);
 			break;
 		}
 		case SCMD_DIVREG: {
-			auto &reg1 = registers[codeOp.Arg1i()];
-			const auto &reg2 = registers[codeOp.Arg2i()];
+			auto &reg1 = registers[codeOp->Arg1i()];
+			const auto &reg2 = registers[codeOp->Arg2i()];
 			if (reg2.IValue == 0) {
 				cc_error("!Integer divide by zero");
 				return -1;
@@ -770,88 +837,88 @@ int ccInstance::Run(int32_t curpc) {
 			break;
 		}
 		case SCMD_ADDREG: {
-			auto &reg1 = registers[codeOp.Arg1i()];
-			const auto &reg2 = registers[codeOp.Arg2i()];
+			auto &reg1 = registers[codeOp->Arg1i()];
+			const auto &reg2 = registers[codeOp->Arg2i()];
 			// This may be pointer arithmetics, in which case IValue stores offset from base pointer
 			reg1.IValue += reg2.IValue;
 			break;
 		}
 		case SCMD_SUBREG: {
-			auto &reg1 = registers[codeOp.Arg1i()];
-			const auto &reg2 = registers[codeOp.Arg2i()];
+			auto &reg1 = registers[codeOp->Arg1i()];
+			const auto &reg2 = registers[codeOp->Arg2i()];
 			// This may be pointer arithmetics, in which case IValue stores offset from base pointer
 			reg1.IValue -= reg2.IValue;
 			break;
 		}
 		case SCMD_BITAND: {
-			auto &reg1 = registers[codeOp.Arg1i()];
-			const auto &reg2 = registers[codeOp.Arg2i()];
+			auto &reg1 = registers[codeOp->Arg1i()];
+			const auto &reg2 = registers[codeOp->Arg2i()];
 			reg1.SetInt32(reg1.IValue & reg2.IValue);
 			break;
 		}
 		case SCMD_BITOR: {
-			auto &reg1 = registers[codeOp.Arg1i()];
-			const auto &reg2 = registers[codeOp.Arg2i()];
+			auto &reg1 = registers[codeOp->Arg1i()];
+			const auto &reg2 = registers[codeOp->Arg2i()];
 			reg1.SetInt32(reg1.IValue | reg2.IValue);
 			break;
 		}
 		case SCMD_ISEQUAL: {
-			auto &reg1 = registers[codeOp.Arg1i()];
-			const auto &reg2 = registers[codeOp.Arg2i()];
+			auto &reg1 = registers[codeOp->Arg1i()];
+			const auto &reg2 = registers[codeOp->Arg2i()];
 			reg1.SetInt32AsBool(reg1 == reg2);
 			break;
 		}
 		case SCMD_NOTEQUAL: {
-			auto &reg1 = registers[codeOp.Arg1i()];
-			const auto &reg2 = registers[codeOp.Arg2i()];
+			auto &reg1 = registers[codeOp->Arg1i()];
+			const auto &reg2 = registers[codeOp->Arg2i()];
 			reg1.SetInt32AsBool(reg1 != reg2);
 			break;
 		}
 		case SCMD_GREATER: {
-			auto &reg1 = registers[codeOp.Arg1i()];
-			const auto &reg2 = registers[codeOp.Arg2i()];
+			auto &reg1 = registers[codeOp->Arg1i()];
+			const auto &reg2 = registers[codeOp->Arg2i()];
 			reg1.SetInt32AsBool(reg1.IValue > reg2.IValue);
 			break;
 		}
 		case SCMD_LESSTHAN: {
-			auto &reg1 = registers[codeOp.Arg1i()];
-			const auto &reg2 = registers[codeOp.Arg2i()];
+			auto &reg1 = registers[codeOp->Arg1i()];
+			const auto &reg2 = registers[codeOp->Arg2i()];
 			reg1.SetInt32AsBool(reg1.IValue < reg2.IValue);
 			break;
 		}
 		case SCMD_GTE: {
-			auto &reg1 = registers[codeOp.Arg1i()];
-			const auto &reg2 = registers[codeOp.Arg2i()];
+			auto &reg1 = registers[codeOp->Arg1i()];
+			const auto &reg2 = registers[codeOp->Arg2i()];
 			reg1.SetInt32AsBool(reg1.IValue >= reg2.IValue);
 			break;
 		}
 		case SCMD_LTE: {
-			auto &reg1 = registers[codeOp.Arg1i()];
-			const auto &reg2 = registers[codeOp.Arg2i()];
+			auto &reg1 = registers[codeOp->Arg1i()];
+			const auto &reg2 = registers[codeOp->Arg2i()];
 			reg1.SetInt32AsBool(reg1.IValue <= reg2.IValue);
 			break;
 		}
 		case SCMD_AND: {
-			auto &reg1 = registers[codeOp.Arg1i()];
-			const auto &reg2 = registers[codeOp.Arg2i()];
+			auto &reg1 = registers[codeOp->Arg1i()];
+			const auto &reg2 = registers[codeOp->Arg2i()];
 			reg1.SetInt32AsBool(reg1.IValue && reg2.IValue);
 			break;
 		}
 		case SCMD_OR: {
-			auto &reg1 = registers[codeOp.Arg1i()];
-			const auto &reg2 = registers[codeOp.Arg2i()];
+			auto &reg1 = registers[codeOp->Arg1i()];
+			const auto &reg2 = registers[codeOp->Arg2i()];
 			reg1.SetInt32AsBool(reg1.IValue || reg2.IValue);
 			break;
 		}
 		case SCMD_XORREG: {
-			auto &reg1 = registers[codeOp.Arg1i()];
-			const auto &reg2 = registers[codeOp.Arg2i()];
+			auto &reg1 = registers[codeOp->Arg1i()];
+			const auto &reg2 = registers[codeOp->Arg2i()];
 			reg1.SetInt32(reg1.IValue ^ reg2.IValue);
 			break;
 		}
 		case SCMD_MODREG: {
-			auto &reg1 = registers[codeOp.Arg1i()];
-			const auto &reg2 = registers[codeOp.Arg2i()];
+			auto &reg1 = registers[codeOp->Arg1i()];
+			const auto &reg2 = registers[codeOp->Arg2i()];
 			if (reg2.IValue == 0) {
 				cc_error("!Integer divide by zero");
 				return -1;
@@ -860,7 +927,7 @@ int ccInstance::Run(int32_t curpc) {
 			break;
 		}
 		case SCMD_NOTREG: {
-			auto &reg1 = registers[codeOp.Arg1i()];
+			auto &reg1 = registers[codeOp->Arg1i()];
 			reg1 = !(reg1);
 			break;
 		}
@@ -875,9 +942,9 @@ int ccInstance::Run(int32_t curpc) {
 			PUSH_CALL_STACK;
 
 			ASSERT_STACK_SPACE_VALS(1);
-			PushValueToStack(RuntimeScriptValue().SetInt32(pc + codeOp.ArgCount + 1));
+			PushValueToStack(RuntimeScriptValue().SetInt32(pc + codeOp->ArgCount + 1));
 
-			const auto &reg1 = registers[codeOp.Arg1i()];
+			const auto &reg1 = registers[codeOp->Arg1i()];
 			if (thisbase[curnest] == 0)
 				pc = reg1.IValue;
 			else {
@@ -897,55 +964,55 @@ int ccInstance::Run(int32_t curpc) {
 		}
 		case SCMD_MEMREADB: {
 			// Take the data address from reg[MAR] and copy byte to reg[arg1]
-			auto &reg1 = registers[codeOp.Arg1i()];
+			auto &reg1 = registers[codeOp->Arg1i()];
 			reg1.SetUInt8(registers[SREG_MAR].ReadByte());
 			break;
 		}
 		case SCMD_MEMREADW: {
 			// Take the data address from reg[MAR] and copy int16_t to reg[arg1]
-			auto &reg1 = registers[codeOp.Arg1i()];
+			auto &reg1 = registers[codeOp->Arg1i()];
 			reg1.SetInt16(registers[SREG_MAR].ReadInt16());
 			break;
 		}
 		case SCMD_MEMWRITEB: {
 			// Take the data address from reg[MAR] and copy there byte from reg[arg1]
-			const auto &reg1 = registers[codeOp.Arg1i()];
+			const auto &reg1 = registers[codeOp->Arg1i()];
 			registers[SREG_MAR].WriteByte(reg1.IValue);
 			break;
 		}
 		case SCMD_MEMWRITEW: {
 			// Take the data address from reg[MAR] and copy there int16_t from reg[arg1]
-			const auto &reg1 = registers[codeOp.Arg1i()];
+			const auto &reg1 = registers[codeOp->Arg1i()];
 			registers[SREG_MAR].WriteInt16(reg1.IValue);
 			break;
 		}
 		case SCMD_JZ: {
-			const auto arg_lit = codeOp.Arg1i();
+			const auto arg_lit = codeOp->Arg1i();
 			if (registers[SREG_AX].IsNull())
 				pc += arg_lit;
 			break;
 		}
 		case SCMD_JNZ: {
-			const auto arg_lit = codeOp.Arg1i();
+			const auto arg_lit = codeOp->Arg1i();
 			if (!registers[SREG_AX].IsNull())
 				pc += arg_lit;
 			break;
 		}
 		case SCMD_PUSHREG: {
 			// Push reg[arg1] value to the stack
-			const auto &reg1 = registers[codeOp.Arg1i()];
+			const auto &reg1 = registers[codeOp->Arg1i()];
 			ASSERT_STACK_SPACE_VALS(1);
 			PushValueToStack(reg1);
 			break;
 		}
 		case SCMD_POPREG: {
-			auto &reg1 = registers[codeOp.Arg1i()];
+			auto &reg1 = registers[codeOp->Arg1i()];
 			ASSERT_STACK_SIZE(1);
 			reg1 = PopValueFromStack();
 			break;
 		}
 		case SCMD_JMP: {
-			const auto arg_lit = codeOp.Arg1i();
+			const auto arg_lit = codeOp->Arg1i();
 			pc += arg_lit;
 
 			// Make sure it's not stuck in a While loop
@@ -970,14 +1037,14 @@ int ccInstance::Run(int32_t curpc) {
 			break;
 		}
 		case SCMD_MUL: {
-			auto &reg1 = registers[codeOp.Arg1i()];
-			const auto arg_lit = codeOp.Arg2i();
+			auto &reg1 = registers[codeOp->Arg1i()];
+			const auto arg_lit = codeOp->Arg2i();
 			reg1.IValue *= arg_lit;
 			break;
 		}
 		case SCMD_CHECKBOUNDS: {
-			const auto &reg1 = registers[codeOp.Arg1i()];
-			const auto arg_lit = codeOp.Arg2i();
+			const auto &reg1 = registers[codeOp->Arg1i()];
+			const auto arg_lit = codeOp->Arg2i();
 			if ((reg1.IValue < 0) ||
 				(reg1.IValue >= arg_lit)) {
 				cc_error("!Array index out of bounds (index: %d, bounds: 0..%d)", reg1.IValue, arg_lit - 1);
@@ -986,7 +1053,7 @@ int ccInstance::Run(int32_t curpc) {
 			break;
 		}
 		case SCMD_DYNAMICBOUNDS: {
-			const auto &reg1 = registers[codeOp.Arg1i()];
+			const auto &reg1 = registers[codeOp->Arg1i()];
 			// TODO: test reg[MAR] type here;
 			// That might be dynamic object, but also a non-managed dynamic array, "allocated"
 			// on global or local memspace (buffer)
@@ -1009,7 +1076,7 @@ int ccInstance::Run(int32_t curpc) {
 			// 64 bit: Handles are always 32 bit values. They are not C pointer.
 
 		case SCMD_MEMREADPTR: {
-			auto &reg1 = registers[codeOp.Arg1i()];
+			auto &reg1 = registers[codeOp->Arg1i()];
 			int32_t handle = registers[SREG_MAR].ReadInt32();
 			// FIXME: make pool return a ready RuntimeScriptValue with these set?
 			// or another struct, which may be assigned to RSV
@@ -1021,7 +1088,7 @@ int ccInstance::Run(int32_t curpc) {
 			break;
 		}
 		case SCMD_MEMWRITEPTR: {
-			const auto &reg1 = registers[codeOp.Arg1i()];
+			const auto &reg1 = registers[codeOp->Arg1i()];
 			int32_t handle = registers[SREG_MAR].ReadInt32();
 			void *address;
 			switch (reg1.Type) {
@@ -1060,7 +1127,7 @@ int ccInstance::Run(int32_t curpc) {
 		}
 		case SCMD_MEMINITPTR: {
 			void *address;
-			const auto &reg1 = registers[codeOp.Arg1i()];
+			const auto &reg1 = registers[codeOp->Arg1i()];
 
 			switch (reg1.Type) {
 			case kScValStaticArray:
@@ -1119,7 +1186,7 @@ int ccInstance::Run(int32_t curpc) {
 			}
 			break;
 		case SCMD_CHECKNULLREG: {
-			const auto &reg1 = registers[codeOp.Arg1i()];
+			const auto &reg1 = registers[codeOp->Arg1i()];
 			if (reg1.IsNull()) {
 				cc_error("!Null string referenced");
 				return -1;
@@ -1127,7 +1194,7 @@ int ccInstance::Run(int32_t curpc) {
 			break;
 		}
 		case SCMD_NUMFUNCARGS: {
-			const auto arg_lit = codeOp.Arg1i();
+			const auto arg_lit = codeOp->Arg1i();
 			num_args_to_func = arg_lit;
 			break;
 		}
@@ -1135,7 +1202,7 @@ int ccInstance::Run(int32_t curpc) {
 			PUSH_CALL_STACK;
 
 			// Call to a function in another script
-			const auto &reg1 = registers[codeOp.Arg1i()];
+			const auto &reg1 = registers[codeOp->Arg1i()];
 
 			// If there are nested CALLAS calls, the stack might
 			// contain 2 calls worth of parameters, so only
@@ -1158,7 +1225,7 @@ int ccInstance::Run(int32_t curpc) {
 			ccInstance *wasRunning = runningInst;
 
 			// extract the instance ID
-			int32_t instId = codeOp.Instruction.InstanceId;
+			int32_t instId = codeOp->InstanceId;
 			// determine the offset into the code of the instance we want
 			runningInst = _G(loadedInstances)[instId];
 			uintptr_t callAddr = reg1.PtrU8 - reinterpret_cast<uint8_t *>(&runningInst->code[0]);
@@ -1186,7 +1253,7 @@ int ccInstance::Run(int32_t curpc) {
 		}
 		case SCMD_CALLEXT: {
 			// Call to a real 'C' code function
-			const auto &reg1 = registers[codeOp.Arg1i()];
+			const auto &reg1 = registers[codeOp->Arg1i()];
 
 			was_just_callas = -1;
 			if (num_args_to_func < 0) {
@@ -1253,12 +1320,12 @@ int ccInstance::Run(int32_t curpc) {
 			break;
 		}
 		case SCMD_PUSHREAL: {
-			const auto &reg1 = registers[codeOp.Arg1i()];
+			const auto &reg1 = registers[codeOp->Arg1i()];
 			PushToFuncCallStack(func_callstack, reg1);
 			break;
 		}
 		case SCMD_SUBREALSTACK: {
-			const auto arg_lit = codeOp.Arg1i();
+			const auto arg_lit = codeOp->Arg1i();
 			PopFromFuncCallStack(func_callstack, arg_lit);
 			if (was_just_callas >= 0) {
 				ASSERT_STACK_SIZE(arg_lit);
@@ -1269,7 +1336,7 @@ int ccInstance::Run(int32_t curpc) {
 		}
 		case SCMD_CALLOBJ: {
 			// set the OP register
-			const auto &reg1 = registers[codeOp.Arg1i()];
+			const auto &reg1 = registers[codeOp->Arg1i()];
 			if (reg1.IsNull()) {
 				cc_error("!Null pointer referenced");
 				return -1;
@@ -1299,26 +1366,26 @@ int ccInstance::Run(int32_t curpc) {
 			break;
 		}
 		case SCMD_SHIFTLEFT: {
-			auto &reg1 = registers[codeOp.Arg1i()];
-			const auto &reg2 = registers[codeOp.Arg2i()];
+			auto &reg1 = registers[codeOp->Arg1i()];
+			const auto &reg2 = registers[codeOp->Arg2i()];
 			reg1.SetInt32(reg1.IValue << reg2.IValue);
 			break;
 		}
 		case SCMD_SHIFTRIGHT: {
-			auto &reg1 = registers[codeOp.Arg1i()];
-			const auto &reg2 = registers[codeOp.Arg2i()];
+			auto &reg1 = registers[codeOp->Arg1i()];
+			const auto &reg2 = registers[codeOp->Arg2i()];
 			reg1.SetInt32(reg1.IValue >> reg2.IValue);
 			break;
 		}
 		case SCMD_THISBASE: {
-			const auto arg_lit = codeOp.Arg1i();
+			const auto arg_lit = codeOp->Arg1i();
 			thisbase[curnest] = arg_lit;
 			break;
 		}
 		case SCMD_NEWARRAY: {
-			auto &reg1 = registers[codeOp.Arg1i()];
-			const auto arg_elsize = codeOp.Arg2i();
-			const auto arg_managed = codeOp.Arg3().GetAsBool();
+			auto &reg1 = registers[codeOp->Arg1i()];
+			const auto arg_elsize = codeOp->Arg2i();
+			const auto arg_managed = codeOp->Arg3i() != 0;
 			int numElements = reg1.IValue;
 			if (numElements < 1) {
 				cc_error("invalid size for dynamic array; requested: %d, range: 1..%d", numElements, INT32_MAX);
@@ -1329,8 +1396,8 @@ int ccInstance::Run(int32_t curpc) {
 			break;
 		}
 		case SCMD_NEWUSEROBJECT: {
-			auto &reg1 = registers[codeOp.Arg1i()];
-			const auto arg_size = codeOp.Arg2i();
+			auto &reg1 = registers[codeOp->Arg1i()];
+			const auto arg_size = codeOp->Arg2i();
 			if (arg_size < 0) {
 				cc_error("Invalid size for user object; requested: %d (or %d), range: 0..%d", arg_size, arg_size, INT_MAX);
 				return -1;
@@ -1340,26 +1407,26 @@ int ccInstance::Run(int32_t curpc) {
 			break;
 		}
 		case SCMD_FADD: {
-			auto &reg1 = registers[codeOp.Arg1i()];
-			const auto arg_lit = codeOp.Arg2i();
+			auto &reg1 = registers[codeOp->Arg1i()];
+			const auto arg_lit = codeOp->Arg2i();
 			reg1.SetFloat(reg1.FValue + arg_lit); // arg2 was used as int here originally
 			break;
 		}
 		case SCMD_FSUB: {
-			auto &reg1 = registers[codeOp.Arg1i()];
-			const auto arg_lit = codeOp.Arg2i();
+			auto &reg1 = registers[codeOp->Arg1i()];
+			const auto arg_lit = codeOp->Arg2i();
 			reg1.SetFloat(reg1.FValue - arg_lit); // arg2 was used as int here originally
 			break;
 		}
 		case SCMD_FMULREG: {
-			auto &reg1 = registers[codeOp.Arg1i()];
-			const auto &reg2 = registers[codeOp.Arg2i()];
+			auto &reg1 = registers[codeOp->Arg1i()];
+			const auto &reg2 = registers[codeOp->Arg2i()];
 			reg1.SetFloat(reg1.FValue * reg2.FValue);
 			break;
 		}
 		case SCMD_FDIVREG: {
-			auto &reg1 = registers[codeOp.Arg1i()];
-			const auto &reg2 = registers[codeOp.Arg2i()];
+			auto &reg1 = registers[codeOp->Arg1i()];
+			const auto &reg2 = registers[codeOp->Arg2i()];
 			if (reg2.FValue == 0.0) {
 				cc_error("!Floating point divide by zero");
 				return -1;
@@ -1368,43 +1435,43 @@ int ccInstance::Run(int32_t curpc) {
 			break;
 		}
 		case SCMD_FADDREG: {
-			auto &reg1 = registers[codeOp.Arg1i()];
-			const auto &reg2 = registers[codeOp.Arg2i()];
+			auto &reg1 = registers[codeOp->Arg1i()];
+			const auto &reg2 = registers[codeOp->Arg2i()];
 			reg1.SetFloat(reg1.FValue + reg2.FValue);
 			break;
 		}
 		case SCMD_FSUBREG: {
-			auto &reg1 = registers[codeOp.Arg1i()];
-			const auto &reg2 = registers[codeOp.Arg2i()];
+			auto &reg1 = registers[codeOp->Arg1i()];
+			const auto &reg2 = registers[codeOp->Arg2i()];
 			reg1.SetFloat(reg1.FValue - reg2.FValue);
 			break;
 		}
 		case SCMD_FGREATER: {
-			auto &reg1 = registers[codeOp.Arg1i()];
-			const auto &reg2 = registers[codeOp.Arg2i()];
+			auto &reg1 = registers[codeOp->Arg1i()];
+			const auto &reg2 = registers[codeOp->Arg2i()];
 			reg1.SetFloatAsBool(reg1.FValue > reg2.FValue);
 			break;
 		}
 		case SCMD_FLESSTHAN: {
-			auto &reg1 = registers[codeOp.Arg1i()];
-			const auto &reg2 = registers[codeOp.Arg2i()];
+			auto &reg1 = registers[codeOp->Arg1i()];
+			const auto &reg2 = registers[codeOp->Arg2i()];
 			reg1.SetFloatAsBool(reg1.FValue < reg2.FValue);
 			break;
 		}
 		case SCMD_FGTE: {
-			auto &reg1 = registers[codeOp.Arg1i()];
-			const auto &reg2 = registers[codeOp.Arg2i()];
+			auto &reg1 = registers[codeOp->Arg1i()];
+			const auto &reg2 = registers[codeOp->Arg2i()];
 			reg1.SetFloatAsBool(reg1.FValue >= reg2.FValue);
 			break;
 		}
 		case SCMD_FLTE: {
-			auto &reg1 = registers[codeOp.Arg1i()];
-			const auto &reg2 = registers[codeOp.Arg2i()];
+			auto &reg1 = registers[codeOp->Arg1i()];
+			const auto &reg2 = registers[codeOp->Arg2i()];
 			reg1.SetFloatAsBool(reg1.FValue <= reg2.FValue);
 			break;
 		}
 		case SCMD_ZEROMEMORY: {
-			const auto arg_size = codeOp.Arg1i();
+			const auto arg_size = codeOp->Arg1i();
 			// Check if we are zeroing at stack tail
 			if (registers[SREG_MAR] == registers[SREG_SP]) {
 				// creating a local variable -- check the stack to ensure no mem overrun
@@ -1421,15 +1488,15 @@ int ccInstance::Run(int32_t curpc) {
 			break;
 		}
 		case SCMD_CREATESTRING: {
-			auto &reg1 = registers[codeOp.Arg1i()];
+			auto &reg1 = registers[codeOp->Arg1i()];
 			const char *ptr = reinterpret_cast<const char *>(reg1.GetDirectPtr());
 			DynObjectRef ref = ScriptString::Create(ptr);
 			reg1.SetScriptObject(ref.Obj, &_GP(myScriptStringImpl));
 			break;
 		}
 		case SCMD_STRINGSEQUAL: {
-			auto &reg1 = registers[codeOp.Arg1i()];
-			const auto &reg2 = registers[codeOp.Arg2i()];
+			auto &reg1 = registers[codeOp->Arg1i()];
+			const auto &reg2 = registers[codeOp->Arg2i()];
 			if ((reg1.IsNull()) || (reg2.IsNull())) {
 				cc_error("!Null pointer referenced");
 				return -1;
@@ -1441,8 +1508,8 @@ int ccInstance::Run(int32_t curpc) {
 			break;
 		}
 		case SCMD_STRINGSNOTEQ: {
-			auto &reg1 = registers[codeOp.Arg1i()];
-			const auto &reg2 = registers[codeOp.Arg2i()];
+			auto &reg1 = registers[codeOp->Arg1i()];
+			const auto &reg2 = registers[codeOp->Arg2i()];
 			if ((reg1.IsNull()) || (reg2.IsNull())) {
 				cc_error("!Null pointer referenced");
 				return -1;
@@ -1458,13 +1525,13 @@ int ccInstance::Run(int32_t curpc) {
 				loopIterationCheckDisabled++;
 			break;
 		default:
-			cc_error("instruction %d is not implemented", codeOp.Instruction.Code);
+			cc_error("instruction %d is not implemented", codeOp->Code);
 			return -1;
 		}
 		/* End perform operation */
 		//=====================================================================
 
-		pc += codeOp.ArgCount + 1;
+		pc += codeOp->Length;
 	}
 	return 0;
 }
@@ -1651,6 +1718,8 @@ bool ccInstance::_Create(PScript scri, const ccInstance *joined) {
 	if (joined) {
 		resolved_imports = joined->resolved_imports;
 		code_fixups = joined->code_fixups;
+		decoded_code = joined->decoded_code;
+		decoded_values = joined->decoded_values;
 	} else {
 		if (!CreateGlobalVars(scri.get())) {
 			return false;
@@ -1737,9 +1806,13 @@ void ccInstance::Free() {
 	if ((flags & INSTF_SHAREDATA) == 0) {
 		delete[] resolved_imports;
 		delete[] code_fixups;
+		delete[] decoded_code;
+		delete[] decoded_values;
 	}
 	resolved_imports = nullptr;
 	code_fixups = nullptr;
+	decoded_code = nullptr;
+	decoded_values = nullptr;
 }
 
 bool ccInstance::ResolveScriptImports(const ccScript *scri) {
@@ -1950,9 +2023,91 @@ bool ccInstance::ResolveImportFixups(const ccScript *scri) {
 		if (import->InstancePtr != nullptr && (code[fixup + 1] & INSTANCE_ID_REMOVEMASK) == SCMD_CALLEXT)
 			code[fixup + 1] = SCMD_CALLAS | (import->InstancePtr->loadedInstanceId << INSTANCE_ID_SHIFT);
 	}
+	// This is the last change made to the code, so it may be decoded now
+	DecodeCode();
 	return true;
 }
 
+void ccInstance::DecodeCode() {
+	// Forked instances share the decoded code with the original one
+	if (flags & INSTF_SHAREDATA)
+		return;
+
+	delete[] decoded_code;
+	delete[] decoded_values;
+	decoded_code = nullptr;
+	decoded_values = nullptr;
+	if (ccGetOption(SCOPT_NOPREDECODE) || codesize <= 0)
+		return;
+
+	decoded_code = new ScriptDecodedOp[codesize];
+	std::vector<RuntimeScriptValue> values;
+	for (int32_t at = 0; at < codesize;) {
+		const int32_t instr = static_cast<int32_t>(code[at]);
+		const int32_t cmd = instr & INSTANCE_ID_REMOVEMASK;
+		// Leave the rest for Run(), which reports the error if it gets there
+		if (cmd < 0 || cmd >= CC_NUM_SCCMDS)
+			break;
+		const int32_t arg_count = (*g_commands)[cmd].ArgCount;
+		if (at + arg_count >= codesize)
+			break;
+
+		ScriptDecodedOp &op = decoded_code[at];
+		op.Code = cmd;
+		op.InstanceId = (instr >> INSTANCE_ID_SHIFT) & INSTANCE_ID_MASK;
+		op.ArgCount = arg_count;
+		op.Length = arg_count + 1;
+		for (int32_t i = 0; i < arg_count; ++i)
+			op.Args[i] = static_cast<int32_t>(code[at + 1 + i]);
+
+		// Imports and stack offsets may only be resolved when run
+		if (cmd == SCMD_LITTOREG || cmd == SCMD_WRITELIT) {
+			const int fixup = code_fixups[at + 2];
+			if (fixup == FIXUP_NOFIXUP || fixup == FIXUP_GLOBALDATA ||
+					fixup == FIXUP_FUNCTION || fixup == FIXUP_STRING) {
+				RuntimeScriptValue arg;
+				arg.SetInt32(op.Args[1]);
+				FixupArgument(arg, fixup, code[at + 2], nullptr, strings);
+				op.Value = static_cast<int32_t>(values.size());
+				values.push_back(arg);
+			}
+		}
+		at += op.Length;
+	}
+
+	if (!values.empty()) {
+		decoded_values = new RuntimeScriptValue[values.size()];
+		for (size_t i = 0; i < values.size(); ++i)
+			decoded_values[i] = values[i];
+	}
+
+#if (!DEBUG_CC_EXEC)
+	// Use the internal instructions where possible: plain integer loads, and
+	// the most common pairs of instructions, which load an address and access
+	// the memory at it. The second instruction of a pair is still decoded on
+	// its own, in case there is a jump to it.
+	for (int32_t at = 0; at < codesize && decoded_code[at].Code >= 0; at += decoded_code[at].ArgCount + 1) {
+		ScriptDecodedOp &op = decoded_code[at];
+		const int32_t next_at = at + op.ArgCount + 1;
+		const ScriptDecodedOp *next = (next_at < codesize) ? &decoded_code[next_at] : nullptr;
+		const bool memAccess = next && next->Code >= 0 && next->InstanceId == 0 &&
+			(next->Code == SCMD_MEMREAD || next->Code == SCMD_MEMWRITE);
+
+		if (op.Code == SCMD_LITTOREG && op.Args[0] == SREG_MAR && op.Value >= 0 && memAccess) {
+			op.Code = (next->Code == SCMD_MEMREAD) ? kScCmdValueMemRead : kScCmdValueMemWrite;
+		} else if (op.Code == SCMD_LOADSPOFFS && memAccess) {
+			op.Code = (next->Code == SCMD_MEMREAD) ? kScCmdStackMemRead : kScCmdStackMemWrite;
+		} else {
+			if (op.Code == SCMD_LITTOREG && code_fixups[at + 2] == FIXUP_NOFIXUP)
+				op.Code = kScCmdIntToReg;
+			continue;
+		}
+		op.Args[1] = next->Args[0];
+		op.Length += next->Length;
+	}
+#endif
+}
+
 void ccInstance::PushValueToStack(const RuntimeScriptValue &rval) {
 	// Write value to the stack tail and advance stack ptr
 	registers[SREG_SP].WriteValue(rval);
@@ -83,6 +83,22 @@ struct ScriptOperation {
 	inline int Arg3i() const { return Args[2].IValue; }
 };
 
+// Instruction decoded ahead of execution, with the arguments unpacked.
+// It may also stand for a sequence of instructions which are run at once.
+struct ScriptDecodedOp {
+	int32_t Code = -1;  // instruction code, or -1 if it has to be decoded when run
+	int32_t InstanceId = 0;
+	int32_t Args[MAX_SCMD_ARGS]{};
+	int32_t ArgCount = 0;
+	int32_t Length = 0; // number of code elements to advance by
+	int32_t Value = -1; // index of the fixed-up argument in ccInstance::decoded_values, if any
+
+	// returns argN as a integer literal
+	inline int Arg1i() const { return Args[0]; }
+	inline int Arg2i() const { return Args[1]; }
+	inline int Arg3i() const { return Args[2]; }
+};
+
 struct ScriptVariable {
 	ScriptVariable() {
 		ScAddress = -1; // address = 0 is valid one, -1 means undefined
@@ -155,6 +171,12 @@ public:
 
 	char *code_fixups;
 
+	// Instructions decoded ahead of execution, one for each element of the
+	// code array; shared with forked instances.
+	ScriptDecodedOp *decoded_code;
+	// Arguments which had their fixups applied when decoding
+	RuntimeScriptValue *decoded_values;
+
 	// returns the currently executing instance, or NULL if none
 	static ccInstance *GetCurrentInstance(void);
 	// clears recorded stack of current instances
@@ -208,6 +230,8 @@ private:
 	bool    AddGlobalVar(const ScriptVariable &glvar);
 	ScriptVariable *FindGlobalVar(int32_t var_addr);
 	bool    CreateRuntimeCodeFixups(const ccScript *scri);
+	// Decodes the code ahead of running it, once all the fixups are resolved
+	void    DecodeCode();
 
 	// Begin executing script starting from the given bytecode index
 	int     Run(int32_t curpc);
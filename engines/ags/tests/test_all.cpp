@@ -29,6 +29,7 @@ void Test_DoAllTests() {
 	Test_Memory();
 	// The commented out tests don't work right now (will fix, but that is not my problem right now) @eklipsed
 	//Test_Path();
+	Test_Script();
 	Test_ScriptSprintf();
 	Test_String();
 	Test_Version();
@@ -0,0 +1,442 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "ags/shared/core/platform.h"
+#include "common/scummsys.h"
+#include "common/debug.h"
+#include "common/std/chrono.h"
+#include "common/std/vector.h"
+#include "ags/shared/script/cc_common.h"
+#include "ags/shared/script/cc_internal.h"
+#include "ags/shared/script/cc_script.h"
+#include "ags/shared/util/memory.h"
+#include "ags/engine/script/cc_instance.h"
+#include "ags/engine/script/script_runtime.h"
+
+namespace AGS3 {
+
+using namespace AGS::Shared;
+
+// Assembles the byte-code of a script, keeping track of its fixups, and
+// collects the rest of the script's contents
+struct ScriptAssembler {
+	std::vector<int32_t> code;
+	std::vector<int32_t> fixups;
+	std::vector<char> fixuptypes;
+	std::vector<int32_t> globals; // initial values of the global variables
+	std::vector<char> strings;
+	std::vector<const char *> imports;
+	std::vector<const char *> exports;
+	std::vector<int32_t> export_addr;
+
+	int32_t pos() const {
+		return static_cast<int32_t>(code.size());
+	}
+	void op(int32_t cmd) {
+		code.push_back(cmd);
+	}
+	void op(int32_t cmd, int32_t arg1) {
+		code.push_back(cmd);
+		code.push_back(arg1);
+	}
+	void op(int32_t cmd, int32_t arg1, int32_t arg2) {
+		code.push_back(cmd);
+		code.push_back(arg1);
+		code.push_back(arg2);
+	}
+	// movl reg, <value with a fixup>
+	void opFixup(int32_t reg, int32_t value, char fixuptype) {
+		op(SCMD_LITTOREG, reg, value);
+		fixups.push_back(pos() - 1);
+		fixuptypes.push_back(fixuptype);
+	}
+	// Jumps are relative to the following instruction
+	void jump(int32_t cmd, int32_t target) {
+		op(cmd, target - (pos() + 2));
+	}
+	// Sets the target of a jump assembled before it
+	void patchJump(int32_t at, int32_t target) {
+		code[at + 1] = target - (at + 2);
+	}
+
+	// Returns the offset of a string literal, to be used with FIXUP_STRING
+	int32_t string(const char *str) {
+		const int32_t offset = static_cast<int32_t>(strings.size());
+		strings.insert(strings.end(), str, str + strlen(str) + 1);
+		return offset;
+	}
+	// Returns the index of an import, to be used with FIXUP_IMPORT
+	int32_t import(const char *name) {
+		imports.push_back(name);
+		return static_cast<int32_t>(imports.size() - 1);
+	}
+	void exportFunction(const char *name, int32_t addr) {
+		exports.push_back(name);
+		export_addr.push_back((EXPORT_FUNCTION << 24) | addr);
+	}
+	void exportData(const char *name, int32_t offset) {
+		exports.push_back(name);
+		export_addr.push_back((EXPORT_DATA << 24) | offset);
+	}
+
+	PScript build() const {
+		PScript script(new ccScript());
+		script->globaldatasize = static_cast<int32_t>(globals.size() * sizeof(int32_t));
+		script->globaldata = static_cast<char *>(calloc(script->globaldatasize + 1, 1));
+		for (size_t i = 0; i < globals.size(); i++)
+			Memory::WriteInt32LE(script->globaldata + i * sizeof(int32_t), globals[i]);
+		script->codesize = static_cast<int32_t>(code.size());
+		script->code = static_cast<int32_t *>(malloc(code.size() * sizeof(int32_t)));
+		memcpy(script->code, &code[0], code.size() * sizeof(int32_t));
+		script->stringssize = static_cast<int32_t>(strings.size());
+		script->strings = static_cast<char *>(calloc(strings.size() + 1, 1));
+		if (!strings.empty())
+			memcpy(script->strings, &strings[0], strings.size());
+		script->numfixups = static_cast<int>(fixups.size());
+		if (!fixups.empty()) {
+			script->fixups = static_cast<int32_t *>(malloc(fixups.size() * sizeof(int32_t)));
+			memcpy(script->fixups, &fixups[0], fixups.size() * sizeof(int32_t));
+			script->fixuptypes = static_cast<char *>(malloc(fixuptypes.size()));
+			memcpy(script->fixuptypes, &fixuptypes[0], fixuptypes.size());
+		}
+		script->numimports = static_cast<int>(imports.size());
+		script->imports = static_cast<char **>(calloc(imports.size() + 1, sizeof(char *)));
+		for (size_t i = 0; i < imports.size(); i++)
+			script->imports[i] = scumm_strdup(imports[i]);
+		script->numexports = static_cast<int>(exports.size());
+		script->exports = static_cast<char **>(calloc(exports.size() + 1, sizeof(char *)));
+		script->export_addr = static_cast<int32_t *>(calloc(exports.size() + 1, sizeof(int32_t)));
+		for (size_t i = 0; i < exports.size(); i++) {
+			script->exports[i] = scumm_strdup(exports[i]);
+			script->export_addr[i] = export_addr[i];
+		}
+		return script;
+	}
+};
+
+// Builds a script running a counting loop, which reads and writes both
+// local and global variables, and calls a function on every iteration.
+// Its "main" function returns the sum of the loop indexes, and the
+// global variable at offset 4 counts the calls.
+static PScript CreateLoopScript(int32_t iterations) {
+	ScriptAssembler as;
+	const int32_t kGlobalSum = 0;
+	const int32_t kGlobalCalls = 4;
+
+	as.op(SCMD_LOOPCHECKOFF);
+	as.op(SCMD_LINENUM, 1);
+	as.op(SCMD_LITTOREG, SREG_AX, 0);
+	as.op(SCMD_PUSHREG, SREG_AX);
+	const int32_t loop = as.pos();
+	as.op(SCMD_LINENUM, 2);
+	as.op(SCMD_LOADSPOFFS, 4);
+	as.op(SCMD_MEMREAD, SREG_AX);
+	as.op(SCMD_LITTOREG, SREG_BX, iterations);
+	as.op(SCMD_LESSTHAN, SREG_AX, SREG_BX);
+	const int32_t exitJump = as.pos();
+	as.op(SCMD_JZ, 0);
+	as.op(SCMD_LINENUM, 3);
+	as.opFixup(SREG_MAR, kGlobalSum, FIXUP_GLOBALDATA);
+	as.op(SCMD_MEMREAD, SREG_AX);
+	as.op(SCMD_LOADSPOFFS, 4);
+	as.op(SCMD_MEMREAD, SREG_BX);
+	as.op(SCMD_ADDREG, SREG_AX, SREG_BX);
+	as.opFixup(SREG_MAR, kGlobalSum, FIXUP_GLOBALDATA);
+	as.op(SCMD_MEMWRITE, SREG_AX);
+	const int32_t funcRef = as.pos();
+	as.opFixup(SREG_CX, 0, FIXUP_FUNCTION);
+	as.op(SCMD_CALL, SREG_CX);
+	as.op(SCMD_LINENUM, 4);
+	as.op(SCMD_LOADSPOFFS, 4);
+	as.op(SCMD_MEMREAD, SREG_AX);
+	as.op(SCMD_ADD, SREG_AX, 1);
+	as.op(SCMD_MEMWRITE, SREG_AX);
+	as.jump(SCMD_JMP, loop);
+	as.code[exitJump + 1] = as.pos() - (exitJump + 2);
+	as.op(SCMD_SUB, SREG_SP, 4);
+	as.opFixup(SREG_MAR, kGlobalSum, FIXUP_GLOBALDATA);
+	as.op(SCMD_MEMREAD, SREG_AX);
+	as.op(SCMD_RET);
+
+	as.code[funcRef + 2] = as.pos();
+	as.op(SCMD_LINENUM, 10);
+	as.opFixup(SREG_MAR, kGlobalCalls, FIXUP_GLOBALDATA);
+	as.op(SCMD_MEMREAD, SREG_AX);
+	as.op(SCMD_ADD, SREG_AX, 1);
+	as.op(SCMD_MEMWRITE, SREG_AX);
+	as.op(SCMD_RET);
+
+	as.globals.resize(2);
+	as.exportFunction("main$0", 0);
+	return as.build();
+}
+
+static std::unique_ptr<ccInstance> CreateInstance(PScript script, bool predecode) {
+	const int oldPredecode = ccGetOption(SCOPT_NOPREDECODE);
+	ccSetOption(SCOPT_NOPREDECODE, predecode ? 0 : 1);
+	std::unique_ptr<ccInstance> inst = ccInstance::CreateFromScript(script);
+	assert(inst);
+	bool resolved = inst->ResolveScriptImports(script.get()) && inst->ResolveImportFixups(script.get());
+	assert(resolved);
+	ccSetOption(SCOPT_NOPREDECODE, oldPredecode);
+	return inst;
+}
+
+static uint32 RunLoop(ccInstance *inst, int32_t iterations) {
+	memset(inst->globaldata, 0, inst->globaldatasize);
+	int result = inst->CallScriptFunction("main", 0, nullptr);
+	assert(result == 0);
+
+	// The sum is expected to wrap around for large counts
+	uint32 sum = 0;
+	for (int32_t i = 0; i < iterations; i++)
+		sum += i;
+	assert(static_cast<uint32>(inst->returnValue) == sum);
+	assert(*reinterpret_cast<int32_t *>(inst->globaldata + 4) == iterations);
+	return static_cast<uint32>(inst->returnValue);
+}
+
+void Test_ScriptSpeed(int32_t iterations, int runs) {
+	PScript script = CreateLoopScript(iterations);
+	std::unique_ptr<ccInstance> legacy = CreateInstance(script, false);
+	std::unique_ptr<ccInstance> predecoded = CreateInstance(script, true);
+
+	for (int i = 0; i < 2; i++) {
+		ccInstance *inst = (i == 0) ? legacy.get() : predecoded.get();
+		uint32 start = std::chrono::high_resolution_clock::now();
+		for (int run = 0; run < runs; run++)
+			RunLoop(inst, iterations);
+		uint32 end = std::chrono::high_resolution_clock::now();
+		debug("Script loop of %d iterations, %s: %d runs in %u ms", iterations,
+		      (i == 0) ? "decoded while running" : "predecoded", runs, end - start);
+	}
+}
+
+// Builds a script exercising the instructions merged when decoding ahead,
+// including jumps into the second instruction of a merged pair. Its "main"
+// function returns 12171207.
+static PScript CreateMergedOpsScript() {
+	ScriptAssembler as;
+	const int32_t kGlobalA = 0;
+	const int32_t kGlobalB = 4;
+	const int32_t kGlobalC = 8;
+
+	as.op(SCMD_LITTOREG, SREG_AX, 0);
+	as.op(SCMD_PUSHREG, SREG_AX);
+	as.opFixup(SREG_MAR, kGlobalA, FIXUP_GLOBALDATA);
+	as.op(SCMD_MEMREAD, SREG_AX);
+	as.op(SCMD_LITTOREG, SREG_BX, 5);
+	as.op(SCMD_ADDREG, SREG_AX, SREG_BX);
+	as.opFixup(SREG_MAR, kGlobalB, FIXUP_GLOBALDATA);
+	as.op(SCMD_MEMWRITE, SREG_AX);
+	as.op(SCMD_LOADSPOFFS, 4);
+	as.op(SCMD_MEMWRITE, SREG_AX);
+	as.op(SCMD_LOADSPOFFS, 4);
+	as.op(SCMD_MEMREAD, SREG_CX);
+	as.op(SCMD_ADDREG, SREG_CX, SREG_BX);
+
+	// Jump to the read of a global, skipping the address it's paired with
+	as.opFixup(SREG_MAR, kGlobalA, FIXUP_GLOBALDATA);
+	const int32_t readJump = as.pos();
+	as.op(SCMD_JMP, 0);
+	as.opFixup(SREG_MAR, kGlobalB, FIXUP_GLOBALDATA);
+	as.patchJump(readJump, as.pos());
+	as.op(SCMD_MEMREAD, SREG_AX);
+	as.op(SCMD_REGTOREG, SREG_AX, SREG_DX);
+
+	// Jump to the write to a local, skipping the address it's paired with
+	as.opFixup(SREG_MAR, kGlobalC, FIXUP_GLOBALDATA);
+	const int32_t writeJump = as.pos();
+	as.op(SCMD_JMP, 0);
+	as.op(SCMD_LOADSPOFFS, 4);
+	as.patchJump(writeJump, as.pos());
+	as.op(SCMD_MEMWRITE, SREG_CX);
+
+	// A + local * 100 + C * 10000 + B * 1000000
+	as.op(SCMD_LOADSPOFFS, 4);
+	as.op(SCMD_MEMREAD, SREG_AX);
+	as.op(SCMD_MUL, SREG_AX, 100);
+	as.op(SCMD_ADDREG, SREG_DX, SREG_AX);
+	as.opFixup(SREG_MAR, kGlobalC, FIXUP_GLOBALDATA);
+	as.op(SCMD_MEMREAD, SREG_AX);
+	as.op(SCMD_MUL, SREG_AX, 10000);
+	as.op(SCMD_ADDREG, SREG_DX, SREG_AX);
+	as.opFixup(SREG_MAR, kGlobalB, FIXUP_GLOBALDATA);
+	as.op(SCMD_MEMREAD, SREG_AX);
+	as.op(SCMD_MUL, SREG_AX, 1000000);
+	as.op(SCMD_ADDREG, SREG_DX, SREG_AX);
+	as.op(SCMD_REGTOREG, SREG_DX, SREG_AX);
+	as.op(SCMD_SUB, SREG_SP, 4);
+	as.op(SCMD_RET);
+
+	as.globals.push_back(7);
+	as.globals.push_back(11);
+	as.globals.push_back(0);
+	as.exportFunction("main$0", 0);
+	return as.build();
+}
+
+// Builds a script which another one imports a function and a variable from
+static PScript CreateLibraryScript() {
+	ScriptAssembler as;
+
+	as.op(SCMD_LOADSPOFFS, 8);
+	as.op(SCMD_MEMREAD, SREG_AX);
+	as.op(SCMD_ADDREG, SREG_AX, SREG_AX);
+	as.op(SCMD_RET);
+
+	as.globals.push_back(1000);
+	as.exportFunction("ScriptTest_Twice$1", 0);
+	as.exportData("ScriptTest_Value", 0);
+	return as.build();
+}
+
+static RuntimeScriptValue Sc_ScriptTest_Sub(const RuntimeScriptValue *params, int32_t param_count) {
+	assert(param_count == 2);
+	return RuntimeScriptValue().SetInt32(params[0].IValue - params[1].IValue);
+}
+
+// Builds a script calling an engine function and a function of the library
+// script, and reading a variable of the library script, a local variable
+// through a stack fixup and a string literal. Its "main" function returns
+// 105414.
+static PScript CreateCallsScript() {
+	ScriptAssembler as;
+
+	as.op(SCMD_LITTOREG, SREG_AX, 0);
+	as.op(SCMD_PUSHREG, SREG_AX);
+
+	// ScriptTest_Sub(3, 10), the arguments are pushed last to first
+	as.op(SCMD_LITTOREG, SREG_AX, 10);
+	as.op(SCMD_PUSHREAL, SREG_AX);
+	as.op(SCMD_LITTOREG, SREG_AX, 3);
+	as.op(SCMD_PUSHREAL, SREG_AX);
+	as.op(SCMD_NUMFUNCARGS, 2);
+	as.opFixup(SREG_CX, as.import("ScriptTest_Sub"), FIXUP_IMPORT);
+	as.op(SCMD_CALLEXT, SREG_CX);
+	as.op(SCMD_SUBREALSTACK, 2);
+	as.op(SCMD_LOADSPOFFS, 4);
+	as.op(SCMD_MEMWRITE, SREG_AX);
+
+	// ScriptTest_Twice(21), which becomes a CALLAS when resolved
+	as.op(SCMD_LITTOREG, SREG_AX, 21);
+	as.op(SCMD_PUSHREAL, SREG_AX);
+	as.op(SCMD_NUMFUNCARGS, 1);
+	as.opFixup(SREG_CX, as.import("ScriptTest_Twice"), FIXUP_IMPORT);
+	as.op(SCMD_CALLEXT, SREG_CX);
+	as.op(SCMD_SUBREALSTACK, 1);
+	as.op(SCMD_REGTOREG, SREG_AX, SREG_DX);
+
+	// Imports are only resolved when run, so this is not merged
+	as.opFixup(SREG_MAR, as.import("ScriptTest_Value"), FIXUP_IMPORT);
+	as.op(SCMD_MEMREAD, SREG_AX);
+	as.op(SCMD_ADDREG, SREG_DX, SREG_AX);
+
+	// Neither are stack fixups
+	as.opFixup(SREG_MAR, 4, FIXUP_STACK);
+	as.op(SCMD_MEMREAD, SREG_AX);
+	as.op(SCMD_MUL, SREG_AX, 100);
+	as.op(SCMD_ADDREG, SREG_DX, SREG_AX);
+
+	as.opFixup(SREG_MAR, as.string("Hi"), FIXUP_STRING);
+	as.op(SCMD_MEMREADB, SREG_AX);
+	as.op(SCMD_ADDREG, SREG_DX, SREG_AX);
+	as.op(SCMD_ADD, SREG_MAR, 1);
+	as.op(SCMD_MEMREADB, SREG_AX);
+	as.op(SCMD_MUL, SREG_AX, 1000);
+	as.op(SCMD_ADDREG, SREG_DX, SREG_AX);
+
+	as.op(SCMD_REGTOREG, SREG_DX, SREG_AX);
+	as.op(SCMD_SUB, SREG_SP, 4);
+	as.op(SCMD_RET);
+
+	as.exportFunction("main$0", 0);
+	return as.build();
+}
+
+static int32_t RunMain(ccInstance *inst) {
+	int result = inst->CallScriptFunction("main", 0, nullptr);
+	assert(result == 0);
+	return inst->returnValue;
+}
+
+// Runs a script with and without decoding it ahead
+static int32_t RunBoth(PScript script) {
+	std::unique_ptr<ccInstance> legacy = CreateInstance(script, false);
+	std::unique_ptr<ccInstance> predecoded = CreateInstance(script, true);
+	assert(!legacy->decoded_code);
+	assert(predecoded->decoded_code);
+
+	const int32_t result = RunMain(legacy.get());
+	assert(RunMain(predecoded.get()) == result);
+	assert(memcmp(legacy->globaldata, predecoded->globaldata, legacy->globaldatasize) == 0);
+	return result;
+}
+
+// Runs the calls script along with its own instance of the library, which
+// exports its symbols as long as it's the only one
+static int32_t RunCalls(PScript calls, PScript library, bool predecode) {
+	const int oldAutoImport = ccGetOption(SCOPT_AUTOIMPORT);
+	ccSetOption(SCOPT_AUTOIMPORT, 1);
+	std::unique_ptr<ccInstance> libraryInst = CreateInstance(library, predecode);
+	ccSetOption(SCOPT_AUTOIMPORT, oldAutoImport);
+
+	std::unique_ptr<ccInstance> callsInst = CreateInstance(calls, predecode);
+	assert((callsInst->decoded_code != nullptr) == predecode);
+	return RunMain(callsInst.get());
+}
+
+void Test_Script() {
+	PScript script = CreateLoopScript(100);
+	std::unique_ptr<ccInstance> legacy = CreateInstance(script, false);
+	std::unique_ptr<ccInstance> predecoded = CreateInstance(script, true);
+	assert(RunLoop(legacy.get(), 100) == RunLoop(predecoded.get(), 100));
+
+	// Running again must not depend on anything left from the previous run
+	assert(RunLoop(predecoded.get(), 100) == 4950);
+
+	PScript mergedOps = CreateMergedOpsScript();
+	assert(RunBoth(mergedOps) == 12171207);
+
+	ccAddExternalStaticFunction("ScriptTest_Sub", Sc_ScriptTest_Sub);
+	PScript calls = CreateCallsScript();
+	PScript library = CreateLibraryScript();
+	const int32_t callsResult = RunCalls(calls, library, false);
+	assert(callsResult == 105414);
+	assert(RunCalls(calls, library, true) == callsResult);
+	ccRemoveExternalSymbol("ScriptTest_Sub");
+
+	// Forked instances share the decoded code, which stays with the
+	// original instance when they are gone
+	std::unique_ptr<ccInstance> original = CreateInstance(mergedOps, true);
+	std::unique_ptr<ccInstance> fork = original->Fork();
+	assert(fork && fork->decoded_code == original->decoded_code);
+	assert(fork->decoded_values == original->decoded_values);
+	assert(RunMain(fork.get()) == 12171207);
+	fork.reset();
+	assert(RunMain(original.get()) == 12171207);
+
+#ifdef SLOW_TESTS
+	Test_ScriptSpeed(100000, 20);
+#endif
+}
+
+} // namespace AGS3
@@ -222,6 +222,8 @@ public:
 	void draw();
 
 	Graphics::Primitives *getInkPrimitives();
+	/** Switches the pixel format sprites are drawn in, for the tests */
+	void setInkPixelFormat(const Graphics::PixelFormat &format);
 	uint32 getColorBlack();
 	uint32 getColorWhite();
 
@@ -373,6 +375,8 @@ struct DirectorPlotData {
 	uint32 preprocessColor(uint32 src);
 	void inkBlitShape(Common::Rect &srcRect);
 	void inkBlitSurface(Common::Rect &srcRect, const Graphics::Surface *mask);
+	bool inkBlitRows(Common::Rect &srcRect, const Graphics::Surface *mask);
+	void inkBlitPixels(Common::Rect &srcRect, const Graphics::Surface *mask);
 
 	DirectorPlotData(DirectorEngine *d_, SpriteType s, InkType i, int a, uint32 b, uint32 f) : d(d_), sprite(s), ink(i), alpha(a), backColor(b), foreColor(f) {
 		colorWhite = d->_wm->_colorWhite;
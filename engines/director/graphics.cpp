@@ -543,6 +543,298 @@ Graphics::Primitives *DirectorEngine::getInkPrimitives() {
 	return _primitives;
 }
 
+void DirectorEngine::setInkPixelFormat(const Graphics::PixelFormat &format) {
+	_pixelformat = format;
+	_wm->_pixelformat = format;
+
+	delete _primitives;
+	_primitives = nullptr;
+}
+
+/**
+ * Row kernels for inkBlitSurface.
+ *
+ * drawPoint() decides what to do for every single pixel. For bitmap sprites
+ * the ink, bit depth and options are the same for the whole sprite, so a
+ * kernel composing entire rows is picked once instead. The loops have no
+ * branches depending on the pixels, which lets the compiler vectorize them.
+ * Anything without a kernel goes through drawPoint() as before.
+ */
+struct InkRowParams {
+	uint32 foreColor;
+	uint32 backColor;
+	uint32 colorBlack;
+	uint32 colorWhite;
+	uint32 rgbMask;		// Bits of the color channels in 32bpp modes
+	uint32 alphaBits;	// Bits set on every color made by findBestColor()
+	uint32 alpha;
+	byte rShift, gShift, bShift;
+};
+
+typedef void (*InkRowFunc)(void *dst, const void *src, const byte *mask, int width, const InkRowParams &p);
+
+template <typename T, typename Op>
+static void inkRow(void *dstPtr, const void *srcPtr, const byte *mask, int width, const InkRowParams &p) {
+	T *dst = (T *)dstPtr;
+	const T *src = (const T *)srcPtr;
+
+	if (mask) {
+		for (int i = 0; i < width; i++) {
+			T d = dst[i];
+			T r = Op::apply(d, src[i], p);
+			dst[i] = mask[i] ? r : d;
+		}
+	} else {
+		for (int i = 0; i < width; i++)
+			dst[i] = Op::apply(dst[i], src[i], p);
+	}
+}
+
+template <typename T>
+static void inkRowCopy(void *dstPtr, const void *srcPtr, const byte *mask, int width, const InkRowParams &p) {
+	if (mask) {
+		T *dst = (T *)dstPtr;
+		const T *src = (const T *)srcPtr;
+
+		for (int i = 0; i < width; i++)
+			dst[i] = mask[i] ? src[i] : dst[i];
+	} else {
+		memcpy(dstPtr, srcPtr, width * sizeof(T));
+	}
+}
+
+template <typename T>
+struct InkOpBackgndTrans {
+	static FORCEINLINE T apply(T d, T s, const InkRowParams &p) { return ((uint32)s == p.backColor) ? d : s; }
+};
+
+template <typename T>
+struct InkOpBackgndTransOneBit {
+	static FORCEINLINE T apply(T d, T s, const InkRowParams &p) { return ((uint32)s == p.colorBlack) ? (T)p.foreColor : d; }
+};
+
+struct InkOpCopyApplyColor8 {
+	static FORCEINLINE byte apply(byte d, byte s, const InkRowParams &p) {
+		return (s == 0xff) ? (byte)p.foreColor : ((s == 0x00) ? (byte)p.backColor : d);
+	}
+};
+
+struct InkOpCopyApplyColor32 {
+	static FORCEINLINE uint32 apply(uint32 d, uint32 s, const InkRowParams &p) {
+		return ((s | p.foreColor) & (~s | p.backColor) & p.rgbMask) | p.alphaBits;
+	}
+};
+
+struct InkOpNotCopyApplyColor8 {
+	static FORCEINLINE byte apply(byte d, byte s, const InkRowParams &p) {
+		return (s == 0xff) ? (byte)p.backColor : ((s == 0x00) ? (byte)p.foreColor : s);
+	}
+};
+
+struct InkOpNotCopyApplyColor32 {
+	static FORCEINLINE uint32 apply(uint32 d, uint32 s, const InkRowParams &p) {
+		return ((~s | p.foreColor) & (s | p.backColor) & p.rgbMask) | p.alphaBits;
+	}
+};
+
+struct InkOpNotCopy32 {
+	static FORCEINLINE uint32 apply(uint32 d, uint32 s, const InkRowParams &p) { return (~s & p.rgbMask) | p.alphaBits; }
+};
+
+// Transparent and Ghost inks in their one-bit and colorized forms
+template <typename T, bool white, bool back>
+struct InkOpReplaceColor {
+	static FORCEINLINE T apply(T d, T s, const InkRowParams &p) {
+		return ((uint32)s == (white ? p.colorWhite : p.colorBlack)) ? (T)(back ? p.backColor : p.foreColor) : d;
+	}
+};
+
+template <typename T>
+struct InkOpTransparent {
+	static FORCEINLINE T apply(T d, T s, const InkRowParams &p) { return d | s; }
+};
+
+template <typename T>
+struct InkOpNotTrans {
+	static FORCEINLINE T apply(T d, T s, const InkRowParams &p) { return d | (T)~s; }
+};
+
+struct InkOpReverse8 {
+	static FORCEINLINE byte apply(byte d, byte s, const InkRowParams &p) { return d ^ s; }
+};
+
+struct InkOpReverse32 {
+	static FORCEINLINE uint32 apply(uint32 d, uint32 s, const InkRowParams &p) { return d ^ ~s; }
+};
+
+struct InkOpNotReverse8 {
+	static FORCEINLINE byte apply(byte d, byte s, const InkRowParams &p) { return d ^ (byte)~s; }
+};
+
+struct InkOpNotReverse32 {
+	static FORCEINLINE uint32 apply(uint32 d, uint32 s, const InkRowParams &p) { return d ^ (s & 0xffffff00); }
+};
+
+struct InkOpGhost8 {
+	static FORCEINLINE byte apply(byte d, byte s, const InkRowParams &p) { return d & (byte)~s; }
+};
+
+struct InkOpNotGhost8 {
+	static FORCEINLINE byte apply(byte d, byte s, const InkRowParams &p) { return d & s; }
+};
+
+// In 32bpp modes, Ghost ORs with the inverse of src and NotGhost with src,
+// the same as NotTrans and Transparent
+
+// Applies a channel operation to each of red, green and blue, then puts them
+// back together the way findBestColor() does
+template <typename ChannelOp>
+struct InkOpRGB {
+	static FORCEINLINE uint32 apply(uint32 d, uint32 s, const InkRowParams &p) {
+		uint32 r = ChannelOp::apply((d >> p.rShift) & 0xff, (s >> p.rShift) & 0xff, p) & 0xff;
+		uint32 g = ChannelOp::apply((d >> p.gShift) & 0xff, (s >> p.gShift) & 0xff, p) & 0xff;
+		uint32 b = ChannelOp::apply((d >> p.bShift) & 0xff, (s >> p.bShift) & 0xff, p) & 0xff;
+		return (r << p.rShift) | (g << p.gShift) | (b << p.bShift) | p.alphaBits;
+	}
+};
+
+struct InkChannelBlend {
+	static FORCEINLINE uint32 apply(uint32 d, uint32 s, const InkRowParams &p) { return (d * p.alpha + s * (255 - p.alpha)) / 255; }
+};
+
+struct InkChannelAddPin {
+	static FORCEINLINE uint32 apply(uint32 d, uint32 s, const InkRowParams &p) { return MIN<uint32>(d + s, 0xff); }
+};
+
+struct InkChannelAdd {
+	static FORCEINLINE uint32 apply(uint32 d, uint32 s, const InkRowParams &p) { return d + s; }
+};
+
+struct InkChannelSubPin {
+	// Matches drawPoint(), which pins one below the difference
+	static FORCEINLINE uint32 apply(uint32 d, uint32 s, const InkRowParams &p) { return (d > s) ? d - s - 1 : 0; }
+};
+
+struct InkChannelLight {
+	static FORCEINLINE uint32 apply(uint32 d, uint32 s, const InkRowParams &p) { return MAX(d, s); }
+};
+
+struct InkChannelSub {
+	static FORCEINLINE uint32 apply(uint32 d, uint32 s, const InkRowParams &p) { return d - s; }
+};
+
+struct InkChannelDark {
+	static FORCEINLINE uint32 apply(uint32 d, uint32 s, const InkRowParams &p) { return MIN(d, s); }
+};
+
+static InkRowFunc getInkRowFunc8(const DirectorPlotData *p) {
+	// Blending and the arithmetic inks need palette lookups
+	if (p->alpha)
+		return nullptr;
+
+	switch (p->ink) {
+	case kInkTypeBackgndTrans:
+		if (p->oneBitImage)
+			return inkRow<byte, InkOpBackgndTransOneBit<byte> >;
+		return inkRow<byte, InkOpBackgndTrans<byte> >;
+	case kInkTypeMatte:
+	case kInkTypeMask:
+	case kInkTypeBlend:
+	case kInkTypeCopy:
+		if (p->applyColor)
+			return inkRow<byte, InkOpCopyApplyColor8>;
+		return inkRowCopy<byte>;
+	case kInkTypeNotCopy:
+		if (p->applyColor)
+			return inkRow<byte, InkOpNotCopyApplyColor8>;
+		return nullptr;
+	case kInkTypeTransparent:
+		if (p->oneBitImage || p->applyColor)
+			return inkRow<byte, InkOpReplaceColor<byte, false, false> >;
+		return inkRow<byte, InkOpTransparent<byte> >;
+	case kInkTypeNotTrans:
+		if (p->oneBitImage || p->applyColor)
+			return inkRow<byte, InkOpReplaceColor<byte, true, false> >;
+		return inkRow<byte, InkOpNotTrans<byte> >;
+	case kInkTypeReverse:
+		return inkRow<byte, InkOpReverse8>;
+	case kInkTypeNotReverse:
+		return inkRow<byte, InkOpNotReverse8>;
+	case kInkTypeGhost:
+		if (p->oneBitImage || p->applyColor)
+			return inkRow<byte, InkOpReplaceColor<byte, false, true> >;
+		return inkRow<byte, InkOpGhost8>;
+	case kInkTypeNotGhost:
+		if (p->oneBitImage || p->applyColor)
+			return inkRow<byte, InkOpReplaceColor<byte, true, true> >;
+		return inkRow<byte, InkOpNotGhost8>;
+	default:
+		return nullptr;
+	}
+}
+
+static InkRowFunc getInkRowFunc32(const DirectorPlotData *p) {
+	// The channel operations rely on findBestColor() being RGBToColor()
+	const Graphics::PixelFormat &format = p->d->_wm->_pixelformat;
+	if (format.rLoss || format.gLoss || format.bLoss)
+		return nullptr;
+
+	if (p->alpha)
+		return inkRow<uint32, InkOpRGB<InkChannelBlend> >;
+
+	switch (p->ink) {
+	case kInkTypeBackgndTrans:
+		if (p->oneBitImage)
+			return inkRow<uint32, InkOpBackgndTransOneBit<uint32> >;
+		return inkRow<uint32, InkOpBackgndTrans<uint32> >;
+	case kInkTypeMatte:
+	case kInkTypeMask:
+	case kInkTypeBlend:
+	case kInkTypeCopy:
+		if (p->applyColor)
+			return inkRow<uint32, InkOpCopyApplyColor32>;
+		return inkRowCopy<uint32>;
+	case kInkTypeNotCopy:
+		if (p->applyColor)
+			return inkRow<uint32, InkOpNotCopyApplyColor32>;
+		return inkRow<uint32, InkOpNotCopy32>;
+	case kInkTypeTransparent:
+		if (p->oneBitImage || p->applyColor)
+			return inkRow<uint32, InkOpReplaceColor<uint32, false, false> >;
+		return inkRow<uint32, InkOpTransparent<uint32> >;
+	case kInkTypeNotTrans:
+		if (p->oneBitImage || p->applyColor)
+			return inkRow<uint32, InkOpReplaceColor<uint32, true, false> >;
+		return inkRow<uint32, InkOpNotTrans<uint32> >;
+	case kInkTypeReverse:
+		return inkRow<uint32, InkOpReverse32>;
+	case kInkTypeNotReverse:
+		return inkRow<uint32, InkOpNotReverse32>;
+	case kInkTypeGhost:
+		if (p->oneBitImage || p->applyColor)
+			return inkRow<uint32, InkOpReplaceColor<uint32, false, true> >;
+		return inkRow<uint32, InkOpNotTrans<uint32> >;
+	case kInkTypeNotGhost:
+		if (p->oneBitImage || p->applyColor)
+			return inkRow<uint32, InkOpReplaceColor<uint32, true, true> >;
+		return inkRow<uint32, InkOpTransparent<uint32> >;
+	case kInkTypeAddPin:
+		return inkRow<uint32, InkOpRGB<InkChannelAddPin> >;
+	case kInkTypeAdd:
+		return inkRow<uint32, InkOpRGB<InkChannelAdd> >;
+	case kInkTypeSubPin:
+		return inkRow<uint32, InkOpRGB<InkChannelSubPin> >;
+	case kInkTypeLight:
+		return inkRow<uint32, InkOpRGB<InkChannelLight> >;
+	case kInkTypeSub:
+		return inkRow<uint32, InkOpRGB<InkChannelSub> >;
+	case kInkTypeDark:
+		return inkRow<uint32, InkOpRGB<InkChannelDark> >;
+	default:
+		return nullptr;
+	}
+}
+
 uint32 DirectorEngine::getColorBlack() {
 	if (_pixelformat.bytesPerPixel == 1)
 		// needs to be the last entry in the palette.
@@ -737,9 +1029,6 @@ void DirectorPlotData::inkBlitSurface(Common::Rect &srcRect, const Graphics::Sur
 	if (sprite == kTextSprite || sprite == kButtonSprite || sprite == kCheckboxSprite || sprite == kRadioButtonSprite)
 		applyColor = false;
 
-	Common::Rect srfClip = srf->getBounds();
-	bool failedBoundsCheck = false;
-
 	// FAST PATH: if we're not doing any per-pixel ops,
 	// use the stock blitter. Your CPU will thank you.
 	if (!applyColor && !alpha && !ms) {
@@ -748,7 +1037,7 @@ void DirectorPlotData::inkBlitSurface(Common::Rect &srcRect, const Graphics::Sur
 			destRect.width(),
 			destRect.height()
 		);
-		offsetRect.clip(srfClip);
+		offsetRect.clip(srf->getBounds());
 		switch (ink) {
 		case kInkTypeCopy:
 			if (!mask) {
@@ -761,6 +1050,59 @@ void DirectorPlotData::inkBlitSurface(Common::Rect &srcRect, const Graphics::Sur
 		}
 	}
 
+	if (!inkBlitRows(srcRect, mask))
+		inkBlitPixels(srcRect, mask);
+}
+
+bool DirectorPlotData::inkBlitRows(Common::Rect &srcRect, const Graphics::Surface *mask) {
+	const Graphics::PixelFormat &format = d->_wm->_pixelformat;
+
+	// Shapes and colourized text still need drawPoint()
+	if (ms)
+		return false;
+	if (sprite == kTextSprite || sprite == kButtonSprite || sprite == kCheckboxSprite || sprite == kRadioButtonSprite)
+		return false;
+	if (srf->format.bytesPerPixel != format.bytesPerPixel || dst->format.bytesPerPixel != format.bytesPerPixel)
+		return false;
+
+	// Leave anything out of bounds to drawPoint(), which reports it
+	Common::Rect srcArea(Common::Point(abs(srcRect.left - destRect.left), abs(srcRect.top - destRect.top)),
+						 destRect.width(), destRect.height());
+	if (!srf->getBounds().contains(srcArea) || !dst->getBounds().contains(destRect))
+		return false;
+	if (mask && !Common::Rect(mask->w, mask->h).contains(srcArea))
+		return false;
+
+	InkRowFunc func = (format.bytesPerPixel == 1) ? getInkRowFunc8(this) : getInkRowFunc32(this);
+	if (!func)
+		return false;
+
+	InkRowParams params;
+	params.foreColor = foreColor;
+	params.backColor = backColor;
+	params.colorBlack = colorBlack;
+	params.colorWhite = colorWhite;
+	params.rgbMask = (0xff << format.rShift) | (0xff << format.gShift) | (0xff << format.bShift);
+	params.alphaBits = format.RGBToColor(0, 0, 0);
+	params.alpha = CLIP(alpha, 0, 255);
+	params.rShift = format.rShift;
+	params.gShift = format.gShift;
+	params.bShift = format.bShift;
+
+	for (int i = 0; i < destRect.height(); i++) {
+		const byte *msk = mask ? (const byte *)mask->getBasePtr(srcArea.left, srcArea.top + i) : nullptr;
+
+		func(dst->getBasePtr(destRect.left, destRect.top + i), srf->getBasePtr(srcArea.left, srcArea.top + i),
+			 msk, destRect.width(), params);
+	}
+
+	return true;
+}
+
+void DirectorPlotData::inkBlitPixels(Common::Rect &srcRect, const Graphics::Surface *mask) {
+	Common::Rect srfClip = srf->getBounds();
+	bool failedBoundsCheck = false;
+
 	// For blit efficiency, surfaces passed here need to be the same
 	// format as the window manager. Most of the time this is
 	// the job of BitmapCastMember::createWidget.
@@ -20,6 +20,7 @@
  */
 
 #include "common/config-manager.h"
+#include "common/random.h"
 #include "common/system.h"
 #include "common/compression/deflate.h"
 
@@ -165,6 +166,143 @@ void Window::testFonts() {
 	delete fontFile;
 }
 
+// Fills a surface with random colors, mixed with the ones the inks single out
+static void fillInkTestSurface(Graphics::ManagedSurface &surface, Common::RandomSource &rnd, const uint32 *specialColors, int numSpecial) {
+	const Graphics::PixelFormat &format = surface.format;
+
+	for (int y = 0; y < surface.h; y++) {
+		for (int x = 0; x < surface.w; x++) {
+			uint32 color;
+			if (rnd.getRandomNumber(3) == 0)
+				color = specialColors[rnd.getRandomNumber(numSpecial - 1)];
+			else if (format.bytesPerPixel == 1)
+				color = rnd.getRandomNumber(255);
+			else
+				color = format.RGBToColor(rnd.getRandomNumber(255), rnd.getRandomNumber(255), rnd.getRandomNumber(255));
+			surface.setPixel(x, y, color);
+		}
+	}
+}
+
+// Compares the row kernels with drawPoint() for every ink and option, with
+// the engine drawing in the given pixel format
+void Window::testInkKernelsInFormat(const Graphics::PixelFormat &format) {
+	static const InkType inks[] = {
+		kInkTypeCopy, kInkTypeTransparent, kInkTypeReverse, kInkTypeGhost,
+		kInkTypeNotCopy, kInkTypeNotTrans, kInkTypeNotReverse, kInkTypeNotGhost,
+		kInkTypeMatte, kInkTypeMask, kInkTypeBlend, kInkTypeAddPin, kInkTypeAdd,
+		kInkTypeSubPin, kInkTypeBackgndTrans, kInkTypeLight, kInkTypeSub, kInkTypeDark
+	};
+	Common::RandomSource rnd("inkkernels");
+	int numTested = 0, numFallback = 0;
+
+	g_director->setInkPixelFormat(format);
+
+	// Black and white are the last and first palette entries in 8bpp
+	const uint32 colorBlack = (format.bytesPerPixel == 1) ? g_director->_wm->_colorBlack : format.RGBToColor(0, 0, 0);
+	const uint32 colorWhite = (format.bytesPerPixel == 1) ? g_director->_wm->_colorWhite : format.RGBToColor(0xff, 0xff, 0xff);
+
+	const int w = 37, h = 11;
+	Graphics::ManagedSurface srf(w, h, format);
+	Graphics::ManagedSurface dstOrig(w + 8, h + 6, format);
+	Graphics::ManagedSurface dstRows(w + 8, h + 6, format);
+	Graphics::ManagedSurface dstPixels(w + 8, h + 6, format);
+	Graphics::Surface mask;
+	mask.create(w, h, Graphics::PixelFormat::createFormatCLUT8());
+
+	for (int i = 0; i < ARRAYSIZE(inks); i++) {
+		// Bit 0: one-bit image, bit 1: colorized, bit 2: mask, bit 3: blend factor
+		for (int options = 0; options < 16; options++) {
+			bool applyColor = options & 2;
+			uint32 foreColor = applyColor ? g_director->_wm->findBestColor(0xc0, 0x20, 0x40) : colorBlack;
+			uint32 backColor = applyColor ? g_director->_wm->findBestColor(0x30, 0xe0, 0x90) : colorWhite;
+
+			DirectorPlotData pd(g_director, kBitmapSprite, inks[i], (options & 8) ? 100 : 0, backColor, foreColor);
+			pd.colorBlack = colorBlack;
+			pd.colorWhite = colorWhite;
+			pd.oneBitImage = options & 1;
+			pd.applyColor = applyColor;
+			pd.srf = &srf;
+
+			const uint32 specialColors[] = { colorBlack, colorWhite, foreColor, backColor };
+			fillInkTestSurface(srf, rnd, specialColors, ARRAYSIZE(specialColors));
+			fillInkTestSurface(dstOrig, rnd, specialColors, ARRAYSIZE(specialColors));
+			for (int y = 0; y < h; y++) {
+				for (int x = 0; x < w; x++)
+					*(byte *)mask.getBasePtr(x, y) = rnd.getRandomBit() ? 0xff : 0;
+			}
+
+			// Draw the sprite from its third column and second row on
+			Common::Rect srcRect(3, 2, 3 + w, 2 + h);
+			pd.destRect = Common::Rect(5, 3, 5 + w - 2, 3 + h - 1);
+			const Graphics::Surface *msk = (options & 4) ? &mask : nullptr;
+
+			dstRows.copyFrom(dstOrig);
+			dstPixels.copyFrom(dstOrig);
+
+			pd.dst = &dstRows;
+			if (!pd.inkBlitRows(srcRect, msk)) {
+				numFallback++;
+				continue;
+			}
+			pd.dst = &dstPixels;
+			pd.inkBlitPixels(srcRect, msk);
+
+			numTested++;
+			for (int y = 0; y < dstRows.h; y++) {
+				if (memcmp(dstRows.getBasePtr(0, y), dstPixels.getBasePtr(0, y), dstRows.w * format.bytesPerPixel))
+					error("testInkKernels(): %d bpp ink %d with options %d differs from drawPoint() in row %d", format.bytesPerPixel * 8, inks[i], options, y);
+			}
+		}
+	}
+
+	mask.free();
+	debug("testInkKernels(): %d bpp: %d combinations tested, %d left to drawPoint()", format.bytesPerPixel * 8, numTested, numFallback);
+
+	// Compare the speed of both paths on a full screen matte sprite
+	if (!debugChannelSet(-1, kDebugImages))
+		return;
+
+	srf.create(640, 480, format);
+	dstRows.create(640, 480, format);
+	mask.create(640, 480, Graphics::PixelFormat::createFormatCLUT8());
+	const uint32 specialColors[] = { colorWhite };
+	fillInkTestSurface(srf, rnd, specialColors, ARRAYSIZE(specialColors));
+	for (int y = 0; y < 480; y++)
+		memset(mask.getBasePtr(0, y), (y & 1) ? 0xff : 0, 640);
+
+	DirectorPlotData pd(g_director, kBitmapSprite, kInkTypeMatte, 0, colorWhite, colorBlack);
+	pd.colorBlack = colorBlack;
+	pd.colorWhite = colorWhite;
+	pd.srf = &srf;
+	pd.dst = &dstRows;
+	pd.destRect = Common::Rect(640, 480);
+	Common::Rect srcRect(640, 480);
+
+	uint32 start = g_system->getMillis();
+	for (int i = 0; i < 20; i++)
+		pd.inkBlitRows(srcRect, &mask);
+	uint32 rowsTime = g_system->getMillis() - start;
+
+	start = g_system->getMillis();
+	for (int i = 0; i < 20; i++)
+		pd.inkBlitPixels(srcRect, &mask);
+	uint32 pixelsTime = g_system->getMillis() - start;
+
+	debug("testInkKernels(): %d bpp: 20 full screen matte sprites take %u ms with row kernels, %u ms with drawPoint()", format.bytesPerPixel * 8, rowsTime, pixelsTime);
+
+	mask.free();
+}
+
+void Window::testInkKernels() {
+	const Graphics::PixelFormat oldFormat = g_director->_pixelformat;
+
+	testInkKernelsInFormat(Graphics::PixelFormat::createFormatCLUT8());
+	testInkKernelsInFormat(Graphics::PixelFormat(4, 8, 8, 8, 8, 24, 16, 8, 0));
+
+	g_director->setInkPixelFormat(oldFormat);
+}
+
 //////////////////////
 // Movie iteration
 //////////////////////
@@ -339,6 +477,8 @@ void Window::runTests() {
 		testFonts();
 	}
 
+	testInkKernels();
+
 	g_lingo->runTests();
 }
 
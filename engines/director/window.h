@@ -194,6 +194,8 @@ public:
 	Common::HashMap<Common::String, Movie *> *scanMovies(const Common::Path &folder);
 	void testFontScaling();
 	void testFonts();
+	void testInkKernels();
+	void testInkKernelsInFormat(const Graphics::PixelFormat &format);
 	void enqueueAllMovies();
 	MovieReference getNextMovieFromQueue();
 	void runTests();
@@ -20,6 +20,7 @@
  */
 
 #include "glk/debugger.h"
+#include "glk/events.h"
 #include "glk/glk.h"
 #include "glk/raw_decoder.h"
 #include "common/file.h"
@@ -30,6 +31,7 @@ namespace Glk {
 
 Debugger::Debugger() : GUI::Debugger() {
 	registerCmd("dumppic", WRAP_METHOD(Debugger, cmdDumpPic));
+	registerCmd("replay", WRAP_METHOD(Debugger, cmdReplay));
 }
 
 int Debugger::strToInt(const char *s) {
@@ -137,4 +139,35 @@ void Debugger::saveRawPicture(const RawDecoder &rd, Common::WriteStream &ws) {
 #endif
 }
 
+bool Debugger::cmdReplay(int argc, const char **argv) {
+	if (argc != 2) {
+		debugPrintf("Format: replay <transcript file>\n");
+		debugPrintf("The file holds one command per line. Each turn is timed, and the totals are logged at the end\n");
+		return true;
+	}
+
+	Common::File f;
+	if (!f.open(Common::Path(argv[1]))) {
+		debugPrintf("Could not open %s\n", argv[1]);
+		return true;
+	}
+
+	Common::StringArray lines;
+	while (!f.eos() && !f.err()) {
+		Common::String line = f.readLine();
+		if (f.eos() && line.empty())
+			break;
+		lines.push_back(line);
+	}
+
+	if (lines.empty()) {
+		debugPrintf("The transcript has no commands\n");
+		return true;
+	}
+
+	g_vm->_events->replay(lines);
+	debugPrintf("Replaying %u commands\n", lines.size());
+	return false;
+}
+
 } // End of namespace Glk
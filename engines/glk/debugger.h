@@ -42,6 +42,11 @@ private:
 	 * Dump a picture
 	 */
 	bool cmdDumpPic(int argc, const char **argv);
+
+	/**
+	 * Replay the commands of a transcript, timing the turns
+	 */
+	bool cmdReplay(int argc, const char **argv);
 protected:
 	/**
 	 * Convert a numeric string to an integer
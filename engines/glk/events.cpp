@@ -56,7 +56,8 @@ const byte ARROW[] = {
 };
 
 Events::Events() : _forceClick(false), _currentEvent(nullptr), _cursorId(CURSOR_NONE),
-	_timerMilli(0), _timerTimeExpiry(0), _priorFrameTime(0), _frameCounter(0) {
+	_timerMilli(0), _timerTimeExpiry(0), _priorFrameTime(0), _frameCounter(0),
+	_replayLine(0), _replayTurnStart(0), _replayTotalTime(0), _replayMaxTime(0) {
 	initializeCursors();
 }
 
@@ -119,12 +120,17 @@ void Events::getEvent(event_t *event, bool polled) {
 	_currentEvent  = event;
 	event->clear();
 
+	if (!polled)
+		endReplayTurn();
+
 	dispatchEvent(*_currentEvent, polled);
 
 	if (!polled) {
 		while (!g_vm->shouldQuit() && _currentEvent->type == evtype_None && !isTimerExpired()) {
-			pollEvents();
-			g_system->delayMillis(10);
+			if (!replayNextLine()) {
+				pollEvents();
+				g_system->delayMillis(10);
+			}
 
 			dispatchEvent(*_currentEvent, polled);
 		}
@@ -143,6 +149,63 @@ void Events::getEvent(event_t *event, bool polled) {
 	_currentEvent = nullptr;
 }
 
+void Events::replay(const Common::StringArray &lines) {
+	_replayLines = lines;
+	_replayLine = 0;
+	_replayTurnStart = 0;
+	_replayTotalTime = 0;
+	_replayMaxTime = 0;
+}
+
+bool Events::replayNextLine() {
+	if (_replayLine >= _replayLines.size())
+		return false;
+
+	// Only lines are replayed, so anything else the game waits for, such as
+	// a key press or a [MORE] prompt, is left to the player
+	if (Windows::_moreFocus)
+		return false;
+
+	Windows &windows = *g_vm->_windows;
+	Window *win = nullptr;
+	for (Windows::iterator i = windows.begin(); i != windows.end(); ++i) {
+		if ((*i)->_lineRequest || (*i)->_lineRequestUni) {
+			win = *i;
+			break;
+		}
+	}
+	if (!win)
+		return false;
+
+	windows.setFocus(win);
+
+	const Common::String &line = _replayLines[_replayLine++];
+	for (uint idx = 0; idx < line.size(); ++idx)
+		windows.inputHandleKey((byte)line[idx]);
+	windows.inputHandleKey(keycode_Return);
+
+	// Timing starts once the command is entered, and runs until the game waits for input again
+	_replayTurnStart = MAX<uint32>(g_system->getMillis(), 1);
+	return true;
+}
+
+void Events::endReplayTurn() {
+	if (!_replayTurnStart)
+		return;
+
+	uint32 turnTime = g_system->getMillis() - _replayTurnStart;
+	_replayTurnStart = 0;
+	_replayTotalTime += turnTime;
+	_replayMaxTime = MAX(_replayMaxTime, turnTime);
+
+	if (_replayLine >= _replayLines.size()) {
+		debug("Replayed %u turns in %u ms, average %u ms, slowest %u ms", _replayLines.size(),
+			_replayTotalTime, _replayTotalTime / _replayLines.size(), _replayMaxTime);
+		_replayLines.clear();
+		_replayLine = 0;
+	}
+}
+
 void Events::store(EvType type, Window *win, uint val1, uint val2) {
 	Event ev(type, win, val1, val2);
 
@@ -23,6 +23,7 @@
 #define GLK_EVENTS_H
 
 #include "common/events.h"
+#include "common/str-array.h"
 #include "graphics/surface.h"
 #include "glk/utils.h"
 
@@ -174,6 +175,11 @@ private:
 	Surface _cursors[4];            ///< Cursor pixel data
 	uint _timerMilli;               ///< Time in milliseconds between timer events
 	uint _timerTimeExpiry;          ///< When to trigger next timer event
+	Common::StringArray _replayLines; ///< Commands of a transcript being replayed
+	uint _replayLine;               ///< Next command to replay
+	uint32 _replayTurnStart;        ///< When the current replayed turn started, or 0
+	uint32 _replayTotalTime;        ///< Total time of the replayed turns
+	uint32 _replayMaxTime;          ///< Time of the slowest replayed turn
 private:
 	/**
 	 * Initialize the cursor graphics
@@ -220,6 +226,17 @@ private:
 	 */
 	void handleButtonUp(bool isLeft, const Point &pos);
 
+	/**
+	 * Types in the next command of the replayed transcript, if any, as long as
+	 * a window is waiting for line input. Returns true if a command was sent
+	 */
+	bool replayNextLine();
+
+	/**
+	 * Records the time taken by the replayed turn that just finished, if any
+	 */
+	void endReplayTurn();
+
 	/**
 	 * Returns true if the passed keycode is for the Ctrl or Alt keys
 	 */
@@ -242,6 +259,12 @@ public:
 	  */
 	void getEvent(event_t *event, bool polled);
 
+	/**
+	 * Replays the commands of a transcript as line input, one per line, as fast as the game
+	 * takes them. The time the game took for each turn is logged at the end
+	 */
+	void replay(const Common::StringArray &lines);
+
 	/**
 	 * Store an event for retrieval
 	 */
@@ -0,0 +1,161 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "common/endian.h"
+#include "glk/glulx/decode.h"
+
+namespace Glk {
+namespace Glulx {
+
+uint decode_opcode(const byte *mem, uint &addr) {
+	uint opcode = mem[addr];
+	addr++;
+	if (opcode & 0x80) {
+		/* More than one-byte opcode. */
+		if (opcode & 0x40) {
+			/* Four-byte opcode */
+			opcode &= 0x3F;
+			opcode = (opcode << 8) | mem[addr];
+			addr++;
+			opcode = (opcode << 8) | mem[addr];
+			addr++;
+			opcode = (opcode << 8) | mem[addr];
+			addr++;
+		} else {
+			/* Two-byte opcode */
+			opcode &= 0x7F;
+			opcode = (opcode << 8) | mem[addr];
+			addr++;
+		}
+	}
+
+	return opcode;
+}
+
+const char *decode_operands(const byte *mem, uint &addr, uint limit, uint ramstart,
+		const operandlist_t *oplist, byte *modes, uint *values) {
+	int numops = oplist->num_ops;
+	uint modeaddr = addr;
+	int modeval = 0;
+
+	uint pos = addr + (numops + 1) / 2;
+	if (pos > limit)
+		return "Operand modes out of range.";
+
+	for (int ix = 0; ix < numops; ix++) {
+		int mode;
+
+		if ((ix & 1) == 0) {
+			modeval = mem[modeaddr];
+			mode = (modeval & 0x0F);
+		} else {
+			mode = ((modeval >> 4) & 0x0F);
+			modeaddr++;
+		}
+
+		/* Length of the operand data */
+		uint len;
+		switch (mode) {
+		case 0: /* constant zero, discard value */
+		case 8: /* pop off stack, push on stack */
+			len = 0;
+			break;
+		case 1: /* one-byte constant */
+		case 5: /* main memory, one-byte address */
+		case 9: /* locals, one-byte address */
+		case 13: /* main memory RAM, one-byte address */
+			len = 1;
+			break;
+		case 2: /* two-byte constant */
+		case 6: /* main memory, two-byte address */
+		case 10: /* locals, two-byte address */
+		case 14: /* main memory RAM, two-byte address */
+			len = 2;
+			break;
+		case 3: /* four-byte constant */
+		case 7: /* main memory, four-byte address */
+		case 11: /* locals, four-byte address */
+		case 15: /* main memory RAM, four-byte address */
+			len = 4;
+			break;
+		default:
+			if (oplist->formlist[ix] == modeform_Load)
+				return "Unknown addressing mode in load operand.";
+			return "Unknown addressing mode in store operand.";
+		}
+
+		if (pos + len > limit)
+			return "Operand out of range.";
+
+		uint value = 0;
+		if (len == 1) {
+			value = mem[pos];
+			/* Sign-extend from 8 bits to 32 */
+			if (mode == 1)
+				value = (int)(signed char)value;
+		} else if (len == 2) {
+			value = READ_BE_UINT16(mem + pos);
+			/* Sign-extend from 16 bits to 32 */
+			if (mode == 2)
+				value = (int)(int16)value;
+		} else if (len == 4) {
+			/* Bytes must not be sign-extended. */
+			value = READ_BE_UINT32(mem + pos);
+		}
+		pos += len;
+
+		if (mode >= 13)
+			value += ramstart;
+
+		if (oplist->formlist[ix] == modeform_Load) {
+			if (mode <= 3)
+				modes[ix] = decodedmode_Const;
+			else if (mode == 8)
+				modes[ix] = decodedmode_Pop;
+			else if (mode >= 9 && mode <= 11)
+				modes[ix] = decodedmode_Locals;
+			else
+				modes[ix] = decodedmode_Mem;
+		} else {
+			/* The desttype of store_operand(). The store address for locals is
+			   relative to the current locals segment, not an absolute stack
+			   position. */
+			if (mode == 0)
+				modes[ix] = 0;
+			else if (mode == 8)
+				modes[ix] = 3;
+			else if (mode >= 9 && mode <= 11)
+				modes[ix] = 2;
+			else if (mode >= 5)
+				modes[ix] = 1;
+			else
+				return "Constant addressing mode in store operand.";
+		}
+
+		values[ix] = value;
+	}
+
+	addr = pos;
+	return nullptr;
+}
+
+} // End of namespace Glulx
+} // End of namespace Glk
@@ -0,0 +1,56 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef GLK_GLULXE_DECODE
+#define GLK_GLULXE_DECODE
+
+#include "glk/glk_types.h"
+#include "glk/glulx/glulx_types.h"
+
+namespace Glk {
+namespace Glulx {
+
+/**
+ * Read the opcode number of the instruction at addr. Upon return, addr is at the
+ * beginning of the operand mode list.
+ */
+extern uint decode_opcode(const byte *mem, uint &addr);
+
+/**
+ * Decode the operands of an instruction, without looking at the VM state. addr must be
+ * at the beginning of the operand mode list; upon return, it is at the beginning of the
+ * next instruction.
+ *
+ * For load operands, modes receives a decodedmode and values the constant, the main
+ * memory address or the locals offset. For store operands, modes receives the
+ * desttype and values the destination address, as store_operand() takes them. Addresses
+ * in the RAM modes have ramstart added.
+ *
+ * Returns nullptr on success, or the error message if the operands don't end before
+ * limit or use a mode that isn't allowed.
+ */
+extern const char *decode_operands(const byte *mem, uint &addr, uint limit, uint ramstart,
+	const operandlist_t *oplist, byte *modes, uint *values);
+
+} // End of namespace Glulx
+} // End of namespace Glk
+
+#endif
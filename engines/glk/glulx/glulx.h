@@ -145,6 +145,13 @@ private:
 	 */
 	const operandlist_t *fast_operandlist[0x80];
 
+	/**
+	 * Direct-mapped cache of the instructions in ROM, decoded ahead of running them. ROM can't
+	 * be written, so the entries never go stale. Instructions in RAM, which may be modified, are
+	 * decoded every time they run.
+	 */
+	decodedinst_t *decoded_cache;
+
 	/**@}*/
 
 	/**
@@ -551,6 +558,24 @@ public:
 	*/
 	void parse_operands(oparg_t *opargs, const operandlist_t *oplist);
 
+	/**
+	 * Return the decoded form of the instruction at the PC, decoding it if it isn't cached yet.
+	 * Returns nullptr if the instruction isn't entirely in ROM.
+	 */
+	const decodedinst_t *get_decoded_instruction();
+
+	/**
+	 * Like parse_operands(), for the operands of a decoded instruction. Upon return, the PC
+	 * will be at the beginning of the next instruction.
+	 */
+	void parse_decoded_operands(oparg_t *opargs, const decodedinst_t *dinst);
+
+	/**
+	 * Put the values of operands decoded by decode_operands() in args, doing the loads
+	 * which depend on the VM state.
+	 */
+	void resolve_operands(oparg_t *args, const operandlist_t *oplist, const byte *modes, const uint *values);
+
 	/**
 	 * Store a result value, according to the desttype and destaddress given. This is usually used to store
 	 * the result of an opcode, but it's also used by any code that pulls a call-stub off the stack.
@@ -351,6 +351,35 @@ typedef oparg_struct oparg_t;
 
 #define MAX_OPERANDS (8)
 
+/**
+ * How the value of a load operand of a decoded instruction is found.
+ */
+enum decodedmode {
+	decodedmode_Const = 0,   ///< The value itself
+	decodedmode_Pop = 1,     ///< Pop off the stack
+	decodedmode_Mem = 2,     ///< Read at a main memory address
+	decodedmode_Locals = 3   ///< Read at an offset in the locals
+};
+
+/**
+ * An instruction in ROM, decoded ahead of running it. The addressing modes of its
+ * operands are resolved as far as they can be without looking at the VM state.
+ */
+struct decodedinst_struct {
+	uint addr;                  ///< Address of the instruction, or 0xFFFFFFFF if unused
+	uint nextaddr;              ///< Address of the following instruction
+	uint opcode;
+	const operandlist_t *oplist;
+	byte modes[MAX_OPERANDS];   ///< decodedmode for loads, desttype for stores
+	uint values[MAX_OPERANDS];  ///< Constant, address or offset for loads, store address for stores
+};
+typedef decodedinst_struct decodedinst_t;
+
+/**
+ * Number of entries in the cache of decoded instructions. Must be a power of two.
+ */
+#define DECODED_CACHE_SIZE (0x4000)
+
 typedef uint(Glulx::*acceleration_func)(uint argc, uint *argv);
 
 struct accelentry_struct {
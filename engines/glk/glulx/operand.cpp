@@ -20,6 +20,7 @@
  */
 
 #include "glk/glulx/glulx.h"
+#include "glk/glulx/decode.h"
 
 namespace Glk {
 namespace Glulx {
@@ -66,6 +67,9 @@ static const operandlist_t list_LLSS = { 4, 4, &array_LLSS[0] };
 void Glulx::init_operands() {
 	for (int ix = 0; ix < 0x80; ix++)
 		fast_operandlist[ix] = lookup_operandlist(ix);
+
+	for (int ix = 0; ix < DECODED_CACHE_SIZE; ix++)
+		decoded_cache[ix].addr = 0xFFFFFFFF;
 }
 
 const operandlist_t *Glulx::lookup_operandlist(uint opcode) {
@@ -280,239 +284,111 @@ const operandlist_t *Glulx::lookup_operandlist(uint opcode) {
 }
 
 void Glulx::parse_operands(oparg_t *args, const operandlist_t *oplist) {
-	int ix;
-	oparg_t *curarg;
+	byte modes[MAX_OPERANDS];
+	uint values[MAX_OPERANDS];
+
+	const char *error = decode_operands(memmap, pc, endmem, ramstart, oplist, modes, values);
+	if (error)
+		fatal_error(error);
+
+	resolve_operands(args, oplist, modes, values);
+}
+
+const decodedinst_t *Glulx::get_decoded_instruction() {
+	decodedinst_t *dinst = &decoded_cache[pc & (DECODED_CACHE_SIZE - 1)];
+	if (dinst->addr == pc)
+		return dinst;
+
+	/* Only the instructions that lie entirely in ROM are cached, since
+	   nothing can write there. Anything else, including an instruction
+	   that would raise an error, is left to the regular decoding. */
+	uint addr = pc;
+	if (addr >= ramstart)
+		return nullptr;
+
+	uint opcode = decode_opcode(memmap, addr);
+	if (addr > ramstart)
+		return nullptr;
+
+	const operandlist_t *oplist;
+	if (opcode < 0x80)
+		oplist = fast_operandlist[opcode];
+	else
+		oplist = lookup_operandlist(opcode);
+
+	byte modes[MAX_OPERANDS];
+	uint values[MAX_OPERANDS];
+	if (!oplist || decode_operands(memmap, addr, ramstart, ramstart, oplist, modes, values))
+		return nullptr;
+
+	dinst->addr = pc;
+	dinst->nextaddr = addr;
+	dinst->opcode = opcode;
+	dinst->oplist = oplist;
+	memcpy(dinst->modes, modes, oplist->num_ops);
+	memcpy(dinst->values, values, oplist->num_ops * sizeof(uint));
+	return dinst;
+}
+
+void Glulx::parse_decoded_operands(oparg_t *args, const decodedinst_t *dinst) {
+	pc = dinst->nextaddr;
+	resolve_operands(args, dinst->oplist, dinst->modes, dinst->values);
+}
+
+void Glulx::resolve_operands(oparg_t *args, const operandlist_t *oplist, const byte *modes, const uint *values) {
 	int numops = oplist->num_ops;
 	int argsize = oplist->arg_size;
-	uint modeaddr = pc;
-	int modeval = 0;
+	oparg_t *curarg = args;
 
-	pc += (numops + 1) / 2;
+	for (int ix = 0; ix < numops; ix++, curarg++) {
+		uint value = values[ix];
 
-	for (ix = 0, curarg = args; ix < numops; ix++, curarg++) {
-		int mode;
-		uint value;
-		uint addr;
+		if (oplist->formlist[ix] == modeform_Store) {
+			curarg->desttype = modes[ix];
+			curarg->value = value;
+			continue;
+		}
 
 		curarg->desttype = 0;
 
-		if ((ix & 1) == 0) {
-			modeval = Mem1(modeaddr);
-			mode = (modeval & 0x0F);
-		} else {
-			mode = ((modeval >> 4) & 0x0F);
-			modeaddr++;
-		}
+		switch (modes[ix]) {
+		case decodedmode_Const:
+			break;
 
-		if (oplist->formlist[ix] == modeform_Load) {
-
-			switch (mode) {
-
-			case 8: /* pop off stack */
-				if (stackptr < valstackbase + 4) {
-					fatal_error("Stack underflow in operand.");
-				}
-				stackptr -= 4;
-				value = Stk4(stackptr);
-				break;
-
-			case 0: /* constant zero */
-				value = 0;
-				break;
-
-			case 1: /* one-byte constant */
-				/* Sign-extend from 8 bits to 32 */
-				value = (int)(signed char)(Mem1(pc));
-				pc++;
-				break;
-
-			case 2: /* two-byte constant */
-				/* Sign-extend the first byte from 8 bits to 32; the subsequent
-				   byte must not be sign-extended. */
-				value = (int)(signed char)(Mem1(pc));
-				pc++;
-				value = (value << 8) | (uint)(Mem1(pc));
-				pc++;
-				break;
-
-			case 3: /* four-byte constant */
-				/* Bytes must not be sign-extended. */
-				value = Mem4(pc);
-				pc += 4;
-				break;
-
-			case 15: /* main memory RAM, four-byte address */
-				addr = Mem4(pc);
-				addr += ramstart;
-				pc += 4;
-				goto MainMemAddr;
-
-			case 14: /* main memory RAM, two-byte address */
-				addr = (uint)Mem2(pc);
-				addr += ramstart;
-				pc += 2;
-				goto MainMemAddr;
-
-			case 13: /* main memory RAM, one-byte address */
-				addr = (uint)(Mem1(pc));
-				addr += ramstart;
-				pc++;
-				goto MainMemAddr;
-
-			case 7: /* main memory, four-byte address */
-				addr = Mem4(pc);
-				pc += 4;
-				goto MainMemAddr;
-
-			case 6: /* main memory, two-byte address */
-				addr = (uint)Mem2(pc);
-				pc += 2;
-				goto MainMemAddr;
-
-			case 5: /* main memory, one-byte address */
-				addr = (uint)(Mem1(pc));
-				pc++;
-				/* fall through */
-
-MainMemAddr:
-				/* cases 5, 6, 7, 13, 14, 15 all wind up here. */
-				if (argsize == 4) {
-					value = Mem4(addr);
-				} else if (argsize == 2) {
-					value = Mem2(addr);
-				} else {
-					value = Mem1(addr);
-				}
-				break;
-
-			case 11: /* locals, four-byte address */
-				addr = Mem4(pc);
-				pc += 4;
-				goto LocalsAddr;
-
-			case 10: /* locals, two-byte address */
-				addr = (uint)Mem2(pc);
-				pc += 2;
-				goto LocalsAddr;
-
-			case 9: /* locals, one-byte address */
-				addr = (uint)(Mem1(pc));
-				pc++;
-				/* fall through */
-
-LocalsAddr:
-				/* cases 9, 10, 11 all wind up here. It's illegal for addr to not
-				   be four-byte aligned, but we don't check this explicitly.
-				   A "strict mode" interpreter probably should. It's also illegal
-				   for addr to be less than zero or greater than the size of
-				   the locals segment. */
-				addr += localsbase;
-				if (argsize == 4) {
-					value = Stk4(addr);
-				} else if (argsize == 2) {
-					value = Stk2(addr);
-				} else {
-					value = Stk1(addr);
-				}
-				break;
-
-			default:
-				value = 0;
-				fatal_error("Unknown addressing mode in load operand.");
+		case decodedmode_Pop:
+			if (stackptr < valstackbase + 4) {
+				fatal_error("Stack underflow in operand.");
 			}
-
-			curarg->value = value;
-
-		} else { /* modeform_Store */
-			switch (mode) {
-
-			case 0: /* discard value */
-				curarg->desttype = 0;
-				curarg->value = 0;
-				break;
-
-			case 8: /* push on stack */
-				curarg->desttype = 3;
-				curarg->value = 0;
-				break;
-
-			case 15: /* main memory RAM, four-byte address */
-				addr = Mem4(pc);
-				addr += ramstart;
-				pc += 4;
-				goto WrMainMemAddr;
-
-			case 14: /* main memory RAM, two-byte address */
-				addr = (uint)Mem2(pc);
-				addr += ramstart;
-				pc += 2;
-				goto WrMainMemAddr;
-
-			case 13: /* main memory RAM, one-byte address */
-				addr = (uint)(Mem1(pc));
-				addr += ramstart;
-				pc++;
-				goto WrMainMemAddr;
-
-			case 7: /* main memory, four-byte address */
-				addr = Mem4(pc);
-				pc += 4;
-				goto WrMainMemAddr;
-
-			case 6: /* main memory, two-byte address */
-				addr = (uint)Mem2(pc);
-				pc += 2;
-				goto WrMainMemAddr;
-
-			case 5: /* main memory, one-byte address */
-				addr = (uint)(Mem1(pc));
-				pc++;
-				/* fall through */
-
-WrMainMemAddr:
-				/* cases 5, 6, 7 all wind up here. */
-				curarg->desttype = 1;
-				curarg->value = addr;
-				break;
-
-			case 11: /* locals, four-byte address */
-				addr = Mem4(pc);
-				pc += 4;
-				goto WrLocalsAddr;
-
-			case 10: /* locals, two-byte address */
-				addr = (uint)Mem2(pc);
-				pc += 2;
-				goto WrLocalsAddr;
-
-			case 9: /* locals, one-byte address */
-				addr = (uint)(Mem1(pc));
-				pc++;
-				/* fall through */
-
-WrLocalsAddr:
-				/* cases 9, 10, 11 all wind up here. It's illegal for addr to not
-				   be four-byte aligned, but we don't check this explicitly.
-				   A "strict mode" interpreter probably should. It's also illegal
-				   for addr to be less than zero or greater than the size of
-				   the locals segment. */
-				curarg->desttype = 2;
-				/* We don't add localsbase here; the store address for desttype 2
-				   is relative to the current locals segment, not an absolute
-				   stack position. */
-				curarg->value = addr;
-				break;
-
-			case 1:
-			case 2:
-			case 3:
-				fatal_error("Constant addressing mode in store operand.");
-				break;
-
-			default:
-				fatal_error("Unknown addressing mode in store operand.");
+			stackptr -= 4;
+			value = Stk4(stackptr);
+			break;
+
+		case decodedmode_Mem:
+			if (argsize == 4) {
+				value = Mem4(value);
+			} else if (argsize == 2) {
+				value = Mem2(value);
+			} else {
+				value = Mem1(value);
+			}
+			break;
+
+		default: /* decodedmode_Locals */
+			/* It's illegal for the offset to not be four-byte aligned, or to
+			   be outside the locals segment, but we don't check this
+			   explicitly. A "strict mode" interpreter probably should. */
+			value += localsbase;
+			if (argsize == 4) {
+				value = Stk4(value);
+			} else if (argsize == 2) {
+				value = Stk2(value);
+			} else {
+				value = Stk1(value);
 			}
+			break;
 		}
+
+		curarg->value = value;
 	}
 }
 
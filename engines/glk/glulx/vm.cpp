@@ -85,6 +85,14 @@ void Glulx::setup_vm() {
 		memmap = nullptr;
 		fatal_error("Unable to allocate Glulx stack space.");
 	}
+	decoded_cache = (decodedinst_t *)glulx_malloc(DECODED_CACHE_SIZE * sizeof(decodedinst_t));
+	if (!decoded_cache) {
+		glulx_free(stack);
+		stack = nullptr;
+		glulx_free(memmap);
+		memmap = nullptr;
+		fatal_error("Unable to allocate the decoded instruction cache.");
+	}
 	stringtable = 0;
 
 	// Initialize various other things in the terp.
@@ -114,6 +122,10 @@ void Glulx::finalize_vm() {
 		glulx_free(stack);
 		stack = nullptr;
 	}
+	if (decoded_cache) {
+		glulx_free(decoded_cache);
+		decoded_cache = nullptr;
+	}
 
 	final_serial();
 }
@@ -178,6 +178,7 @@ MODULE_OBJS := \
 	comprehend/game_tr2.o \
 	comprehend/pics.o \
 	glulx/accel.o \
+	glulx/decode.o \
 	glulx/exec.o \
 	glulx/float.o \
 	glulx/funcs.o \
@@ -26,6 +26,7 @@
 #include "backends/keymapper/keymap.h"
 #include "backends/keymapper/standard-actions.h"
 
+#include "common/memstream.h"
 #include "common/savefile.h"
 #include "common/system.h"
 #include "common/translation.h"
@@ -409,6 +410,9 @@ SaveStateList MetaEngine::listSaves(const char *target) const {
 		}
 	}
 
+	// Keep what was read for the next session
+	saveFileMan->flushSavefileMetaData();
+
 	// Sort saves based on slot number.
 	Common::sort(saveList.begin(), saveList.end(), SaveStateDescriptorSlotComparator());
 	return saveList;
@@ -469,26 +473,112 @@ bool MetaEngine::removeSaveState(const char *target, int slot) const {
 	return g_system->getSavefileManager()->removeSavefile(getSavegameFile(slot, target));
 }
 
+// The metadata of saves in the extended format, as kept in the metadata
+// index of the save file manager
+enum {
+	kSaveMetaDataVersion = 1
+};
+
+static void writeSaveMetaData(Common::WriteStream &out, const ExtendedSavegameHeader *header) {
+	out.writeByte(kSaveMetaDataVersion);
+	out.writeByte(header != nullptr);
+	if (!header)
+		return;
+
+	out.writeUint32LE(header->date);
+	out.writeUint16LE(header->time);
+	out.writeUint32LE(header->playtime);
+	out.writeUint32LE(header->description.size());
+	out.writeString(header->description);
+	out.writeByte(header->isAutosave);
+	out.writeByte(header->thumbnail != nullptr);
+	if (header->thumbnail)
+		Graphics::saveThumbnail(out, *header->thumbnail);
+}
+
+static bool readSaveMetaData(Common::SeekableReadStream &in, bool &hasHeader, ExtendedSavegameHeader *header) {
+	if (in.readByte() != kSaveMetaDataVersion)
+		return false;
+
+	hasHeader = in.readByte() != 0;
+	if (!hasHeader)
+		return !in.err() && !in.eos();
+
+	header->date = in.readUint32LE();
+	header->time = in.readUint16LE();
+	header->playtime = in.readUint32LE();
+	const uint32 descriptionSize = in.readUint32LE();
+	header->description = in.readString(0, descriptionSize);
+	header->isAutosave = in.readByte() != 0;
+	const bool hasThumbnail = in.readByte() != 0;
+	if (in.err() || in.eos())
+		return false;
+
+	return !hasThumbnail || Graphics::loadThumbnail(in, header->thumbnail);
+}
+
 SaveStateDescriptor MetaEngine::querySaveMetaInfos(const char *target, int slot) const {
 	if (!hasFeature(kSavesUseExtendedFormat))
 		return SaveStateDescriptor();
 
-	Common::ScopedPtr<Common::InSaveFile> f(g_system->getSavefileManager()->openForLoading(
-		getSavegameFile(slot, target)));
+	Common::SaveFileManager *saveFileMan = g_system->getSavefileManager();
+	const Common::String filename = getSavegameFile(slot, target);
 
-	if (f) {
-		ExtendedSavegameHeader header;
-		if (!readSavegameHeader(f.get(), &header, false)) {
-			return SaveStateDescriptor();
+	if (_saveMetaInfoCacheTarget != target) {
+		_saveMetaInfoCache.clear();
+		_saveMetaInfoCacheTarget = target;
+	}
+
+	// Reading the header means decoding the thumbnail, which adds up for
+	// games with many saves, so reuse what was read before if the file
+	// did not change since
+	const uint32 revision = saveFileMan->getSavefileRevision(filename);
+	if (revision != 0) {
+		SaveMetaInfoCache::const_iterator cached = _saveMetaInfoCache.find(filename);
+		if (cached != _saveMetaInfoCache.end() && cached->_value.revision == revision)
+			return cached->_value.desc;
+	}
+
+	// The save file manager may also keep what was read in earlier
+	// sessions, which avoids opening the save file at all
+	SaveStateDescriptor desc;
+	ExtendedSavegameHeader header;
+	bool hasHeader = false;
+	bool found = false;
+
+	Common::ScopedPtr<Common::SeekableReadStream> metaData(saveFileMan->openSavefileMetaData(target, filename));
+	if (metaData) {
+		found = readSaveMetaData(*metaData, hasHeader, &header);
+		if (!found) {
+			delete header.thumbnail;
+			header = ExtendedSavegameHeader();
 		}
+	}
 
+	if (!found) {
+		Common::ScopedPtr<Common::InSaveFile> f(saveFileMan->openForLoading(filename));
+		if (!f)
+			return SaveStateDescriptor();
+
+		hasHeader = readSavegameHeader(f.get(), &header, false);
+
+		Common::MemoryWriteStreamDynamic out(DisposeAfterUse::YES);
+		writeSaveMetaData(out, hasHeader ? &header : nullptr);
+		saveFileMan->storeSavefileMetaData(target, filename, out.getData(), out.size());
+	}
+
+	if (hasHeader) {
 		// Create the return descriptor
-		SaveStateDescriptor desc(this, slot, Common::U32String());
+		desc = SaveStateDescriptor(this, slot, Common::U32String());
 		parseSavegameHeader(&header, &desc);
 		desc.setThumbnail(header.thumbnail);
 		desc.setAutosave(header.isAutosave);
-		return desc;
 	}
 
-	return SaveStateDescriptor();
+	if (revision != 0) {
+		CachedSaveMetaInfo &entry = _saveMetaInfoCache[filename];
+		entry.revision = revision;
+		entry.desc = desc;
+	}
+	return desc;
 }
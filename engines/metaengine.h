@@ -26,6 +26,8 @@
 #include "common/error.h"
 #include "common/array.h"
 #include "common/debug-channels.h"
+#include "common/hashmap.h"
+#include "common/hash-str.h"
 
 #include "engines/achievements.h"
 #include "engines/game.h"
@@ -592,6 +594,23 @@ public:
 	 * Read the extended savegame header from the given savegame file.
 	 */
 	WARN_UNUSED_RESULT static bool readSavegameHeader(Common::InSaveFile *in, ExtendedSavegameHeader *header, bool skipThumbnail = true);
+
+private:
+	struct CachedSaveMetaInfo {
+		uint32 revision;
+		SaveStateDescriptor desc;
+	};
+
+	typedef Common::HashMap<Common::String, CachedSaveMetaInfo, Common::IgnoreCase_Hash, Common::IgnoreCase_EqualTo> SaveMetaInfoCache;
+
+	/**
+	 * Meta information read by the default querySaveMetaInfos(), by save
+	 * file name. Entries are only used while the revision reported by the
+	 * save file manager stays the same. Only the saves of one target are
+	 * kept, so that the thumbnails do not pile up.
+	 */
+	mutable SaveMetaInfoCache _saveMetaInfoCache;
+	mutable Common::String _saveMetaInfoCacheTarget;
 };
 
 /**
@@ -117,6 +117,7 @@ Console::Console(SciEngine *engine) : GUI::Debugger(),
 	registerCmd("resource_types",		WRAP_METHOD(Console, cmdResourceTypes));
 	registerCmd("list",				WRAP_METHOD(Console, cmdList));
 	registerCmd("alloc_list",				WRAP_METHOD(Console, cmdAllocList));
+	registerCmd("resource_cache",		WRAP_METHOD(Console, cmdResourceCache));
 	registerCmd("hexgrep",			WRAP_METHOD(Console, cmdHexgrep));
 	registerCmd("verify_scripts",		WRAP_METHOD(Console, cmdVerifyScripts));
 	registerCmd("integrity_dump",	WRAP_METHOD(Console, cmdResourceIntegrityDump));
@@ -233,6 +234,7 @@ Console::Console(SciEngine *engine) : GUI::Debugger(),
 	registerCmd("bpe",				WRAP_METHOD(Console, cmdBreakpointFunction));		// alias
 	// VM
 	registerCmd("script_steps",		WRAP_METHOD(Console, cmdScriptSteps));
+	registerCmd("send_cache",			WRAP_METHOD(Console, cmdSendCache));
 	registerCmd("script_objects",   WRAP_METHOD(Console, cmdScriptObjects));
 	registerCmd("scro",             WRAP_METHOD(Console, cmdScriptObjects));
 	registerCmd("script_strings",   WRAP_METHOD(Console, cmdScriptStrings));
@@ -357,6 +359,7 @@ bool Console::cmdHelp(int argc, const char **argv) {
 	debugPrintf(" resource_types - Shows the valid resource types\n");
 	debugPrintf(" list - Lists all the resources of a given type\n");
 	debugPrintf(" alloc_list - Lists all allocated resources\n");
+	debugPrintf(" resource_cache - Shows or changes the resource cache size and prefetching\n");
 	debugPrintf(" hexgrep - Searches some resources for a particular sequence of bytes, represented as hexadecimal numbers\n");
 	debugPrintf(" verify_scripts - Performs sanity checks on SCI1.1-SCI2.1 game scripts (e.g. if they're up to 64KB in total)\n");
 	debugPrintf(" integrity_dump - Dumps integrity data about resources in the current game to disk\n");
@@ -447,6 +450,7 @@ bool Console::cmdHelp(int argc, const char **argv) {
 	debugPrintf("\n");
 	debugPrintf("VM:\n");
 	debugPrintf(" script_steps - Shows the number of executed SCI operations\n");
+	debugPrintf(" send_cache - Shows the hit ratio of the selector lookup caches of send operations\n");
 	debugPrintf(" script_objects / scro - Shows all objects inside a specified script\n");
 	debugPrintf(" script_strings / scrs - Shows all strings inside a specified script\n");
 	debugPrintf(" script_said - Shows all said - strings inside a specified script\n");
@@ -1134,6 +1138,39 @@ bool Console::cmdAllocList(int argc, const char **argv) {
 	return true;
 }
 
+bool Console::cmdResourceCache(int argc, const char **argv) {
+	ResourceManager *resMan = _engine->getResMan();
+
+	if (argc > 1) {
+		if (!scumm_stricmp(argv[1], "size") && argc > 2) {
+			int size = atoi(argv[2]);
+			if (size < 64) {
+				debugPrintf("The cache must be at least 64 KiB\n");
+				return true;
+			}
+			resMan->setMaxMemoryLRU(size * 1024);
+		} else if (!scumm_stricmp(argv[1], "prefetch") && argc > 2) {
+			resMan->setPrefetchEnabled(!scumm_stricmp(argv[2], "on"));
+		} else if (!scumm_stricmp(argv[1], "reset")) {
+			resMan->resetPrefetchStats();
+		} else {
+			debugPrintf("Shows or changes the resource cache size and prefetching.\n");
+			debugPrintf("Usage: %s [size <KiB> | prefetch on|off | reset]\n", argv[0]);
+			debugPrintf("Use the resource_cache_size setting (in KiB) to change the size permanently\n");
+			return true;
+		}
+	}
+
+	const ResourceManager::PrefetchStats &stats = resMan->getPrefetchStats();
+	debugPrintf("LRU cache: %d of %d KiB used, %d KiB locked\n", resMan->getMemoryLRU() / 1024,
+		resMan->getMaxMemoryLRU() / 1024, resMan->getMemoryLocked() / 1024);
+	debugPrintf("Prefetching: %s, %u resources queued\n", resMan->isPrefetchEnabled() ? "on" : "off",
+		resMan->getPrefetchQueueSize());
+	debugPrintf("Hints: %u, prefetched: %u, used: %u, dropped unused: %u, skipped: %u\n",
+		stats.hints, stats.prefetched, stats.hits, stats.wasted, stats.skipped);
+	return true;
+}
+
 bool Console::cmdDissectScript(int argc, const char **argv) {
 	if (argc != 2) {
 		debugPrintf("Examines a script\n");
@@ -3436,6 +3473,30 @@ bool Console::cmdScriptSteps(int argc, const char **argv) {
 	return true;
 }
 
+bool Console::cmdSendCache(int argc, const char **argv) {
+	SendCache &cache = _engine->_gamestate->_segMan->getSendCache();
+
+	if (argc > 1) {
+		if (!scumm_stricmp(argv[1], "reset")) {
+			cache.resetStats();
+			debugPrintf("Statistics reset\n");
+		} else {
+			debugPrintf("Shows the hit ratio of the selector lookup caches of send operations.\n");
+			debugPrintf("Usage: %s [reset]\n", argv[0]);
+		}
+		return true;
+	}
+
+	const SendCache::Stats stats = cache.getStats();
+	const uint32 lookups = stats.hits + stats.misses;
+	debugPrintf("Lookups: %u, hits: %u (%.1f%%), misses: %u\n", lookups, stats.hits,
+		lookups ? stats.hits * 100.0 / lookups : 0.0, stats.misses);
+	debugPrintf("Send sites: %u, polymorphic: %u, up to %u objects each\n", stats.sites,
+		stats.polymorphicSites, SendCache::kWays);
+	debugPrintf("Evictions: %u, invalidations: %u\n", stats.evictions, stats.invalidations);
+	return true;
+}
+
 bool Console::cmdScriptObjects(int argc, const char **argv) {
 	if (argc < 2) {
 		debugPrintf("Shows all objects inside a specified script.\n");
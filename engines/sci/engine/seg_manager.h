@@ -28,6 +28,7 @@
 #include "sci/engine/vm.h"
 #include "sci/engine/vm_types.h"
 #include "sci/engine/segment.h"
+#include "sci/engine/selector.h"
 #ifdef ENABLE_SCI32
 #include "sci/graphics/celobj32.h" // kLowResX, kLowResY
 #endif
@@ -460,6 +461,12 @@ public:
 
 	const Common::Array<SegmentObj *> &getSegments() const { return _heap; }
 
+	/**
+	 * Returns the selector lookup caches of the send operations, which are
+	 * invalidated here whenever scripts are loaded or unloaded.
+	 */
+	SendCache &getSendCache() { return _sendCache; }
+
 private:
 	Common::Array<SegmentObj *> _heap;
 	Common::Array<Class> _classTable; /**< Table of all classes */
@@ -468,6 +475,7 @@ private:
 
 	ResourceManager *_resMan;
 	ScriptPatcher *_scriptPatcher;
+	SendCache _sendCache;
 
 	SegmentId _clonesSegId; ///< ID of the (a) clones segment
 	SegmentId _listsSegId; ///< ID of the (a) list segment
@@ -363,4 +363,91 @@ SelectorType lookupSelector(SegManager *segMan, reg_t obj_location, Selector sel
 	}
 }
 
+SendCache::SendCache() : _hits(0), _misses(0), _evictions(0), _invalidations(0) {
+}
+
+SelectorType SendCache::lookup(SegManager *segMan, reg_t sendPc, reg_t obj, Selector selectorId,
+		ObjVarRef *varp, reg_t *fptr) {
+	const Object *object = segMan->getObject(obj);
+	if (!object || sendPc.getSegment() == 0) {
+		// Not cacheable, let lookupSelector() handle (or report) it
+		return lookupSelector(segMan, obj, selectorId, varp, fptr);
+	}
+
+	const uint64 key = ((uint64)(uint16)selectorId << 48) | ((uint64)sendPc.getSegment() << 32) | sendPc.getOffset();
+	const reg_t objPos = object->getPos();
+	Site &site = _sites.getOrCreateVal(key);
+
+	const Entry *entry = nullptr;
+	for (uint i = 0; i < site.count; i++) {
+		if (site.entries[i].objPos == objPos) {
+			entry = &site.entries[i];
+			break;
+		}
+	}
+
+	if (entry) {
+		_hits++;
+	} else {
+		_misses++;
+
+		ObjVarRef resolvedVar;
+		reg_t resolvedFunc = NULL_REG;
+		const SelectorType type = lookupSelector(segMan, obj, selectorId, &resolvedVar, &resolvedFunc);
+		if (type == kSelectorNone)
+			return type;
+
+		uint index;
+		if (site.count < kWays) {
+			index = site.count++;
+		} else {
+			index = site.next;
+			site.next = (site.next + 1) % kWays;
+			_evictions++;
+		}
+		Entry &newEntry = site.entries[index];
+		newEntry.objPos = objPos;
+		newEntry.type = type;
+		newEntry.varIndex = (type == kSelectorVariable) ? resolvedVar.varindex : -1;
+		newEntry.funcp = resolvedFunc;
+		entry = &newEntry;
+	}
+
+	if (entry->type == kSelectorVariable) {
+		if (varp) {
+			varp->obj = obj;
+			varp->varindex = entry->varIndex;
+		}
+	} else if (fptr) {
+		*fptr = entry->funcp;
+	}
+	return entry->type;
+}
+
+void SendCache::invalidate() {
+	if (_sites.empty())
+		return;
+	_sites.clear();
+	_invalidations++;
+}
+
+SendCache::Stats SendCache::getStats() const {
+	Stats stats;
+	stats.hits = _hits;
+	stats.misses = _misses;
+	stats.evictions = _evictions;
+	stats.invalidations = _invalidations;
+	stats.sites = _sites.size();
+	stats.polymorphicSites = 0;
+	for (SiteMap::const_iterator it = _sites.begin(); it != _sites.end(); ++it) {
+		if (it->_value.count > 1)
+			stats.polymorphicSites++;
+	}
+	return stats;
+}
+
+void SendCache::resetStats() {
+	_hits = _misses = _evictions = _invalidations = 0;
+}
+
 } // End of namespace Sci
@@ -23,6 +23,7 @@
 #define SCI_ENGINE_SELECTOR_H
 
 #include "common/scummsys.h"
+#include "common/hashmap.h"
 
 #include "sci/engine/vm_types.h"	// for reg_t
 #include "sci/engine/vm.h"
@@ -238,6 +239,70 @@ void writeSelector(SegManager *segMan, reg_t object, Selector selectorId, reg_t
 void invokeSelector(EngineState *s, reg_t object, int selectorId,
 	int k_argc, StackPtr k_argp, int argc = 0, const reg_t *argv = 0);
 
+/**
+ * Inline caches for the selector lookups of the send operations. Each send
+ * site remembers the lookup results for the last few objects sent to it,
+ * with objects being told apart by the position of their definition, which
+ * their clones share. Must be invalidated when scripts are loaded or unloaded.
+ */
+class SendCache {
+public:
+	/** Number of objects remembered for each send site */
+	static const uint kWays = 4;
+
+	struct Stats {
+		uint32 hits;
+		uint32 misses;
+		uint32 evictions;     ///< Results dropped because their site was full
+		uint32 invalidations;
+		uint sites;
+		uint polymorphicSites; ///< Sites which have seen more than one object
+	};
+
+	SendCache();
+
+	/**
+	 * Same as lookupSelector(), with the result cached for the send site
+	 * at sendPc.
+	 */
+	SelectorType lookup(SegManager *segMan, reg_t sendPc, reg_t obj, Selector selectorId,
+		ObjVarRef *varp, reg_t *fptr);
+
+	/** Drops all the cached lookups */
+	void invalidate();
+
+	Stats getStats() const;
+	void resetStats();
+
+private:
+	struct Entry {
+		reg_t objPos;
+		SelectorType type;
+		int varIndex;
+		reg_t funcp;
+	};
+
+	struct Site {
+		Entry entries[kWays];
+		uint8 count;
+		uint8 next; ///< Entry to replace when the site is full
+	};
+
+	struct SiteHash {
+		uint operator()(uint64 key) const {
+			return (uint)(key ^ (key >> 29) ^ (key >> 47));
+		}
+	};
+
+	typedef Common::HashMap<uint64, Site, SiteHash> SiteMap;
+	SiteMap _sites;
+
+	uint32 _hits;
+	uint32 _misses;
+	uint32 _evictions;
+	uint32 _invalidations;
+};
+
 #ifdef ENABLE_SCI32
 /**
  * SCI32 set kInfoFlagViewVisible in the -info- selector if a certain
@@ -677,6 +677,8 @@ void SciMetaEngine::registerDefaultSettings(const Common::String &target) const
 	for (const PopUpOptionsMap *entry = popUpOptionsList; entry->guioFlag; ++entry)
 		ConfMan.registerDefault(entry->configOption, entry->defaultState);
 
+	ConfMan.registerDefault("resource_prefetch", true);
+
 	// enable_high_resolution_graphics is normally enabled by default,
 	// except for KQ6 where it overrides the DOS platform with Windows.
 	// If it were enabled by default for KQ6, then the DOS platform
@@ -25,6 +25,7 @@
 #include "common/file.h"
 #include "common/fs.h"
 #include "common/macresman.h"
+#include "common/system.h"
 #include "common/textconsole.h"
 #include "common/translation.h"
 #ifdef ENABLE_SCI32
@@ -207,6 +208,7 @@ Resource::Resource(ResourceManager *resMan, ResourceId id) : SciSpan<const byte>
 	_fileOffset = 0;
 	_status = kResStatusNoMalloc;
 	_lockers = 0;
+	_prefetched = false;
 	_source = nullptr;
 	_header = nullptr;
 	_headerSize = 0;
@@ -1009,6 +1011,10 @@ void ResourceManager::init() {
 	_memoryLocked = 0;
 	_memoryLRU = 0;
 	_LRU.clear();
+	_prefetchQueue.clear();
+	_memoryPrefetched = 0;
+	_prefetchEnabled = !_detectionMode && (!ConfMan.hasKey("resource_prefetch") || ConfMan.getBool("resource_prefetch"));
+	resetPrefetchStats();
 	_resMap.clear();
 	_audioMapSCI1 = nullptr;
 #ifdef ENABLE_SCI32
@@ -1082,6 +1088,10 @@ void ResourceManager::init() {
 		_maxMemoryLRU = 4096 * 1024; // 4MiB
 	}
 
+	// The cache may be enlarged for games whose rooms need more resources
+	if (!_detectionMode && ConfMan.hasKey("resource_cache_size"))
+		_maxMemoryLRU = MAX(ConfMan.getInt("resource_cache_size"), 64) * 1024;
+
 	switch (_viewType) {
 	case kViewEga:
 		debugC(1, kDebugLevelResMan, "resMan: Detected EGA graphic resources");
@@ -1131,6 +1141,13 @@ void ResourceManager::removeFromLRU(Resource *res) {
 	_LRU.remove(res);
 	_memoryLRU -= res->size();
 	res->_status = kResStatusAllocated;
+
+	// Prefetched resources stay in the LRU list until they are requested,
+	// so they stop counting as prefetched whichever way they leave it
+	if (res->_prefetched) {
+		res->_prefetched = false;
+		_memoryPrefetched -= res->size();
+	}
 }
 
 void ResourceManager::addToLRU(Resource *res) {
@@ -1152,6 +1169,8 @@ void ResourceManager::freeOldResources() {
 	while (_maxMemoryLRU < _memoryLRU) {
 		assert(!_LRU.empty());
 		Resource *goner = _LRU.back();
+		if (goner->_prefetched)
+			_prefetchStats.wasted++;
 		removeFromLRU(goner);
 		goner->unalloc();
 #ifdef SCI_VERBOSE_RESMAN
@@ -1196,15 +1215,19 @@ Resource *ResourceManager::findResource(ResourceId id, bool lock) {
 	if (!retval)
 		return nullptr;
 
-	if (retval->_status == kResStatusNoMalloc)
+	if (retval->_status == kResStatusNoMalloc) {
 		loadResource(retval);
-	else if (retval->_status == kResStatusEnqueued)
+	} else if (retval->_status == kResStatusEnqueued) {
+		if (retval->_prefetched)
+			_prefetchStats.hits++;
+
 		// The resource is removed from its current position
 		// in the LRU list because it has been requested
 		// again. Below, it will either be locked, or it
 		// will be added back to the LRU list at the 'most
 		// recent' position.
 		removeFromLRU(retval);
+	}
 
 	// Unless an error occurred, the resource is now either
 	// locked or allocated, but never queued or freed.
@@ -1231,6 +1254,73 @@ Resource *ResourceManager::findResource(ResourceId id, bool lock) {
 	}
 }
 
+void ResourceManager::prefetchResource(ResourceId id) {
+	// Long queues are unlikely to be processed before the game moves on
+	const uint kMaxPrefetchQueueSize = 64;
+
+	if (!_prefetchEnabled || _prefetchQueue.size() >= kMaxPrefetchQueueSize)
+		return;
+
+	Resource *res = testResource(id);
+	if (!res || res->_status != kResStatusNoMalloc)
+		return;
+
+	for (Common::List<ResourceId>::const_iterator it = _prefetchQueue.begin(); it != _prefetchQueue.end(); ++it) {
+		if (*it == id)
+			return;
+	}
+
+	_prefetchQueue.push_back(id);
+	_prefetchStats.hints++;
+}
+
+bool ResourceManager::processPrefetchQueue(uint32 deadline) {
+	bool loaded = false;
+
+	while (!_prefetchQueue.empty() && g_system->getMillis() < deadline) {
+		// Keep prefetched resources from pushing each other out of the cache
+		if (_memoryPrefetched >= _maxMemoryLRU / 2)
+			break;
+
+		Resource *res = testResource(_prefetchQueue.front());
+		_prefetchQueue.pop_front();
+		if (!res || res->_status != kResStatusNoMalloc) {
+			_prefetchStats.skipped++;
+			continue;
+		}
+
+		loadResource(res);
+		if (res->_status != kResStatusAllocated) {
+			_prefetchStats.skipped++;
+			continue;
+		}
+
+		res->_prefetched = true;
+		_memoryPrefetched += res->size();
+		_prefetchStats.prefetched++;
+		addToLRU(res);
+		freeOldResources();
+		loaded = true;
+	}
+
+	return loaded;
+}
+
+void ResourceManager::setPrefetchEnabled(bool enable) {
+	_prefetchEnabled = enable;
+	if (!enable)
+		_prefetchQueue.clear();
+}
+
+void ResourceManager::resetPrefetchStats() {
+	memset(&_prefetchStats, 0, sizeof(_prefetchStats));
+}
+
+void ResourceManager::setMaxMemoryLRU(int size) {
+	_maxMemoryLRU = size;
+	freeOldResources();
+}
+
 void ResourceManager::unlockResource(Resource *res) {
 	assert(res);
 
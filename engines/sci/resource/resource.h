@@ -309,6 +309,7 @@ protected:
 	int32 _fileOffset; /**< Offset in file */
 	ResourceStatus _status;
 	uint16 _lockers; /**< Number of places where this resource was locked */
+	bool _prefetched; /**< Loaded ahead of being requested, and not requested since */
 	ResourceSource *_source;
 	ResourceManager *_resMan;
 
@@ -407,6 +408,41 @@ public:
 	 */
 	bool hasResourceType(ResourceType type);
 
+	struct PrefetchStats {
+		uint32 hints;      ///< Resources queued for prefetching
+		uint32 prefetched; ///< Resources loaded ahead of being requested
+		uint32 hits;       ///< Prefetched resources which were requested later
+		uint32 wasted;     ///< Prefetched resources dropped before being requested
+		uint32 skipped;    ///< Queued resources which were already loaded, or missing
+	};
+
+	/**
+	 * Queues a resource which the game is expected to request soon, so that
+	 * it can be loaded into the LRU cache while the engine is idle.
+	 * @param id	The resource to load ahead
+	 */
+	void prefetchResource(ResourceId id);
+
+	/**
+	 * Loads queued resources into the LRU cache, until the queue is empty
+	 * or the given time is reached.
+	 * @param deadline	Time to stop at, as returned by OSystem::getMillis()
+	 * @return true if any resource was loaded
+	 */
+	bool processPrefetchQueue(uint32 deadline);
+
+	bool isPrefetchEnabled() const { return _prefetchEnabled; }
+	void setPrefetchEnabled(bool enable);
+	uint getPrefetchQueueSize() const { return _prefetchQueue.size(); }
+	const PrefetchStats &getPrefetchStats() const { return _prefetchStats; }
+	void resetPrefetchStats();
+
+	int getMaxMemoryLRU() const { return _maxMemoryLRU; }
+	/** Changes the size of the LRU cache, dropping resources if needed */
+	void setMaxMemoryLRU(int size);
+	int getMemoryLRU() const { return _memoryLRU; }
+	int getMemoryLocked() const { return _memoryLocked; }
+
 	bool setAudioLanguage(int language);
 	void unloadAudioLanguage();
 	int getAudioLanguage() const;
@@ -502,6 +538,10 @@ protected:
 	int _memoryLocked;	///< Amount of resource bytes in locked memory
 	int _memoryLRU;		///< Amount of resource bytes under LRU control
 	Common::List<Resource *> _LRU; ///< Last Resource Used list
+	Common::List<ResourceId> _prefetchQueue; ///< Resources to load while idle
+	int _memoryPrefetched;	///< Amount of resource bytes loaded ahead, and not requested yet
+	bool _prefetchEnabled;
+	PrefetchStats _prefetchStats;
 	ResourceMap _resMap;
 	Common::List<Common::File *> _volumeFiles; ///< list of opened volume files
 	ResourceSource *_audioMapSCI1; ///< Currently loaded audio map for SCI1
@@ -322,6 +322,8 @@ protected:
 
 	void clearDrawQueues() override;
 
+	void resourceNuked(ResType type, ResId idx) override;
+
 	int getStringCharWidth(byte chr);
 	void appendSubstring(int dst, int src, int len2, int len);
 
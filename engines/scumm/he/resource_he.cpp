@@ -331,6 +331,11 @@ void ScummEngine_v90he::readMAXS(int blockSize) {
 		ScummEngine_v72he::readMAXS(blockSize);
 }
 
+void ScummEngine_v71he::resourceNuked(ResType type, ResId idx) {
+	if (type == rtImage && _wiz)
+		_wiz->dropDecodedWizStates(idx);
+}
+
 void ScummEngine_v72he::readMAXS(int blockSize) {
 	if (blockSize == 40) {
 		_numVariables = _fileHandle->readUint16LE();
@@ -377,6 +377,12 @@ WizPxShrdBuffer Wiz::drawAWizPrimEx(int globNum, int state, int x, int y, int z,
 			}
 
 			auxDrawZplaneFromTRLEImage(_vm->getMaskBuffer(0, 0, 1), srcData + _vm->_resourceHeaderSize, destWidth, destHeight, x, y, srcWidth, srcHeight, &clipRect, kWZOIgnore, kWZOClear);
+		} else if (!shadowPtr && drawDecodedWizState(
+			globNum, state, srcData + _vm->_resourceHeaderSize, srcWidth, srcHeight,
+			destPtr(), destWidth, destHeight, x, y, &clipRect, flags,
+			(flags & kWRFRemap) ? remapPtr + _vm->_resourceHeaderSize + 4 : nullptr,
+			optionalColorConversionTable)) {
+			// Drawn from the cache of decoded states...
 		} else if (_vm->_game.heversion <= 98 && !(flags & (kWRFHFlip | kWRFVFlip))) {
 			if (flags & kWRFRemap) {
 				auxDecompRemappedTRLEImage(
@@ -24,6 +24,8 @@
 
 //#define WIZ_DEBUG_BUFFERS
 
+#include "common/array.h"
+#include "common/hashmap.h"
 #include "common/rect.h"
 
 namespace Scumm {
@@ -415,6 +417,69 @@ struct WizCompressedImage {
 	int height;
 };
 
+/**
+ * A TRLE state decompressed once, with its remap and color conversion
+ * already applied, see wizcache_he.cpp. The opaque pixels of each row are
+ * listed as spans, so the state can be drawn without going through the
+ * compressed data again. The spans and drawing are in wizdecoded_he.cpp,
+ * which doesn't depend on the engine.
+ */
+struct WizDecodedState {
+	const byte *compData;
+	uint32 resourceGeneration;
+	int width;
+	int height;
+	bool uses16BitColor;
+
+	// The tables the pixels were made with
+	bool hasRemapTable;
+	byte remapTable[256];
+	int conversionTableSize;
+	byte conversionTable[256 * sizeof(WizRawPixel16)];
+
+	byte *pixels;
+	Common::Array<uint16> spans;    // Start and end columns of the opaque runs
+	Common::Array<uint32> rowSpans; // First span of each row, plus the end of the last one
+
+	uint32 memorySize;
+	uint32 lastUsed;
+
+	WizDecodedState() : compData(nullptr), resourceGeneration(0), width(0), height(0), uses16BitColor(false),
+		hasRemapTable(false), conversionTableSize(0), pixels(nullptr), memorySize(0), lastUsed(0) {}
+	~WizDecodedState() { free(pixels); }
+
+	/** Lists the opaque spans of each row of compData */
+	void buildSpans();
+
+	/**
+	 * Draws the opaque pixels at x, y, clipped to the buffer and the
+	 * optional clipping rect, which includes its right and bottom edges.
+	 */
+	void draw(WizRawPixel *bufferPtr, int bufferWidth, int bufferHeight, int x, int y,
+		const Common::Rect *clipRectPtr, bool hFlip, bool vFlip) const;
+};
+
+struct WizDecodedStateKey {
+	int image;
+	int state;
+	bool flipDecompressor;
+	bool remap;
+	const WizRawPixel *conversionTable;
+
+	bool operator==(const WizDecodedStateKey &other) const {
+		return image == other.image && state == other.state &&
+			flipDecompressor == other.flipDecompressor && remap == other.remap &&
+			conversionTable == other.conversionTable;
+	}
+};
+
+struct WizDecodedStateKeyHash {
+	uint operator()(const WizDecodedStateKey &key) const {
+		return (uint)(key.image * 0x9E3779B1u) ^ (uint)(key.state << 16) ^ (uint)((uintptr)key.conversionTable >> 4) ^
+			(key.flipDecompressor ? 0x40000000u : 0) ^ (key.remap ? 0x80000000u : 0);
+	}
+};
+
 struct WizMoonbaseCompressedImage {
 	int type, size, width, height;
 	WizRawPixel16 transparentColor;
@@ -641,6 +706,7 @@ public:
 
 	Wiz(ScummEngine_v71he *vm);
 	~Wiz() {
+		freeDecodedWizStates();
 #ifdef WIZ_DEBUG_BUFFERS
 		WizPxShrdBuffer::dbgLeakRpt();
 #endif
@@ -693,6 +759,17 @@ public:
 	void processWizImageLoadCmd(const WizImageCommand *params);
 	void processWizImageSaveCmd(const WizImageCommand *params);
 
+	// Decoded state cache
+	bool drawDecodedWizState(
+		int globNum, int state, const byte *compData, int width, int height,
+		WizRawPixel *bufferPtr, int bufferWidth, int bufferHeight, int x, int y,
+		const Common::Rect *clipRectPtr, int32 flags, byte *remapTable, const WizRawPixel *conversionTable);
+	WizDecodedState *getDecodedWizState(
+		const WizDecodedStateKey &key, const byte *compData, int width, int height,
+		int32 flags, byte *remapTable);
+	void dropDecodedWizStates(int globNum);
+	void freeDecodedWizStates();
+
 	void getWizImageDim(int resNum, int state, int32 &w, int32 &h);
 	void getWizImageDim(uint8 *dataPtr, int state, int32 &w, int32 &h);
 	int getWizStateCount(int resnum);
@@ -816,6 +893,11 @@ public:
 private:
 	ScummEngine_v71he *_vm;
 
+	typedef Common::HashMap<WizDecodedStateKey, WizDecodedState *, WizDecodedStateKeyHash> DecodedWizStateMap;
+	DecodedWizStateMap _decodedStates;
+	uint32 _decodedStatesMemory = 0;
+	uint32 _decodedStatesClock = 0;
+
 
 public:
 	/* Drawing Primitives
@@ -0,0 +1,205 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifdef ENABLE_HE
+
+#include "scumm/he/intern_he.h"
+#include "scumm/he/wiz_he.h"
+#include "scumm/resource.h"
+
+namespace Scumm {
+
+/*
+ * Sprites and images keep getting drawn from the same TRLE states, frame
+ * after frame. Each time, the compressed stream had to be parsed again and
+ * every pixel looked up in the remap and color conversion tables. Instead,
+ * the states are decompressed once into a buffer of raw pixels, using the
+ * same decompressors as the direct drawing. Drawing then copies the opaque
+ * spans of the buffer, mirrored as needed for the flipping flags.
+ *
+ * Entries belong to an image, state, decompressor and conversion table, and
+ * keep a copy of the tables they were made with. They are dropped when the
+ * resource is nuked, when it has been created or marked as modified again
+ * since, or when the tables differ, which covers palette changes and
+ * remapping. The least recently used entries go when the memory budget is
+ * exceeded.
+ *
+ * Nothing writes into TRLE data without going through createResource():
+ * the drawing and rendering commands only write into images through
+ * dwSetSimpleBitmapStructFromImage(), which refuses compressed states, the
+ * movie player only writes into the raw image it created, and
+ * remapImagePrim() only changes the remap table. Code writing compressed
+ * data in place would have to call ResourceManager::setModified().
+ */
+
+#define WIZ_DECODED_STATES_BUDGET (8 * 1024 * 1024)
+
+bool Wiz::drawDecodedWizState(
+	int globNum, int state, const byte *compData, int width, int height,
+	WizRawPixel *bufferPtr, int bufferWidth, int bufferHeight, int x, int y,
+	const Common::Rect *clipRectPtr, int32 flags, byte *remapTable, const WizRawPixel *conversionTable) {
+
+	// The blending modes depend on the destination...
+	if (_uses16BitColor && (flags & (kWRFAdditiveBlend | kWRFSubtractiveBlend | kWRF5050Blend)))
+		return false;
+
+	if (width <= 0 || height <= 0)
+		return false;
+
+	WizDecodedStateKey key;
+	key.image = globNum;
+	key.state = state;
+	key.flipDecompressor = (_vm->_game.heversion > 98 || (flags & (kWRFHFlip | kWRFVFlip)));
+	key.remap = (remapTable != nullptr);
+	key.conversionTable = conversionTable;
+
+	WizDecodedState *decoded = getDecodedWizState(key, compData, width, height, flags, remapTable);
+	if (!decoded)
+		return false;
+
+	decoded->draw(bufferPtr, bufferWidth, bufferHeight, x, y, clipRectPtr,
+		(flags & kWRFHFlip) != 0, (flags & kWRFVFlip) != 0);
+	return true;
+}
+
+WizDecodedState *Wiz::getDecodedWizState(
+	const WizDecodedStateKey &key, const byte *compData, int width, int height,
+	int32 flags, byte *remapTable) {
+
+	uint32 generation = _vm->_res->_types[rtImage][key.image]._generation;
+	int conversionTableSize = 0;
+	if (key.conversionTable)
+		conversionTableSize = _uses16BitColor ? 256 * sizeof(WizRawPixel16) : 256;
+
+	DecodedWizStateMap::iterator it = _decodedStates.find(key);
+	if (it != _decodedStates.end()) {
+		WizDecodedState *decoded = it->_value;
+
+		if (decoded->resourceGeneration == generation && decoded->compData == compData &&
+			decoded->width == width && decoded->height == height &&
+			(!remapTable || !memcmp(decoded->remapTable, remapTable, sizeof(decoded->remapTable))) &&
+			(!conversionTableSize || !memcmp(decoded->conversionTable, key.conversionTable, conversionTableSize))) {
+			decoded->lastUsed = ++_decodedStatesClock;
+			return decoded;
+		}
+
+		_decodedStatesMemory -= decoded->memorySize;
+		delete decoded;
+		_decodedStates.erase(it);
+	}
+
+	int pixelSize = _uses16BitColor ? sizeof(WizRawPixel16) : sizeof(WizRawPixel8);
+	uint32 pixelsSize = width * height * pixelSize;
+
+	// Leave the big images, like backgrounds, to the direct drawing...
+	if (pixelsSize > WIZ_DECODED_STATES_BUDGET / 4)
+		return nullptr;
+
+	WizDecodedState *decoded = new WizDecodedState();
+	decoded->compData = compData;
+	decoded->resourceGeneration = generation;
+	decoded->width = width;
+	decoded->height = height;
+	decoded->uses16BitColor = _uses16BitColor;
+	decoded->hasRemapTable = (remapTable != nullptr);
+	if (remapTable)
+		memcpy(decoded->remapTable, remapTable, sizeof(decoded->remapTable));
+	decoded->conversionTableSize = conversionTableSize;
+	if (conversionTableSize)
+		memcpy(decoded->conversionTable, key.conversionTable, conversionTableSize);
+
+	decoded->pixels = (byte *)malloc(pixelsSize);
+	if (!decoded->pixels) {
+		delete decoded;
+		return nullptr;
+	}
+
+	// Decompress with the primitive the direct drawing would use, just
+	// without any clipping or flipping...
+	Common::Rect fullRect;
+	makeSizedRect(&fullRect, width, height);
+
+	if (!key.flipDecompressor) {
+		if (remapTable) {
+			auxDecompRemappedTRLEImage(
+				(WizRawPixel *)decoded->pixels, compData, width, height,
+				0, 0, width, height, &fullRect, remapTable, key.conversionTable);
+		} else {
+			auxDecompTRLEImage(
+				(WizRawPixel *)decoded->pixels, compData, width, height,
+				0, 0, width, height, &fullRect, key.conversionTable);
+		}
+	} else {
+		trleFLIPDecompressImage(
+			(WizRawPixel *)decoded->pixels, compData, width, height,
+			0, 0, width, height, &fullRect, flags & ~(kWRFHFlip | kWRFVFlip),
+			remapTable, key.conversionTable, nullptr);
+	}
+
+	decoded->buildSpans();
+
+	decoded->memorySize = sizeof(WizDecodedState) + pixelsSize +
+		decoded->spans.size() * sizeof(uint16) + decoded->rowSpans.size() * sizeof(uint32);
+
+	// Make room for the new entry...
+	while (!_decodedStates.empty() && _decodedStatesMemory + decoded->memorySize > WIZ_DECODED_STATES_BUDGET) {
+		DecodedWizStateMap::iterator oldest = _decodedStates.begin();
+		for (DecodedWizStateMap::iterator i = _decodedStates.begin(); i != _decodedStates.end(); ++i) {
+			if (i->_value->lastUsed < oldest->_value->lastUsed)
+				oldest = i;
+		}
+
+		_decodedStatesMemory -= oldest->_value->memorySize;
+		delete oldest->_value;
+		_decodedStates.erase(oldest);
+	}
+
+	decoded->lastUsed = ++_decodedStatesClock;
+	_decodedStatesMemory += decoded->memorySize;
+	_decodedStates[key] = decoded;
+
+	return decoded;
+}
+
+void Wiz::dropDecodedWizStates(int globNum) {
+	DecodedWizStateMap::iterator i = _decodedStates.begin();
+	while (i != _decodedStates.end()) {
+		if (i->_key.image == globNum) {
+			_decodedStatesMemory -= i->_value->memorySize;
+			delete i->_value;
+			_decodedStates.erase(i++);
+		} else {
+			++i;
+		}
+	}
+}
+
+void Wiz::freeDecodedWizStates() {
+	for (DecodedWizStateMap::iterator i = _decodedStates.begin(); i != _decodedStates.end(); ++i)
+		delete i->_value;
+
+	_decodedStates.clear();
+	_decodedStatesMemory = 0;
+}
+
+} // End of namespace Scumm
+
+#endif // ENABLE_HE
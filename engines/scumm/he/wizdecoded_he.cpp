@@ -0,0 +1,153 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifdef ENABLE_HE
+
+#include "common/endian.h"
+#include "common/util.h"
+
+#include "scumm/he/intern_he.h"
+#include "scumm/he/wiz_he.h"
+
+namespace Scumm {
+
+void WizDecodedState::buildSpans() {
+	const byte *data = compData;
+
+	spans.clear();
+	rowSpans.clear();
+	rowSpans.reserve(height + 1);
+
+	for (int row = 0; row < height; row++) {
+		uint32 rowStart = spans.size();
+		rowSpans.push_back(rowStart);
+
+		int lineSize = READ_LE_UINT16(data);
+		const byte *dataStream = data + 2;
+		const byte *lineEnd = dataStream + lineSize;
+		data += lineSize + 2;
+
+		// Same run encoding as TRLE_HANDLE_RUN_DECOMPRESS_STEP()
+		int pos = 0;
+		while (pos < width && dataStream < lineEnd) {
+			int runCount = *dataStream++;
+
+			if (runCount & 1) {
+				pos += runCount >> 1;
+				continue;
+			}
+
+			int start = pos;
+			pos += (runCount >> 2) + 1;
+			dataStream += (runCount & 2) ? 1 : (runCount >> 2) + 1;
+
+			int end = MIN(pos, width);
+			if (spans.size() > rowStart && spans.back() == start) {
+				// Merge with the previous span
+				spans.back() = end;
+			} else {
+				spans.push_back(start);
+				spans.push_back(end);
+			}
+		}
+	}
+
+	rowSpans.push_back(spans.size());
+}
+
+// Same as Wiz::findRectOverlap()
+static bool clipDecodedRect(Common::Rect &rect, const Common::Rect &clipRect) {
+	if (rect.left > clipRect.right || rect.top > clipRect.bottom ||
+		rect.right < clipRect.left || rect.bottom < clipRect.top) {
+		return false;
+	}
+
+	rect.left = MAX(rect.left, clipRect.left);
+	rect.top = MAX(rect.top, clipRect.top);
+	rect.right = MIN(rect.right, clipRect.right);
+	rect.bottom = MIN(rect.bottom, clipRect.bottom);
+	return true;
+}
+
+template<typename T>
+static void drawDecodedRow(T *dstRow, const T *srcRow, const uint16 *spans, const uint16 *spansEnd,
+						   int x, int width, int clipLeft, int clipRight, bool hFlip) {
+	for (; spans < spansEnd; spans += 2) {
+		int srcStart = spans[0];
+		int srcEnd = spans[1];
+
+		if (!hFlip) {
+			int dstStart = MAX(x + srcStart, clipLeft);
+			int dstEnd = MIN(x + srcEnd, clipRight + 1);
+			if (dstStart < dstEnd)
+				memcpy(dstRow + dstStart, srcRow + (dstStart - x), (dstEnd - dstStart) * sizeof(T));
+		} else {
+			// Column c of the source ends up in column x + width - 1 - c
+			int dstStart = MAX(x + width - srcEnd, clipLeft);
+			int dstEnd = MIN(x + width - srcStart, clipRight + 1);
+			const T *src = srcRow + (x + width - 1 - dstStart);
+			for (int dstX = dstStart; dstX < dstEnd; dstX++)
+				dstRow[dstX] = *src--;
+		}
+	}
+}
+
+void WizDecodedState::draw(WizRawPixel *bufferPtr, int bufferWidth, int bufferHeight, int x, int y,
+	const Common::Rect *clipRectPtr, bool hFlip, bool vFlip) const {
+	Common::Rect clipRect(0, 0, bufferWidth - 1, bufferHeight - 1);
+	if (clipRectPtr) {
+		Common::Rect workRect = clipRect;
+		clipRect = *clipRectPtr;
+		if (!clipDecodedRect(clipRect, workRect)) {
+			return;
+		}
+	}
+
+	Common::Rect destRect(x, y, x + width - 1, y + height - 1);
+	if (!clipDecodedRect(destRect, clipRect)) {
+		return;
+	}
+
+	for (int destY = destRect.top; destY <= destRect.bottom; destY++) {
+		int srcY = vFlip ? (y + height - 1 - destY) : (destY - y);
+		const uint16 *rowStart = spans.begin() + rowSpans[srcY];
+		const uint16 *rowEnd = spans.begin() + rowSpans[srcY + 1];
+
+		if (rowStart == rowEnd)
+			continue;
+
+		if (uses16BitColor) {
+			drawDecodedRow<WizRawPixel16>(
+				(WizRawPixel16 *)bufferPtr + destY * bufferWidth,
+				(const WizRawPixel16 *)pixels + srcY * width,
+				rowStart, rowEnd, x, width, destRect.left, destRect.right, hFlip);
+		} else {
+			drawDecodedRow<WizRawPixel8>(
+				(WizRawPixel8 *)bufferPtr + destY * bufferWidth,
+				(const WizRawPixel8 *)pixels + srcY * width,
+				rowStart, rowEnd, x, width, destRect.left, destRect.right, hFlip);
+		}
+	}
+}
+
+} // End of namespace Scumm
+
+#endif // ENABLE_HE
@@ -22,6 +22,7 @@
 #include "common/scummsys.h"
 #include "common/mutex.h"
 #include "common/serializer.h"
+#include "common/system.h"
 #include "common/textconsole.h"
 #include "common/util.h"
 
@@ -221,6 +222,10 @@ void IMuseDigiInternalMixer::mix(uint8 *srcBuf, int32 inFrameCount, int wordSize
 					// Linear volume quantization from the lookup table
 					rightChannelVolume = _stereoVolumeTable[17 * channelVolume + channelPan];
 					leftChannelVolume = _stereoVolumeTable[17 * channelVolume - channelPan];
+
+					if (mixVectorized(srcBuf, inFrameCount, wordSize, channelCount, feedSize, mixBufStartIndex, leftChannelVolume, rightChannelVolume, ftIs11025Hz))
+						return;
+
 					if (wordSize == 8) {
 						mixBits8ConvertToStereo(
 							srcBuf,
@@ -254,6 +259,10 @@ void IMuseDigiInternalMixer::mix(uint8 *srcBuf, int32 inFrameCount, int wordSize
 					if (channelVolume >= 17)
 						channelVolume = 16;
 
+					if (_outChannelCount == channelCount &&
+						mixVectorized(srcBuf, inFrameCount, wordSize, channelCount, feedSize, mixBufStartIndex, channelVolume, channelVolume, ftIs11025Hz))
+						return;
+
 					if (wordSize == 8)
 						ampTable = &_amp8Table[channelVolume * 128];
 					else
@@ -288,6 +297,119 @@ void IMuseDigiInternalMixer::mix(uint8 *srcBuf, int32 inFrameCount, int wordSize
 	}
 }
 
+IMuseDigiInternalMixer::VectorFuncs IMuseDigiInternalMixer::_vectorFuncs = { nullptr, nullptr };
+bool IMuseDigiInternalMixer::_vectorFuncsSelected = false;
+
+void IMuseDigiInternalMixer::selectVectorFuncs() {
+	// Without any, the original table lookups are used
+	VectorFuncs funcs = { nullptr, nullptr };
+#ifdef SCUMMVM_NEON
+	if (g_system->hasFeature(OSystem::kFeatureCpuNEON)) {
+		funcs.mix = mixNEON;
+		funcs.mixToStereo = mixToStereoNEON;
+	}
+#endif
+#ifdef SCUMMVM_SSE2
+	if (g_system->hasFeature(OSystem::kFeatureCpuSSE2)) {
+		funcs.mix = mixSSE2;
+		funcs.mixToStereo = mixToStereoSSE2;
+	}
+#endif
+#ifdef SCUMMVM_AVX2
+	if (g_system->hasFeature(OSystem::kFeatureCpuAVX2)) {
+		funcs.mix = mixAVX2;
+		funcs.mixToStereo = mixToStereoAVX2;
+	}
+#endif
+	_vectorFuncs = funcs;
+	_vectorFuncsSelected = true;
+}
+
+bool IMuseDigiInternalMixer::mixVectorized(uint8 *srcBuf, int32 inFrameCount, int wordSize, int channelCount, int feedSize, int32 mixBufStartIndex, int leftVolume, int rightVolume, bool ftIs11025Hz) {
+	if (!_vectorFuncsSelected)
+		selectVectorFuncs();
+
+	if (!_vectorFuncs.mix)
+		return false;
+
+	bool toStereo = (channelCount == 1 && _outChannelCount == 2);
+	int sampleCount;
+
+	// Only take the cases which mix every sample once, as they are...
+	if (_isEarlyDiMUSE && wordSize == 8 && channelCount == 1) {
+		if (ftIs11025Hz)
+			return false;
+
+		sampleCount = inFrameCount;
+	} else {
+		if (feedSize != inFrameCount)
+			return false;
+
+		// Radio chatter filters the samples, and odd counts of 12-bit
+		// samples are warned about by the regular code
+		if (wordSize == 8 && channelCount == 1 && _radioChatter)
+			return false;
+		if (wordSize == 12 && channelCount == 1 && (inFrameCount & 1))
+			return false;
+
+		sampleCount = inFrameCount * channelCount;
+	}
+
+	if (sampleCount <= 0)
+		return false;
+
+	// Like the regular code, 16-bit mono to stereo mixing starts at the mono offset
+	uint16 *mixBufCurCell;
+	if (_outChannelCount == 2 && !(toStereo && wordSize == 16))
+		mixBufCurCell = (uint16 *)(&_mixBuf[4 * mixBufStartIndex]);
+	else
+		mixBufCurCell = (uint16 *)(&_mixBuf[2 * mixBufStartIndex]);
+
+	int leftScale = getAmpScale(leftVolume);
+	int rightScale = getAmpScale(rightVolume);
+
+	if (wordSize == 16) {
+		// The amplitude tables only take the top 12 bits
+		if (toStereo)
+			_vectorFuncs.mixToStereo(mixBufCurCell, (const int16 *)srcBuf, sampleCount, 4, leftScale, rightScale);
+		else
+			_vectorFuncs.mix(mixBufCurCell, (const int16 *)srcBuf, sampleCount, 4, leftScale);
+		return true;
+	}
+
+	// Unpack the 8-bit and 12-bit samples to signed 12-bit values, a chunk at a time
+	int16 samples[512];
+	uint8 *srcBuf_ptr = srcBuf;
+
+	while (sampleCount > 0) {
+		int count = MIN<int>(sampleCount, ARRAYSIZE(samples));
+
+		if (wordSize == 8) {
+			for (int i = 0; i < count; i++)
+				samples[i] = (int16)((srcBuf_ptr[i] - 128) * 16);
+			srcBuf_ptr += count;
+		} else {
+			for (int i = 0; i < count; i += 2) {
+				samples[i]     = (int16)((srcBuf_ptr[0] | ((srcBuf_ptr[1] & 0xF)  << 8)) - 2048);
+				samples[i + 1] = (int16)((srcBuf_ptr[2] | ((srcBuf_ptr[1] & 0xF0) << 4)) - 2048);
+				srcBuf_ptr += 3;
+			}
+		}
+
+		if (toStereo) {
+			_vectorFuncs.mixToStereo(mixBufCurCell, samples, count, 0, leftScale, rightScale);
+			mixBufCurCell += 2 * count;
+		} else {
+			_vectorFuncs.mix(mixBufCurCell, samples, count, 0, leftScale);
+			mixBufCurCell += count;
+		}
+
+		sampleCount -= count;
+	}
+
+	return true;
+}
+
 int IMuseDigiInternalMixer::loop(uint8 **destBuffer, int len) {
 	int16 *mixBuffer = (int16 *)_mixBuf;
 	uint8 *destBuffer_tmp = *destBuffer;
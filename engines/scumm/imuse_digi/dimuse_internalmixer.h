@@ -34,6 +34,8 @@
 #include "audio/mixer.h"
 #include "audio/audiostream.h"
 
+class IMuseDigiInternalMixerTestSuite;
+
 namespace Audio {
 class AudioStream;
 class Mixer;
@@ -79,6 +81,47 @@ private:
 	void mixBits12Stereo(uint8 *srcBuf, int32 inFrameCount, int feedSize, int32 mixBufStartIndex, int32 *ampTable);
 	void mixBits16Stereo(uint8 *srcBuf, int32 inFrameCount, int feedSize, int32 mixBufStartIndex, int32 *ampTable);
 
+	// Vectorized mixing of the tracks which don't need any resampling. Instead of looking
+	// up the amplitude tables, the values they hold are computed for several samples at once:
+	// mixBuf[i] += ((samples[i] >> shift) * scale) / 127, with the division truncating.
+	typedef void (*MixFunc)(uint16 *mixBuf, const int16 *samples, int count, int shift, int scale);
+	typedef void (*MixToStereoFunc)(uint16 *mixBuf, const int16 *samples, int count, int shift, int leftScale, int rightScale);
+
+	struct VectorFuncs {
+		MixFunc mix;
+		MixToStereoFunc mixToStereo;
+	};
+
+	static VectorFuncs _vectorFuncs;
+	static bool _vectorFuncsSelected;
+	static void selectVectorFuncs();
+
+	// Returns the factor the amplitude table of a volume (0-16) was built with
+	static int getAmpScale(int volume) {
+		return volume ? 8 * volume - 1 : 0;
+	}
+
+	static int16 scaleSample(int16 sample, int shift, int scale) {
+		return (int16)(((sample >> shift) * scale) / 127);
+	}
+
+	bool mixVectorized(uint8 *srcBuf, int32 inFrameCount, int wordSize, int channelCount, int feedSize, int32 mixBufStartIndex, int leftVolume, int rightVolume, bool ftIs11025Hz);
+
+#ifdef SCUMMVM_NEON
+	static void mixNEON(uint16 *mixBuf, const int16 *samples, int count, int shift, int scale);
+	static void mixToStereoNEON(uint16 *mixBuf, const int16 *samples, int count, int shift, int leftScale, int rightScale);
+#endif
+#ifdef SCUMMVM_SSE2
+	static void mixSSE2(uint16 *mixBuf, const int16 *samples, int count, int shift, int scale);
+	static void mixToStereoSSE2(uint16 *mixBuf, const int16 *samples, int count, int shift, int leftScale, int rightScale);
+#endif
+#ifdef SCUMMVM_AVX2
+	static void mixAVX2(uint16 *mixBuf, const int16 *samples, int count, int shift, int scale);
+	static void mixToStereoAVX2(uint16 *mixBuf, const int16 *samples, int count, int shift, int leftScale, int rightScale);
+#endif
+
+	friend class ::IMuseDigiInternalMixerTestSuite;
+
 public:
 	IMuseDigiInternalMixer(Audio::Mixer *mixer, int sampleRate, bool isEarlyDiMUSE, bool lowLatencyMode = false);
 	~IMuseDigiInternalMixer();
@@ -0,0 +1,107 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "common/scummsys.h"
+
+#include "scumm/imuse_digi/dimuse_engine.h"
+#include "scumm/imuse_digi/dimuse_internalmixer.h"
+
+#include <immintrin.h>
+
+#if defined(__clang__)
+#pragma clang attribute push (__attribute__((target("avx2"))), apply_to=function)
+#elif defined(__GNUC__)
+#pragma GCC push_options
+#pragma GCC target("avx2")
+#endif
+
+namespace Scumm {
+
+// Divides by 127 and truncates, like the building of the amplitude tables.
+// See the SSE2 version.
+static inline __m256i divideBy127(__m256i products) {
+	const __m256 sign = _mm256_castsi256_ps(_mm256_set1_epi32((int)0x80000000));
+	const __m256 half = _mm256_set1_ps(0.5f);
+	const __m256 recip = _mm256_set1_ps(1.0f / 127.0f);
+
+	__m256 p = _mm256_cvtepi32_ps(products);
+	p = _mm256_mul_ps(_mm256_add_ps(p, _mm256_or_ps(half, _mm256_and_ps(p, sign))), recip);
+	return _mm256_cvttps_epi32(p);
+}
+
+// Computes the amplitude table values of sixteen samples. Unpacking and
+// packing both work within 128-bit lanes, so the order is kept.
+static inline __m256i scaleSixteen(__m256i samples, __m256i scale) {
+	const __m256i lo = _mm256_mullo_epi16(samples, scale);
+	const __m256i hi = _mm256_mulhi_epi16(samples, scale);
+
+	return _mm256_packs_epi32(divideBy127(_mm256_unpacklo_epi16(lo, hi)), divideBy127(_mm256_unpackhi_epi16(lo, hi)));
+}
+
+void IMuseDigiInternalMixer::mixAVX2(uint16 *mixBuf, const int16 *samples, int count, int shift, int scale) {
+	const __m128i shiftCount = _mm_cvtsi32_si128(shift);
+	const __m256i scaleVec = _mm256_set1_epi16((int16)scale);
+
+	int i = 0;
+	for (; i + 16 <= count; i += 16) {
+		__m256i s = _mm256_sra_epi16(_mm256_loadu_si256((const __m256i *)(samples + i)), shiftCount);
+		__m256i d = _mm256_loadu_si256((const __m256i *)(mixBuf + i));
+		_mm256_storeu_si256((__m256i *)(mixBuf + i), _mm256_add_epi16(d, scaleSixteen(s, scaleVec)));
+	}
+
+	for (; i < count; i++)
+		mixBuf[i] += scaleSample(samples[i], shift, scale);
+}
+
+void IMuseDigiInternalMixer::mixToStereoAVX2(uint16 *mixBuf, const int16 *samples, int count, int shift, int leftScale, int rightScale) {
+	const __m128i shiftCount = _mm_cvtsi32_si128(shift);
+	const __m256i leftVec = _mm256_set1_epi16((int16)leftScale);
+	const __m256i rightVec = _mm256_set1_epi16((int16)rightScale);
+
+	int i = 0;
+	for (; i + 16 <= count; i += 16) {
+		__m256i s = _mm256_sra_epi16(_mm256_loadu_si256((const __m256i *)(samples + i)), shiftCount);
+		__m256i l = scaleSixteen(s, leftVec);
+		__m256i r = scaleSixteen(s, rightVec);
+
+		// The unpacking interleaves samples 0-3 and 8-11, then 4-7 and 12-15
+		__m256i lo = _mm256_unpacklo_epi16(l, r);
+		__m256i hi = _mm256_unpackhi_epi16(l, r);
+
+		__m256i d0 = _mm256_loadu_si256((const __m256i *)(mixBuf + 2 * i));
+		__m256i d1 = _mm256_loadu_si256((const __m256i *)(mixBuf + 2 * i + 16));
+		_mm256_storeu_si256((__m256i *)(mixBuf + 2 * i), _mm256_add_epi16(d0, _mm256_permute2x128_si256(lo, hi, 0x20)));
+		_mm256_storeu_si256((__m256i *)(mixBuf + 2 * i + 16), _mm256_add_epi16(d1, _mm256_permute2x128_si256(lo, hi, 0x31)));
+	}
+
+	for (; i < count; i++) {
+		mixBuf[2 * i]     += scaleSample(samples[i], shift, leftScale);
+		mixBuf[2 * i + 1] += scaleSample(samples[i], shift, rightScale);
+	}
+}
+
+} // End of namespace Scumm
+
+#if defined(__clang__)
+#pragma clang attribute pop
+#elif defined(__GNUC__)
+#pragma GCC pop_options
+#endif
@@ -0,0 +1,113 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "common/scummsys.h"
+
+#ifdef SCUMMVM_NEON
+
+#include "scumm/imuse_digi/dimuse_engine.h"
+#include "scumm/imuse_digi/dimuse_internalmixer.h"
+
+#include <arm_neon.h>
+
+#if !defined(__aarch64__) && !defined(__ARM_NEON)
+
+#if defined(__clang__)
+#pragma clang attribute push (__attribute__((target("neon"))), apply_to=function)
+#elif defined(__GNUC__)
+#pragma GCC push_options
+#pragma GCC target("fpu=neon")
+#endif
+
+#endif // !defined(__aarch64__) && !defined(__ARM_NEON)
+
+namespace Scumm {
+
+// Divides by 127 and truncates, like the building of the amplitude tables.
+// See the SSE2 version.
+static inline int32x4_t divideBy127(int32x4_t products) {
+	const uint32x4_t sign = vdupq_n_u32(0x80000000);
+	const uint32x4_t half = vreinterpretq_u32_f32(vdupq_n_f32(0.5f));
+	const float32x4_t recip = vdupq_n_f32(1.0f / 127.0f);
+
+	float32x4_t p = vcvtq_f32_s32(products);
+	float32x4_t bias = vreinterpretq_f32_u32(vorrq_u32(half, vandq_u32(vreinterpretq_u32_f32(p), sign)));
+	return vcvtq_s32_f32(vmulq_f32(vaddq_f32(p, bias), recip));
+}
+
+// Computes the amplitude table values of eight samples
+static inline int16x8_t scaleEight(int16x8_t samples, int16x4_t scale) {
+	int32x4_t lo = divideBy127(vmull_s16(vget_low_s16(samples), scale));
+	int32x4_t hi = divideBy127(vmull_s16(vget_high_s16(samples), scale));
+
+	return vcombine_s16(vmovn_s32(lo), vmovn_s32(hi));
+}
+
+void IMuseDigiInternalMixer::mixNEON(uint16 *mixBuf, const int16 *samples, int count, int shift, int scale) {
+	const int16x8_t shiftVec = vdupq_n_s16((int16)-shift);
+	const int16x4_t scaleVec = vdup_n_s16((int16)scale);
+
+	int i = 0;
+	for (; i + 8 <= count; i += 8) {
+		int16x8_t s = vshlq_s16(vld1q_s16(samples + i), shiftVec);
+		uint16x8_t d = vld1q_u16(mixBuf + i);
+		vst1q_u16(mixBuf + i, vaddq_u16(d, vreinterpretq_u16_s16(scaleEight(s, scaleVec))));
+	}
+
+	for (; i < count; i++)
+		mixBuf[i] += scaleSample(samples[i], shift, scale);
+}
+
+void IMuseDigiInternalMixer::mixToStereoNEON(uint16 *mixBuf, const int16 *samples, int count, int shift, int leftScale, int rightScale) {
+	const int16x8_t shiftVec = vdupq_n_s16((int16)-shift);
+	const int16x4_t leftVec = vdup_n_s16((int16)leftScale);
+	const int16x4_t rightVec = vdup_n_s16((int16)rightScale);
+
+	int i = 0;
+	for (; i + 8 <= count; i += 8) {
+		int16x8_t s = vshlq_s16(vld1q_s16(samples + i), shiftVec);
+
+		// Loading and storing two channels deinterleaves and interleaves them
+		uint16x8x2_t d = vld2q_u16(mixBuf + 2 * i);
+		d.val[0] = vaddq_u16(d.val[0], vreinterpretq_u16_s16(scaleEight(s, leftVec)));
+		d.val[1] = vaddq_u16(d.val[1], vreinterpretq_u16_s16(scaleEight(s, rightVec)));
+		vst2q_u16(mixBuf + 2 * i, d);
+	}
+
+	for (; i < count; i++) {
+		mixBuf[2 * i]     += scaleSample(samples[i], shift, leftScale);
+		mixBuf[2 * i + 1] += scaleSample(samples[i], shift, rightScale);
+	}
+}
+
+} // End of namespace Scumm
+
+#if !defined(__aarch64__) && !defined(__ARM_NEON)
+
+#if defined(__clang__)
+#pragma clang attribute pop
+#elif defined(__GNUC__)
+#pragma GCC pop_options
+#endif
+
+#endif // !defined(__aarch64__) && !defined(__ARM_NEON)
+
+#endif // SCUMMVM_NEON
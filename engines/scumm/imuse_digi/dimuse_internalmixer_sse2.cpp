@@ -0,0 +1,112 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "common/scummsys.h"
+
+#include "scumm/imuse_digi/dimuse_engine.h"
+#include "scumm/imuse_digi/dimuse_internalmixer.h"
+
+#include <emmintrin.h>
+
+#if !defined(__x86_64__)
+
+#if defined(__clang__)
+#pragma clang attribute push (__attribute__((target("sse2"))), apply_to=function)
+#elif defined(__GNUC__)
+#pragma GCC push_options
+#pragma GCC target("sse2")
+#endif
+
+#endif // !defined(__x86_64__)
+
+namespace Scumm {
+
+// Divides by 127 and truncates, like the building of the amplitude tables.
+// The products have at most 19 bits, so they are exact as floats; adding
+// half a step away from zero keeps the multiplication by the reciprocal
+// from landing on the wrong side of a multiple of 127.
+static inline __m128i divideBy127(__m128i products) {
+	const __m128 sign = _mm_castsi128_ps(_mm_set1_epi32((int)0x80000000));
+	const __m128 half = _mm_set1_ps(0.5f);
+	const __m128 recip = _mm_set1_ps(1.0f / 127.0f);
+
+	__m128 p = _mm_cvtepi32_ps(products);
+	p = _mm_mul_ps(_mm_add_ps(p, _mm_or_ps(half, _mm_and_ps(p, sign))), recip);
+	return _mm_cvttps_epi32(p);
+}
+
+// Computes the amplitude table values of eight samples
+static inline __m128i scaleEight(__m128i samples, __m128i scale) {
+	const __m128i lo = _mm_mullo_epi16(samples, scale);
+	const __m128i hi = _mm_mulhi_epi16(samples, scale);
+
+	return _mm_packs_epi32(divideBy127(_mm_unpacklo_epi16(lo, hi)), divideBy127(_mm_unpackhi_epi16(lo, hi)));
+}
+
+void IMuseDigiInternalMixer::mixSSE2(uint16 *mixBuf, const int16 *samples, int count, int shift, int scale) {
+	const __m128i shiftCount = _mm_cvtsi32_si128(shift);
+	const __m128i scaleVec = _mm_set1_epi16((int16)scale);
+
+	int i = 0;
+	for (; i + 8 <= count; i += 8) {
+		__m128i s = _mm_sra_epi16(_mm_loadu_si128((const __m128i *)(samples + i)), shiftCount);
+		__m128i d = _mm_loadu_si128((const __m128i *)(mixBuf + i));
+		_mm_storeu_si128((__m128i *)(mixBuf + i), _mm_add_epi16(d, scaleEight(s, scaleVec)));
+	}
+
+	for (; i < count; i++)
+		mixBuf[i] += scaleSample(samples[i], shift, scale);
+}
+
+void IMuseDigiInternalMixer::mixToStereoSSE2(uint16 *mixBuf, const int16 *samples, int count, int shift, int leftScale, int rightScale) {
+	const __m128i shiftCount = _mm_cvtsi32_si128(shift);
+	const __m128i leftVec = _mm_set1_epi16((int16)leftScale);
+	const __m128i rightVec = _mm_set1_epi16((int16)rightScale);
+
+	int i = 0;
+	for (; i + 8 <= count; i += 8) {
+		__m128i s = _mm_sra_epi16(_mm_loadu_si128((const __m128i *)(samples + i)), shiftCount);
+		__m128i l = scaleEight(s, leftVec);
+		__m128i r = scaleEight(s, rightVec);
+
+		__m128i d0 = _mm_loadu_si128((const __m128i *)(mixBuf + 2 * i));
+		__m128i d1 = _mm_loadu_si128((const __m128i *)(mixBuf + 2 * i + 8));
+		_mm_storeu_si128((__m128i *)(mixBuf + 2 * i), _mm_add_epi16(d0, _mm_unpacklo_epi16(l, r)));
+		_mm_storeu_si128((__m128i *)(mixBuf + 2 * i + 8), _mm_add_epi16(d1, _mm_unpackhi_epi16(l, r)));
+	}
+
+	for (; i < count; i++) {
+		mixBuf[2 * i]     += scaleSample(samples[i], shift, leftScale);
+		mixBuf[2 * i + 1] += scaleSample(samples[i], shift, rightScale);
+	}
+}
+
+} // End of namespace Scumm
+
+#if !defined(__x86_64__)
+
+#if defined(__clang__)
+#pragma clang attribute pop
+#elif defined(__GNUC__)
+#pragma GCC pop_options
+#endif
+
+#endif // !defined(__x86_64__)
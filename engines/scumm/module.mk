@@ -138,6 +138,19 @@ MODULE_OBJS += \
 	smush/codec47ARM.o
 endif
 
+ifdef SCUMMVM_NEON
+MODULE_OBJS += \
+	imuse_digi/dimuse_internalmixer_neon.o
+endif
+ifdef SCUMMVM_SSE2
+MODULE_OBJS += \
+	imuse_digi/dimuse_internalmixer_sse2.o
+endif
+ifdef SCUMMVM_AVX2
+MODULE_OBJS += \
+	imuse_digi/dimuse_internalmixer_avx2.o
+endif
+
 endif
 
 ifdef USE_ARM_GFX_ASM
@@ -186,6 +199,8 @@ MODULE_OBJS += \
 	he/sprite_he.o \
 	he/wiz_he.o \
 	he/wizwarp_he.o \
+	he/wizcache_he.o \
+	he/wizdecoded_he.o \
 	he/localizer.o \
 	he/logic/baseball2001.o \
 	he/logic/basketball_logic.o \
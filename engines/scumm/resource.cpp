@@ -864,6 +864,9 @@ byte *ResourceManager::createResource(ResType type, ResId idx, uint32 size) {
 		}
 	}
 
+	// The data is about to be (re)written, whether it is reused or not
+	_types[type][idx]._generation++;
+
 	// HE70+ reuses the resource without deallocating it if it has the same size.
 	// 
 	// Not replicating this behavior this can creare very rare gfx corruption issues, e.g.
@@ -909,6 +912,7 @@ ResourceManager::Resource::Resource() {
 	_status = 0;
 	_roomno = 0;
 	_roomoffs = 0;
+	_generation = 0;
 }
 
 ResourceManager::Resource::~Resource() {
@@ -966,6 +970,7 @@ void ResourceManager::nukeResource(ResType type, ResId idx) {
 		debugC(DEBUG_RESOURCE, "nukeResource(%s,%d)", nameOfResType(type), idx);
 		_allocatedSize -= _types[type][idx]._size;
 		_types[type][idx].nuke();
+		_vm->resourceNuked(type, idx);
 	}
 }
 
@@ -1062,6 +1067,7 @@ void ResourceManager::setModified(ResType type, ResId idx) {
 	if (!validateResource("Modified", type, idx))
 		return;
 	_types[type][idx].setModified();
+	_types[type][idx]._generation++;
 }
 
 void ResourceManager::setOffHeap(ResType type, ResId idx) {
@@ -131,6 +131,14 @@ public:
 		 */
 		uint32 _roomoffs;
 
+		/**
+		 * Counts how often the data of this resource has been created or
+		 * marked as modified, so that anything derived from the data can
+		 * tell when it is stale.
+		 * Unlike the other fields, this is kept when the resource is nuked.
+		 */
+		uint32 _generation;
+
 	public:
 		Resource();
 		~Resource();
@@ -587,10 +587,10 @@ int ScummEngine::readVar(uint var) {
 		}
 
 		if (VAR_SUBTITLES != 0xFF && var == VAR_SUBTITLES) {
-			return ConfMan.getBool("subtitles");
+			return _subtitlesSetting.get();
 		}
 		if (VAR_NOSUBTITLES != 0xFF && var == VAR_NOSUBTITLES) {
-			return !ConfMan.getBool("subtitles");
+			return !_subtitlesSetting.get();
 		}
 
 		// WORKAROUND: The Macintosh version version of MI2 first sets the
@@ -24,6 +24,7 @@
 
 #include "engines/engine.h"
 
+#include "common/config-manager.h"
 #include "common/endian.h"
 #include "common/events.h"
 #include "common/file.h"
@@ -1115,6 +1116,9 @@ protected:
 	int readSoundResourceSmallHeader(ResId idx);
 	bool isResourceInUse(ResType type, ResId idx) const;
 
+	/** Called by the resource manager after the data of a resource was freed */
+	virtual void resourceNuked(ResType type, ResId idx) {}
+
 	virtual void setupRoomSubBlocks();
 	virtual void resetRoomSubBlocks();
 
@@ -1549,6 +1553,10 @@ protected:
 	bool _copyProtection = false;
 	bool _shadowPalRemap = false;
 
+	// Read by scripts through VAR_SUBTITLES, and every frame while a line
+	// is being spoken
+	Common::ConfigValue<bool> _subtitlesSetting{"subtitles"};
+
 	// Indy4 Amiga specific
 	uint16 _amigaFirstUsedColor = 0;
 	byte _amigaPalette[3 * 64];
@@ -576,10 +576,9 @@ void SmushPlayer::handleTextResource(uint32 subType, int32 subSize, Common::Seek
 
 	// if subtitles disabled and bit 3 is set, then do not draw
 	//
-	// Query ConfMan here. However it may be slower, but
-	// player may want to switch the subtitles on or off during the
-	// playback. This fixes bug #2812
-	if ((!ConfMan.getBool("subtitles")) && ((flags & 8) == 8))
+	// Query the setting here, since the player may want to switch the
+	// subtitles on or off during the playback. This fixes bug #2812
+	if ((!_subtitlesSetting.get()) && ((flags & 8) == 8))
 		return;
 
 	bool isCJKComi = (_vm->_game.id == GID_CMI && _vm->_useCJKMode);
@@ -22,6 +22,7 @@
 #if !defined(SCUMM_SMUSH_PLAYER_H) && defined(ENABLE_SCUMM_7_8)
 #define SCUMM_SMUSH_PLAYER_H
 
+#include "common/config-manager.h"
 #include "common/util.h"
 
 namespace Audio {
@@ -172,6 +173,9 @@ private:
 	bool _skipPalette;
 	int _iactTable[4];
 
+	// Checked for every subtitle, since it can change during playback
+	Common::ConfigValue<bool> _subtitlesSetting{"subtitles"};
+
 	SmushAudioTrack _smushTracks[SMUSH_MAX_TRACKS];
 	SmushAudioDispatch _smushDispatch[SMUSH_MAX_TRACKS];
 
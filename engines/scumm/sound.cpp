@@ -428,9 +428,9 @@ void Sound::processSfxQueues() {
 
 #ifdef USE_TTS
 		Common::TextToSpeechManager *ttsMan = g_system->getTextToSpeechManager();
-		if (finished && (!ConfMan.getBool("subtitles") || _vm->_talkDelay == 0) && (!ttsMan || !ttsMan->isSpeaking())) {
+		if (finished && (!_subtitlesSetting.get() || _vm->_talkDelay == 0) && (!ttsMan || !ttsMan->isSpeaking())) {
 #else
-		if (finished && (!ConfMan.getBool("subtitles") || _vm->_talkDelay == 0)) {
+		if (finished && (!_subtitlesSetting.get() || _vm->_talkDelay == 0)) {
 #endif
 			if (!(_vm->_game.version == 8 && _vm->VAR(_vm->VAR_HAVE_MSG) == 0))
 				_vm->stopTalk();
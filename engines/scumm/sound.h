@@ -22,6 +22,7 @@
 #ifndef SCUMM_SOUND_H
 #define SCUMM_SOUND_H
 
+#include "common/config-manager.h"
 #include "common/scummsys.h"
 #include "common/serializer.h"
 #include "common/str.h"
@@ -106,6 +107,9 @@ protected:
 	bool _useRemasteredAudio = false;
 	bool _enableAmbienceSounds = false;
 
+	// Checked every frame while a line is being spoken
+	Common::ConfigValue<bool> _subtitlesSetting{"subtitles"};
+
 public:
 	Audio::SoundHandle *_talkChannelHandle;	// Handle of mixer channel actor is talking on
 
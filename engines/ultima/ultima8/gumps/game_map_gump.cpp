@@ -49,14 +49,14 @@ int GameMapGump::_gridlines = 0;
 
 GameMapGump::GameMapGump() :
 	Gump(), _displayDragging(false), _displayList(0), _draggingShape(0),
-		_draggingFrame(0), _draggingFlags(0) {
+		_draggingFrame(0), _draggingFlags(0), _benchmarkBuilds(0) {
 	_displayList = new ItemSorter(2048);
 }
 
 GameMapGump::GameMapGump(int x, int y, int width, int height) :
 		Gump(x, y, width, height, 0, FLAG_DONT_SAVE | FLAG_CORE_GUMP, LAYER_GAMEMAP),
 		_displayList(0), _displayDragging(false), _draggingShape(0), _draggingFrame(0),
-		_draggingFlags(0) {
+		_draggingFlags(0), _benchmarkBuilds(0) {
 	// Offset the gump. We want 0,0 to be the centre
 	_dims.moveTo(-_dims.width() / 2, -_dims.height() / 2);
 
@@ -106,6 +106,26 @@ void GameMapGump::PaintThis(RenderSurface *surf, int32 lerp_factor, bool scaled)
 	}
 
 	Common::Rect32 clipWindow = surf->getClippingRect();
+	BuildDisplayList(map, clipWindow, loc, zlimit, lerp_factor);
+
+	// Build the display list again when benchmarking the sorting
+	if (_benchmarkBuilds > 0) {
+		uint32 start = g_system->getMillis();
+		for (int i = 0; i < _benchmarkBuilds; i++)
+			BuildDisplayList(map, clipWindow, loc, zlimit, lerp_factor);
+		debug("Built the display list %d times in %u ms", _benchmarkBuilds, g_system->getMillis() - start);
+		_benchmarkBuilds = 0;
+	}
+
+	int gridlines = _gridlines;
+	if (gridlines < 0) {
+		gridlines = map->getChunkSize();
+	}
+
+	_displayList->PaintDisplayList(surf, _highlightItems, _showFootpads, gridlines);
+}
+
+void GameMapGump::BuildDisplayList(CurrentMap *map, const Common::Rect32 &clipWindow, const Point3 &loc, int zlimit, int32 lerp_factor) {
 	_displayList->BeginDisplayList(clipWindow, loc);
 
 	uint32 gametick = Kernel::get_instance()->getFrameNum();
@@ -161,13 +181,6 @@ void GameMapGump::PaintThis(RenderSurface *surf, int32 lerp_factor, bool scaled)
 		_displayList->AddItem(_draggingPos, _draggingShape, _draggingFrame,
 		                      _draggingFlags, Item::EXT_TRANSPARENT);
 	}
-
-	int gridlines = _gridlines;
-	if (gridlines < 0) {
-		gridlines = map->getChunkSize();
-	}
-
-	_displayList->PaintDisplayList(surf, _highlightItems, _showFootpads, gridlines);
 }
 
 // Trace a click, and return ObjId
@@ -381,6 +394,10 @@ void GameMapGump::IncSortOrder(int count) {
 	_displayList->IncSortLimit(count);
 }
 
+void GameMapGump::BenchmarkDisplayList(int builds) {
+	_benchmarkBuilds = builds;
+}
+
 bool GameMapGump::StartDraggingItem(Item *item, int mx, int my) {
 //	ParentToGump(mx, my);
 
@@ -31,6 +31,7 @@ namespace Ultima8 {
 
 class ItemSorter;
 class CameraProcess;
+class CurrentMap;
 
 /**
  * The  gump which holds all the game map elements (floor, avatar, objects, etc)
@@ -76,6 +77,9 @@ public:
 
 	void IncSortOrder(int count);
 
+	// Time building the display list this many more times on the next paint
+	void BenchmarkDisplayList(int builds);
+
 	bool loadData(Common::ReadStream *rs, uint32 version);
 	void saveData(Common::WriteStream *ws) override;
 
@@ -101,12 +105,16 @@ public:
 	void        RenderSurfaceChanged() override;
 
 protected:
+	void BuildDisplayList(CurrentMap *map, const Common::Rect32 &clipWindow, const Point3 &loc, int zlimit, int32 lerp_factor);
+
 	bool _displayDragging;
 	uint32 _draggingShape;
 	uint32 _draggingFrame;
 	uint32 _draggingFlags;
 	Point3 _draggingPos;
 
+	int _benchmarkBuilds;
+
 	static bool _highlightItems;
 	static bool _showFootpads;
 	static int _gridlines;
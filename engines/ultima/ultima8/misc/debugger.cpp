@@ -98,6 +98,7 @@ Debugger::Debugger() : GUI::Debugger() {
 	registerCmd("GameMapGump::dumpAllMaps", WRAP_METHOD(Debugger, cmdDumpAllMaps));
 	registerCmd("GameMapGump::incrementSortOrder", WRAP_METHOD(Debugger, cmdIncrementSortOrder));
 	registerCmd("GameMapGump::decrementSortOrder", WRAP_METHOD(Debugger, cmdDecrementSortOrder));
+	registerCmd("GameMapGump::benchmarkDisplayList", WRAP_METHOD(Debugger, cmdBenchmarkDisplayList));
 
 	registerCmd("Kernel::processTypes", WRAP_METHOD(Debugger, cmdProcessTypes));
 	registerCmd("Kernel::processInfo", WRAP_METHOD(Debugger, cmdProcessInfo));
@@ -900,6 +901,14 @@ bool Debugger::cmdDecrementSortOrder(int argc, const char **argv) {
 	return false;
 }
 
+bool Debugger::cmdBenchmarkDisplayList(int argc, const char **argv) {
+	int32 builds = argc > 1 ? strtol(argv[1], 0, 0) : 100;
+	GameMapGump *gump = Ultima8Engine::get_instance()->getGameMapGump();
+	if (gump)
+		gump->BenchmarkDisplayList(builds);
+	return false;
+}
+
 
 bool Debugger::cmdProcessTypes(int argc, const char **argv) {
 	Kernel::get_instance()->processTypes();
@@ -46,8 +46,8 @@ static const uint32 TRANSPARENT_COLOR = TEX32_PACK_RGBA(0x7F, 0x00, 0x00, 0x7F);
 static const uint32 HIGHLIGHT_COLOR = TEX32_PACK_RGBA(0xFF, 0xFF, 0x00, 0x1F);
 
 ItemSorter::ItemSorter(int capacity) :
-	_shapes(nullptr), _clipWindow(0, 0, 0, 0), _items(nullptr), _itemsTail(nullptr),
-	_itemsUnused(nullptr), _painted(nullptr), _camSx(0), _camSy(0),
+	_shapes(nullptr), _clipWindow(0, 0, 0, 0), _itemsUnused(nullptr),
+	_painted(nullptr), _camSx(0), _camSy(0),
 	_sortLimit(0), _sortLimitChanged(false) {
 	int i = capacity;
 	while (i--) {
@@ -58,12 +58,10 @@ ItemSorter::ItemSorter(int capacity) :
 }
 
 ItemSorter::~ItemSorter() {
-	if (_itemsTail) {
-		_itemsTail->_next = _itemsUnused;
-		_itemsUnused = _items;
+	if (_list.getItemsTail()) {
+		_list.getItemsTail()->_next = _itemsUnused;
+		_itemsUnused = _list.getItems();
 	}
-	_items = nullptr;
-	_itemsTail = nullptr;
 
 	while (_itemsUnused) {
 		SortItem *next = _itemsUnused->_next;
@@ -79,13 +77,12 @@ void ItemSorter::BeginDisplayList(const Common::Rect32 &clipWindow, const Point3
 	// Set the clip window, and reset the item list
 	_clipWindow = clipWindow;
 
-	if (_itemsTail) {
-		_itemsTail->_next = _itemsUnused;
-		_itemsUnused = _items;
+	if (_list.getItemsTail()) {
+		_list.getItemsTail()->_next = _itemsUnused;
+		_itemsUnused = _list.getItems();
 	}
 
-	_items = nullptr;
-	_itemsTail = nullptr;
+	_list.clear(clipWindow);
 	_painted = nullptr;
 
 	// Screenspace bounding box bottom x coord (RNB x coord)
@@ -187,86 +184,10 @@ void ItemSorter::AddItem(const Point3 &pt, uint32 shapeNum, uint32 frame_num, ui
 	// are never deleted
 	si->_depends.clear();
 
-	// Iterate the list and compare _shapes
-
-	// Ok,
-	SortItem *addpoint = nullptr;
-	for (SortItem *si2 = _items; si2 != nullptr; si2 = si2->_next) {
-		// Get the insert point... which is before the first item that has higher z than us
-		if (!addpoint && si->listLessThan(*si2))
-			addpoint = si2;
-
-		if (si2->_occluded)
-			continue;
-
-#ifdef SORTITEM_OCCLUSION_EXPERIMENTAL
-		// Find adjoining rects for better occlusion
-		if (si->_occl && si2->_occl && si->_z == si2->_z) {
-			// Does this share an edge?
-			if (si->_y == si2->_y && si->_yFar == si2->_yFar) {
-				if (si->_xLeft == si2->_x) {
-					si->_xAdjoin = si2;
-				} else if (si->_x == si2->_xLeft) {
-					si2->_xAdjoin = si;
-				}
-			}
-			else if (si->_x == si2->_x && si->_xLeft == si2->_xLeft) {
-				if (si->_yFar == si2->_y) {
-					si->_yAdjoin = si2;
-				} else if (si->_y == si2->_yFar) {
-					si2->_yAdjoin = si;
-				}
-			}
-		}
-#endif // SORTITEM_OCCLUSION_EXPERIMENTAL
-
-		// Attempt to find paint dependency order
-		if (si->overlap(*si2)) {
-			if (si->below(*si2)) {
-				if (si2->_occl && si2->occludes(*si)) {
-					// No need to do any more checks, this isn't visible
-					si->_occluded = true;
-					break;
-				} else {
-					// si1 is behind si2, so add it to si2's dependency list
-					si2->_depends.insert_sorted(si);
-				}
-			} else {
-				if (si->_occl && si->occludes(*si2)) {
-					// Occluded, but we can't remove it from the list
-					si2->_occluded = true;
-				} else {
-					// si2 is behind si1, so add it to si1's dependency list
-					si->_depends.insert_sorted(si2);
-				}
-			}
-		}
-	}
-
-	// Add it to the list
+	// Take it from the unused ones, then find its dependencies and add it
+	// to the list
 	_itemsUnused = _itemsUnused->_next;
-
-	// have a position
-	//addpoint = 0;
-	if (addpoint) {
-		si->_next = addpoint;
-		si->_prev = addpoint->_prev;
-		addpoint->_prev = si;
-		if (si->_prev)
-			si->_prev->_next = si;
-		else
-			_items = si;
-	}
-	// Add it to the end of the list
-	else {
-		if (_itemsTail)
-			_itemsTail->_next = si;
-		if (!_items)
-			_items = si;
-		si->_next = nullptr;
-		si->_prev = _itemsTail;
-		_itemsTail = si;
-	}
+	_list.add(si);
 }
 
 void ItemSorter::AddItem(const Item *add) {
@@ -282,12 +203,12 @@ void ItemSorter::PaintDisplayList(RenderSurface *surf, bool item_highlight, bool
 	}
 
 #ifdef SORTITEM_OCCLUSION_EXPERIMENTAL
-	int32 minZ = _items ? _items->_z : 0;
+	int32 minZ = _list.getItems() ? _list.getItems()->_z : 0;
 
 	// Reverse iterate to check higher z items first.
 	// This increases odds of occluding items below before checking them.
 	// Ignore items already occluded or at lowest Z as they are less likely occlude additional items.
-	for (SortItem *si1 = _itemsTail; si1 != nullptr; si1 = si1->_prev) {
+	for (SortItem *si1 = _list.getItemsTail(); si1 != nullptr; si1 = si1->_prev) {
 		// Check if item is part of a 2x2 rects square
 		if (si1->_occl && !si1->_occluded && si1->_z > minZ &&
 			si1->_xAdjoin && si1->_yAdjoin &&
@@ -354,7 +275,7 @@ void ItemSorter::PaintDisplayList(RenderSurface *surf, bool item_highlight, bool
 
 				oc.setBoxBounds(box, _camSx, _camSy);
 
-				for (si2 = _items; si2 != nullptr; si2 = si2->_next) {
+				for (si2 = _list.getItems(); si2 != nullptr; si2 = si2->_next) {
 					if (si2->_groupNum != group && !si2->_occluded &&
 						si2->overlap(oc) && si2->below(oc) && oc.occludes(*si2)) {
 						si2->_occluded = true;
@@ -365,7 +286,7 @@ void ItemSorter::PaintDisplayList(RenderSurface *surf, bool item_highlight, bool
 	}
 #endif
 
-	SortItem *it = _items;
+	SortItem *it = _list.getItems();
 	SortItem *end = nullptr;
 	_painted = nullptr;  // Reset the paint tracking
 	while (it != end) {
@@ -377,7 +298,7 @@ void ItemSorter::PaintDisplayList(RenderSurface *surf, bool item_highlight, bool
 
 	// Item highlighting. We redraw each 'item' transparent
 	if (item_highlight) {
-		it = _items;
+		it = _list.getItems();
 		while (it != end) {
 			if (!(it->_flags & (Item::FLG_DISPOSABLE | Item::FLG_FAST_ONLY)) && !it->_fixed) {
 				surf->PaintHighlightInvis(it->_shape,
@@ -542,7 +463,7 @@ uint16 ItemSorter::Trace(int32 x, int32 y, HitFace *face, bool item_highlight) {
 	SortItem *selected;
 
 	if (!_painted) { // If no painted item found, we need to sort the items
-		it = _items;
+		it = _list.getItems();
 		_painted = nullptr;
 		while (it != nullptr) {
 			if (it->_order == -1)
@@ -559,7 +480,7 @@ uint16 ItemSorter::Trace(int32 x, int32 y, HitFace *face, bool item_highlight) {
 	if (item_highlight) {
 		selected = nullptr;
 
-		for (it = _itemsTail; it != nullptr; it = it->_prev) {
+		for (it = _list.getItemsTail(); it != nullptr; it = it->_prev) {
 			if (!(it->_flags & (Item::FLG_DISPOSABLE | Item::FLG_FAST_ONLY)) && !it->_fixed) {
 				if (!it->_itemNum || !it->contains(x, y))
 					continue;
@@ -591,7 +512,7 @@ uint16 ItemSorter::Trace(int32 x, int32 y, HitFace *face, bool item_highlight) {
 	// Finally we then set the selected SortItem if it's '_order' is highest
 
 	if (!selected) {
-		for (it = _items; it != nullptr; it = it->_next) {
+		for (it = _list.getItems(); it != nullptr; it = it->_next) {
 			if (!it->_itemNum || !it->contains(x, y))
 				continue;
 
@@ -23,6 +23,7 @@
 #define ULTIMA8_WORLD_ITEMSORTER_H
 
 #include "common/rect.h"
+#include "ultima/ultima8/world/sort_item_list.h"
 
 namespace Ultima {
 namespace Ultima8 {
@@ -37,8 +38,7 @@ class ItemSorter {
 	MainShapeArchive    *_shapes;
 	Common::Rect32      _clipWindow;
 
-	SortItem    *_items;
-	SortItem    *_itemsTail;
+	SortItemList _list;
 	SortItem    *_itemsUnused;
 	SortItem    *_painted;
 
@@ -0,0 +1,237 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "common/algorithm.h"
+#include "ultima/ultima8/world/sort_item_list.h"
+#include "ultima/ultima8/world/sort_item.h"
+
+namespace Ultima {
+namespace Ultima8 {
+
+// Size in pixels of the cells of the grid
+static const int32 GRID_CELL_SIZE = 64;
+
+// Distance between the list orders of consecutive items, after renumbering
+static const uint64 LIST_ORDER_STEP = (uint64)1 << 32;
+
+SortItemList::SortItemList() : _items(nullptr), _itemsTail(nullptr),
+	_clipWindow(0, 0, 0, 0), _gridWidth(0), _gridHeight(0) {
+}
+
+void SortItemList::clear(const Common::Rect32 &clipWindow) {
+	_items = nullptr;
+	_itemsTail = nullptr;
+
+	// Reset the grid, keeping its memory
+	_clipWindow = clipWindow;
+	_gridWidth = MAX<int32>((clipWindow.width() + GRID_CELL_SIZE - 1) / GRID_CELL_SIZE, 1);
+	_gridHeight = MAX<int32>((clipWindow.height() + GRID_CELL_SIZE - 1) / GRID_CELL_SIZE, 1);
+	_gridCells.resize(_gridWidth * _gridHeight);
+	for (uint i = 0; i < _gridCells.size(); i++)
+		_gridCells[i] = -1;
+	_gridEntries.resize(0);
+	_keyFirst.resize(0);
+}
+
+void SortItemList::add(SortItem *si) {
+	// Get the insert point... which is before the first item that has higher z than us
+	SortItem *addpoint = nullptr;
+	for (uint i = 0; i < _keyFirst.size(); i++) {
+		SortItem *first = _keyFirst[i];
+		if (si->listLessThan(*first) && (!addpoint || first->_listOrder < addpoint->_listOrder))
+			addpoint = first;
+	}
+
+	// Compare with the items we could overlap, in list order. The others
+	// would fail the screenspace rect check of overlap() anyway.
+	findCandidates(si);
+
+	for (uint i = 0; i < _candidates.size(); i++) {
+		SortItem *si2 = _candidates[i];
+
+		if (si2->_occluded)
+			continue;
+
+#ifdef SORTITEM_OCCLUSION_EXPERIMENTAL
+		// Find adjoining rects for better occlusion
+		if (si->_occl && si2->_occl && si->_z == si2->_z) {
+			// Does this share an edge?
+			if (si->_y == si2->_y && si->_yFar == si2->_yFar) {
+				if (si->_xLeft == si2->_x) {
+					si->_xAdjoin = si2;
+				} else if (si->_x == si2->_xLeft) {
+					si2->_xAdjoin = si;
+				}
+			}
+			else if (si->_x == si2->_x && si->_xLeft == si2->_xLeft) {
+				if (si->_yFar == si2->_y) {
+					si->_yAdjoin = si2;
+				} else if (si->_y == si2->_yFar) {
+					si2->_yAdjoin = si;
+				}
+			}
+		}
+#endif // SORTITEM_OCCLUSION_EXPERIMENTAL
+
+		// Attempt to find paint dependency order
+		if (si->overlap(*si2)) {
+			if (si->below(*si2)) {
+				if (si2->_occl && si2->occludes(*si)) {
+					// No need to do any more checks, this isn't visible
+					si->_occluded = true;
+
+					// The insert point was only looked for up to here
+					if (addpoint && addpoint->_listOrder > si2->_listOrder)
+						addpoint = nullptr;
+					break;
+				} else {
+					// si1 is behind si2, so add it to si2's dependency list
+					si2->_depends.insert_sorted(si);
+				}
+			} else {
+				if (si->_occl && si->occludes(*si2)) {
+					// Occluded, but we can't remove it from the list
+					si2->_occluded = true;
+				} else {
+					// si2 is behind si1, so add it to si1's dependency list
+					si->_depends.insert_sorted(si2);
+				}
+			}
+		}
+	}
+
+	// have a position
+	if (addpoint) {
+		si->_next = addpoint;
+		si->_prev = addpoint->_prev;
+		addpoint->_prev = si;
+		if (si->_prev)
+			si->_prev->_next = si;
+		else
+			_items = si;
+	}
+	// Add it to the end of the list
+	else {
+		if (_itemsTail)
+			_itemsTail->_next = si;
+		if (!_items)
+			_items = si;
+		si->_next = nullptr;
+		si->_prev = _itemsTail;
+		_itemsTail = si;
+	}
+
+	setListOrder(si);
+
+	// Keep track of the first item of each sorting key
+	uint key;
+	for (key = 0; key < _keyFirst.size(); key++) {
+		if (!si->listLessThan(*_keyFirst[key]) && !_keyFirst[key]->listLessThan(*si))
+			break;
+	}
+	if (key == _keyFirst.size())
+		_keyFirst.push_back(si);
+	else if (si->_listOrder < _keyFirst[key]->_listOrder)
+		_keyFirst[key] = si;
+
+	// Occluded items are never compared again
+	if (!si->_occluded)
+		addToGrid(si);
+}
+
+void SortItemList::getGridRange(const Common::Rect32 &r, int32 &x0, int32 &y0, int32 &x1, int32 &y1) const {
+	// Parts outside of the clip window go to the border cells
+	x0 = CLIP<int32>((r.left - _clipWindow.left) / GRID_CELL_SIZE, 0, _gridWidth - 1);
+	y0 = CLIP<int32>((r.top - _clipWindow.top) / GRID_CELL_SIZE, 0, _gridHeight - 1);
+	x1 = CLIP<int32>((r.right - 1 - _clipWindow.left) / GRID_CELL_SIZE, x0, _gridWidth - 1);
+	y1 = CLIP<int32>((r.bottom - 1 - _clipWindow.top) / GRID_CELL_SIZE, y0, _gridHeight - 1);
+}
+
+void SortItemList::addToGrid(SortItem *si) {
+	int32 x0, y0, x1, y1;
+	getGridRange(si->_sr, x0, y0, x1, y1);
+
+	for (int32 y = y0; y <= y1; y++) {
+		for (int32 x = x0; x <= x1; x++) {
+			GridEntry entry;
+			entry._item = si;
+			entry._next = _gridCells[y * _gridWidth + x];
+			_gridCells[y * _gridWidth + x] = _gridEntries.size();
+			_gridEntries.push_back(entry);
+		}
+	}
+}
+
+static bool compareListOrder(const SortItem *si1, const SortItem *si2) {
+	return si1->_listOrder < si2->_listOrder;
+}
+
+void SortItemList::findCandidates(const SortItem *si) {
+	_candidates.resize(0);
+
+#ifdef SORTITEM_OCCLUSION_EXPERIMENTAL
+	// The adjoining rects are looked for among all the items
+	for (SortItem *si2 = _items; si2 != nullptr; si2 = si2->_next)
+		_candidates.push_back(si2);
+#else
+	int32 x0, y0, x1, y1;
+	getGridRange(si->_sr, x0, y0, x1, y1);
+
+	for (int32 y = y0; y <= y1; y++) {
+		for (int32 x = x0; x <= x1; x++) {
+			for (int e = _gridCells[y * _gridWidth + x]; e != -1; e = _gridEntries[e]._next) {
+				SortItem *si2 = _gridEntries[e]._item;
+				if (!si->_sr.intersects(si2->_sr))
+					continue;
+
+				// Items in several cells are only taken from the first cell
+				// they share with us
+				int32 x2, y2, x3, y3;
+				getGridRange(si2->_sr, x2, y2, x3, y3);
+				if (x == MAX(x0, x2) && y == MAX(y0, y2))
+					_candidates.push_back(si2);
+			}
+		}
+	}
+
+	Common::sort(_candidates.begin(), _candidates.end(), compareListOrder);
+#endif
+}
+
+void SortItemList::setListOrder(SortItem *si) {
+	uint64 prevOrder = si->_prev ? si->_prev->_listOrder : 0;
+	uint64 nextOrder = si->_next ? si->_next->_listOrder : (uint64)-1;
+
+	if (nextOrder - prevOrder >= 2) {
+		si->_listOrder = prevOrder + MIN<uint64>((nextOrder - prevOrder) / 2, LIST_ORDER_STEP);
+		return;
+	}
+
+	// No room left, so renumber the whole list
+	uint64 order = 0;
+	for (SortItem *it = _items; it != nullptr; it = it->_next) {
+		order += LIST_ORDER_STEP;
+		it->_listOrder = order;
+	}
+}
+
+} // End of namespace Ultima8
+} // End of namespace Ultima
@@ -0,0 +1,91 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef ULTIMA8_WORLD_SORTITEMLIST_H
+#define ULTIMA8_WORLD_SORTITEMLIST_H
+
+#include "common/array.h"
+#include "common/rect.h"
+
+namespace Ultima {
+namespace Ultima8 {
+
+struct SortItem;
+
+/**
+ * The sorted list of SortItems of the ItemSorter, along with their paint
+ * dependencies. Like SortItem, it is in a separate header to enable unit
+ * testing.
+ *
+ * A new item only needs to be compared with the items its screenspace rect
+ * overlaps, which are found with a grid over the clip window. The results
+ * are the same as comparing it with every item in the list.
+ */
+class SortItemList {
+	// Item in a cell of the grid
+	struct GridEntry {
+		SortItem    *_item;
+		int         _next;
+	};
+
+	SortItem    *_items;
+	SortItem    *_itemsTail;
+
+	Common::Rect32              _clipWindow;
+	int32                       _gridWidth, _gridHeight;
+	Common::Array<int>          _gridCells;
+	Common::Array<GridEntry>    _gridEntries;
+
+	// First item in the list for each distinct sorting key
+	Common::Array<SortItem *>   _keyFirst;
+
+	// Items to compare with the one being added
+	Common::Array<SortItem *>   _candidates;
+
+public:
+	SortItemList();
+
+	// Empty the list. The items themselves are not freed.
+	void clear(const Common::Rect32 &clipWindow);
+
+	// Find the dependencies of an item with its bounds and flags set up,
+	// and insert it in the list
+	void add(SortItem *si);
+
+	SortItem *getItems() const {
+		return _items;
+	}
+
+	SortItem *getItemsTail() const {
+		return _itemsTail;
+	}
+
+private:
+	void getGridRange(const Common::Rect32 &r, int32 &x0, int32 &y0, int32 &x1, int32 &y1) const;
+	void addToGrid(SortItem *si);
+	void findCandidates(const SortItem *si);
+	void setListOrder(SortItem *si);
+};
+
+} // End of namespace Ultima8
+} // End of namespace Ultima
+
+#endif
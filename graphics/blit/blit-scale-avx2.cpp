@@ -0,0 +1,172 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "common/scummsys.h"
+
+#include "graphics/blit/blit-scale.h"
+
+#include <immintrin.h>
+
+#if defined(__clang__)
+#pragma clang attribute push (__attribute__((target("avx2"))), apply_to=function)
+#elif defined(__GNUC__)
+#pragma GCC push_options
+#pragma GCC target("avx2")
+#endif
+
+namespace Graphics {
+
+namespace {
+
+// See the SSE2 version for how the unsigned fraction is handled.
+static FORCEINLINE __m256i interpolate(__m256i c0, __m256i c1, __m256i frac) {
+	__m256i diff = _mm256_sub_epi16(c1, c0);
+	__m256i high = _mm256_mulhi_epi16(diff, frac);
+	high = _mm256_add_epi16(high, _mm256_and_si256(diff, _mm256_srai_epi16(frac, 15)));
+	return _mm256_add_epi16(c0, high);
+}
+
+// Interpolates eight pixels. fracX and fracY hold one 16 bit fraction per
+// 32 bit lane, replicated into both halves.
+static FORCEINLINE __m256i interpolatePixels(__m256i c00, __m256i c01, __m256i c10, __m256i c11, __m256i fracX, __m256i fracY) {
+	const __m256i zero = _mm256_setzero_si256();
+
+	// All of these work within 128 bit lanes, so the pixel order is
+	// restored by the final pack.
+	__m256i fxLo = _mm256_unpacklo_epi32(fracX, fracX);
+	__m256i fxHi = _mm256_unpackhi_epi32(fracX, fracX);
+	__m256i fyLo = _mm256_unpacklo_epi32(fracY, fracY);
+	__m256i fyHi = _mm256_unpackhi_epi32(fracY, fracY);
+
+	__m256i t1Lo = interpolate(_mm256_unpacklo_epi8(c00, zero), _mm256_unpacklo_epi8(c01, zero), fxLo);
+	__m256i t1Hi = interpolate(_mm256_unpackhi_epi8(c00, zero), _mm256_unpackhi_epi8(c01, zero), fxHi);
+	__m256i t2Lo = interpolate(_mm256_unpacklo_epi8(c10, zero), _mm256_unpacklo_epi8(c11, zero), fxLo);
+	__m256i t2Hi = interpolate(_mm256_unpackhi_epi8(c10, zero), _mm256_unpackhi_epi8(c11, zero), fxHi);
+
+	return _mm256_packus_epi16(interpolate(t1Lo, t2Lo, fyLo), interpolate(t1Hi, t2Hi, fyHi));
+}
+
+static FORCEINLINE __m256i replicateFractions(__m256i frac) {
+	frac = _mm256_and_si256(frac, _mm256_set1_epi32(0xffff));
+	return _mm256_or_si256(frac, _mm256_slli_epi32(frac, 16));
+}
+
+} // End of anonymous namespace
+
+void BilinearBlit::scaleRowAVX2(uint32 *dst, const uint32 *row0, const uint32 *row1,
+                                const int *col0, const int *col1, const uint16 *fracX,
+                                int fracY, uint width) {
+	const __m256i fy = _mm256_set1_epi16((int16)fracY);
+
+	uint x = 0;
+	for (; x + 8 <= width; x += 8) {
+		__m256i i0 = _mm256_loadu_si256((const __m256i *)(col0 + x));
+		__m256i i1 = _mm256_loadu_si256((const __m256i *)(col1 + x));
+
+		__m256i c00 = _mm256_i32gather_epi32((const int *)row0, i0, 4);
+		__m256i c01 = _mm256_i32gather_epi32((const int *)row0, i1, 4);
+		__m256i c10 = _mm256_i32gather_epi32((const int *)row1, i0, 4);
+		__m256i c11 = _mm256_i32gather_epi32((const int *)row1, i1, 4);
+
+		__m256i fx = _mm256_cvtepu16_epi32(_mm_loadu_si128((const __m128i *)(fracX + x)));
+
+		_mm256_storeu_si256((__m256i *)(dst + x), interpolatePixels(c00, c01, c10, c11, replicateFractions(fx), fy));
+	}
+
+	for (; x < width; x++) {
+		dst[x] = interpolatePixel(row0[col0[x]], row0[col1[x]], row1[col0[x]], row1[col1[x]], fracX[x], fracY);
+	}
+}
+
+void BilinearBlit::rotoscaleRowAVX2(uint32 *dst, const byte *src, uint srcPitch,
+                                    int sdx, int sdy, int incX, int incY, uint width,
+                                    int sw, int sh, bool flipx, bool flipy) {
+	const __m256i minusOne = _mm256_set1_epi32(-1);
+	const __m256i swv = _mm256_set1_epi32(sw);
+	const __m256i shv = _mm256_set1_epi32(sh);
+	const __m256i pitch = _mm256_set1_epi32(srcPitch);
+	const __m256i stepX = _mm256_set1_epi32(incX * 8);
+	const __m256i stepY = _mm256_set1_epi32(incY * 8);
+	const __m256i lanes = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+
+	const int *src00 = (const int *)src;
+	const int *src01 = (const int *)(src + 4);
+	const int *src10 = (const int *)(src + srcPitch);
+	const int *src11 = (const int *)(src + srcPitch + 4);
+
+	__m256i sdxv = _mm256_add_epi32(_mm256_set1_epi32(sdx), _mm256_mullo_epi32(lanes, _mm256_set1_epi32(incX)));
+	__m256i sdyv = _mm256_add_epi32(_mm256_set1_epi32(sdy), _mm256_mullo_epi32(lanes, _mm256_set1_epi32(incY)));
+
+	uint x = 0;
+	for (; x + 8 <= width; x += 8) {
+		__m256i dx = _mm256_srai_epi32(sdxv, 16);
+		__m256i dy = _mm256_srai_epi32(sdyv, 16);
+		if (flipx)
+			dx = _mm256_sub_epi32(swv, dx);
+		if (flipy)
+			dy = _mm256_sub_epi32(shv, dy);
+
+		__m256i inside = _mm256_and_si256(_mm256_and_si256(_mm256_cmpgt_epi32(dx, minusOne), _mm256_cmpgt_epi32(swv, dx)),
+		                                  _mm256_and_si256(_mm256_cmpgt_epi32(dy, minusOne), _mm256_cmpgt_epi32(shv, dy)));
+
+		if (!_mm256_testz_si256(inside, inside)) {
+			// Only lanes inside the source are fetched, so the offsets of
+			// the others do not matter.
+			const __m256i zero = _mm256_setzero_si256();
+			__m256i offset = _mm256_add_epi32(_mm256_mullo_epi32(dy, pitch), _mm256_slli_epi32(dx, 2));
+
+			__m256i c00 = _mm256_mask_i32gather_epi32(zero, src00, offset, inside, 1);
+			__m256i c01 = _mm256_mask_i32gather_epi32(zero, src01, offset, inside, 1);
+			__m256i c10 = _mm256_mask_i32gather_epi32(zero, src10, offset, inside, 1);
+			__m256i c11 = _mm256_mask_i32gather_epi32(zero, src11, offset, inside, 1);
+			if (flipx) {
+				SWAP(c00, c01);
+				SWAP(c10, c11);
+			}
+			if (flipy) {
+				SWAP(c00, c10);
+				SWAP(c01, c11);
+			}
+
+			__m256i result = interpolatePixels(c00, c01, c10, c11, replicateFractions(sdxv), replicateFractions(sdyv));
+			_mm256_maskstore_epi32((int *)(dst + x), inside, result);
+		}
+
+		sdxv = _mm256_add_epi32(sdxv, stepX);
+		sdyv = _mm256_add_epi32(sdyv, stepY);
+	}
+
+	sdx += (int)x * incX;
+	sdy += (int)x * incY;
+	for (; x < width; x++) {
+		rotoscalePixel(dst + x, src, srcPitch, sdx, sdy, sw, sh, flipx, flipy);
+		sdx += incX;
+		sdy += incY;
+	}
+}
+
+} // End of namespace Graphics
+
+#if defined(__clang__)
+#pragma clang attribute pop
+#elif defined(__GNUC__)
+#pragma GCC pop_options
+#endif
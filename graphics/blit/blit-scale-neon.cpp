@@ -0,0 +1,174 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "common/scummsys.h"
+
+#ifdef SCUMMVM_NEON
+
+#include "graphics/blit/blit-scale.h"
+
+#include <arm_neon.h>
+
+#if !defined(__aarch64__) && !defined(__ARM_NEON)
+
+#if defined(__clang__)
+#pragma clang attribute push (__attribute__((target("neon"))), apply_to=function)
+#elif defined(__GNUC__)
+#pragma GCC push_options
+#pragma GCC target("fpu=neon")
+#endif
+
+#endif // !defined(__aarch64__) && !defined(__ARM_NEON)
+
+namespace Graphics {
+
+namespace {
+
+// Computes c0 + ((c1 - c0) * frac >> 16) on four 16 bit lanes, where frac
+// is an unsigned 16 bit fraction reinterpreted as signed. The signed
+// product is short by (c1 - c0) << 16 for fractions of 0x8000 and above,
+// which is added back after the shift.
+static inline int16x4_t interpolate(int16x4_t c0, int16x4_t c1, int16x4_t frac) {
+	int16x4_t diff = vsub_s16(c1, c0);
+	int16x4_t high = vshrn_n_s32(vmull_s16(diff, frac), 16);
+	high = vadd_s16(high, vand_s16(diff, vshr_n_s16(frac, 15)));
+	return vadd_s16(c0, high);
+}
+
+// Interpolates two pixels, fracX and fracY hold one fraction per channel.
+static inline uint8x8_t interpolatePixels(uint8x8_t c00, uint8x8_t c01, uint8x8_t c10, uint8x8_t c11, int16x8_t fracX, int16x8_t fracY) {
+	int16x8_t p00 = vreinterpretq_s16_u16(vmovl_u8(c00));
+	int16x8_t p01 = vreinterpretq_s16_u16(vmovl_u8(c01));
+	int16x8_t p10 = vreinterpretq_s16_u16(vmovl_u8(c10));
+	int16x8_t p11 = vreinterpretq_s16_u16(vmovl_u8(c11));
+
+	int16x4_t t1Lo = interpolate(vget_low_s16(p00), vget_low_s16(p01), vget_low_s16(fracX));
+	int16x4_t t1Hi = interpolate(vget_high_s16(p00), vget_high_s16(p01), vget_high_s16(fracX));
+	int16x4_t t2Lo = interpolate(vget_low_s16(p10), vget_low_s16(p11), vget_low_s16(fracX));
+	int16x4_t t2Hi = interpolate(vget_high_s16(p10), vget_high_s16(p11), vget_high_s16(fracX));
+
+	int16x8_t result = vcombine_s16(interpolate(t1Lo, t2Lo, vget_low_s16(fracY)),
+	                                interpolate(t1Hi, t2Hi, vget_high_s16(fracY)));
+	return vqmovun_s16(result);
+}
+
+static inline int16x8_t spreadFractions(uint16 frac0, uint16 frac1) {
+	return vcombine_s16(vdup_n_s16((int16)frac0), vdup_n_s16((int16)frac1));
+}
+
+} // End of anonymous namespace
+
+void BilinearBlit::scaleRowNEON(uint32 *dst, const uint32 *row0, const uint32 *row1,
+                                const int *col0, const int *col1, const uint16 *fracX,
+                                int fracY, uint width) {
+	const int16x8_t fy = vdupq_n_s16((int16)fracY);
+
+	uint x = 0;
+	for (; x + 2 <= width; x += 2) {
+		uint32x2_t c00 = vset_lane_u32(row0[col0[x + 1]], vdup_n_u32(row0[col0[x]]), 1);
+		uint32x2_t c01 = vset_lane_u32(row0[col1[x + 1]], vdup_n_u32(row0[col1[x]]), 1);
+		uint32x2_t c10 = vset_lane_u32(row1[col0[x + 1]], vdup_n_u32(row1[col0[x]]), 1);
+		uint32x2_t c11 = vset_lane_u32(row1[col1[x + 1]], vdup_n_u32(row1[col1[x]]), 1);
+
+		uint8x8_t result = interpolatePixels(vreinterpret_u8_u32(c00), vreinterpret_u8_u32(c01),
+		                                     vreinterpret_u8_u32(c10), vreinterpret_u8_u32(c11),
+		                                     spreadFractions(fracX[x], fracX[x + 1]), fy);
+		vst1_u32(dst + x, vreinterpret_u32_u8(result));
+	}
+
+	for (; x < width; x++) {
+		dst[x] = interpolatePixel(row0[col0[x]], row0[col1[x]], row1[col0[x]], row1[col1[x]], fracX[x], fracY);
+	}
+}
+
+void BilinearBlit::rotoscaleRowNEON(uint32 *dst, const byte *src, uint srcPitch,
+                                    int sdx, int sdy, int incX, int incY, uint width,
+                                    int sw, int sh, bool flipx, bool flipy) {
+	uint x = 0;
+	for (; x + 2 <= width; x += 2) {
+		uint32 c[4][2];
+		bool inside[2];
+
+		for (int i = 0; i < 2; i++) {
+			int dx = (sdx + i * incX) >> 16;
+			int dy = (sdy + i * incY) >> 16;
+			if (flipx)
+				dx = sw - dx;
+			if (flipy)
+				dy = sh - dy;
+
+			inside[i] = dx > -1 && dy > -1 && dx < sw && dy < sh;
+			if (inside[i]) {
+				const uint32 *p0 = (const uint32 *)(src + dy * srcPitch) + dx;
+				const uint32 *p1 = (const uint32 *)((const byte *)p0 + srcPitch);
+				c[0][i] = p0[0];
+				c[1][i] = p0[1];
+				c[2][i] = p1[0];
+				c[3][i] = p1[1];
+				if (flipx) {
+					SWAP(c[0][i], c[1][i]);
+					SWAP(c[2][i], c[3][i]);
+				}
+				if (flipy) {
+					SWAP(c[0][i], c[2][i]);
+					SWAP(c[1][i], c[3][i]);
+				}
+			} else {
+				c[0][i] = c[1][i] = c[2][i] = c[3][i] = 0;
+			}
+		}
+
+		if (inside[0] || inside[1]) {
+			uint8x8_t result = interpolatePixels(vreinterpret_u8_u32(vld1_u32(c[0])), vreinterpret_u8_u32(vld1_u32(c[1])),
+			                                     vreinterpret_u8_u32(vld1_u32(c[2])), vreinterpret_u8_u32(vld1_u32(c[3])),
+			                                     spreadFractions(sdx & 0xffff, (sdx + incX) & 0xffff),
+			                                     spreadFractions(sdy & 0xffff, (sdy + incY) & 0xffff));
+			uint32x2_t pixels = vreinterpret_u32_u8(result);
+			if (inside[0])
+				dst[x] = vget_lane_u32(pixels, 0);
+			if (inside[1])
+				dst[x + 1] = vget_lane_u32(pixels, 1);
+		}
+
+		sdx += incX * 2;
+		sdy += incY * 2;
+	}
+
+	for (; x < width; x++) {
+		rotoscalePixel(dst + x, src, srcPitch, sdx, sdy, sw, sh, flipx, flipy);
+		sdx += incX;
+		sdy += incY;
+	}
+}
+
+} // End of namespace Graphics
+
+#if !defined(__aarch64__) && !defined(__ARM_NEON)
+
+#if defined(__clang__)
+#pragma clang attribute pop
+#elif defined(__GNUC__)
+#pragma GCC pop_options
+#endif
+
+#endif // !defined(__aarch64__) && !defined(__ARM_NEON)
+
+#endif // SCUMMVM_NEON
@@ -0,0 +1,187 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "common/scummsys.h"
+
+#include "graphics/blit/blit-scale.h"
+
+#include <emmintrin.h>
+
+#if !defined(__x86_64__)
+
+#if defined(__clang__)
+#pragma clang attribute push (__attribute__((target("sse2"))), apply_to=function)
+#elif defined(__GNUC__)
+#pragma GCC push_options
+#pragma GCC target("sse2")
+#endif
+
+#endif // !defined(__x86_64__)
+
+namespace Graphics {
+
+namespace {
+
+// Computes c0 + ((c1 - c0) * frac >> 16) on 16 bit lanes, where frac is an
+// unsigned 16 bit fraction. _mm_mulhi_epi16() treats fractions of 0x8000 and
+// above as negative, which lowers the high half of the product by exactly
+// (c1 - c0); that is added back so the result matches the 32 bit formula.
+static FORCEINLINE __m128i interpolate(__m128i c0, __m128i c1, __m128i frac) {
+	__m128i diff = _mm_sub_epi16(c1, c0);
+	__m128i high = _mm_mulhi_epi16(diff, frac);
+	high = _mm_add_epi16(high, _mm_and_si128(diff, _mm_srai_epi16(frac, 15)));
+	return _mm_add_epi16(c0, high);
+}
+
+// Interpolates four pixels. fracX and fracY hold one 16 bit fraction per
+// 32 bit lane, replicated into both halves.
+static FORCEINLINE __m128i interpolatePixels(__m128i c00, __m128i c01, __m128i c10, __m128i c11, __m128i fracX, __m128i fracY) {
+	const __m128i zero = _mm_setzero_si128();
+
+	// Spread the fractions over the four channels of each pixel.
+	__m128i fxLo = _mm_unpacklo_epi32(fracX, fracX);
+	__m128i fxHi = _mm_unpackhi_epi32(fracX, fracX);
+	__m128i fyLo = _mm_unpacklo_epi32(fracY, fracY);
+	__m128i fyHi = _mm_unpackhi_epi32(fracY, fracY);
+
+	__m128i t1Lo = interpolate(_mm_unpacklo_epi8(c00, zero), _mm_unpacklo_epi8(c01, zero), fxLo);
+	__m128i t1Hi = interpolate(_mm_unpackhi_epi8(c00, zero), _mm_unpackhi_epi8(c01, zero), fxHi);
+	__m128i t2Lo = interpolate(_mm_unpacklo_epi8(c10, zero), _mm_unpacklo_epi8(c11, zero), fxLo);
+	__m128i t2Hi = interpolate(_mm_unpackhi_epi8(c10, zero), _mm_unpackhi_epi8(c11, zero), fxHi);
+
+	return _mm_packus_epi16(interpolate(t1Lo, t2Lo, fyLo), interpolate(t1Hi, t2Hi, fyHi));
+}
+
+static FORCEINLINE __m128i replicateFractions(__m128i frac) {
+	frac = _mm_and_si128(frac, _mm_set1_epi32(0xffff));
+	return _mm_or_si128(frac, _mm_slli_epi32(frac, 16));
+}
+
+} // End of anonymous namespace
+
+void BilinearBlit::scaleRowSSE2(uint32 *dst, const uint32 *row0, const uint32 *row1,
+                                const int *col0, const int *col1, const uint16 *fracX,
+                                int fracY, uint width) {
+	const __m128i fy = _mm_set1_epi16((int16)fracY);
+
+	uint x = 0;
+	for (; x + 4 <= width; x += 4) {
+		__m128i c00 = _mm_setr_epi32(row0[col0[x]], row0[col0[x + 1]], row0[col0[x + 2]], row0[col0[x + 3]]);
+		__m128i c01 = _mm_setr_epi32(row0[col1[x]], row0[col1[x + 1]], row0[col1[x + 2]], row0[col1[x + 3]]);
+		__m128i c10 = _mm_setr_epi32(row1[col0[x]], row1[col0[x + 1]], row1[col0[x + 2]], row1[col0[x + 3]]);
+		__m128i c11 = _mm_setr_epi32(row1[col1[x]], row1[col1[x + 1]], row1[col1[x + 2]], row1[col1[x + 3]]);
+
+		__m128i fx = _mm_loadl_epi64((const __m128i *)(fracX + x));
+		fx = _mm_unpacklo_epi16(fx, fx);
+
+		_mm_storeu_si128((__m128i *)(dst + x), interpolatePixels(c00, c01, c10, c11, fx, fy));
+	}
+
+	for (; x < width; x++) {
+		dst[x] = interpolatePixel(row0[col0[x]], row0[col1[x]], row1[col0[x]], row1[col1[x]], fracX[x], fracY);
+	}
+}
+
+void BilinearBlit::rotoscaleRowSSE2(uint32 *dst, const byte *src, uint srcPitch,
+                                    int sdx, int sdy, int incX, int incY, uint width,
+                                    int sw, int sh, bool flipx, bool flipy) {
+	const __m128i minusOne = _mm_set1_epi32(-1);
+	const __m128i swv = _mm_set1_epi32(sw);
+	const __m128i shv = _mm_set1_epi32(sh);
+	const __m128i stepX = _mm_set1_epi32(incX * 4);
+	const __m128i stepY = _mm_set1_epi32(incY * 4);
+
+	__m128i sdxv = _mm_add_epi32(_mm_set1_epi32(sdx), _mm_setr_epi32(0, incX, incX * 2, incX * 3));
+	__m128i sdyv = _mm_add_epi32(_mm_set1_epi32(sdy), _mm_setr_epi32(0, incY, incY * 2, incY * 3));
+
+	uint x = 0;
+	for (; x + 4 <= width; x += 4) {
+		__m128i dx = _mm_srai_epi32(sdxv, 16);
+		__m128i dy = _mm_srai_epi32(sdyv, 16);
+		if (flipx)
+			dx = _mm_sub_epi32(swv, dx);
+		if (flipy)
+			dy = _mm_sub_epi32(shv, dy);
+
+		__m128i inside = _mm_and_si128(_mm_and_si128(_mm_cmpgt_epi32(dx, minusOne), _mm_cmpgt_epi32(swv, dx)),
+		                               _mm_and_si128(_mm_cmpgt_epi32(dy, minusOne), _mm_cmpgt_epi32(shv, dy)));
+		int insideMask = _mm_movemask_ps(_mm_castsi128_ps(inside));
+
+		if (insideMask) {
+			int32 dxs[4], dys[4];
+			uint32 c[4][4];
+			_mm_storeu_si128((__m128i *)dxs, dx);
+			_mm_storeu_si128((__m128i *)dys, dy);
+
+			for (int i = 0; i < 4; i++) {
+				if (insideMask & (1 << i)) {
+					const uint32 *p0 = (const uint32 *)(src + dys[i] * srcPitch) + dxs[i];
+					const uint32 *p1 = (const uint32 *)((const byte *)p0 + srcPitch);
+					c[0][i] = p0[0];
+					c[1][i] = p0[1];
+					c[2][i] = p1[0];
+					c[3][i] = p1[1];
+					if (flipx) {
+						SWAP(c[0][i], c[1][i]);
+						SWAP(c[2][i], c[3][i]);
+					}
+					if (flipy) {
+						SWAP(c[0][i], c[2][i]);
+						SWAP(c[1][i], c[3][i]);
+					}
+				} else {
+					c[0][i] = c[1][i] = c[2][i] = c[3][i] = 0;
+				}
+			}
+
+			__m128i result = interpolatePixels(_mm_loadu_si128((const __m128i *)c[0]), _mm_loadu_si128((const __m128i *)c[1]),
+			                                   _mm_loadu_si128((const __m128i *)c[2]), _mm_loadu_si128((const __m128i *)c[3]),
+			                                   replicateFractions(sdxv), replicateFractions(sdyv));
+
+			__m128i old = _mm_loadu_si128((const __m128i *)(dst + x));
+			result = _mm_or_si128(_mm_and_si128(inside, result), _mm_andnot_si128(inside, old));
+			_mm_storeu_si128((__m128i *)(dst + x), result);
+		}
+
+		sdxv = _mm_add_epi32(sdxv, stepX);
+		sdyv = _mm_add_epi32(sdyv, stepY);
+	}
+
+	sdx += (int)x * incX;
+	sdy += (int)x * incY;
+	for (; x < width; x++) {
+		rotoscalePixel(dst + x, src, srcPitch, sdx, sdy, sw, sh, flipx, flipy);
+		sdx += incX;
+		sdy += incY;
+	}
+}
+
+} // End of namespace Graphics
+
+#if !defined(__x86_64__)
+
+#if defined(__clang__)
+#pragma clang attribute pop
+#elif defined(__GNUC__)
+#pragma GCC pop_options
+#endif
+
+#endif // !defined(__x86_64__)
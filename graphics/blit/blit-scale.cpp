@@ -25,11 +25,13 @@
  */
 
 #include "graphics/blit.h"
+#include "graphics/blit/blit-scale.h"
 #include "graphics/pixelformat.h"
 #include "graphics/transform_struct.h"
 
 #include "common/endian.h"
 #include "common/rect.h"
+#include "common/system.h"
 #include "math/utils.h"
 
 namespace Graphics {
@@ -319,6 +321,53 @@ void scaleBlitBilinearLogic(byte *dst, const byte *src,
 	}
 }
 
+void scaleBlitBilinearRows(byte *dst, const byte *src,
+						   const uint dstPitch, const uint srcPitch,
+						   const uint dstW, const uint dstH,
+						   const uint srcW, const uint srcH,
+						   const int *sax, const int *say, byte flip,
+						   BilinearBlit::ScaleRowFunc scaleRow) {
+	const bool flipx = flip & FLIP_H;
+	const bool flipy = flip & FLIP_V;
+
+	int spixelw = (srcW - 1);
+	int spixelh = (srcH - 1);
+
+	/*
+	* Precalculate the source columns and weights, they are the same for
+	* every row
+	*/
+	int *col0 = new int[dstW];
+	int *col1 = new int[dstW];
+	uint16 *fracX = new uint16[dstW];
+	for (uint x = 0; x < dstW; x++) {
+		int cx = (sax[x] >> 16);
+		int step = (cx < spixelw) ? 1 : 0;
+		if (flipx) {
+			col0[x] = spixelw - cx;
+			col1[x] = col0[x] - step;
+		} else {
+			col0[x] = cx;
+			col1[x] = col0[x] + step;
+		}
+		fracX[x] = sax[x] & 0xffff;
+	}
+
+	for (uint y = 0; y < dstH; y++) {
+		int cy = (say[y] >> 16);
+		int step = (cy < spixelh) ? 1 : 0;
+		int row = flipy ? spixelh - cy : cy;
+		const uint32 *row0 = (const uint32 *)(src + srcPitch * row);
+		const uint32 *row1 = (const uint32 *)(src + srcPitch * (flipy ? row - step : row + step));
+
+		scaleRow((uint32 *)(dst + dstPitch * y), row0, row1, col0, col1, fracX, say[y] & 0xffff, dstW);
+	}
+
+	delete[] col0;
+	delete[] col1;
+	delete[] fracX;
+}
+
 template<typename ColorMask, typename Color, int Size, bool filtering>
 void rotoscaleBlitLogic(byte *dst, const byte *src,
 						const uint dstPitch, const uint srcPitch,
@@ -326,7 +375,8 @@ void rotoscaleBlitLogic(byte *dst, const byte *src,
 						const uint srcW, const uint srcH,
 						const Graphics::PixelFormat &fmt,
 						const TransformStruct &transform,
-						const Common::Point &newHotspot) {
+						const Common::Point &newHotspot,
+						BilinearBlit::RotoscaleRowFunc rotoscaleRow = nullptr) {
 	const bool flipx = transform._flip & FLIP_H;
 	const bool flipy = transform._flip & FLIP_V;
 
@@ -362,6 +412,11 @@ void rotoscaleBlitLogic(byte *dst, const byte *src,
 		int t = cy - y;
 		int sdx = ax + (isinx * t) + xd;
 		int sdy = ay - (icosy * t) + yd;
+		if (filtering && rotoscaleRow) {
+			rotoscaleRow((uint32 *)pc, src, srcPitch, sdx, sdy, icosx, isiny, dstW, sw, sh, flipx, flipy);
+			pc += dstW * Size;
+			continue;
+		}
 		for (uint x = 0; x < dstW; x++) {
 			int dx = (sdx >> 16);
 			int dy = (sdy >> 16);
@@ -417,6 +472,35 @@ void rotoscaleBlitLogic(byte *dst, const byte *src,
 
 } // End of anonymous namespace
 
+bool BilinearBlit::rowFuncsSelected = false;
+BilinearBlit::ScaleRowFunc BilinearBlit::scaleRowFunc = nullptr;
+BilinearBlit::RotoscaleRowFunc BilinearBlit::rotoscaleRowFunc = nullptr;
+
+void BilinearBlit::selectRowFuncs() {
+	if (rowFuncsSelected)
+		return;
+	rowFuncsSelected = true;
+
+#ifdef SCUMMVM_NEON
+	if (g_system->hasFeature(OSystem::kFeatureCpuNEON)) {
+		scaleRowFunc = scaleRowNEON;
+		rotoscaleRowFunc = rotoscaleRowNEON;
+	}
+#endif
+#ifdef SCUMMVM_SSE2
+	if (g_system->hasFeature(OSystem::kFeatureCpuSSE2)) {
+		scaleRowFunc = scaleRowSSE2;
+		rotoscaleRowFunc = rotoscaleRowSSE2;
+	}
+#endif
+#ifdef SCUMMVM_AVX2
+	if (g_system->hasFeature(OSystem::kFeatureCpuAVX2)) {
+		scaleRowFunc = scaleRowAVX2;
+		rotoscaleRowFunc = rotoscaleRowAVX2;
+	}
+#endif
+}
+
 bool scaleBlitBilinear(byte *dst, const byte *src,
 					   const uint dstPitch, const uint srcPitch,
 					   const uint dstW, const uint dstH,
@@ -470,7 +554,13 @@ bool scaleBlitBilinear(byte *dst, const byte *src,
 		}
 	}
 
-	if (fmt == createPixelFormat<8888>()) {
+	BilinearBlit::ScaleRowFunc scaleRow = nullptr;
+	if (BilinearBlit::isSupportedFormat(fmt))
+		scaleRow = BilinearBlit::getScaleRowFunc();
+
+	if (scaleRow) {
+		scaleBlitBilinearRows(dst, src, dstPitch, srcPitch, dstW, dstH, srcW, srcH, sax, say, flip, scaleRow);
+	} else if (fmt == createPixelFormat<8888>()) {
 		scaleBlitBilinearLogic<ColorMasks<8888>, uint32, 4>(dst, src, dstPitch, srcPitch, dstW, dstH, srcW, srcH, fmt, sax, say, flip);
 	} else if (fmt == createPixelFormat<888>()) {
 		scaleBlitBilinearLogic<ColorMasks<888>,  uint32, 4>(dst, src, dstPitch, srcPitch, dstW, dstH, srcW, srcH, fmt, sax, say, flip);
@@ -527,7 +617,13 @@ bool rotoscaleBlitBilinear(byte *dst, const byte *src,
 						   const Graphics::PixelFormat &fmt,
 						   const TransformStruct &transform,
 						   const Common::Point &newHotspot) {
-	if (fmt == createPixelFormat<8888>()) {
+	BilinearBlit::RotoscaleRowFunc rotoscaleRow = nullptr;
+	if (BilinearBlit::isSupportedFormat(fmt))
+		rotoscaleRow = BilinearBlit::getRotoscaleRowFunc();
+
+	if (rotoscaleRow) {
+		rotoscaleBlitLogic<ColorMasks<0>,    uint32, 4, true>(dst, src, dstPitch, srcPitch, dstW, dstH, srcW, srcH, fmt, transform, newHotspot, rotoscaleRow);
+	} else if (fmt == createPixelFormat<8888>()) {
 		rotoscaleBlitLogic<ColorMasks<8888>, uint32, 4, true>(dst, src, dstPitch, srcPitch, dstW, dstH, srcW, srcH, fmt, transform, newHotspot);
 	} else if (fmt == createPixelFormat<888>()) {
 		rotoscaleBlitLogic<ColorMasks<888>,  uint32, 4, true>(dst, src, dstPitch, srcPitch, dstW, dstH, srcW, srcH, fmt, transform, newHotspot);
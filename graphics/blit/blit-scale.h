@@ -0,0 +1,148 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef GRAPHICS_BLIT_SCALE_H
+#define GRAPHICS_BLIT_SCALE_H
+
+#include "common/util.h"
+
+#include "graphics/pixelformat.h"
+
+class BilinearBlitTestSuite;
+
+namespace Graphics {
+
+/**
+ * Row kernels used by scaleBlitBilinear() and rotoscaleBlitBilinear() for
+ * 32bpp formats with four 8 bit channels. For those formats interpolating
+ * each byte of a pixel on its own is the same as interpolating each
+ * channel, so the kernels do not need to know the channel layout. All
+ * kernels give results identical to the generic code in blit-scale.cpp.
+ */
+class BilinearBlit {
+public:
+	/**
+	 * Interpolate one scaled row. Destination pixel x is interpolated from
+	 * row0[col0[x]], row0[col1[x]], row1[col0[x]] and row1[col1[x]] with
+	 * the 16 bit fractions fracX[x] and fracY.
+	 */
+	typedef void (*ScaleRowFunc)(uint32 *dst, const uint32 *row0, const uint32 *row1,
+	                             const int *col0, const int *col1, const uint16 *fracX,
+	                             int fracY, uint width);
+
+	/**
+	 * Interpolate one rotated row, starting at the 16.16 source position
+	 * (sdx, sdy) and stepping by (incX, incY) per pixel. Destination
+	 * pixels that map outside of the source are left untouched.
+	 */
+	typedef void (*RotoscaleRowFunc)(uint32 *dst, const byte *src, uint srcPitch,
+	                                 int sdx, int sdy, int incX, int incY, uint width,
+	                                 int sw, int sh, bool flipx, bool flipy);
+
+private:
+#ifdef SCUMMVM_NEON
+	static void scaleRowNEON(uint32 *dst, const uint32 *row0, const uint32 *row1, const int *col0, const int *col1, const uint16 *fracX, int fracY, uint width);
+	static void rotoscaleRowNEON(uint32 *dst, const byte *src, uint srcPitch, int sdx, int sdy, int incX, int incY, uint width, int sw, int sh, bool flipx, bool flipy);
+#endif
+#ifdef SCUMMVM_SSE2
+	static void scaleRowSSE2(uint32 *dst, const uint32 *row0, const uint32 *row1, const int *col0, const int *col1, const uint16 *fracX, int fracY, uint width);
+	static void rotoscaleRowSSE2(uint32 *dst, const byte *src, uint srcPitch, int sdx, int sdy, int incX, int incY, uint width, int sw, int sh, bool flipx, bool flipy);
+#endif
+#ifdef SCUMMVM_AVX2
+	static void scaleRowAVX2(uint32 *dst, const uint32 *row0, const uint32 *row1, const int *col0, const int *col1, const uint16 *fracX, int fracY, uint width);
+	static void rotoscaleRowAVX2(uint32 *dst, const byte *src, uint srcPitch, int sdx, int sdy, int incX, int incY, uint width, int sw, int sh, bool flipx, bool flipy);
+#endif
+
+	static bool rowFuncsSelected;
+	static ScaleRowFunc scaleRowFunc;
+	static RotoscaleRowFunc rotoscaleRowFunc;
+
+	friend class ::BilinearBlitTestSuite;
+
+	static inline int interpolate(int c0, int c1, int frac) {
+		return (((c1 - c0) * frac) >> 16) + c0;
+	}
+
+public:
+	/**
+	 * Select the row kernels for the running CPU. Both are nullptr if no
+	 * kernel is available, in which case the generic code has to be used.
+	 */
+	static void selectRowFuncs();
+
+	static ScaleRowFunc getScaleRowFunc() {
+		selectRowFuncs();
+		return scaleRowFunc;
+	}
+
+	static RotoscaleRowFunc getRotoscaleRowFunc() {
+		selectRowFuncs();
+		return rotoscaleRowFunc;
+	}
+
+	/** Whether the row kernels can handle the given pixel format. */
+	static bool isSupportedFormat(const PixelFormat &fmt) {
+		return fmt.bytesPerPixel == 4 &&
+			fmt.rLoss == 0 && fmt.gLoss == 0 && fmt.bLoss == 0 && fmt.aLoss == 0 &&
+			((1 << fmt.rShift) | (1 << fmt.gShift) | (1 << fmt.bShift) | (1 << fmt.aShift)) == 0x01010101;
+	}
+
+	/** Interpolate a single pixel the way the generic code does. */
+	static inline uint32 interpolatePixel(uint32 c00, uint32 c01, uint32 c10, uint32 c11, int fracX, int fracY) {
+		uint32 result = 0;
+		for (int shift = 0; shift < 32; shift += 8) {
+			int t1 = interpolate((c00 >> shift) & 0xff, (c01 >> shift) & 0xff, fracX);
+			int t2 = interpolate((c10 >> shift) & 0xff, (c11 >> shift) & 0xff, fracX);
+			result |= (uint32)interpolate(t1, t2, fracY) << shift;
+		}
+		return result;
+	}
+
+	/** Interpolate a single rotated pixel the way the generic code does. */
+	static inline void rotoscalePixel(uint32 *dst, const byte *src, uint srcPitch,
+	                                  int sdx, int sdy, int sw, int sh, bool flipx, bool flipy) {
+		int dx = sdx >> 16;
+		int dy = sdy >> 16;
+		if (flipx)
+			dx = sw - dx;
+		if (flipy)
+			dy = sh - dy;
+		if (dx <= -1 || dy <= -1 || dx >= sw || dy >= sh)
+			return;
+
+		const uint32 *row0 = (const uint32 *)(src + dy * srcPitch) + dx;
+		const uint32 *row1 = (const uint32 *)((const byte *)row0 + srcPitch);
+		uint32 c00 = row0[0], c01 = row0[1], c10 = row1[0], c11 = row1[1];
+		if (flipx) {
+			SWAP(c00, c01);
+			SWAP(c10, c11);
+		}
+		if (flipy) {
+			SWAP(c00, c10);
+			SWAP(c01, c11);
+		}
+		*dst = interpolatePixel(c00, c01, c10, c11, sdx & 0xffff, sdy & 0xffff);
+	}
+};
+
+} // End of namespace Graphics
+
+#endif // GRAPHICS_BLIT_SCALE_H
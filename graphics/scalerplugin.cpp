@@ -52,8 +52,21 @@ void Scaler::scale(const uint8 *srcPtr, uint32 srcPitch, uint8 *dstPtr,
 		} else {
 			Normal1x<uint32>(srcPtr, srcPitch, dstPtr, dstPitch, width, height);
 		}
-	} else {
+	} else if (_bandHeight <= 0 || height < _bandHeight * 2) {
 		scaleIntern(srcPtr, srcPitch, dstPtr, dstPitch, width, height, x, y);
+		scaleFinished(srcPtr, srcPitch, width, height, x, y);
+	} else {
+		// The last band takes the remaining rows, so that no band is
+		// shorter than the band height
+		int band = 0;
+		while (band < height) {
+			int rows = (height - band < _bandHeight * 2) ? height - band : _bandHeight;
+			scaleIntern(srcPtr + band * srcPitch, srcPitch,
+			            dstPtr + band * _factor * dstPitch, dstPitch,
+			            width, rows, x, y + band);
+			band += rows;
+		}
+		scaleFinished(srcPtr, srcPitch, width, height, x, y);
 	}
 }
 
@@ -119,8 +132,15 @@ void SourceScaler::scaleIntern(const uint8 *srcPtr, uint32 srcPitch, uint8 *dstP
 		buffer += _bufferedOutput.pitch;
 		dstPtr += dstPitch;
 	}
+}
 
-	// Update old src
+void SourceScaler::scaleFinished(const uint8 *srcPtr, uint32 srcPitch, int width, int height, int x, int y) {
+	if (!_enable)
+		return;
+
+	// Update old src. This is done once the whole rect is scaled since
+	// checking for unchanged pixels looks at the rows around each band.
+	int offset = (_padding + x) * _format.bytesPerPixel + (_padding + y) * srcPitch;
 	byte *oldSrc = _oldSrc + offset;
 	while (height--) {
 		memcpy(oldSrc, srcPtr, width * _format.bytesPerPixel);
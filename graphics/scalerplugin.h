@@ -27,7 +27,7 @@
 
 class Scaler {
 public:
-	Scaler(const Graphics::PixelFormat &format) : _format(format) {}
+	Scaler(const Graphics::PixelFormat &format) : _bandHeight(0), _format(format) {}
 	virtual ~Scaler() {}
 
 	/**
@@ -59,6 +59,26 @@ public:
 
 	virtual uint getFactor() const { return _factor; }
 
+	/**
+	 * Set the number of source rows scaled at a time. Rects taller than
+	 * this are split into horizontal bands which are scaled one after
+	 * another. The scalers read the rows around each band from the source
+	 * like they do at the edges of any rect, so the output is the same as
+	 * scaling the rect in one go.
+	 *
+	 * Some scalers need at least four rows per call, so smaller band
+	 * heights are raised to that. Rows left over at the bottom are added
+	 * to the last band.
+	 *
+	 * The SDL and OpenGL backends set it for the game screen from the
+	 * "scaler_band_height" setting.
+	 *
+	 * @param rows The band height, or 0 to never split rects.
+	 */
+	void setBandHeight(int rows) { _bandHeight = rows > 0 ? MAX(rows, 4) : 0; }
+
+	int getBandHeight() const { return _bandHeight; }
+
 	/**
 	 * Set the scaling factor.
 	 * Intended to be used with GUI to set a known valid factor.
@@ -101,6 +121,15 @@ protected:
 	virtual void scaleIntern(const uint8 *srcPtr, uint32 srcPitch, uint8 *dstPtr,
 	                         uint32 dstPitch, int width, int height, int x, int y) = 0;
 
+	/**
+	 * Called by scale once all bands of a rect are scaled, with the
+	 * whole rect. Scalers which keep state about the source update it here
+	 * rather than in scaleIntern, where the following bands could still
+	 * read it.
+	 */
+	virtual void scaleFinished(const uint8 *srcPtr, uint32 srcPitch, int width, int height, int x, int y) {}
+
+	int _bandHeight;
 	uint _factor;
 	Graphics::PixelFormat _format;
 };
@@ -127,6 +156,8 @@ protected:
 	virtual void scaleIntern(const uint8 *srcPtr, uint32 srcPitch, uint8 *dstPtr,
 	                         uint32 dstPitch, int width, int height, int x, int y) final;
 
+	virtual void scaleFinished(const uint8 *srcPtr, uint32 srcPitch, int width, int height, int x, int y) final;
+
 	/**
 	 * Scalers must implement this function. It will be called by oldSrcScale.
 	 * If by comparing the src and oldsrc images it is discovered that no change
@@ -359,6 +359,8 @@ void GLContext::init(int screenW, int screenH, Graphics::PixelFormat pixelFormat
 	_drawCallAllocator[1].initialize(drawCallMemorySize);
 	_debugRectsEnabled = false;
 	_profilingEnabled = false;
+	_renderTileSize = 0;
+	_nextRenderTileSize = 0;
 }
 
 void GLContext::deinit() {
@@ -39,6 +39,17 @@ void destroyContext(ContextHandle *handle);
 void setContext(ContextHandle *handle);
 void presentBuffer();
 void presentBuffer(Common::List<Common::Rect> &dirtyAreas);
+/**
+ * Execute the queued draw calls of the current context tile by tile.
+ *
+ * Each draw call is binned into every tileSize x tileSize screen tile its
+ * dirty region touches, then the tiles are executed one after another,
+ * clipped to the tile, keeping the frame and depth buffers of a tile hot in
+ * the cache. The output is identical to untiled execution. A tile size of 0
+ * disables tiling. The change applies from the next frame if draw calls are
+ * already queued.
+ */
+void setRenderTileSize(int tileSize);
 void getSurfaceRef(Graphics::Surface &surface);
 Graphics::Surface *copyFromFrameBuffer(const Graphics::PixelFormat &dstFormat);
 
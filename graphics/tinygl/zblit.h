@@ -31,6 +31,9 @@ namespace TinyGL {
 
 struct BlitImage;
 
+// Bounding box of a rectangle rotated around the origin point
+Common::Rect rotateRectangle(int x, int y, int width, int height, int rotation, int originX, int originY);
+
 namespace Internal {
 	/**
 	@brief Performs a cleanup of disposed blit images.
@@ -207,12 +207,20 @@ void GLContext::presentBufferDirtyRects(Common::List<Common::Rect> &dirtyAreas)
 		}
 
 		// Execute draw calls.
-		for (auto &drawCall : _drawCallsQueue) {
-			Common::Rect drawCallRegion = drawCall->getDirtyRegion();
+		if (_renderTileSize > 0 && canTileDrawCalls()) {
+			// Merged rectangles never overlap, so executing them one after
+			// another is equivalent to the interleaved order below.
 			for (auto &rect : rectangles) {
-				Common::Rect dirtyRegion = rect.rectangle;
-				if (dirtyRegion.intersects(drawCallRegion)) {
-					drawCall->execute(true, &dirtyRegion);
+				executeDrawCallsTiled(rect.rectangle);
+			}
+		} else {
+			for (auto &drawCall : _drawCallsQueue) {
+				Common::Rect drawCallRegion = drawCall->getDirtyRegion();
+				for (auto &rect : rectangles) {
+					Common::Rect dirtyRegion = rect.rectangle;
+					if (dirtyRegion.intersects(drawCallRegion)) {
+						drawCall->execute(true, &dirtyRegion);
+					}
 				}
 			}
 		}
@@ -247,14 +255,23 @@ void GLContext::presentBufferDirtyRects(Common::List<Common::Rect> &dirtyAreas)
 
 	_currentAllocatorIndex = (_currentAllocatorIndex + 1) & 0x1;
 	_drawCallAllocator[_currentAllocatorIndex].reset();
+
+	_renderTileSize = _nextRenderTileSize;
 }
 
 void GLContext::presentBufferSimple(Common::List<Common::Rect> &dirtyAreas) {
 	dirtyAreas.push_back(Common::Rect(fb->getPixelBufferWidth(), fb->getPixelBufferHeight()));
 
-	for (const auto &drawCall : _drawCallsQueue) {
-		drawCall->execute(true);
-		delete drawCall;
+	if (_renderTileSize > 0) {
+		executeDrawCallsTiled(renderRect);
+		for (const auto &drawCall : _drawCallsQueue) {
+			delete drawCall;
+		}
+	} else {
+		for (const auto &drawCall : _drawCallsQueue) {
+			drawCall->execute(true);
+			delete drawCall;
+		}
 	}
 
 	_drawCallsQueue.clear();
@@ -262,6 +279,85 @@ void GLContext::presentBufferSimple(Common::List<Common::Rect> &dirtyAreas) {
 	disposeResources();
 
 	_drawCallAllocator[_currentAllocatorIndex].reset();
+
+	_renderTileSize = _nextRenderTileSize;
+}
+
+bool GLContext::canTileDrawCalls() const {
+	for (const auto &drawCall : _drawCallsQueue) {
+		if (!drawCall->canBeTiled())
+			return false;
+	}
+	return true;
+}
+
+void GLContext::executeDrawCallsTiled(const Common::Rect &area) {
+	if (area.isEmpty())
+		return;
+
+	const int tileSize = _renderTileSize;
+	const int tilesX = (area.width() + tileSize - 1) / tileSize;
+	const int tilesY = (area.height() + tileSize - 1) / tileSize;
+	if (_renderTileBins.size() < (uint)(tilesX * tilesY))
+		_renderTileBins.resize(tilesX * tilesY);
+
+	Common::List<DrawCall *>::const_iterator it = _drawCallsQueue.begin();
+	while (it != _drawCallsQueue.end()) {
+		// Bin draw calls into every tile their dirty region touches, up to
+		// the next one which can't be tiled. The bins keep their storage
+		// from frame to frame.
+		for (auto &bin : _renderTileBins) {
+			bin.resize(0);
+		}
+
+		for (; it != _drawCallsQueue.end() && (*it)->canBeTiled(); ++it) {
+			Common::Rect region = (*it)->getDirtyRegion();
+			region.clip(area);
+			if (region.isEmpty())
+				continue;
+
+			int firstX = (region.left - area.left) / tileSize;
+			int lastX = (region.right - 1 - area.left) / tileSize;
+			int firstY = (region.top - area.top) / tileSize;
+			int lastY = (region.bottom - 1 - area.top) / tileSize;
+			for (int y = firstY; y <= lastY; y++) {
+				for (int x = firstX; x <= lastX; x++) {
+					_renderTileBins[y * tilesX + x].push_back(*it);
+				}
+			}
+		}
+
+		// Execute the tiles in order. Tiles do not overlap and each one keeps
+		// the draw call order, so the result does not depend on the tile size.
+		for (int y = 0; y < tilesY; y++) {
+			for (int x = 0; x < tilesX; x++) {
+				const Common::Array<DrawCall *> &bin = _renderTileBins[y * tilesX + x];
+				if (bin.empty())
+					continue;
+
+				Common::Rect tile(tileSize, tileSize);
+				tile.translate(area.left + x * tileSize, area.top + y * tileSize);
+				tile.clip(area);
+				for (const auto &drawCall : bin) {
+					drawCall->execute(true, &tile);
+				}
+			}
+		}
+
+		// The draw call after them is executed once, like without tiles
+		if (it != _drawCallsQueue.end()) {
+			(*it)->execute(true);
+			++it;
+		}
+	}
+}
+
+void setRenderTileSize(int tileSize) {
+	GLContext *c = gl_get_context();
+	c->_nextRenderTileSize = MAX(tileSize, 0);
+	// Draw calls queued without tiling may lack a dirty region.
+	if (c->_drawCallsQueue.empty())
+		c->_renderTileSize = c->_nextRenderTileSize;
 }
 
 void presentBuffer(Common::List<Common::Rect> &dirtyAreas) {
@@ -307,7 +403,7 @@ RasterizationDrawCall::RasterizationDrawCall() : DrawCall(DrawCall_Rasterization
 	_drawTriangleBack = c->draw_triangle_back;
 	memcpy(_vertex, c->vertex, sizeof(GLVertex) * _vertexCount);
 	_state = captureState();
-	if (c->_enableDirtyRectangles) {
+	if (c->needsDirtyRegions()) {
 		computeDirtyRegion();
 	}
 }
@@ -593,7 +689,7 @@ BlittingDrawCall::BlittingDrawCall(BlitImage *image, const BlitTransform &transf
 	tglIncBlitImageRef(image);
 	_blitState = captureState();
 	_imageVersion = tglGetBlitImageVersion(image);
-	if (gl_get_context()->_enableDirtyRectangles) {
+	if (gl_get_context()->needsDirtyRegions()) {
 		computeDirtyRegion();
 	}
 }
@@ -664,6 +760,13 @@ void BlittingDrawCall::applyState(const BlittingState &state, const Common::Rect
 	memcpy(c->scissor, state.scissor, sizeof(c->scissor));
 }
 
+bool BlittingDrawCall::canBeTiled() const {
+	// Scaled and rotated blits are clipped to the clipping rectangle in
+	// source space, so their output depends on it
+	return _mode != BlitMode_Regular ||
+		(_transform._rotation == 0 && _transform._destinationRectangle.width() == 0 && _transform._destinationRectangle.height() == 0);
+}
+
 void BlittingDrawCall::computeDirtyRegion() {
 	int blitWidth = _transform._destinationRectangle.width();
 	int blitHeight = _transform._destinationRectangle.height();
@@ -681,6 +784,14 @@ void BlittingDrawCall::computeDirtyRegion() {
 			tglGetBlitImageSize(_image, blitWidth, blitHeight);
 		}
 	}
+	if (_transform._rotation != 0 && blitWidth != 0 && blitHeight != 0) {
+		// Rotated blits fill the bounding box of the rotated rectangle, from
+		// the destination position
+		Common::Rect rotated = rotateRectangle(_transform._destinationRectangle.left, _transform._destinationRectangle.top,
+			blitWidth, blitHeight, _transform._rotation, _transform._originX, _transform._originY);
+		blitWidth = rotated.width();
+		blitHeight = rotated.height();
+	}
 	if (blitWidth == 0 || blitHeight == 0) {
 		_dirtyRegion = Common::Rect();
 	} else {
@@ -712,7 +823,7 @@ ClearBufferDrawCall::ClearBufferDrawCall(bool clearZBuffer, int zValue,
 	  _stencilValue(stencilValue), DrawCall(DrawCall_Clear) {
 	_clearState = captureState();
 	TinyGL::GLContext *c = gl_get_context();
-	if (c->_enableDirtyRectangles) {
+	if (c->needsDirtyRegions()) {
 		_dirtyRegion = c->renderRect;
 	}
 }
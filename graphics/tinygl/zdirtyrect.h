@@ -75,6 +75,9 @@ public:
 	virtual void execute(bool restoreState, const Common::Rect *clippingRectangle = nullptr) const = 0;
 	DrawCallType getType() const { return _type; }
 	virtual const Common::Rect getDirtyRegion() const { return _dirtyRegion; }
+	// Whether the output doesn't depend on the clipping rectangle, so that
+	// the draw call can be executed tile by tile
+	virtual bool canBeTiled() const { return true; }
 protected:
 	Common::Rect _dirtyRegion;
 private:
@@ -208,6 +211,7 @@ public:
 	virtual ~BlittingDrawCall();
 	bool operator==(const BlittingDrawCall &other) const;
 	virtual void execute(bool restoreState, const Common::Rect *clippingRectangle = nullptr) const;
+	virtual bool canBeTiled() const;
 
 	BlittingMode getBlittingMode() const { return _mode; }
 
@@ -470,6 +470,11 @@ struct GLContext {
 	int _currentAllocatorIndex;
 	LinearAllocator _drawCallAllocator[2];
 	bool _debugRectsEnabled;
+
+	// Tiled draw call execution
+	int _renderTileSize;
+	int _nextRenderTileSize;
+	Common::Array<Common::Array<DrawCall *> > _renderTileBins;
 	bool _profilingEnabled;
 
 	void gl_vertex_transform(GLVertex *v);
@@ -528,6 +533,9 @@ public:
 
 	void presentBufferDirtyRects(Common::List<Common::Rect> &dirtyAreas);
 	void presentBufferSimple(Common::List<Common::Rect> &dirtyAreas);
+	bool canTileDrawCalls() const;
+	void executeDrawCallsTiled(const Common::Rect &area);
+	bool needsDirtyRegions() const { return _enableDirtyRectangles || _renderTileSize > 0; }
 
 	void debugDrawRectangle(Common::Rect rect, int r, int g, int b);
 
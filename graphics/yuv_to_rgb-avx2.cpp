@@ -0,0 +1,179 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+#include "common/scummsys.h"
+
+#include "graphics/yuv_to_rgb_intern.h"
+
+#include <immintrin.h>
+
+#if defined(__clang__)
+#pragma clang attribute push (__attribute__((target("avx2"))), apply_to=function)
+#elif defined(__GNUC__)
+#pragma GCC push_options
+#pragma GCC target("avx2")
+#endif
+
+namespace Graphics {
+
+namespace {
+
+struct RowParams {
+	__m128i rLoss, gLoss, bLoss, aLoss;
+	__m128i rShift, gShift, bShift, aShift;
+};
+
+// Computes (int16)(k * c) for the chroma value c, with k = mul / 32768
+static inline __m256i chromaTerm(__m256i absC2, __m256i sign, int mul) {
+	const __m256i t = _mm256_mulhi_epu16(absC2, _mm256_set1_epi16((int16)mul));
+	return _mm256_sub_epi16(_mm256_xor_si256(t, sign), sign);
+}
+
+// Does the job of the clip table for sixteen channel values
+template<bool itu>
+static inline __m256i clipChannel(__m256i x, __m128i loss) {
+	if (itu) {
+		x = _mm256_min_epi16(_mm256_max_epi16(x, _mm256_set1_epi16(16)), _mm256_set1_epi16(235));
+		x = _mm256_mullo_epi16(_mm256_sub_epi16(x, _mm256_set1_epi16(16)), _mm256_set1_epi16(255));
+		x = _mm256_srli_epi16(_mm256_mulhi_epu16(x, _mm256_set1_epi16((int16)kYUVScaleITU)), 6);
+	} else {
+		x = _mm256_min_epi16(_mm256_max_epi16(x, _mm256_setzero_si256()), _mm256_set1_epi16(255));
+	}
+
+	return _mm256_srl_epi16(x, loss);
+}
+
+static inline __m256i widen(__m256i x, bool high, __m128i shift) {
+	return _mm256_sll_epi32(_mm256_cvtepu16_epi32(high ? _mm256_extracti128_si256(x, 1) : _mm256_castsi256_si128(x)), shift);
+}
+
+template<typename PixelInt, bool halfChroma, bool alpha, bool itu>
+static int convertRow(byte *dst, const RowParams &params, const byte *ySrc, const byte *uSrc, const byte *vSrc, const byte *aSrc, int width) {
+	const __m256i bias = _mm256_set1_epi16(128);
+	const __m256i opaque = _mm256_set1_epi16(255);
+
+	int x = 0;
+	for (; x + 16 <= width; x += 16) {
+		__m128i u, v;
+		if (halfChroma) {
+			u = _mm_loadl_epi64((const __m128i *)(uSrc + x / 2));
+			v = _mm_loadl_epi64((const __m128i *)(vSrc + x / 2));
+			u = _mm_unpacklo_epi8(u, u);
+			v = _mm_unpacklo_epi8(v, v);
+		} else {
+			u = _mm_loadu_si128((const __m128i *)(uSrc + x));
+			v = _mm_loadu_si128((const __m128i *)(vSrc + x));
+		}
+
+		const __m256i y = _mm256_cvtepu8_epi16(_mm_loadu_si128((const __m128i *)(ySrc + x)));
+		const __m256i cu = _mm256_sub_epi16(_mm256_cvtepu8_epi16(u), bias);
+		const __m256i cv = _mm256_sub_epi16(_mm256_cvtepu8_epi16(v), bias);
+
+		// Split the chroma values into sign and doubled magnitude
+		const __m256i signU = _mm256_srai_epi16(cu, 15);
+		const __m256i signV = _mm256_srai_epi16(cv, 15);
+		const __m256i absU2 = _mm256_slli_epi16(_mm256_abs_epi16(cu), 1);
+		const __m256i absV2 = _mm256_slli_epi16(_mm256_abs_epi16(cv), 1);
+
+		__m256i r = _mm256_add_epi16(y, chromaTerm(absV2, signV, kYUVCrR));
+		__m256i g = _mm256_sub_epi16(y, chromaTerm(absV2, signV, kYUVCrG));
+		g = _mm256_sub_epi16(g, chromaTerm(absU2, signU, kYUVCbG));
+		__m256i b = _mm256_add_epi16(y, chromaTerm(absU2, signU, kYUVCbB));
+
+		r = clipChannel<itu>(r, params.rLoss);
+		g = clipChannel<itu>(g, params.gLoss);
+		b = clipChannel<itu>(b, params.bLoss);
+
+		__m256i a = alpha ? _mm256_cvtepu8_epi16(_mm_loadu_si128((const __m128i *)(aSrc + x))) : opaque;
+		a = _mm256_srl_epi16(a, params.aLoss);
+
+		if (sizeof(PixelInt) == 2) {
+			__m256i pixels = _mm256_sll_epi16(r, params.rShift);
+			pixels = _mm256_or_si256(pixels, _mm256_sll_epi16(g, params.gShift));
+			pixels = _mm256_or_si256(pixels, _mm256_sll_epi16(b, params.bShift));
+			pixels = _mm256_or_si256(pixels, _mm256_sll_epi16(a, params.aShift));
+			_mm256_storeu_si256((__m256i *)(dst + x * 2), pixels);
+		} else {
+			__m256i lo = widen(r, false, params.rShift);
+			__m256i hi = widen(r, true, params.rShift);
+			lo = _mm256_or_si256(lo, widen(g, false, params.gShift));
+			hi = _mm256_or_si256(hi, widen(g, true, params.gShift));
+			lo = _mm256_or_si256(lo, widen(b, false, params.bShift));
+			hi = _mm256_or_si256(hi, widen(b, true, params.bShift));
+			lo = _mm256_or_si256(lo, widen(a, false, params.aShift));
+			hi = _mm256_or_si256(hi, widen(a, true, params.aShift));
+			_mm256_storeu_si256((__m256i *)(dst + x * 4), lo);
+			_mm256_storeu_si256((__m256i *)(dst + x * 4 + 32), hi);
+		}
+	}
+
+	return x;
+}
+
+template<typename PixelInt, bool halfChroma, bool alpha>
+static int convertRow(byte *dst, const RowParams &params, bool itu, const byte *ySrc, const byte *uSrc, const byte *vSrc, const byte *aSrc, int width) {
+	if (itu)
+		return convertRow<PixelInt, halfChroma, alpha, true>(dst, params, ySrc, uSrc, vSrc, aSrc, width);
+	return convertRow<PixelInt, halfChroma, alpha, false>(dst, params, ySrc, uSrc, vSrc, aSrc, width);
+}
+
+template<typename PixelInt>
+static int convertRow(byte *dst, const RowParams &params, bool itu, const byte *ySrc, const byte *uSrc, const byte *vSrc, const byte *aSrc, int width, bool halfChroma) {
+	if (halfChroma) {
+		if (aSrc)
+			return convertRow<PixelInt, true, true>(dst, params, itu, ySrc, uSrc, vSrc, aSrc, width);
+		return convertRow<PixelInt, true, false>(dst, params, itu, ySrc, uSrc, vSrc, aSrc, width);
+	}
+
+	if (aSrc)
+		return convertRow<PixelInt, false, true>(dst, params, itu, ySrc, uSrc, vSrc, aSrc, width);
+	return convertRow<PixelInt, false, false>(dst, params, itu, ySrc, uSrc, vSrc, aSrc, width);
+}
+
+} // End of anonymous namespace
+
+int convertYUVToRGBRowAVX2(byte *dst, const YUVToRGBLookup *lookup, const byte *ySrc, const byte *uSrc, const byte *vSrc, const byte *aSrc, int width, bool halfChroma) {
+	const Graphics::PixelFormat format = lookup->getFormat();
+	const bool itu = lookup->getScale() == YUVToRGBManager::kScaleITU;
+
+	RowParams params;
+	params.rLoss = _mm_cvtsi32_si128(format.rLoss);
+	params.gLoss = _mm_cvtsi32_si128(format.gLoss);
+	params.bLoss = _mm_cvtsi32_si128(format.bLoss);
+	params.aLoss = _mm_cvtsi32_si128(format.aLoss);
+	params.rShift = _mm_cvtsi32_si128(format.rShift);
+	params.gShift = _mm_cvtsi32_si128(format.gShift);
+	params.bShift = _mm_cvtsi32_si128(format.bShift);
+	params.aShift = _mm_cvtsi32_si128(format.aShift);
+
+	if (format.bytesPerPixel == 2)
+		return convertRow<uint16>(dst, params, itu, ySrc, uSrc, vSrc, aSrc, width, halfChroma);
+	return convertRow<uint32>(dst, params, itu, ySrc, uSrc, vSrc, aSrc, width, halfChroma);
+}
+
+} // End of namespace Graphics
+
+#if defined(__clang__)
+#pragma clang attribute pop
+#elif defined(__GNUC__)
+#pragma GCC pop_options
+#endif
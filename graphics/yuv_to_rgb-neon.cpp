@@ -0,0 +1,201 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+#include "common/scummsys.h"
+
+#ifdef SCUMMVM_NEON
+
+#include "graphics/yuv_to_rgb_intern.h"
+
+#include <arm_neon.h>
+
+#if !defined(__aarch64__) && !defined(__ARM_NEON)
+
+#if defined(__clang__)
+#pragma clang attribute push (__attribute__((target("neon"))), apply_to=function)
+#elif defined(__GNUC__)
+#pragma GCC push_options
+#pragma GCC target("fpu=neon")
+#endif
+
+#endif // !defined(__aarch64__) && !defined(__ARM_NEON)
+
+namespace Graphics {
+
+namespace {
+
+struct RowParams {
+	int16x8_t rLoss, gLoss, bLoss, aLoss;
+	int16x8_t rShift16, gShift16, bShift16, aShift16;
+	int32x4_t rShift, gShift, bShift, aShift;
+};
+
+static inline uint16x8_t mulhi(uint16x8_t x, uint16 mul) {
+	return vcombine_u16(vshrn_n_u32(vmull_n_u16(vget_low_u16(x), mul), 16), vshrn_n_u32(vmull_n_u16(vget_high_u16(x), mul), 16));
+}
+
+// Computes (int16)(k * c) for the chroma value c, with k = mul / 32768
+static inline int16x8_t chromaTerm(uint16x8_t absC2, int16x8_t sign, uint16 mul) {
+	const int16x8_t t = vreinterpretq_s16_u16(mulhi(absC2, mul));
+	return vsubq_s16(veorq_s16(t, sign), sign);
+}
+
+// Does the job of the clip table for eight channel values. The loss is
+// passed as a negative shift.
+template<bool itu>
+static inline uint16x8_t clipChannel(int16x8_t x, int16x8_t loss) {
+	uint16x8_t clipped;
+	if (itu) {
+		x = vminq_s16(vmaxq_s16(x, vdupq_n_s16(16)), vdupq_n_s16(235));
+		clipped = vmulq_n_u16(vreinterpretq_u16_s16(vsubq_s16(x, vdupq_n_s16(16))), 255);
+		clipped = vshrq_n_u16(mulhi(clipped, kYUVScaleITU), 6);
+	} else {
+		clipped = vreinterpretq_u16_s16(vminq_s16(vmaxq_s16(x, vdupq_n_s16(0)), vdupq_n_s16(255)));
+	}
+
+	return vshlq_u16(clipped, loss);
+}
+
+static inline uint32x4_t widen(uint16x4_t x, int32x4_t shift) {
+	return vshlq_u32(vmovl_u16(x), shift);
+}
+
+template<typename PixelInt, bool halfChroma, bool alpha, bool itu>
+static int convertRow(byte *dst, const RowParams &params, const byte *ySrc, const byte *uSrc, const byte *vSrc, const byte *aSrc, int width) {
+	const int16x8_t bias = vdupq_n_s16(128);
+
+	int x = 0;
+	for (; x + 8 <= width; x += 8) {
+		uint8x8_t u, v;
+		if (halfChroma) {
+			u = vreinterpret_u8_u32(vdup_n_u32(READ_UINT32(uSrc + x / 2)));
+			v = vreinterpret_u8_u32(vdup_n_u32(READ_UINT32(vSrc + x / 2)));
+			u = vzip_u8(u, u).val[0];
+			v = vzip_u8(v, v).val[0];
+		} else {
+			u = vld1_u8(uSrc + x);
+			v = vld1_u8(vSrc + x);
+		}
+
+		const int16x8_t y = vreinterpretq_s16_u16(vmovl_u8(vld1_u8(ySrc + x)));
+		const int16x8_t cu = vsubq_s16(vreinterpretq_s16_u16(vmovl_u8(u)), bias);
+		const int16x8_t cv = vsubq_s16(vreinterpretq_s16_u16(vmovl_u8(v)), bias);
+
+		// Split the chroma values into sign and doubled magnitude
+		const int16x8_t signU = vshrq_n_s16(cu, 15);
+		const int16x8_t signV = vshrq_n_s16(cv, 15);
+		const uint16x8_t absU2 = vreinterpretq_u16_s16(vshlq_n_s16(vabsq_s16(cu), 1));
+		const uint16x8_t absV2 = vreinterpretq_u16_s16(vshlq_n_s16(vabsq_s16(cv), 1));
+
+		int16x8_t r = vaddq_s16(y, chromaTerm(absV2, signV, kYUVCrR));
+		int16x8_t g = vsubq_s16(y, chromaTerm(absV2, signV, kYUVCrG));
+		g = vsubq_s16(g, chromaTerm(absU2, signU, kYUVCbG));
+		int16x8_t b = vaddq_s16(y, chromaTerm(absU2, signU, kYUVCbB));
+
+		const uint16x8_t rc = clipChannel<itu>(r, params.rLoss);
+		const uint16x8_t gc = clipChannel<itu>(g, params.gLoss);
+		const uint16x8_t bc = clipChannel<itu>(b, params.bLoss);
+
+		uint16x8_t a = alpha ? vmovl_u8(vld1_u8(aSrc + x)) : vdupq_n_u16(255);
+		a = vshlq_u16(a, params.aLoss);
+
+		if (sizeof(PixelInt) == 2) {
+			uint16x8_t pixels = vshlq_u16(rc, params.rShift16);
+			pixels = vorrq_u16(pixels, vshlq_u16(gc, params.gShift16));
+			pixels = vorrq_u16(pixels, vshlq_u16(bc, params.bShift16));
+			pixels = vorrq_u16(pixels, vshlq_u16(a, params.aShift16));
+			vst1q_u8(dst + x * 2, vreinterpretq_u8_u16(pixels));
+		} else {
+			uint32x4_t lo = widen(vget_low_u16(rc), params.rShift);
+			uint32x4_t hi = widen(vget_high_u16(rc), params.rShift);
+			lo = vorrq_u32(lo, widen(vget_low_u16(gc), params.gShift));
+			hi = vorrq_u32(hi, widen(vget_high_u16(gc), params.gShift));
+			lo = vorrq_u32(lo, widen(vget_low_u16(bc), params.bShift));
+			hi = vorrq_u32(hi, widen(vget_high_u16(bc), params.bShift));
+			lo = vorrq_u32(lo, widen(vget_low_u16(a), params.aShift));
+			hi = vorrq_u32(hi, widen(vget_high_u16(a), params.aShift));
+			vst1q_u8(dst + x * 4, vreinterpretq_u8_u32(lo));
+			vst1q_u8(dst + x * 4 + 16, vreinterpretq_u8_u32(hi));
+		}
+	}
+
+	return x;
+}
+
+template<typename PixelInt, bool halfChroma, bool alpha>
+static int convertRow(byte *dst, const RowParams &params, bool itu, const byte *ySrc, const byte *uSrc, const byte *vSrc, const byte *aSrc, int width) {
+	if (itu)
+		return convertRow<PixelInt, halfChroma, alpha, true>(dst, params, ySrc, uSrc, vSrc, aSrc, width);
+	return convertRow<PixelInt, halfChroma, alpha, false>(dst, params, ySrc, uSrc, vSrc, aSrc, width);
+}
+
+template<typename PixelInt>
+static int convertRow(byte *dst, const RowParams &params, bool itu, const byte *ySrc, const byte *uSrc, const byte *vSrc, const byte *aSrc, int width, bool halfChroma) {
+	if (halfChroma) {
+		if (aSrc)
+			return convertRow<PixelInt, true, true>(dst, params, itu, ySrc, uSrc, vSrc, aSrc, width);
+		return convertRow<PixelInt, true, false>(dst, params, itu, ySrc, uSrc, vSrc, aSrc, width);
+	}
+
+	if (aSrc)
+		return convertRow<PixelInt, false, true>(dst, params, itu, ySrc, uSrc, vSrc, aSrc, width);
+	return convertRow<PixelInt, false, false>(dst, params, itu, ySrc, uSrc, vSrc, aSrc, width);
+}
+
+} // End of anonymous namespace
+
+int convertYUVToRGBRowNEON(byte *dst, const YUVToRGBLookup *lookup, const byte *ySrc, const byte *uSrc, const byte *vSrc, const byte *aSrc, int width, bool halfChroma) {
+	const Graphics::PixelFormat format = lookup->getFormat();
+	const bool itu = lookup->getScale() == YUVToRGBManager::kScaleITU;
+
+	RowParams params;
+	params.rLoss = vdupq_n_s16(-format.rLoss);
+	params.gLoss = vdupq_n_s16(-format.gLoss);
+	params.bLoss = vdupq_n_s16(-format.bLoss);
+	params.aLoss = vdupq_n_s16(-format.aLoss);
+	params.rShift16 = vdupq_n_s16(format.rShift);
+	params.gShift16 = vdupq_n_s16(format.gShift);
+	params.bShift16 = vdupq_n_s16(format.bShift);
+	params.aShift16 = vdupq_n_s16(format.aShift);
+	params.rShift = vdupq_n_s32(format.rShift);
+	params.gShift = vdupq_n_s32(format.gShift);
+	params.bShift = vdupq_n_s32(format.bShift);
+	params.aShift = vdupq_n_s32(format.aShift);
+
+	if (format.bytesPerPixel == 2)
+		return convertRow<uint16>(dst, params, itu, ySrc, uSrc, vSrc, aSrc, width, halfChroma);
+	return convertRow<uint32>(dst, params, itu, ySrc, uSrc, vSrc, aSrc, width, halfChroma);
+}
+
+} // End of namespace Graphics
+
+#if !defined(__aarch64__) && !defined(__ARM_NEON)
+
+#if defined(__clang__)
+#pragma clang attribute pop
+#elif defined(__GNUC__)
+#pragma GCC pop_options
+#endif
+
+#endif // !defined(__aarch64__) && !defined(__ARM_NEON)
+
+#endif // SCUMMVM_NEON
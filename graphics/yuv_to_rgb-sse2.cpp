@@ -0,0 +1,184 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+#include "common/scummsys.h"
+
+#include "graphics/yuv_to_rgb_intern.h"
+
+#include <emmintrin.h>
+
+#if !defined(__x86_64__)
+
+#if defined(__clang__)
+#pragma clang attribute push (__attribute__((target("sse2"))), apply_to=function)
+#elif defined(__GNUC__)
+#pragma GCC push_options
+#pragma GCC target("sse2")
+#endif
+
+#endif // !defined(__x86_64__)
+
+namespace Graphics {
+
+namespace {
+
+struct RowParams {
+	__m128i rLoss, gLoss, bLoss, aLoss;
+	__m128i rShift, gShift, bShift, aShift;
+};
+
+// Computes (int16)(k * c) for the chroma value c, with k = mul / 32768
+static inline __m128i chromaTerm(__m128i absC2, __m128i sign, int mul) {
+	const __m128i t = _mm_mulhi_epu16(absC2, _mm_set1_epi16((int16)mul));
+	return _mm_sub_epi16(_mm_xor_si128(t, sign), sign);
+}
+
+// Does the job of the clip table for eight channel values
+template<bool itu>
+static inline __m128i clipChannel(__m128i x, __m128i loss) {
+	if (itu) {
+		x = _mm_min_epi16(_mm_max_epi16(x, _mm_set1_epi16(16)), _mm_set1_epi16(235));
+		x = _mm_mullo_epi16(_mm_sub_epi16(x, _mm_set1_epi16(16)), _mm_set1_epi16(255));
+		x = _mm_srli_epi16(_mm_mulhi_epu16(x, _mm_set1_epi16((int16)kYUVScaleITU)), 6);
+	} else {
+		x = _mm_min_epi16(_mm_max_epi16(x, _mm_setzero_si128()), _mm_set1_epi16(255));
+	}
+
+	return _mm_srl_epi16(x, loss);
+}
+
+template<typename PixelInt, bool halfChroma, bool alpha, bool itu>
+static int convertRow(byte *dst, const RowParams &params, const byte *ySrc, const byte *uSrc, const byte *vSrc, const byte *aSrc, int width) {
+	const __m128i zero = _mm_setzero_si128();
+	const __m128i bias = _mm_set1_epi16(128);
+	const __m128i opaque = _mm_set1_epi16(255);
+
+	int x = 0;
+	for (; x + 8 <= width; x += 8) {
+		__m128i u, v;
+		if (halfChroma) {
+			u = _mm_cvtsi32_si128(READ_UINT32(uSrc + x / 2));
+			v = _mm_cvtsi32_si128(READ_UINT32(vSrc + x / 2));
+			u = _mm_unpacklo_epi8(u, u);
+			v = _mm_unpacklo_epi8(v, v);
+		} else {
+			u = _mm_loadl_epi64((const __m128i *)(uSrc + x));
+			v = _mm_loadl_epi64((const __m128i *)(vSrc + x));
+		}
+
+		const __m128i y = _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i *)(ySrc + x)), zero);
+		const __m128i cu = _mm_sub_epi16(_mm_unpacklo_epi8(u, zero), bias);
+		const __m128i cv = _mm_sub_epi16(_mm_unpacklo_epi8(v, zero), bias);
+
+		// Split the chroma values into sign and doubled magnitude
+		const __m128i signU = _mm_srai_epi16(cu, 15);
+		const __m128i signV = _mm_srai_epi16(cv, 15);
+		const __m128i absU2 = _mm_slli_epi16(_mm_sub_epi16(_mm_xor_si128(cu, signU), signU), 1);
+		const __m128i absV2 = _mm_slli_epi16(_mm_sub_epi16(_mm_xor_si128(cv, signV), signV), 1);
+
+		__m128i r = _mm_add_epi16(y, chromaTerm(absV2, signV, kYUVCrR));
+		__m128i g = _mm_sub_epi16(y, chromaTerm(absV2, signV, kYUVCrG));
+		g = _mm_sub_epi16(g, chromaTerm(absU2, signU, kYUVCbG));
+		__m128i b = _mm_add_epi16(y, chromaTerm(absU2, signU, kYUVCbB));
+
+		r = clipChannel<itu>(r, params.rLoss);
+		g = clipChannel<itu>(g, params.gLoss);
+		b = clipChannel<itu>(b, params.bLoss);
+
+		__m128i a = alpha ? _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i *)(aSrc + x)), zero) : opaque;
+		a = _mm_srl_epi16(a, params.aLoss);
+
+		if (sizeof(PixelInt) == 2) {
+			__m128i pixels = _mm_sll_epi16(r, params.rShift);
+			pixels = _mm_or_si128(pixels, _mm_sll_epi16(g, params.gShift));
+			pixels = _mm_or_si128(pixels, _mm_sll_epi16(b, params.bShift));
+			pixels = _mm_or_si128(pixels, _mm_sll_epi16(a, params.aShift));
+			_mm_storeu_si128((__m128i *)(dst + x * 2), pixels);
+		} else {
+			__m128i lo = _mm_sll_epi32(_mm_unpacklo_epi16(r, zero), params.rShift);
+			__m128i hi = _mm_sll_epi32(_mm_unpackhi_epi16(r, zero), params.rShift);
+			lo = _mm_or_si128(lo, _mm_sll_epi32(_mm_unpacklo_epi16(g, zero), params.gShift));
+			hi = _mm_or_si128(hi, _mm_sll_epi32(_mm_unpackhi_epi16(g, zero), params.gShift));
+			lo = _mm_or_si128(lo, _mm_sll_epi32(_mm_unpacklo_epi16(b, zero), params.bShift));
+			hi = _mm_or_si128(hi, _mm_sll_epi32(_mm_unpackhi_epi16(b, zero), params.bShift));
+			lo = _mm_or_si128(lo, _mm_sll_epi32(_mm_unpacklo_epi16(a, zero), params.aShift));
+			hi = _mm_or_si128(hi, _mm_sll_epi32(_mm_unpackhi_epi16(a, zero), params.aShift));
+			_mm_storeu_si128((__m128i *)(dst + x * 4), lo);
+			_mm_storeu_si128((__m128i *)(dst + x * 4 + 16), hi);
+		}
+	}
+
+	return x;
+}
+
+template<typename PixelInt, bool halfChroma, bool alpha>
+static int convertRow(byte *dst, const RowParams &params, bool itu, const byte *ySrc, const byte *uSrc, const byte *vSrc, const byte *aSrc, int width) {
+	if (itu)
+		return convertRow<PixelInt, halfChroma, alpha, true>(dst, params, ySrc, uSrc, vSrc, aSrc, width);
+	return convertRow<PixelInt, halfChroma, alpha, false>(dst, params, ySrc, uSrc, vSrc, aSrc, width);
+}
+
+template<typename PixelInt>
+static int convertRow(byte *dst, const RowParams &params, bool itu, const byte *ySrc, const byte *uSrc, const byte *vSrc, const byte *aSrc, int width, bool halfChroma) {
+	if (halfChroma) {
+		if (aSrc)
+			return convertRow<PixelInt, true, true>(dst, params, itu, ySrc, uSrc, vSrc, aSrc, width);
+		return convertRow<PixelInt, true, false>(dst, params, itu, ySrc, uSrc, vSrc, aSrc, width);
+	}
+
+	if (aSrc)
+		return convertRow<PixelInt, false, true>(dst, params, itu, ySrc, uSrc, vSrc, aSrc, width);
+	return convertRow<PixelInt, false, false>(dst, params, itu, ySrc, uSrc, vSrc, aSrc, width);
+}
+
+} // End of anonymous namespace
+
+int convertYUVToRGBRowSSE2(byte *dst, const YUVToRGBLookup *lookup, const byte *ySrc, const byte *uSrc, const byte *vSrc, const byte *aSrc, int width, bool halfChroma) {
+	const Graphics::PixelFormat format = lookup->getFormat();
+	const bool itu = lookup->getScale() == YUVToRGBManager::kScaleITU;
+
+	RowParams params;
+	params.rLoss = _mm_cvtsi32_si128(format.rLoss);
+	params.gLoss = _mm_cvtsi32_si128(format.gLoss);
+	params.bLoss = _mm_cvtsi32_si128(format.bLoss);
+	params.aLoss = _mm_cvtsi32_si128(format.aLoss);
+	params.rShift = _mm_cvtsi32_si128(format.rShift);
+	params.gShift = _mm_cvtsi32_si128(format.gShift);
+	params.bShift = _mm_cvtsi32_si128(format.bShift);
+	params.aShift = _mm_cvtsi32_si128(format.aShift);
+
+	if (format.bytesPerPixel == 2)
+		return convertRow<uint16>(dst, params, itu, ySrc, uSrc, vSrc, aSrc, width, halfChroma);
+	return convertRow<uint32>(dst, params, itu, ySrc, uSrc, vSrc, aSrc, width, halfChroma);
+}
+
+} // End of namespace Graphics
+
+#if !defined(__x86_64__)
+
+#if defined(__clang__)
+#pragma clang attribute pop
+#elif defined(__GNUC__)
+#pragma GCC pop_options
+#endif
+
+#endif // !defined(__x86_64__)
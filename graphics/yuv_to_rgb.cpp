@@ -82,8 +82,11 @@
 // BASIS, AND BROWN UNIVERSITY HAS NO OBLIGATION TO PROVIDE MAINTENANCE,
 // SUPPORT, UPDATES, ENHANCEMENTS, OR MODIFICATIONS.
 
+#include "common/system.h"
+
 #include "graphics/surface.h"
 #include "graphics/yuv_to_rgb.h"
+#include "graphics/yuv_to_rgb_intern.h"
 
 namespace Common {
 DECLARE_SINGLETON(Graphics::YUVToRGBManager);
@@ -91,22 +94,6 @@ DECLARE_SINGLETON(Graphics::YUVToRGBManager);
 
 namespace Graphics {
 
-class YUVToRGBLookup {
-public:
-	YUVToRGBLookup(Graphics::PixelFormat format, YUVToRGBManager::LuminanceScale scale);
-
-	Graphics::PixelFormat getFormat() const { return _format; }
-	YUVToRGBManager::LuminanceScale getScale() const { return _scale; }
-	const int16 *getColorTable() const { return _colorTab; }
-	const byte *getClipTable() const { return _clipTable; }
-
-private:
-	Graphics::PixelFormat _format;
-	YUVToRGBManager::LuminanceScale _scale;
-	int16 _colorTab[4 * 256]; // 2048 bytes
-	byte _clipTable[3 * 768];
-};
-
 YUVToRGBLookup::YUVToRGBLookup(Graphics::PixelFormat format, YUVToRGBManager::LuminanceScale scale) {
 	_format = format;
 	_scale = scale;
@@ -183,13 +170,36 @@ YUVToRGBLookup::YUVToRGBLookup(Graphics::PixelFormat format, YUVToRGBManager::Lu
 
 YUVToRGBManager::YUVToRGBManager() {
 	_lookup = 0;
+	_convertRow = nullptr;
+	_convertRowSelected = false;
 }
 
 YUVToRGBManager::~YUVToRGBManager() {
 	delete _lookup;
 }
 
+void YUVToRGBManager::selectConvertRow() {
+	// Pick the fastest row converter the CPU supports
+	_convertRow = nullptr;
+#ifdef SCUMMVM_NEON
+	if (g_system->hasFeature(OSystem::kFeatureCpuNEON))
+		_convertRow = convertYUVToRGBRowNEON;
+#endif
+#ifdef SCUMMVM_SSE2
+	if (g_system->hasFeature(OSystem::kFeatureCpuSSE2))
+		_convertRow = convertYUVToRGBRowSSE2;
+#endif
+#ifdef SCUMMVM_AVX2
+	if (g_system->hasFeature(OSystem::kFeatureCpuAVX2))
+		_convertRow = convertYUVToRGBRowAVX2;
+#endif
+	_convertRowSelected = true;
+}
+
 const YUVToRGBLookup *YUVToRGBManager::getLookup(Graphics::PixelFormat format, YUVToRGBManager::LuminanceScale scale) {
+	if (!_convertRowSelected)
+		selectConvertRow();
+
 	if (_lookup && _lookup->getFormat() == format && _lookup->getScale() == scale)
 		return _lookup;
 
@@ -203,7 +213,7 @@ const YUVToRGBLookup *YUVToRGBManager::getLookup(Graphics::PixelFormat format, Y
 	*((PixelInt *)(d)) = ((L[cr_r] << r_shift) | (L[crb_g] << g_shift) | (L[cb_b] << b_shift) | a_mask)
 
 template<typename PixelInt>
-void convertYUV444ToRGB(byte *dstPtr, int dstPitch, const YUVToRGBLookup *lookup, const byte *ySrc, const byte *uSrc, const byte *vSrc, int yWidth, int yHeight, int yPitch, int uvPitch) {
+void convertYUV444ToRGB(byte *dstPtr, int dstPitch, const YUVToRGBLookup *lookup, YUVToRGBRowFunc convertRow, const byte *ySrc, const byte *uSrc, const byte *vSrc, int yWidth, int yHeight, int yPitch, int uvPitch) {
 	// Keep the tables in pointers here to avoid a dereference on each pixel
 	const int16 *Cr_r_tab = lookup->getColorTable();
 	const int16 *Cr_g_tab = Cr_r_tab + 256;
@@ -217,7 +227,16 @@ void convertYUV444ToRGB(byte *dstPtr, int dstPitch, const YUVToRGBLookup *lookup
 	const PixelInt a_mask = (0xFF >> lookup->getFormat().aLoss) << lookup->getFormat().aShift;
 
 	for (int h = 0; h < yHeight; h++) {
-		for (int w = 0; w < yWidth; w++) {
+		int start = 0;
+		if (convertRow) {
+			start = convertRow(dstPtr, lookup, ySrc, uSrc, vSrc, nullptr, yWidth, false);
+			dstPtr += start * sizeof(PixelInt);
+			ySrc += start;
+			uSrc += start;
+			vSrc += start;
+		}
+
+		for (int w = start; w < yWidth; w++) {
 			const byte *L;
 
 			int16 cr_r  = Cr_r_tab[*vSrc];
@@ -248,13 +267,13 @@ void YUVToRGBManager::convert444(Graphics::Surface *dst, YUVToRGBManager::Lumina
 
 	// Use a templated function to avoid an if check on every pixel
 	if (dst->format.bytesPerPixel == 2)
-		convertYUV444ToRGB<uint16>((byte *)dst->getPixels(), dst->pitch, lookup, ySrc, uSrc, vSrc, yWidth, yHeight, yPitch, uvPitch);
+		convertYUV444ToRGB<uint16>((byte *)dst->getPixels(), dst->pitch, lookup, _convertRow, ySrc, uSrc, vSrc, yWidth, yHeight, yPitch, uvPitch);
 	else
-		convertYUV444ToRGB<uint32>((byte *)dst->getPixels(), dst->pitch, lookup, ySrc, uSrc, vSrc, yWidth, yHeight, yPitch, uvPitch);
+		convertYUV444ToRGB<uint32>((byte *)dst->getPixels(), dst->pitch, lookup, _convertRow, ySrc, uSrc, vSrc, yWidth, yHeight, yPitch, uvPitch);
 }
 
 template<typename PixelInt>
-void convertYUV422ToRGB(byte *dstPtr, int dstPitch, const YUVToRGBLookup *lookup, const byte *ySrc, const byte *uSrc, const byte *vSrc, int yWidth, int yHeight, int yPitch, int uvPitch) {
+void convertYUV422ToRGB(byte *dstPtr, int dstPitch, const YUVToRGBLookup *lookup, YUVToRGBRowFunc convertRow, const byte *ySrc, const byte *uSrc, const byte *vSrc, int yWidth, int yHeight, int yPitch, int uvPitch) {
 	int halfWidth = yWidth >> 1;
 
 	// Keep the tables in pointers here to avoid a dereference on each pixel
@@ -270,7 +289,16 @@ void convertYUV422ToRGB(byte *dstPtr, int dstPitch, const YUVToRGBLookup *lookup
 	const PixelInt a_mask = (0xFF >> lookup->getFormat().aLoss) << lookup->getFormat().aShift;
 
 	for (int h = 0; h < yHeight; h++) {
-		for (int w = 0; w < halfWidth; w++) {
+		int start = 0;
+		if (convertRow) {
+			start = convertRow(dstPtr, lookup, ySrc, uSrc, vSrc, nullptr, yWidth, true) >> 1;
+			dstPtr += start * 2 * sizeof(PixelInt);
+			ySrc += start * 2;
+			uSrc += start;
+			vSrc += start;
+		}
+
+		for (int w = start; w < halfWidth; w++) {
 			const byte *L;
 
 			int16 cr_r  = Cr_r_tab[*vSrc];
@@ -305,13 +333,13 @@ void YUVToRGBManager::convert422(Graphics::Surface *dst, YUVToRGBManager::Lumina
 
 	// Use a templated function to avoid an if check on every pixel
 	if (dst->format.bytesPerPixel == 2)
-		convertYUV422ToRGB<uint16>((byte *)dst->getPixels(), dst->pitch, lookup, ySrc, uSrc, vSrc, yWidth, yHeight, yPitch, uvPitch);
+		convertYUV422ToRGB<uint16>((byte *)dst->getPixels(), dst->pitch, lookup, _convertRow, ySrc, uSrc, vSrc, yWidth, yHeight, yPitch, uvPitch);
 	else
-		convertYUV422ToRGB<uint32>((byte *)dst->getPixels(), dst->pitch, lookup, ySrc, uSrc, vSrc, yWidth, yHeight, yPitch, uvPitch);
+		convertYUV422ToRGB<uint32>((byte *)dst->getPixels(), dst->pitch, lookup, _convertRow, ySrc, uSrc, vSrc, yWidth, yHeight, yPitch, uvPitch);
 }
 
 template<typename PixelInt>
-void convertYUV420ToRGB(byte *dstPtr, int dstPitch, const YUVToRGBLookup *lookup, const byte *ySrc, const byte *uSrc, const byte *vSrc, int yWidth, int yHeight, int yPitch, int uvPitch) {
+void convertYUV420ToRGB(byte *dstPtr, int dstPitch, const YUVToRGBLookup *lookup, YUVToRGBRowFunc convertRow, const byte *ySrc, const byte *uSrc, const byte *vSrc, int yWidth, int yHeight, int yPitch, int uvPitch) {
 	int halfHeight = yHeight >> 1;
 	int halfWidth = yWidth >> 1;
 
@@ -328,7 +356,18 @@ void convertYUV420ToRGB(byte *dstPtr, int dstPitch, const YUVToRGBLookup *lookup
 	const PixelInt a_mask = (0xFF >> lookup->getFormat().aLoss) << lookup->getFormat().aShift;
 
 	for (int h = 0; h < halfHeight; h++) {
-		for (int w = 0; w < halfWidth; w++) {
+		int start = 0;
+		if (convertRow) {
+			// Both rows share the same chroma
+			start = convertRow(dstPtr, lookup, ySrc, uSrc, vSrc, nullptr, yWidth, true) >> 1;
+			convertRow(dstPtr + dstPitch, lookup, ySrc + yPitch, uSrc, vSrc, nullptr, yWidth, true);
+			dstPtr += start * 2 * sizeof(PixelInt);
+			ySrc += start * 2;
+			uSrc += start;
+			vSrc += start;
+		}
+
+		for (int w = start; w < halfWidth; w++) {
 			const byte *L;
 
 			int16 cr_r  = Cr_r_tab[*vSrc];
@@ -366,9 +405,9 @@ void YUVToRGBManager::convert420(Graphics::Surface *dst, YUVToRGBManager::Lumina
 
 	// Use a templated function to avoid an if check on every pixel
 	if (dst->format.bytesPerPixel == 2)
-		convertYUV420ToRGB<uint16>((byte *)dst->getPixels(), dst->pitch, lookup, ySrc, uSrc, vSrc, yWidth, yHeight, yPitch, uvPitch);
+		convertYUV420ToRGB<uint16>((byte *)dst->getPixels(), dst->pitch, lookup, _convertRow, ySrc, uSrc, vSrc, yWidth, yHeight, yPitch, uvPitch);
 	else
-		convertYUV420ToRGB<uint32>((byte *)dst->getPixels(), dst->pitch, lookup, ySrc, uSrc, vSrc, yWidth, yHeight, yPitch, uvPitch);
+		convertYUV420ToRGB<uint32>((byte *)dst->getPixels(), dst->pitch, lookup, _convertRow, ySrc, uSrc, vSrc, yWidth, yHeight, yPitch, uvPitch);
 }
 
 #define PUT_PIXELA(s, a, d) \
@@ -376,7 +415,7 @@ void YUVToRGBManager::convert420(Graphics::Surface *dst, YUVToRGBManager::Lumina
 	*((PixelInt *)(d)) = ((L[cr_r] << r_shift) | (L[crb_g] << g_shift) | (L[cb_b] << b_shift) | ((a >> a_loss) << a_shift))
 
 template<typename PixelInt>
-void convertYUVA420ToRGBA(byte *dstPtr, int dstPitch, const YUVToRGBLookup *lookup, const byte *ySrc, const byte *uSrc, const byte *vSrc, const byte *aSrc, int yWidth, int yHeight, int yPitch, int uvPitch) {
+void convertYUVA420ToRGBA(byte *dstPtr, int dstPitch, const YUVToRGBLookup *lookup, YUVToRGBRowFunc convertRow, const byte *ySrc, const byte *uSrc, const byte *vSrc, const byte *aSrc, int yWidth, int yHeight, int yPitch, int uvPitch) {
 	int halfHeight = yHeight >> 1;
 	int halfWidth = yWidth >> 1;
 
@@ -394,7 +433,19 @@ void convertYUVA420ToRGBA(byte *dstPtr, int dstPitch, const YUVToRGBLookup *look
 	const byte a_loss = lookup->getFormat().aLoss;
 
 	for (int h = 0; h < halfHeight; h++) {
-		for (int w = 0; w < halfWidth; w++) {
+		int start = 0;
+		if (convertRow) {
+			// Both rows share the same chroma
+			start = convertRow(dstPtr, lookup, ySrc, uSrc, vSrc, aSrc, yWidth, true) >> 1;
+			convertRow(dstPtr + dstPitch, lookup, ySrc + yPitch, uSrc, vSrc, aSrc + yPitch, yWidth, true);
+			dstPtr += start * 2 * sizeof(PixelInt);
+			ySrc += start * 2;
+			aSrc += start * 2;
+			uSrc += start;
+			vSrc += start;
+		}
+
+		for (int w = start; w < halfWidth; w++) {
 			const byte *L;
 
 			int16 cr_r  = Cr_r_tab[*vSrc];
@@ -435,9 +486,9 @@ void YUVToRGBManager::convert420Alpha(Graphics::Surface *dst, YUVToRGBManager::L
 
 	// Use a templated function to avoid an if check on every pixel
 	if (dst->format.bytesPerPixel == 2)
-		convertYUVA420ToRGBA<uint16>((byte *)dst->getPixels(), dst->pitch, lookup, ySrc, uSrc, vSrc, aSrc, yWidth, yHeight, yPitch, uvPitch);
+		convertYUVA420ToRGBA<uint16>((byte *)dst->getPixels(), dst->pitch, lookup, _convertRow, ySrc, uSrc, vSrc, aSrc, yWidth, yHeight, yPitch, uvPitch);
 	else
-		convertYUVA420ToRGBA<uint32>((byte *)dst->getPixels(), dst->pitch, lookup, ySrc, uSrc, vSrc, aSrc, yWidth, yHeight, yPitch, uvPitch);
+		convertYUVA420ToRGBA<uint32>((byte *)dst->getPixels(), dst->pitch, lookup, _convertRow, ySrc, uSrc, vSrc, aSrc, yWidth, yHeight, yPitch, uvPitch);
 }
 
 #define READ_QUAD(ptr, prefix) \
@@ -465,7 +516,7 @@ void YUVToRGBManager::convert420Alpha(Graphics::Surface *dst, YUVToRGBManager::L
 	xDiff++
 
 template<typename PixelInt>
-void convertYUV410ToRGB(byte *dstPtr, int dstPitch, const YUVToRGBLookup *lookup, const byte *ySrc, const byte *uSrc, const byte *vSrc, int yWidth, int yHeight, int yPitch, int uvPitch) {
+void convertYUV410ToRGB(byte *dstPtr, int dstPitch, const YUVToRGBLookup *lookup, YUVToRGBRowFunc convertRow, const byte *ySrc, const byte *uSrc, const byte *vSrc, int yWidth, int yHeight, int yPitch, int uvPitch) {
 	// Keep the tables in pointers here to avoid a dereference on each pixel
 	const int16 *Cr_r_tab = lookup->getColorTable();
 	const int16 *Cr_g_tab = Cr_r_tab + 256;
@@ -480,7 +531,58 @@ void convertYUV410ToRGB(byte *dstPtr, int dstPitch, const YUVToRGBLookup *lookup
 
 	int quarterWidth = yWidth >> 2;
 
+	// Chroma of a part of a row, for the row converter
+	const int kChunkQuads = 64;
+	byte uLine[kChunkQuads * 4];
+	byte vLine[kChunkQuads * 4];
+
 	for (int y = 0; y < yHeight; y++) {
+		if (convertRow) {
+			int targetY = y >> 2;
+			int yDiff = y & 3;
+
+			for (int x = 0; x < quarterWidth; x += kChunkQuads) {
+				int quads = MIN(kChunkQuads, quarterWidth - x);
+
+				// Interpolate the chroma first, so that the pixels can be
+				// converted like YUV444 ones
+				for (int i = 0; i < quads; i++) {
+					int index = targetY * uvPitch + x + i;
+
+					READ_QUAD(uSrc, u);
+					READ_QUAD(vSrc, v);
+
+					for (int xDiff = 0; xDiff < 4; xDiff++) {
+						byte u, v;
+						DO_INTERPOLATION(u);
+						DO_INTERPOLATION(v);
+						uLine[i * 4 + xDiff] = u;
+						vLine[i * 4 + xDiff] = v;
+					}
+				}
+
+				int pixels = quads * 4;
+				int done = convertRow(dstPtr, lookup, ySrc, uLine, vLine, nullptr, pixels, false);
+
+				for (int i = done; i < pixels; i++) {
+					const byte *L;
+
+					int16 cr_r  = Cr_r_tab[vLine[i]];
+					int16 crb_g = Cr_g_tab[vLine[i]] + Cb_g_tab[uLine[i]];
+					int16 cb_b  = Cb_b_tab[uLine[i]];
+
+					PUT_PIXEL(ySrc[i], dstPtr + i * sizeof(PixelInt));
+				}
+
+				dstPtr += pixels * sizeof(PixelInt);
+				ySrc += pixels;
+			}
+
+			dstPtr += dstPitch - yWidth * sizeof(PixelInt);
+			ySrc += yPitch - yWidth;
+			continue;
+		}
+
 		for (int x = 0; x < quarterWidth; x++) {
 			// Perform bilinear interpolation on the chroma values
 			// Based on the algorithm found here:
@@ -526,9 +628,9 @@ void YUVToRGBManager::convert410(Graphics::Surface *dst, YUVToRGBManager::Lumina
 
 	// Use a templated function to avoid an if check on every pixel
 	if (dst->format.bytesPerPixel == 2)
-		convertYUV410ToRGB<uint16>((byte *)dst->getPixels(), dst->pitch, lookup, ySrc, uSrc, vSrc, yWidth, yHeight, yPitch, uvPitch);
+		convertYUV410ToRGB<uint16>((byte *)dst->getPixels(), dst->pitch, lookup, _convertRow, ySrc, uSrc, vSrc, yWidth, yHeight, yPitch, uvPitch);
 	else
-		convertYUV410ToRGB<uint32>((byte *)dst->getPixels(), dst->pitch, lookup, ySrc, uSrc, vSrc, yWidth, yHeight, yPitch, uvPitch);
+		convertYUV410ToRGB<uint32>((byte *)dst->getPixels(), dst->pitch, lookup, _convertRow, ySrc, uSrc, vSrc, yWidth, yHeight, yPitch, uvPitch);
 }
 
 } // End of namespace Graphics
@@ -41,6 +41,8 @@
 #include "common/singleton.h"
 #include "graphics/surface.h"
 
+class YUVToRGBTestSuite;
+
 namespace Graphics {
 
 class YUVToRGBLookup;
@@ -143,6 +145,17 @@ private:
 	const YUVToRGBLookup *getLookup(Graphics::PixelFormat format, LuminanceScale scale);
 
 	YUVToRGBLookup *_lookup;
+
+	void selectConvertRow();
+
+	/**
+	 * The SIMD converter for the start of a row, or nullptr to only use the
+	 * lookup tables. It is selected on first use.
+	 */
+	bool _convertRowSelected;
+	int (*_convertRow)(byte *dst, const YUVToRGBLookup *lookup, const byte *ySrc, const byte *uSrc, const byte *vSrc, const byte *aSrc, int width, bool halfChroma);
+
+	friend class ::YUVToRGBTestSuite;
 };
  /** @} */
 } // End of namespace Graphics
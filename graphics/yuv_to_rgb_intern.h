@@ -0,0 +1,85 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+#ifndef GRAPHICS_YUV_TO_RGB_INTERN_H
+#define GRAPHICS_YUV_TO_RGB_INTERN_H
+
+#include "graphics/yuv_to_rgb.h"
+
+namespace Graphics {
+
+class YUVToRGBLookup {
+public:
+	YUVToRGBLookup(Graphics::PixelFormat format, YUVToRGBManager::LuminanceScale scale);
+
+	Graphics::PixelFormat getFormat() const { return _format; }
+	YUVToRGBManager::LuminanceScale getScale() const { return _scale; }
+	const int16 *getColorTable() const { return _colorTab; }
+	const byte *getClipTable() const { return _clipTable; }
+
+private:
+	Graphics::PixelFormat _format;
+	YUVToRGBManager::LuminanceScale _scale;
+	int16 _colorTab[4 * 256]; // 2048 bytes
+	byte _clipTable[3 * 768];
+};
+
+/**
+ * The SIMD row converters compute the values of the lookup tables instead of
+ * reading them. A chroma table entry (int16)(k * c) is obtained as
+ * ((2 * |c| * M) >> 16), with the sign of k * c applied afterwards, and the
+ * [16, 235] to [0, 255] luminance rescaling (x * 255 / 219) as
+ * ((x * 255 * kYUVScaleITU) >> 22). These constants give the same results
+ * as the tables for every possible input.
+ */
+enum {
+	kYUVCrR = 45900, // 0.419 / 0.299
+	kYUVCrG = 23386, // 0.299 / 0.419, negated
+	kYUVCbG = 11283, // 0.114 / 0.331, negated
+	kYUVCbB = 58110, // 0.587 / 0.331
+	kYUVScaleITU = 19153
+};
+
+/**
+ * The SIMD row converters convert the start of a row of YUV pixels into the
+ * format of the lookup. They return the number of pixels converted, and the
+ * caller completes the row using the lookup tables.
+ *
+ * The u and v components hold one value for each pixel, or one value for
+ * each pair of pixels if halfChroma is set. aSrc is nullptr for opaque
+ * pixels.
+ */
+typedef int (*YUVToRGBRowFunc)(byte *dst, const YUVToRGBLookup *lookup, const byte *ySrc, const byte *uSrc, const byte *vSrc, const byte *aSrc, int width, bool halfChroma);
+
+#ifdef SCUMMVM_NEON
+int convertYUVToRGBRowNEON(byte *dst, const YUVToRGBLookup *lookup, const byte *ySrc, const byte *uSrc, const byte *vSrc, const byte *aSrc, int width, bool halfChroma);
+#endif
+#ifdef SCUMMVM_SSE2
+int convertYUVToRGBRowSSE2(byte *dst, const YUVToRGBLookup *lookup, const byte *ySrc, const byte *uSrc, const byte *vSrc, const byte *aSrc, int width, bool halfChroma);
+#endif
+#ifdef SCUMMVM_AVX2
+int convertYUVToRGBRowAVX2(byte *dst, const YUVToRGBLookup *lookup, const byte *ySrc, const byte *uSrc, const byte *vSrc, const byte *aSrc, int width, bool halfChroma);
+#endif
+
+} // End of namespace Graphics
+
+#endif
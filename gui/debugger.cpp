@@ -26,6 +26,7 @@
 #include "common/debug.h"
 #include "common/debug-channels.h"
 #include "common/system.h"
+#include "common/timer.h"
 
 #ifndef DISABLE_MD5
 #include "common/md5.h"
@@ -76,6 +77,7 @@ Debugger::Debugger() {
 	registerCmd("clear",			WRAP_METHOD(Debugger, cmdClearLog));
 	registerCmd("cls",			WRAP_METHOD(Debugger, cmdClearLog)); // alias
 	registerCmd("exec",				WRAP_METHOD(Debugger, cmdExecFile));
+	registerCmd("timers",			WRAP_METHOD(Debugger, cmdTimers));
 
 	registerCmd("debuglevel",		WRAP_METHOD(Debugger, cmdDebugLevel));
 	registerCmd("debugflag_list",		WRAP_METHOD(Debugger, cmdDebugFlagsList));
@@ -842,6 +844,21 @@ bool Debugger::cmdExecFile(int argc, const char **argv) {
 	return true;
 }
 
+bool Debugger::cmdTimers(int argc, const char **argv) {
+	const Common::TimerManager::TimerStatsList timers = g_system->getTimerManager()->getTimerStats();
+	if (timers.empty()) {
+		debugPrintf("No timer statistics available\n");
+		return true;
+	}
+
+	debugPrintf("%-24s %9s %9s %7s %11s %10s %9s\n", "Timer", "Interval", "Fired", "Late", "Max late", "Callbacks", "Longest");
+	for (const auto &timer : timers) {
+		debugPrintf("%-24s %7dus %9u %7u %9uus %8ums %7ums\n", timer.id.c_str(), timer.interval, timer.fireCount,
+		            timer.lateCount, timer.maxLateness, timer.totalCallbackTime, timer.maxCallbackTime);
+	}
+	return true;
+}
+
 bool Debugger::cmdDebugFlagDisable(int argc, const char **argv) {
 	if (argc < 2) {
 		debugPrintf("debugflag_disable [<flag> | all]\n");
@@ -217,6 +217,9 @@ void SaveLoadChooserDialog::open() {
 }
 
 void SaveLoadChooserDialog::close() {
+	// Keep the metadata read for the saves shown for the next session
+	g_system->getSavefileManager()->flushSavefileMetaData();
+
 	Dialog::close();
 }
 
@@ -1102,6 +1105,7 @@ void SaveLoadChooserGrid::close() {
 
 	SaveLoadChooserDialog::close();
 	hideButtons();
+	_pendingButtons.clear();
 }
 
 int SaveLoadChooserGrid::runIntern() {
@@ -1163,63 +1167,16 @@ void SaveLoadChooserGrid::hideButtons() {
 
 void SaveLoadChooserGrid::updateSaves() {
 	hideButtons();
-
-	bool isWriteProtected = false;
+	_pendingButtons.clear();
 
 	for (uint i = _curPage * _entriesPerPage, curNum = 0; i < _saveList.size() && curNum < _entriesPerPage; ++i, ++curNum) {
-		const uint saveSlot = _saveList[i].getSaveSlot();
-
-		SaveStateDescriptor desc =  (_saveList[i].getLocked() ? _saveList[i] : _metaEngine->querySaveMetaInfos(_target.c_str(), saveSlot));
-		if (!_saveList[i].getLocked() && desc.getSaveSlot() >= 0 && !desc.getDescription().empty())
-			_saveList[i] = desc;
-		SlotButton &curButton = _buttons[curNum];
-		curButton.setVisible(true);
-		const Graphics::Surface *thumbnail = desc.getThumbnail();
-		if (thumbnail) {
-			curButton.button->setGfx(desc.getThumbnail());
-		} else {
-			curButton.button->setGfx(kThumbnailWidth, kThumbnailHeight2, 0, 0, 0);
-		}
-		curButton.description->setLabel(Common::U32String(Common::String::format("%d. ", saveSlot)) + _saveList[i].getDescription());
-
-		Common::U32String tooltip(_("Name: "));
-		tooltip += _saveList[i].getDescription();
-
-		if (_saveDateSupport) {
-			const Common::U32String &saveDate = desc.getSaveDate();
-			if (!saveDate.empty()) {
-				tooltip += Common::U32String("\n");
-				tooltip +=  _("Date: ") + saveDate;
-			}
-
-			const Common::U32String &saveTime = desc.getSaveTime();
-			if (!saveTime.empty()) {
-				tooltip += Common::U32String("\n");
-				tooltip += _("Time: ") + saveTime;
-			}
-		}
+		// Show what the save list already has, the rest of the meta
+		// information is read in handleTickle()
+		_buttons[curNum].setVisible(true);
+		updateSaveButton(curNum, _saveList[i]);
 
-		if (_playTimeSupport) {
-			const Common::U32String &playTime = desc.getPlayTime();
-			if (!playTime.empty()) {
-				tooltip += Common::U32String("\n");
-				tooltip += _("Playtime: ") + playTime;
-			}
-		}
-
-		curButton.button->setTooltip(tooltip);
-
-		// In save mode we disable the button, when it's write protected.
-		// TODO: Maybe we should not display it at all then?
-		// We also disable and description the button if slot is locked
-		isWriteProtected = desc.getWriteProtectedFlag() ||
-			_saveList[i].getWriteProtectedFlag();
-		if ((_saveMode && isWriteProtected) || desc.getLocked()) {
-			curButton.button->setEnabled(false);
-		} else {
-			curButton.button->setEnabled(true);
-		}
-		curButton.description->setEnabled(!desc.getLocked());
+		if (!_saveList[i].getLocked())
+			_pendingButtons.push_back(curNum);
 	}
 
 	const uint numPages = (_entriesPerPage != 0 && !_saveList.empty()) ? ((_saveList.size() + _entriesPerPage - 1) / _entriesPerPage) : 1;
@@ -1236,6 +1193,83 @@ void SaveLoadChooserGrid::updateSaves() {
 		_nextButton->setEnabled(false);
 }
 
+void SaveLoadChooserGrid::handleTickle() {
+	// Read the saves of the current page for a few milliseconds per tickle
+	const uint32 start = g_system->getMillis();
+	bool updated = false;
+
+	while (!_pendingButtons.empty() && g_system->getMillis() - start < 10) {
+		const uint curNum = _pendingButtons.remove_at(0);
+		const uint i = _curPage * _entriesPerPage + curNum;
+		if (curNum >= _buttons.size() || i >= _saveList.size())
+			continue;
+
+		SaveStateDescriptor desc = _metaEngine->querySaveMetaInfos(_target.c_str(), _saveList[i].getSaveSlot());
+		if (desc.getSaveSlot() >= 0 && !desc.getDescription().empty())
+			_saveList[i] = desc;
+		updateSaveButton(curNum, desc);
+		updated = true;
+	}
+
+	if (updated)
+		g_gui.scheduleTopDialogRedraw();
+
+	SaveLoadChooserDialog::handleTickle();
+}
+
+void SaveLoadChooserGrid::updateSaveButton(uint buttonIndex, const SaveStateDescriptor &desc) {
+	const uint i = _curPage * _entriesPerPage + buttonIndex;
+	const uint saveSlot = _saveList[i].getSaveSlot();
+
+	SlotButton &curButton = _buttons[buttonIndex];
+	const Graphics::Surface *thumbnail = desc.getThumbnail();
+	if (thumbnail) {
+		curButton.button->setGfx(desc.getThumbnail());
+	} else {
+		curButton.button->setGfx(kThumbnailWidth, kThumbnailHeight2, 0, 0, 0);
+	}
+	curButton.description->setLabel(Common::U32String(Common::String::format("%d. ", saveSlot)) + _saveList[i].getDescription());
+
+	Common::U32String tooltip(_("Name: "));
+	tooltip += _saveList[i].getDescription();
+
+	if (_saveDateSupport) {
+		const Common::U32String &saveDate = desc.getSaveDate();
+		if (!saveDate.empty()) {
+			tooltip += Common::U32String("\n");
+			tooltip +=  _("Date: ") + saveDate;
+		}
+
+		const Common::U32String &saveTime = desc.getSaveTime();
+		if (!saveTime.empty()) {
+			tooltip += Common::U32String("\n");
+			tooltip += _("Time: ") + saveTime;
+		}
+	}
+
+	if (_playTimeSupport) {
+		const Common::U32String &playTime = desc.getPlayTime();
+		if (!playTime.empty()) {
+			tooltip += Common::U32String("\n");
+			tooltip += _("Playtime: ") + playTime;
+		}
+	}
+
+	curButton.button->setTooltip(tooltip);
+
+	// In save mode we disable the button, when it's write protected.
+	// TODO: Maybe we should not display it at all then?
+	// We also disable and description the button if slot is locked
+	const bool isWriteProtected = desc.getWriteProtectedFlag() ||
+		_saveList[i].getWriteProtectedFlag();
+	if ((_saveMode && isWriteProtected) || desc.getLocked()) {
+		curButton.button->setEnabled(false);
+	} else {
+		curButton.button->setEnabled(true);
+	}
+	curButton.description->setEnabled(!desc.getLocked());
+}
+
 SavenameDialog::SavenameDialog()
 	: Dialog("SavenameDialog") {
 	_title = new StaticTextWidget(this, "SavenameDialog.DescriptionText", Common::String());
@@ -219,6 +219,7 @@ public:
 protected:
 	void handleCommand(CommandSender *sender, uint32 cmd, uint32 data) override;
 	void handleMouseWheel(int x, int y, int direction) override;
+	void handleTickle() override;
 	void updateSaveList(bool external) override;
 private:
 	int runIntern() override;
@@ -256,6 +257,14 @@ private:
 	void destroyButtons();
 	void hideButtons();
 	void updateSaves();
+	void updateSaveButton(uint buttonIndex, const SaveStateDescriptor &desc);
+
+	/**
+	 * Buttons of the current page whose save has not been read yet. These
+	 * are filled in from handleTickle(), so that a page is shown right away
+	 * even when reading its saves takes a while.
+	 */
+	Common::Array<uint> _pendingButtons;
 };
 
 #endif // !DISABLE_SAVELOADCHOOSER_GRID
@@ -0,0 +1,155 @@
+#include <cxxtest/TestSuite.h>
+#include "test/instrset_detect.h"
+
+#include "audio/mixbus.h"
+#include "audio/mixer.h"
+#include "audio/rate.h"
+
+#include "helper.h"
+
+class MixBusTestSuite : public CxxTest::TestSuite
+{
+	typedef void (*MixFunc)(int32 *, const Audio::st_sample_t *, uint, Audio::st_volume_t, Audio::st_volume_t);
+	typedef void (*SaturateFunc)(Audio::st_sample_t *, const int32 *, uint);
+	typedef int32 (*ConvolveFunc)(const Audio::st_sample_t *, const int16 *, uint);
+
+	static void fillSamples(Audio::st_sample_t *samples, uint count) {
+		uint32 seed = 0x12345678;
+		for (uint i = 0; i < count; ++i) {
+			seed = seed * 1103515245 + 12345;
+			samples[i] = (Audio::st_sample_t)(seed >> 16);
+		}
+		// Make sure the extremes are covered
+		samples[0] = Audio::ST_SAMPLE_MIN;
+		samples[1] = Audio::ST_SAMPLE_MAX;
+	}
+
+	void checkMix(MixFunc func, bool monoInput) {
+		// Odd sizes exercise the scalar tails of the kernels
+		const uint frames = 131;
+		Audio::st_sample_t src[frames * 2];
+		fillSamples(src, ARRAYSIZE(src));
+
+		const Audio::st_volume_t volumes[][2] = {
+			{ 0, 0 }, { 1, 255 }, { 128, 77 }, { Audio::Mixer::kMaxMixerVolume, Audio::Mixer::kMaxMixerVolume }
+		};
+
+		for (uint v = 0; v < ARRAYSIZE(volumes); ++v) {
+			int32 expected[frames * 2], actual[frames * 2];
+			for (uint i = 0; i < frames * 2; ++i)
+				expected[i] = actual[i] = (int32)i * 1000 - 100000;
+
+			if (monoInput)
+				Audio::MixBus::mixMonoToStereoGeneric(expected, src, frames, volumes[v][0], volumes[v][1]);
+			else
+				Audio::MixBus::mixStereoGeneric(expected, src, frames, volumes[v][0], volumes[v][1]);
+			func(actual, src, frames, volumes[v][0], volumes[v][1]);
+
+			TS_ASSERT_SAME_DATA(expected, actual, sizeof(expected));
+		}
+	}
+
+	void checkSaturate(SaturateFunc func) {
+		const uint numSamples = 77;
+		int32 bus[numSamples];
+		for (uint i = 0; i < numSamples; ++i)
+			bus[i] = ((int32)i - 38) * 1500;
+
+		Audio::st_sample_t expected[numSamples], actual[numSamples];
+		Audio::MixBus::saturateGeneric(expected, bus, numSamples);
+		func(actual, bus, numSamples);
+
+		TS_ASSERT_SAME_DATA(expected, actual, sizeof(expected));
+	}
+
+	void checkConvolve(ConvolveFunc func) {
+		Audio::st_sample_t samples[128];
+		int16 coeffs[128];
+		fillSamples(samples, ARRAYSIZE(samples));
+		for (uint i = 0; i < ARRAYSIZE(coeffs); ++i)
+			coeffs[i] = (int16)((int)(i * 2654435761U >> 23) - 256);
+
+		for (uint count = 8; count <= ARRAYSIZE(samples); count += 8) {
+			TS_ASSERT_EQUALS(func(samples, coeffs, count), Audio::MixBus::convolveGeneric(samples, coeffs, count));
+		}
+	}
+
+	void checkKernels(MixFunc mixStereo, MixFunc mixMonoToStereo, SaturateFunc saturate, ConvolveFunc convolve) {
+		checkMix(mixStereo, false);
+		checkMix(mixMonoToStereo, true);
+		checkSaturate(saturate);
+		checkConvolve(convolve);
+	}
+
+	public:
+	void test_saturate_generic() {
+		const int32 bus[] = { -100000, Audio::ST_SAMPLE_MIN - 1, Audio::ST_SAMPLE_MIN, -1, 0, 1, Audio::ST_SAMPLE_MAX, Audio::ST_SAMPLE_MAX + 1, 100000 };
+		const Audio::st_sample_t expected[] = { Audio::ST_SAMPLE_MIN, Audio::ST_SAMPLE_MIN, Audio::ST_SAMPLE_MIN, -1, 0, 1, Audio::ST_SAMPLE_MAX, Audio::ST_SAMPLE_MAX, Audio::ST_SAMPLE_MAX };
+		Audio::st_sample_t actual[ARRAYSIZE(bus)];
+
+		Audio::MixBus::saturateGeneric(actual, bus, ARRAYSIZE(bus));
+		TS_ASSERT_SAME_DATA(expected, actual, sizeof(expected));
+	}
+
+	void test_kernels_match_generic() {
+#ifdef SCUMMVM_NEON
+		checkKernels(Audio::MixBus::mixStereoNEON, Audio::MixBus::mixMonoToStereoNEON, Audio::MixBus::saturateNEON, Audio::MixBus::convolveNEON);
+#endif
+#ifdef SCUMMVM_SSE2
+		if (instrset_detect() >= 2)
+			checkKernels(Audio::MixBus::mixStereoSSE2, Audio::MixBus::mixMonoToStereoSSE2, Audio::MixBus::saturateSSE2, Audio::MixBus::convolveSSE2);
+#endif
+#ifdef SCUMMVM_AVX2
+		if (instrset_detect() >= 8)
+			checkKernels(Audio::MixBus::mixStereoAVX2, Audio::MixBus::mixMonoToStereoAVX2, Audio::MixBus::saturateAVX2, Audio::MixBus::convolveAVX2);
+#endif
+	}
+
+	void test_bus_matches_clamped_output() {
+		// Pick the kernels without going through OSystem::hasFeature()
+		Audio::MixBus::Funcs funcs = { Audio::MixBus::mixStereoGeneric, Audio::MixBus::mixMonoToStereoGeneric, Audio::MixBus::saturateGeneric, Audio::MixBus::convolveGeneric };
+#ifdef SCUMMVM_NEON
+		funcs.mixStereo = Audio::MixBus::mixStereoNEON;
+		funcs.mixMonoToStereo = Audio::MixBus::mixMonoToStereoNEON;
+		funcs.saturate = Audio::MixBus::saturateNEON;
+#endif
+#ifdef SCUMMVM_SSE2
+		if (instrset_detect() >= 2) {
+			funcs.mixStereo = Audio::MixBus::mixStereoSSE2;
+			funcs.mixMonoToStereo = Audio::MixBus::mixMonoToStereoSSE2;
+			funcs.saturate = Audio::MixBus::saturateSSE2;
+		}
+#endif
+		Audio::MixBus::_funcs = funcs;
+
+		// As long as nothing clips, converting into the 32-bit bus and
+		// saturating afterwards yields the same output as the 16-bit path
+		const int rates[][2] = { { 22050, 22050 }, { 44100, 22050 }, { 11025, 48000 } };
+
+		for (int stereo = 0; stereo < 2; ++stereo) {
+			for (uint r = 0; r < ARRAYSIZE(rates); ++r) {
+				Audio::SeekableAudioStream *s1 = createSineStream<int16>(rates[r][0], 1, nullptr, false, stereo);
+				Audio::SeekableAudioStream *s2 = createSineStream<int16>(rates[r][0], 1, nullptr, false, stereo);
+				Audio::RateConverter *c1 = Audio::makeRateConverter(rates[r][0], rates[r][1], stereo, true, false);
+				Audio::RateConverter *c2 = Audio::makeRateConverter(rates[r][0], rates[r][1], stereo, true, false);
+
+				const uint frames = 1000;
+				Audio::st_sample_t expected[frames * 2], actual[frames * 2];
+				int32 bus[frames * 2];
+				memset(expected, 0, sizeof(expected));
+				memset(bus, 0, sizeof(bus));
+
+				TS_ASSERT_EQUALS(c1->convert(*s1, expected, frames, 200, 100), (int)frames);
+				TS_ASSERT_EQUALS(c2->convert(*s2, bus, frames, 200, 100), (int)frames);
+				Audio::MixBus::saturate(actual, bus, frames * 2);
+
+				TS_ASSERT_SAME_DATA(expected, actual, sizeof(expected));
+
+				delete c1;
+				delete c2;
+				delete s1;
+				delete s2;
+			}
+		}
+	}
+};
@@ -0,0 +1,153 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/array.h"
+#include "common/debug.h"
+
+#include "audio/softsynth/opl/nuked.h"
+
+#include "../system/benchmark.h"
+
+class NukedOplTestSuite : public CxxTest::TestSuite
+{
+#ifndef DISABLE_NUKED_OPL
+	enum {
+		kChipRate = 49716,
+		kTickSamples = 497
+	};
+
+	// A register write, after a delay in samples, like in a DRO capture
+	struct RegisterWrite {
+		uint32 delay;
+		uint16 reg;
+		uint8 val;
+	};
+
+	typedef Common::Array<RegisterWrite> RegisterLog;
+
+	static uint32 nextRandom(uint32 &seed) {
+		seed = seed * 1103515245 + 12345;
+		return seed >> 16;
+	}
+
+	static void addWrite(RegisterLog &log, uint32 delay, uint16 reg, uint8 val) {
+		RegisterWrite write;
+		write.delay = delay;
+		write.reg = reg;
+		write.val = val;
+		log.push_back(write);
+	}
+
+	// Builds the register log of a song with random instruments and notes.
+	// The OPL2 one switches rhythm mode on and off, the OPL3 one uses all
+	// the channels and some 4 operator ones.
+	static void buildSong(RegisterLog &log, bool opl3, uint32 seconds) {
+		static const uint8 opOffsets[9] = { 0, 1, 2, 8, 9, 10, 16, 17, 18 };
+		uint32 seed = opl3 ? 0x0dd0b1e5 : 0x5eed0b1e;
+		const int channels = opl3 ? 18 : 9;
+
+		if (opl3) {
+			addWrite(log, 0, 0x105, 0x01);
+			addWrite(log, 0, 0x104, 0x09);
+		}
+		addWrite(log, 0, 0x01, 0x20);
+
+		for (int ch = 0; ch < channels; ch++) {
+			uint16 base = ch >= 9 ? 0x100 : 0;
+			for (int op = 0; op < 2; op++) {
+				uint16 slot = base + opOffsets[ch % 9] + op * 3;
+				addWrite(log, 0, 0x20 + slot, nextRandom(seed));
+				addWrite(log, 0, 0x40 + slot, nextRandom(seed) & 0xdf);
+				addWrite(log, 0, 0x60 + slot, nextRandom(seed) | 0x11);
+				addWrite(log, 0, 0x80 + slot, nextRandom(seed));
+				addWrite(log, 0, 0xe0 + slot, nextRandom(seed) & 7);
+			}
+			addWrite(log, 0, 0xc0 + base + ch % 9, (nextRandom(seed) & 0x0f) | 0x30);
+		}
+
+		uint8 keyOn[18] = {};
+		uint32 delay = 0;
+		for (uint32 tick = 0; tick < seconds * 100; tick++) {
+			delay += kTickSamples;
+			if (nextRandom(seed) % 4)
+				continue;
+
+			int ch = nextRandom(seed) % channels;
+			uint16 base = ch >= 9 ? 0x100 : 0;
+			uint16 fnum = 0x100 + nextRandom(seed) % 0x200;
+			uint8 block = 2 + nextRandom(seed) % 4;
+			keyOn[ch] ^= 1;
+			addWrite(log, delay, 0xa0 + base + ch % 9, fnum & 0xff);
+			addWrite(log, 0, 0xb0 + base + ch % 9, (keyOn[ch] << 5) | (block << 2) | (fnum >> 8));
+			delay = 0;
+
+			if (!opl3 && tick % 200 == 100)
+				addWrite(log, 0, 0xbd, nextRandom(seed));
+		}
+		addWrite(log, delay, 0x01, 0x20);
+	}
+
+	// Plays the log at the rate of the chip, and returns the number of
+	// samples and a hash of them
+	static uint32 replay(const RegisterLog &log, uint32 &hash) {
+		OPL::NUKED::opl3_chip *chip = new OPL::NUKED::opl3_chip();
+		OPL::NUKED::OPL3_Reset(chip, kChipRate);
+
+		int16 buffer[1024 * 2];
+		uint32 samples = 0;
+		hash = 2166136261u;
+		for (uint i = 0; i < log.size(); i++) {
+			uint32 delay = log[i].delay;
+			while (delay) {
+				uint32 length = MIN<uint32>(delay, 1024);
+				OPL::NUKED::OPL3_GenerateStream(chip, buffer, length);
+				for (uint32 j = 0; j < length * 2; j++)
+					hash = (hash ^ (uint16)buffer[j]) * 16777619u;
+				delay -= length;
+				samples += length;
+			}
+			OPL::NUKED::OPL3_WriteRegBuffered(chip, log[i].reg, log[i].val);
+		}
+
+		delete chip;
+		return samples;
+	}
+#endif
+
+public:
+	void test_output() {
+#ifndef DISABLE_NUKED_OPL
+		// The hashes of the output of the emulator before the slots which
+		// are off or sustained were special cased
+		RegisterLog opl2Log, opl3Log;
+		buildSong(opl2Log, false, 5);
+		buildSong(opl3Log, true, 5);
+
+		uint32 hash;
+		TS_ASSERT_EQUALS(replay(opl2Log, hash), 5u * 100 * kTickSamples);
+		TS_ASSERT_EQUALS(hash, 0x276088ddu);
+		TS_ASSERT_EQUALS(replay(opl3Log, hash), 5u * 100 * kTickSamples);
+		TS_ASSERT_EQUALS(hash, 0x124db378u);
+#endif
+	}
+
+	void test_replay_speed() {
+#if BENCHMARK_TESTS && !defined(DISABLE_NUKED_OPL)
+		Common::install_null_g_system();
+
+		const int seconds = 60;
+
+		for (int opl3 = 0; opl3 < 2; opl3++) {
+			RegisterLog log;
+			buildSong(log, opl3, seconds);
+
+			uint32 hash;
+			Common::BenchmarkTimer timer;
+			uint32 samples = replay(log, hash);
+			const uint32 time = timer.elapsed();
+
+			debug("Nuked OPL replay of %s log: %u samples in %u ms (%f emulated seconds per second)",
+			      opl3 ? "an OPL3" : "an OPL2", samples, time, samples * 1000.0 / kChipRate / time);
+		}
+#endif
+	}
+};
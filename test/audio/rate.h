@@ -0,0 +1,183 @@
+#include <cxxtest/TestSuite.h>
+#include "test/instrset_detect.h"
+
+#include "audio/decoders/raw.h"
+#include "audio/mixbus.h"
+#include "audio/mixer.h"
+#include "audio/rate.h"
+
+#include "common/endian.h"
+#include "common/stream.h"
+#include "common/system.h"
+#include "common/textconsole.h"
+
+#include "../system/benchmark.h"
+
+#include <math.h>
+
+class RateConverterTestSuite : public CxxTest::TestSuite
+{
+	enum {
+		kAmplitude = 16000
+	};
+
+	// Pick the kernels without going through OSystem::hasFeature()
+	static void selectKernels() {
+		Audio::MixBus::Funcs funcs = { Audio::MixBus::mixStereoGeneric, Audio::MixBus::mixMonoToStereoGeneric, Audio::MixBus::saturateGeneric, Audio::MixBus::convolveGeneric };
+#ifdef SCUMMVM_NEON
+		funcs.mixStereo = Audio::MixBus::mixStereoNEON;
+		funcs.mixMonoToStereo = Audio::MixBus::mixMonoToStereoNEON;
+		funcs.saturate = Audio::MixBus::saturateNEON;
+		funcs.convolve = Audio::MixBus::convolveNEON;
+#endif
+#ifdef SCUMMVM_SSE2
+		if (instrset_detect() >= 2) {
+			funcs.mixStereo = Audio::MixBus::mixStereoSSE2;
+			funcs.mixMonoToStereo = Audio::MixBus::mixMonoToStereoSSE2;
+			funcs.saturate = Audio::MixBus::saturateSSE2;
+			funcs.convolve = Audio::MixBus::convolveSSE2;
+		}
+#endif
+#ifdef SCUMMVM_AVX2
+		if (instrset_detect() >= 8) {
+			funcs.mixStereo = Audio::MixBus::mixStereoAVX2;
+			funcs.mixMonoToStereo = Audio::MixBus::mixMonoToStereoAVX2;
+			funcs.saturate = Audio::MixBus::saturateAVX2;
+			funcs.convolve = Audio::MixBus::convolveAVX2;
+		}
+#endif
+		Audio::MixBus::_funcs = funcs;
+	}
+
+	static Audio::AudioStream *createToneStream(int rate, int frequency, int frames, bool stereo) {
+		const int channels = stereo ? 2 : 1;
+		int16 *data = (int16 *)malloc(frames * channels * sizeof(int16));
+		for (int i = 0; i < frames; ++i) {
+			const int16 sample = (int16)(sin(2 * M_PI * frequency * i / rate) * kAmplitude);
+			for (int c = 0; c < channels; ++c)
+				WRITE_LE_INT16(&data[i * channels + c], sample);
+		}
+
+		Common::SeekableReadStream *stream = new Common::MemoryReadStream((const byte *)data, frames * channels * sizeof(int16), DisposeAfterUse::YES);
+		return Audio::makeRawStream(stream, rate, Audio::FLAG_16BITS | Audio::FLAG_LITTLE_ENDIAN | (stereo ? Audio::FLAG_STEREO : 0));
+	}
+
+	public:
+	void test_sinc_tracks_sine() {
+		selectKernels();
+
+		const int rates[][2] = { { 11025, 48000 }, { 22050, 44100 }, { 44100, 48000 }, { 48000, 22050 } };
+		const int frequency = 1000;
+		const uint frames = 2000;
+
+		for (int stereo = 0; stereo < 2; ++stereo) {
+			for (uint r = 0; r < ARRAYSIZE(rates); ++r) {
+				Audio::AudioStream *stream = createToneStream(rates[r][0], frequency, rates[r][0], stereo);
+				Audio::RateConverter *converter = Audio::makeRateConverter(rates[r][0], rates[r][1], stereo, true, false, Audio::kRateConverterSinc);
+
+				Audio::st_sample_t output[frames * 2];
+				memset(output, 0, sizeof(output));
+				TS_ASSERT_EQUALS(converter->convert(*stream, output, frames, Audio::Mixer::kMaxMixerVolume, Audio::Mixer::kMaxMixerVolume), (int)frames);
+
+				// Output sample 0 is centered on input sample 0, so the result
+				// should follow the tone once the filter is fully primed
+				int maxError = 0;
+				for (uint i = 64; i < frames; ++i) {
+					const int expected = (int)(sin(2 * M_PI * frequency * i / rates[r][1]) * kAmplitude);
+					maxError = MAX(maxError, ABS(output[i * 2] - expected));
+					maxError = MAX(maxError, ABS(output[i * 2 + 1] - expected));
+				}
+				TS_ASSERT_LESS_THAN(maxError, kAmplitude / 100);
+
+				delete converter;
+				delete stream;
+			}
+		}
+	}
+
+	void test_sinc_drains_stream() {
+		selectKernels();
+
+		const int rates[][2] = { { 11025, 48000 }, { 44100, 48000 }, { 48000, 22050 } };
+
+		for (uint r = 0; r < ARRAYSIZE(rates); ++r) {
+			const int inFrames = 5000;
+			Audio::AudioStream *stream = createToneStream(rates[r][0], 440, inFrames, false);
+			Audio::RateConverter *converter = Audio::makeRateConverter(rates[r][0], rates[r][1], false, true, false, Audio::kRateConverterSinc);
+
+			// Convert in small pieces, the way the mixer does
+			int32 bus[256 * 2];
+			int total = 0;
+			while (!stream->endOfData() || converter->needsDraining()) {
+				const int written = converter->convert(*stream, bus, 256, Audio::Mixer::kMaxMixerVolume, Audio::Mixer::kMaxMixerVolume);
+				total += written;
+				if (written < 256)
+					break;
+			}
+
+			// Every input sample has been output, without trailing silence
+			const int expected = (int)(((int64)inFrames * rates[r][1] + rates[r][0] - 1) / rates[r][0]);
+			TS_ASSERT_EQUALS(total, expected);
+			TS_ASSERT(!converter->needsDraining());
+
+			delete converter;
+			delete stream;
+		}
+	}
+
+	void test_sinc_rate_change() {
+		selectKernels();
+
+		Audio::AudioStream *stream = createToneStream(22050, 440, 22050, true);
+		Audio::RateConverter *converter = Audio::makeRateConverter(22050, 44100, true, true, false, Audio::kRateConverterSinc);
+
+		int32 bus[512 * 2];
+		const Audio::st_rate_t rates[] = { 22050, 11025, 30000, 88200, 22050 };
+		for (uint r = 0; r < ARRAYSIZE(rates); ++r) {
+			converter->setInputRate(rates[r]);
+			TS_ASSERT_EQUALS(converter->getInputRate(), rates[r]);
+			memset(bus, 0, sizeof(bus));
+			TS_ASSERT_EQUALS(converter->convert(*stream, bus, 512, Audio::Mixer::kMaxMixerVolume, Audio::Mixer::kMaxMixerVolume), 512);
+			for (uint i = 0; i < ARRAYSIZE(bus); ++i)
+				TS_ASSERT_LESS_THAN_EQUALS(ABS(bus[i]), (int32)kAmplitude + kAmplitude / 50);
+		}
+
+		delete converter;
+		delete stream;
+	}
+
+	void test_sinc_speed() {
+#if BENCHMARK_TESTS
+		Common::install_null_g_system();
+		selectKernels();
+
+		const int seconds = 60;
+		const int rates[][2] = { { 11025, 48000 }, { 22050, 44100 }, { 44100, 48000 } };
+		const Audio::RateConverterType types[] = { Audio::kRateConverterDefault, Audio::kRateConverterSinc };
+		const char *const typeNames[] = { "default", "sinc" };
+
+		for (uint r = 0; r < ARRAYSIZE(rates); ++r) {
+			for (uint t = 0; t < ARRAYSIZE(types); ++t) {
+				Audio::AudioStream *stream = createToneStream(rates[r][0], 440, rates[r][0] * seconds, true);
+				Audio::RateConverter *converter = Audio::makeRateConverter(rates[r][0], rates[r][1], true, true, false, types[t]);
+
+				int32 bus[1024 * 2];
+				uint32 total = 0;
+				Common::BenchmarkTimer timer;
+				int written;
+				do {
+					written = converter->convert(*stream, bus, 1024, Audio::Mixer::kMaxMixerVolume, Audio::Mixer::kMaxMixerVolume);
+					total += written;
+				} while (written == 1024);
+				const uint32 time = timer.elapsed();
+
+				debug("Rate converter %s %d -> %d: %u sample pairs in %u ms (%f sample pairs per second)",
+				      typeNames[t], rates[r][0], rates[r][1], total, time, total * 1000.0 / time);
+
+				delete converter;
+				delete stream;
+			}
+		}
+#endif
+	}
+};
@@ -0,0 +1,242 @@
+#include <cxxtest/TestSuite.h>
+
+#include "audio/chip.h"
+#include "audio/mixer.h"
+#include "audio/renderahead.h"
+
+#include "backends/timer/default/default-timer.h"
+
+#include "common/config-manager.h"
+#include "common/system.h"
+
+#include "../system/null_osystem.h"
+
+// Renders a ramp, offset by the last value written to it, with a timer
+// callback every 48 frames
+class RampRenderer : public Audio::RenderAhead::Renderer {
+public:
+	RampRenderer() : _position(0), _offset(0), _untilCallback(48), _callbacks(0) {}
+
+	int renderFrames(int16 *buffer, int frames) override {
+		frames = MIN(frames, _untilCallback);
+		for (int i = 0; i < frames; i++) {
+			buffer[i * 2] = (int16)(_position + _offset);
+			buffer[i * 2 + 1] = (int16)-(_position + _offset);
+			_position++;
+		}
+
+		_untilCallback -= frames;
+		return frames;
+	}
+
+	bool isCallbackDue() const override {
+		return _untilCallback == 0;
+	}
+
+	void runCallback() override {
+		_callbacks++;
+		_untilCallback = 48;
+	}
+
+	void applyQueuedWrite(int type, int address, int value) override {
+		_offset = value;
+	}
+
+	int _position;
+	int _offset;
+	int _untilCallback;
+	int _callbacks;
+};
+
+// An emulated chip rendering a ramp, offset by the last value written to it
+class RampChip : public Audio::EmulatedChip {
+public:
+	RampChip() : _position(0), _offset(0) {}
+
+	void write(int value) {
+		if (!queueWrite(0, 0, value))
+			_offset = value;
+	}
+
+	bool isStereo() const override { return true; }
+
+protected:
+	void generateSamples(int16 *buffer, int numSamples) override {
+		for (int i = 0; i < numSamples; i += 2) {
+			buffer[i] = (int16)(_position + _offset);
+			buffer[i + 1] = (int16)-(_position + _offset);
+			_position++;
+		}
+	}
+
+	bool supportsRenderAhead() const override { return true; }
+
+	void applyQueuedWrite(int type, int address, int value) override {
+		_offset = value;
+	}
+
+private:
+	int _position;
+	int _offset;
+};
+
+// Writes to a chip from its timer callback with the mixer mutex held, like
+// many drivers do
+class RampDriver {
+public:
+	RampDriver(RampChip *chip) : _chip(chip), _ticks(0) {
+		_chip->start(new Common::Functor0Mem<void, RampDriver>(this, &RampDriver::onTimer), 250);
+	}
+
+	void onTimer() {
+		Common::StackLock lock(g_system->getMixer()->mutex());
+		_ticks++;
+		_chip->write(_ticks * 1000);
+	}
+
+	RampChip *_chip;
+	int _ticks;
+};
+
+class RenderAheadTestSuite : public CxxTest::TestSuite {
+public:
+	void checkRamp(const int16 *buffer, int frames, int start, int offset) {
+		for (int i = 0; i < frames; i++) {
+			TS_ASSERT_EQUALS(buffer[i * 2], (int16)(start + i + offset));
+			TS_ASSERT_EQUALS(buffer[i * 2 + 1], (int16)-(start + i + offset));
+		}
+	}
+
+	void test_read_without_rendering_ahead() {
+		Common::install_null_g_system();
+
+		RampRenderer renderer;
+		Audio::RenderAhead renderAhead(&renderer, true, 64);
+
+		int16 buffer[100 * 2];
+		renderAhead.read(buffer, 100 * 2);
+		checkRamp(buffer, 100, 0, 0);
+		TS_ASSERT_EQUALS(renderAhead.getUnderruns(), 1u);
+	}
+
+	void test_read_rendered_ahead() {
+		Common::install_null_g_system();
+
+		RampRenderer renderer;
+		Audio::RenderAhead renderAhead(&renderer, true, 64);
+		renderAhead.start();
+
+		// Wrap around the ring buffer several times, with reads of
+		// different sizes
+		int16 buffer[100 * 2];
+		int position = 0;
+		for (int i = 0; i < 20; i++) {
+			Audio::RenderAhead::fill(&renderAhead);
+			int frames = 1 + (i * 37) % 64;
+			renderAhead.read(buffer, frames * 2);
+			checkRamp(buffer, frames, position, 0);
+			position += frames;
+		}
+		TS_ASSERT_EQUALS(renderAhead.getUnderruns(), 0u);
+
+		// Reading more than was rendered renders the rest right away
+		Audio::RenderAhead::fill(&renderAhead);
+		renderAhead.read(buffer, 100 * 2);
+		checkRamp(buffer, 100, position, 0);
+		TS_ASSERT_EQUALS(renderAhead.getUnderruns(), 1u);
+
+		// The callbacks ran wherever the synth was rendered
+		TS_ASSERT_EQUALS(renderer._callbacks, (position + 100) / 48);
+
+		// Nothing is rendered ahead once stopped
+		renderAhead.stop();
+		Audio::RenderAhead::fill(&renderAhead);
+		TS_ASSERT_EQUALS(renderer._position, position + 100);
+	}
+
+	void test_queued_writes() {
+		Common::install_null_g_system();
+
+		RampRenderer renderer;
+		Audio::RenderAhead renderAhead(&renderer, true, 64);
+		renderAhead.start();
+
+		// The writes are applied after the samples already rendered
+		int16 buffer[64 * 2];
+		Audio::RenderAhead::fill(&renderAhead);
+		renderAhead.queueWrite(0, 0, 1000);
+		renderAhead.queueWrite(0, 0, 2000);
+		TS_ASSERT_EQUALS(renderer._offset, 0);
+
+		renderAhead.read(buffer, 32 * 2);
+		checkRamp(buffer, 32, 0, 0);
+		Audio::RenderAhead::fill(&renderAhead);
+		TS_ASSERT_EQUALS(renderer._offset, 2000);
+		renderAhead.read(buffer, 64 * 2);
+		checkRamp(buffer, 32, 32, 0);
+		checkRamp(buffer + 32 * 2, 32, 64, 2000);
+	}
+
+	void test_pending_writes_are_applied() {
+		Common::install_null_g_system();
+
+		RampRenderer renderer;
+		{
+			Audio::RenderAhead renderAhead(&renderer, true, 64);
+			renderAhead.queueWrite(0, 0, 3000);
+		}
+		TS_ASSERT_EQUALS(renderer._offset, 3000);
+	}
+
+	static bool hasRenderAheadTimer() {
+		Common::TimerManager::TimerStatsList stats = g_system->getTimerManager()->getTimerStats();
+		for (uint i = 0; i < stats.size(); i++) {
+			if (stats[i].id == "RenderAhead")
+				return true;
+		}
+		return false;
+	}
+
+	void test_emulated_chip() {
+		Common::install_null_g_system();
+		DefaultTimerManager *timerManager = (DefaultTimerManager *)g_system->getTimerManager();
+		Common::Mutex &mixerMutex = g_system->getMixer()->mutex();
+
+		RampChip *chip = new RampChip();
+		RampDriver driver(chip);
+
+		ConfMan.setInt("emulated_chip_render_ahead", 20, Common::ConfigManager::kTransientDomain);
+		RampChip *aheadChip = new RampChip();
+		RampDriver aheadDriver(aheadChip);
+		ConfMan.removeKey("emulated_chip_render_ahead", Common::ConfigManager::kTransientDomain);
+		TS_ASSERT(hasRenderAheadTimer());
+
+		// The output is the same with the timer rendering ahead, since the
+		// writes of the callbacks are applied where they happened
+		int16 buffer[300 * 2], aheadBuffer[300 * 2];
+		for (int i = 0; i < 10; i++) {
+			g_system->delayMillis(11);
+			timerManager->handler();
+
+			Common::StackLock lock(mixerMutex);
+			chip->readBuffer(buffer, 300 * 2);
+			aheadChip->readBuffer(aheadBuffer, 300 * 2);
+			TS_ASSERT_SAME_DATA(buffer, aheadBuffer, sizeof(buffer));
+		}
+		TS_ASSERT_LESS_THAN(0, driver._ticks);
+		TS_ASSERT_LESS_THAN_EQUALS(driver._ticks, aheadDriver._ticks);
+
+		// Drivers may stop the chip with the mixer mutex held, so the timer
+		// is removed by the timer thread
+		{
+			Common::StackLock lock(mixerMutex);
+			delete aheadChip;
+		}
+		TS_ASSERT(hasRenderAheadTimer());
+		g_system->delayMillis(11);
+		timerManager->handler();
+		TS_ASSERT(!hasRenderAheadTimer());
+
+		delete chip;
+	}
+};
@@ -0,0 +1,150 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/fs.h"
+#include "common/savefile.h"
+#include "common/system.h"
+
+#include "backends/saves/default/default-saves.h"
+
+#include "../system/null_osystem.h"
+
+class DefaultSaveFileManagerTestSuite : public CxxTest::TestSuite {
+	// The files are written to the working directory of the tests, and
+	// removed again once the test is done. This includes the metadata index.
+	static void removeFiles(Common::SaveFileManager *saveFileMan) {
+		Common::StringArray lockedFiles;
+		saveFileMan->updateSavefilesList(lockedFiles);
+
+		Common::StringArray files = saveFileMan->listSavefiles("*default-saves-test.*");
+		for (const auto &file : files)
+			saveFileMan->removeSavefile(file);
+	}
+
+	static void writeFile(Common::SaveFileManager *saveFileMan, const char *name, uint32 size) {
+		Common::OutSaveFile *saveFile = saveFileMan->openForSaving(name, false);
+		TS_ASSERT(saveFile);
+		if (!saveFile)
+			return;
+
+		for (uint32 i = 0; i < size; i++)
+			saveFile->writeByte(i);
+		saveFile->finalize();
+		delete saveFile;
+	}
+
+	static void checkMetaData(Common::SaveFileManager *saveFileMan, const char *name, const byte *data, uint32 size) {
+		Common::SeekableReadStream *stream = saveFileMan->openSavefileMetaData("default-saves-test", name);
+		TS_ASSERT(stream);
+		if (!stream)
+			return;
+
+		TS_ASSERT_EQUALS(stream->size(), (int64)size);
+		byte buffer[16];
+		TS_ASSERT_EQUALS(stream->read(buffer, sizeof(buffer)), size);
+		TS_ASSERT_SAME_DATA(buffer, data, size);
+		delete stream;
+	}
+
+	DefaultSaveFileManager *_saveFileMan;
+
+public:
+	void setUp() {
+		Common::install_null_g_system();
+		// The cloud sync code reaches the save file manager through g_system
+		_saveFileMan = new DefaultSaveFileManager(Common::Path("."));
+		Common::set_null_g_system_savefile_manager(_saveFileMan);
+		removeFiles(_saveFileMan);
+	}
+
+	void tearDown() {
+		removeFiles(_saveFileMan);
+		_saveFileMan->flushSavefileMetaData();
+	}
+
+	void test_savefile_revision() {
+		writeFile(_saveFileMan, "default-saves-test.001", 10);
+		writeFile(_saveFileMan, "default-saves-test.002", 10);
+		uint32 revision = _saveFileMan->getSavefileRevision("default-saves-test.001");
+		TS_ASSERT_DIFFERS(revision, 0u);
+		TS_ASSERT_EQUALS(_saveFileMan->getSavefileRevision("default-saves-test.001"), revision);
+
+		// Writing a file only changes its own revision
+		uint32 otherRevision = _saveFileMan->getSavefileRevision("default-saves-test.002");
+		writeFile(_saveFileMan, "default-saves-test.001", 10);
+		uint32 newRevision = _saveFileMan->getSavefileRevision("default-saves-test.001");
+		TS_ASSERT_DIFFERS(newRevision, revision);
+		TS_ASSERT_EQUALS(_saveFileMan->getSavefileRevision("default-saves-test.002"), otherRevision);
+		revision = newRevision;
+
+		// So does changing it behind the back of the manager, as long as
+		// its size or modification time show it
+		Common::FSNode node = Common::FSNode(Common::Path(".")).getChild("default-saves-test.001");
+		Common::SeekableWriteStream *stream = node.createWriteStream(false);
+		TS_ASSERT(stream);
+		if (stream) {
+			stream->writeUint32LE(0);
+			delete stream;
+		}
+		newRevision = _saveFileMan->getSavefileRevision("default-saves-test.001");
+		TS_ASSERT_DIFFERS(newRevision, revision);
+		TS_ASSERT_EQUALS(_saveFileMan->getSavefileRevision("default-saves-test.001"), newRevision);
+		revision = newRevision;
+
+		TS_ASSERT(_saveFileMan->removeSavefile("default-saves-test.001"));
+		TS_ASSERT_DIFFERS(_saveFileMan->getSavefileRevision("default-saves-test.001"), revision);
+
+#ifndef USE_CLOUD
+		// Locked files are not to be cached. With the cloud, the files being
+		// synced replace the locked ones each time the directory is checked.
+		Common::StringArray lockedFiles;
+		lockedFiles.push_back("default-saves-test.002");
+		_saveFileMan->updateSavefilesList(lockedFiles);
+		TS_ASSERT_EQUALS(_saveFileMan->getSavefileRevision("default-saves-test.002"), 0u);
+#endif
+	}
+
+	void test_savefile_metadata() {
+		const byte data1[] = { 1, 2, 3 };
+		const byte data2[] = { 4, 5 };
+
+		writeFile(_saveFileMan, "default-saves-test.001", 10);
+		writeFile(_saveFileMan, "default-saves-test.002", 10);
+		writeFile(_saveFileMan, "default-saves-test.003", 10);
+		TS_ASSERT(!_saveFileMan->openSavefileMetaData("default-saves-test", "default-saves-test.001"));
+
+		_saveFileMan->storeSavefileMetaData("default-saves-test", "default-saves-test.001", data1, sizeof(data1));
+		_saveFileMan->storeSavefileMetaData("default-saves-test", "default-saves-test.002", data2, sizeof(data2));
+		_saveFileMan->storeSavefileMetaData("default-saves-test", "default-saves-test.003", data2, sizeof(data2));
+		checkMetaData(_saveFileMan, "default-saves-test.001", data1, sizeof(data1));
+		_saveFileMan->flushSavefileMetaData();
+		checkMetaData(_saveFileMan, "default-saves-test.002", data2, sizeof(data2));
+
+		// Another manager reads the data from the index written by the first
+		DefaultSaveFileManager saveFileMan(Common::Path("."));
+		checkMetaData(&saveFileMan, "default-saves-test.001", data1, sizeof(data1));
+		checkMetaData(&saveFileMan, "default-saves-test.002", data2, sizeof(data2));
+		TS_ASSERT(!saveFileMan.openSavefileMetaData("other-index", "default-saves-test.001"));
+
+		// Saving or removing a file drops its data, and so does changing it
+		// behind the back of the manager
+		writeFile(&saveFileMan, "default-saves-test.001", 10);
+		TS_ASSERT(!saveFileMan.openSavefileMetaData("default-saves-test", "default-saves-test.001"));
+		TS_ASSERT(saveFileMan.removeSavefile("default-saves-test.002"));
+		TS_ASSERT(!saveFileMan.openSavefileMetaData("default-saves-test", "default-saves-test.002"));
+
+		Common::FSNode node = Common::FSNode(Common::Path(".")).getChild("default-saves-test.003");
+		Common::SeekableWriteStream *stream = node.createWriteStream(false);
+		TS_ASSERT(stream);
+		if (stream) {
+			stream->writeUint32LE(0);
+			delete stream;
+		}
+		TS_ASSERT(!saveFileMan.openSavefileMetaData("default-saves-test", "default-saves-test.003"));
+
+		// The index is removed once no data is left in it
+		const Common::Path index(".default-saves-test.metadata");
+		TS_ASSERT(Common::FSNode(index).exists());
+		saveFileMan.flushSavefileMetaData();
+		TS_ASSERT(!Common::FSNode(index).exists());
+	}
+};
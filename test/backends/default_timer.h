@@ -0,0 +1,194 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/array.h"
+#include "common/system.h"
+
+#include "backends/timer/default/default-timer.h"
+
+#include "../system/null_osystem.h"
+
+class DefaultTimerTestSuite : public CxxTest::TestSuite {
+	// The timers record which of them fired, and may act on the manager
+	struct TimerLog {
+		DefaultTimerManager *manager;
+		Common::Array<int> events;
+		int delay;
+
+		TimerLog(DefaultTimerManager *m) : manager(m), delay(0) {}
+	};
+
+	static void timerA(void *refCon) { ((TimerLog *)refCon)->events.push_back(0); }
+	static void timerB(void *refCon) { ((TimerLog *)refCon)->events.push_back(1); }
+	static void timerC(void *refCon) { ((TimerLog *)refCon)->events.push_back(2); }
+
+	static void slowTimer(void *refCon) {
+		TimerLog *log = (TimerLog *)refCon;
+		log->events.push_back(3);
+		g_system->delayMillis(log->delay);
+	}
+
+	// Removes itself, and installs timerA instead
+	static void replacingTimer(void *refCon) {
+		TimerLog *log = (TimerLog *)refCon;
+		log->events.push_back(4);
+		log->manager->removeTimerProc(replacingTimer);
+		log->manager->installTimerProc(timerA, 1000, refCon, "A");
+	}
+
+	// Removes timerB, which is due later in the same run of the handler
+	static void removingTimer(void *refCon) {
+		TimerLog *log = (TimerLog *)refCon;
+		log->events.push_back(5);
+		log->manager->removeTimerProc(timerB);
+	}
+
+	static int countEvents(const TimerLog &log, int event) {
+		int count = 0;
+		for (uint i = 0; i < log.events.size(); i++) {
+			if (log.events[i] == event)
+				count++;
+		}
+		return count;
+	}
+
+	static bool findStats(DefaultTimerManager &manager, const char *id, Common::TimerManager::TimerStats &stats) {
+		Common::TimerManager::TimerStatsList list = manager.getTimerStats();
+		for (uint i = 0; i < list.size(); i++) {
+			if (list[i].id == id) {
+				stats = list[i];
+				return true;
+			}
+		}
+		return false;
+	}
+
+	// Installs the timers within the same millisecond, so that their fire
+	// times only depend on their intervals
+	static void installTogether(DefaultTimerManager &manager, TimerLog &log, const int32 *intervals) {
+		static const Common::TimerManager::TimerProc procs[] = { timerA, timerB, timerC };
+		static const char *const ids[] = { "A", "B", "C" };
+
+		while (true) {
+			const uint32 start = g_system->getMillis();
+			for (int i = 0; i < 3; i++)
+				manager.installTimerProc(procs[i], intervals[i], &log, ids[i]);
+			if (g_system->getMillis() == start)
+				break;
+
+			for (int i = 0; i < 3; i++)
+				manager.removeTimerProc(procs[i]);
+		}
+	}
+
+public:
+	void test_fire_order() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		Common::install_null_g_system();
+		DefaultTimerManager manager;
+		TimerLog log(&manager);
+
+		static const int32 intervals[] = { 3000, 5000, 7000 };
+		installTogether(manager, log, intervals);
+
+		// The timers catch up in the order of their fire times. At 15ms, B
+		// comes first, since it was queued again at 10ms and A at 12ms.
+		g_system->delayMillis(17);
+		manager.handler();
+
+		static const int expected[] = { 0, 1, 0, 2, 0, 1, 0, 2, 1, 0 };
+		TS_ASSERT_LESS_THAN_EQUALS((uint)ARRAYSIZE(expected), log.events.size());
+		for (uint i = 0; i < ARRAYSIZE(expected) && i < log.events.size(); i++)
+			TSM_ASSERT_EQUALS(i, log.events[i], expected[i]);
+#endif
+	}
+
+	void test_equal_fire_times() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		Common::install_null_g_system();
+		DefaultTimerManager manager;
+		TimerLog log(&manager);
+
+		// Timers due at the same time fire in the order they were queued,
+		// when installed or when they last fired. At 4ms, C comes first
+		// since it was queued at install time, and A and B at 2ms.
+		static const int32 intervals[] = { 2000, 2000, 4000 };
+		installTogether(manager, log, intervals);
+
+		g_system->delayMillis(9);
+		manager.handler();
+
+		static const int expected[] = { 0, 1, 2, 0, 1, 0, 1, 2, 0, 1 };
+		TS_ASSERT_LESS_THAN_EQUALS((uint)ARRAYSIZE(expected), log.events.size());
+		for (uint i = 0; i < ARRAYSIZE(expected) && i < log.events.size(); i++)
+			TSM_ASSERT_EQUALS(i, log.events[i], expected[i]);
+#endif
+	}
+
+	void test_remove_from_callback() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		Common::install_null_g_system();
+		DefaultTimerManager manager;
+		TimerLog log(&manager);
+
+		manager.installTimerProc(removingTimer, 1000, &log, "removing");
+		manager.installTimerProc(timerB, 3000, &log, "B");
+		manager.installTimerProc(replacingTimer, 1000, &log, "replacing");
+
+		// The removed timers stop firing right away, even though they are
+		// late
+		g_system->delayMillis(6);
+		manager.handler();
+		TS_ASSERT_EQUALS(countEvents(log, 1), 0);
+		TS_ASSERT_EQUALS(countEvents(log, 4), 1);
+		TS_ASSERT_LESS_THAN_EQUALS(1, countEvents(log, 5));
+
+		// The timer installed by the callback fires from the next run on
+		Common::TimerManager::TimerStats stats;
+		TS_ASSERT(!findStats(manager, "B", stats));
+		TS_ASSERT(!findStats(manager, "replacing", stats));
+		TS_ASSERT(findStats(manager, "A", stats));
+		TS_ASSERT_EQUALS(countEvents(log, 0), 0);
+
+		g_system->delayMillis(3);
+		manager.handler();
+		TS_ASSERT_LESS_THAN_EQUALS(1, countEvents(log, 0));
+		TS_ASSERT_EQUALS(countEvents(log, 4), 1);
+
+		// Removed timers can be installed again
+		manager.removeTimerProc(removingTimer);
+		manager.installTimerProc(timerB, 1000, &log, "B");
+		g_system->delayMillis(3);
+		manager.handler();
+		TS_ASSERT_LESS_THAN_EQUALS(1, countEvents(log, 1));
+#endif
+	}
+
+	void test_stats() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		Common::install_null_g_system();
+		DefaultTimerManager manager;
+		TimerLog log(&manager);
+		log.delay = 3;
+
+		manager.installTimerProc(slowTimer, 2000, &log, "slow");
+		g_system->delayMillis(9);
+		manager.handler();
+
+		Common::TimerManager::TimerStats stats;
+		TS_ASSERT(findStats(manager, "slow", stats));
+		TS_ASSERT_EQUALS(stats.interval, 2000);
+		TS_ASSERT_EQUALS(stats.fireCount, (uint32)countEvents(log, 3));
+		TS_ASSERT_LESS_THAN_EQUALS(4u, stats.fireCount);
+
+		// The first firing was at least 6ms late, and the ones after it
+		// waited for the slow callbacks before them
+		TS_ASSERT_LESS_THAN_EQUALS(1u, stats.lateCount);
+		TS_ASSERT_LESS_THAN_EQUALS(6000u, stats.maxLateness);
+		TS_ASSERT_LESS_THAN_EQUALS(3u, stats.maxCallbackTime);
+		TS_ASSERT_LESS_THAN_EQUALS(stats.fireCount * 3, stats.totalCallbackTime);
+
+		manager.removeTimerProc(slowTimer);
+		TS_ASSERT(!findStats(manager, "slow", stats));
+#endif
+	}
+};
@@ -0,0 +1,83 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/fs.h"
+#include "common/memstream.h"
+
+#include "backends/fs/posix/posix-iostream.h"
+
+#include "../system/null_osystem.h"
+
+class PosixMappedReadStreamTestSuite : public CxxTest::TestSuite {
+#ifdef HAS_MMAP
+	enum {
+		kFileSize = 100 * 1024
+	};
+
+	static byte patternByte(uint32 pos) {
+		return (byte)((pos * 7) ^ (pos >> 8));
+	}
+
+	// Writes a file of the given size filled with patternByte()
+	static void writePatternFile(const Common::FSNode &node, uint32 size) {
+		Common::SeekableWriteStream *stream = node.createWriteStream(false);
+		TS_ASSERT(stream);
+		if (!stream)
+			return;
+
+		for (uint32 i = 0; i < size; i++)
+			stream->writeByte(patternByte(i));
+		delete stream;
+	}
+#endif
+
+public:
+	void test_read_mapped_file() {
+#ifdef HAS_MMAP
+		Common::install_null_g_system();
+
+		// The files are left in the working directory of the tests
+		Common::FSNode node(Common::Path("posix-mapped-test.bin"));
+		writePatternFile(node, kFileSize);
+
+		PosixMappedReadStream *stream = PosixMappedReadStream::makeFromPath("posix-mapped-test.bin", 64 * 1024);
+		TS_ASSERT(stream);
+		if (!stream)
+			return;
+
+		TS_ASSERT_EQUALS(stream->size(), (int64)kFileSize);
+		const byte *data = stream->getData();
+		bool matches = true;
+		for (uint32 i = 0; i < kFileSize; i++)
+			matches = matches && data[i] == patternByte(i);
+		TS_ASSERT(matches);
+
+		byte buffer[16];
+		TS_ASSERT(stream->seek(kFileSize - 8));
+		TS_ASSERT_EQUALS(stream->read(buffer, sizeof(buffer)), 8u);
+		TS_ASSERT(stream->eos());
+		for (uint32 i = 0; i < 8; i++)
+			TS_ASSERT_EQUALS(buffer[i], patternByte(kFileSize - 8 + i));
+
+		TS_ASSERT(stream->seek(0x1234));
+		TS_ASSERT_EQUALS(stream->readByte(), patternByte(0x1234));
+		TS_ASSERT_EQUALS(stream->pos(), 0x1235);
+		delete stream;
+
+		// Files smaller than the threshold are left to the stdio streams
+		TS_ASSERT(!PosixMappedReadStream::makeFromPath("posix-mapped-test.bin", kFileSize + 1));
+#endif
+	}
+
+	void test_map_invalid_files() {
+#ifdef HAS_MMAP
+		Common::install_null_g_system();
+
+		TS_ASSERT(!PosixMappedReadStream::makeFromPath("posix-mapped-test-missing.bin", 0));
+
+		Common::FSNode dir(Common::Path("posix-mapped-test"));
+		if (!dir.exists())
+			dir.createDirectory();
+		TS_ASSERT(!PosixMappedReadStream::makeFromPath("posix-mapped-test", 0));
+#endif
+	}
+};
@@ -0,0 +1,66 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/config-manager.h"
+
+class ConfigValueTestSuite : public CxxTest::TestSuite {
+public:
+	void tearDown() {
+		ConfMan.removeKey("configvalue_int", Common::ConfigManager::kTransientDomain);
+		ConfMan.removeKey("configvalue_bool", Common::ConfigManager::kTransientDomain);
+		ConfMan.removeKey("configvalue_string", Common::ConfigManager::kTransientDomain);
+	}
+
+	void test_reads_defaults() {
+		ConfMan.registerDefault("configvalue_int", 42);
+		ConfMan.registerDefault("configvalue_bool", true);
+
+		Common::ConfigValue<int> intValue("configvalue_int");
+		Common::ConfigValue<bool> boolValue("configvalue_bool");
+		TS_ASSERT_EQUALS(intValue.get(), 42);
+		TS_ASSERT_EQUALS(boolValue.get(), true);
+		TS_ASSERT_EQUALS(intValue.getKey(), "configvalue_int");
+	}
+
+	void test_follows_changes() {
+		ConfMan.registerDefault("configvalue_int", 42);
+		Common::ConfigValue<int> intValue("configvalue_int");
+		TS_ASSERT_EQUALS((int)intValue, 42);
+
+		ConfMan.setInt("configvalue_int", 7, Common::ConfigManager::kTransientDomain);
+		TS_ASSERT_EQUALS((int)intValue, 7);
+
+		// Changes made on the domain directly count as well
+		ConfMan.getDomain(Common::ConfigManager::kTransientDomain)->setVal("configvalue_int", "0x10");
+		TS_ASSERT_EQUALS((int)intValue, 16);
+
+		ConfMan.removeKey("configvalue_int", Common::ConfigManager::kTransientDomain);
+		TS_ASSERT_EQUALS((int)intValue, 42);
+	}
+
+	void test_generation_only_changes_on_writes() {
+		ConfMan.setBool("configvalue_bool", false, Common::ConfigManager::kTransientDomain);
+		Common::ConfigValue<bool> boolValue("configvalue_bool");
+		Common::ConfigValue<Common::String> stringValue("configvalue_string");
+
+		const uint32 generation = Common::ConfigManager::getGeneration();
+		TS_ASSERT_EQUALS(boolValue.get(), false);
+		TS_ASSERT_EQUALS(stringValue.get(), "");
+		TS_ASSERT(ConfMan.hasKey("configvalue_bool"));
+		TS_ASSERT_EQUALS(ConfMan.get("configvalue_bool"), "false");
+		TS_ASSERT_EQUALS(Common::ConfigManager::getGeneration(), generation);
+
+		// Reading from a domain directly does not count as a change, but
+		// getting a value to write to does
+		Common::ConfigManager::Domain *domain = ConfMan.getDomain(Common::ConfigManager::kTransientDomain);
+		TS_ASSERT_EQUALS(domain->getVal("configvalue_bool"), "false");
+		TS_ASSERT_EQUALS(Common::ConfigManager::getGeneration(), generation);
+		domain->getOrCreateVal("configvalue_bool") = "true";
+		TS_ASSERT_DIFFERS(Common::ConfigManager::getGeneration(), generation);
+		TS_ASSERT_EQUALS(boolValue.get(), true);
+
+		ConfMan.set("configvalue_string", "abc", Common::ConfigManager::kTransientDomain);
+		TS_ASSERT_DIFFERS(Common::ConfigManager::getGeneration(), generation);
+		TS_ASSERT_EQUALS(stringValue.get(), "abc");
+		TS_ASSERT_EQUALS(boolValue.get(), true);
+	}
+};
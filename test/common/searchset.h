@@ -0,0 +1,232 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/archive.h"
+#include "common/fs.h"
+#include "common/memstream.h"
+
+#include "../system/null_osystem.h"
+
+class SearchSetTestSuite : public CxxTest::TestSuite {
+	// An archive whose members all contain a single byte identifying it
+	class TaggedArchive : public Common::Archive {
+	public:
+		TaggedArchive(byte tag, const char *const *files) : _tag(tag) {
+			for (; *files; ++files)
+				_files.push_back(Common::Path(*files));
+		}
+
+		bool hasFile(const Common::Path &path) const override {
+			for (const Common::Path &file : _files) {
+				if (file.equalsIgnoreCase(path))
+					return true;
+			}
+			return false;
+		}
+
+		int listMembers(Common::ArchiveMemberList &list) const override {
+			for (const Common::Path &file : _files)
+				list.push_back(Common::ArchiveMemberPtr(new Common::GenericArchiveMember(file, *this)));
+			return _files.size();
+		}
+
+		const Common::ArchiveMemberPtr getMember(const Common::Path &path) const override {
+			return Common::ArchiveMemberPtr(new Common::GenericArchiveMember(path, *this));
+		}
+
+		Common::SeekableReadStream *createReadStreamForMember(const Common::Path &path) const override {
+			if (!hasFile(path))
+				return nullptr;
+			return new Common::MemoryReadStream(&_tag, 1);
+		}
+
+	private:
+		byte _tag;
+		Common::Array<Common::Path> _files;
+	};
+
+	static int readTag(const Common::SearchSet &set, const char *path) {
+		return readTag(set, Common::Path(path));
+	}
+
+	static int readTag(const Common::SearchSet &set, const Common::Path &path) {
+		Common::SeekableReadStream *stream = set.createReadStreamForMember(path);
+		if (!stream)
+			return -1;
+
+		const int tag = stream->readByte();
+		delete stream;
+		return tag;
+	}
+
+	static void fillSet(Common::SearchSet &set) {
+		static const char *const filesA[] = { "common.dat", "a.dat", "sub/file.bin", nullptr };
+		static const char *const filesB[] = { "COMMON.DAT", "b.dat", nullptr };
+		static const char *const filesC[] = { "common.dat", "c.dat", "SUB/FILE.BIN", nullptr };
+
+		set.add("a", new TaggedArchive('a', filesA), 0);
+		set.add("b", new TaggedArchive('b', filesB), 5);
+		set.add("c", new TaggedArchive('c', filesC), 0);
+	}
+
+	void checkSameLookups(const Common::SearchSet &indexed, const Common::SearchSet &linear) {
+		static const char *const paths[] = { "common.dat", "Common.Dat", "a.dat", "b.dat", "c.dat", "t.dat", "sub/file.bin", "missing.dat", "sub/missing.bin", nullptr };
+
+		for (const char *const *path = paths; *path; ++path) {
+			TS_ASSERT_EQUALS(indexed.hasFile(Common::Path(*path)), linear.hasFile(Common::Path(*path)));
+			TS_ASSERT_EQUALS(readTag(indexed, *path), readTag(linear, *path));
+		}
+	}
+
+	// Writes a file holding a single byte identifying its directory
+	static void writeTaggedFile(const Common::FSNode &dir, const char *name, byte tag) {
+		Common::SeekableWriteStream *stream = dir.getChild(name).createWriteStream(false);
+		TS_ASSERT(stream);
+		if (stream) {
+			stream->writeByte(tag);
+			delete stream;
+		}
+	}
+
+	static Common::FSNode createTaggedDirectory(const Common::FSNode &parent, const char *name, const char *const *files) {
+		Common::FSNode dir = parent.getChild(name);
+		if (!dir.exists())
+			dir.createDirectory();
+
+		for (; *files; ++files)
+			writeTaggedFile(dir, *files, name[0]);
+		return dir;
+	}
+
+	static void fillSetWithDirectories(Common::SearchSet &set, const Common::FSNode &dirA, const Common::FSNode &dirB) {
+		static const char *const filesT[] = { "common.dat", "t.dat", "b.dat", nullptr };
+
+		set.addDirectory("a", dirA, 0);
+		set.add("t", new TaggedArchive('t', filesT), 5);
+		set.addDirectory("b", dirB, 10);
+	}
+
+public:
+	void test_index_matches_linear_search() {
+		Common::SearchSet indexed, linear;
+		fillSet(indexed);
+		fillSet(linear);
+		indexed.setIndexEnabled(true);
+
+		checkSameLookups(indexed, linear);
+
+		// Higher priority wins, insertion order breaks ties
+		TS_ASSERT_EQUALS(readTag(indexed, "common.dat"), 'b');
+		TS_ASSERT_EQUALS(readTag(indexed, "sub/file.bin"), 'a');
+		TS_ASSERT(!indexed.hasFile(Common::Path("missing.dat")));
+	}
+
+	void test_index_follows_changes() {
+		Common::SearchSet indexed, linear;
+		fillSet(indexed);
+		fillSet(linear);
+		indexed.setIndexEnabled(true);
+
+		// Build the index before changing the set
+		TS_ASSERT(indexed.hasFile(Common::Path("a.dat")));
+
+		static const char *const filesD[] = { "common.dat", "d.dat", nullptr };
+		static const char *const filesE[] = { "sub/file.bin", "e.dat", nullptr };
+		indexed.add("d", new TaggedArchive('d', filesD), 10);
+		linear.add("d", new TaggedArchive('d', filesD), 10);
+		indexed.add("e", new TaggedArchive('e', filesE), 0);
+		linear.add("e", new TaggedArchive('e', filesE), 0);
+		checkSameLookups(indexed, linear);
+		TS_ASSERT_EQUALS(readTag(indexed, "common.dat"), 'd');
+		TS_ASSERT_EQUALS(readTag(indexed, "e.dat"), 'e');
+
+		indexed.remove("d");
+		linear.remove("d");
+		indexed.remove("a");
+		linear.remove("a");
+		checkSameLookups(indexed, linear);
+		TS_ASSERT_EQUALS(readTag(indexed, "common.dat"), 'b');
+		TS_ASSERT_EQUALS(readTag(indexed, "sub/file.bin"), 'c');
+		TS_ASSERT(!indexed.hasFile(Common::Path("a.dat")));
+
+		indexed.setPriority("c", 20);
+		linear.setPriority("c", 20);
+		checkSameLookups(indexed, linear);
+		TS_ASSERT_EQUALS(readTag(indexed, "common.dat"), 'c');
+
+		indexed.clear();
+		TS_ASSERT(!indexed.hasFile(Common::Path("c.dat")));
+	}
+
+	void test_index_with_directories() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		Common::install_null_g_system();
+
+		// The files are left in the working directory of the tests
+		static const char *const filesA[] = { "common.dat", "a.dat", nullptr };
+		static const char *const filesB[] = { "COMMON.DAT", "b.dat", nullptr };
+		Common::FSNode root(Common::Path("searchset-test"));
+		if (!root.exists())
+			root.createDirectory();
+		Common::FSNode dirA = createTaggedDirectory(root, "a", filesA);
+		Common::FSNode dirB = createTaggedDirectory(root, "b", filesB);
+
+		// Only the directories are indexed, the other archives are still
+		// searched in priority order with them
+		Common::SearchSet indexed, linear;
+		fillSetWithDirectories(indexed, dirA, dirB);
+		fillSetWithDirectories(linear, dirA, dirB);
+		indexed.setIndexEnabled(true);
+
+		checkSameLookups(indexed, linear);
+		TS_ASSERT_EQUALS(readTag(indexed, "common.dat"), 'b');
+		TS_ASSERT_EQUALS(readTag(indexed, "b.dat"), 'b');
+		TS_ASSERT_EQUALS(readTag(indexed, "t.dat"), 't');
+		TS_ASSERT_EQUALS(readTag(indexed, "a.dat"), 'a');
+
+		indexed.remove("b");
+		linear.remove("b");
+		checkSameLookups(indexed, linear);
+		TS_ASSERT_EQUALS(readTag(indexed, "common.dat"), 't');
+		TS_ASSERT_EQUALS(readTag(indexed, "b.dat"), 't');
+
+		indexed.remove("t");
+		linear.remove("t");
+		checkSameLookups(indexed, linear);
+		TS_ASSERT_EQUALS(readTag(indexed, "common.dat"), 'a');
+		TS_ASSERT(!indexed.hasFile(Common::Path("b.dat")));
+#endif
+	}
+
+	void test_index_with_mac_names() {
+#if NULL_OSYSTEM_IS_AVAILABLE && defined(POSIX)
+		Common::install_null_g_system();
+
+		// Names of files from Mac discs, which contain a '/': either encoded
+		// with punycode, or with the '/' replaced by ':'
+		static const char *const filesM[] = { "xn--Sound Manager 3.1  SoundLib-lba84k", "Data : File", nullptr };
+		Common::FSNode root(Common::Path("searchset-test"));
+		if (!root.exists())
+			root.createDirectory();
+		Common::FSNode dirM = createTaggedDirectory(root, "m", filesM);
+
+		Common::SearchSet indexed, linear;
+		indexed.addDirectory("m", dirM, 0);
+		linear.addDirectory("m", dirM, 0);
+		indexed.setIndexEnabled(true);
+
+		const Common::Path paths[] = {
+			Common::Path("Sound Manager 3.1 / SoundLib", ':'),
+			Common::Path("xn--Sound Manager 3.1  SoundLib-lba84k"),
+			Common::Path("sound manager 3.1 / soundlib", ':'),
+			Common::Path("Data / File", ':'),
+			Common::Path("Data : File"),
+			Common::Path("DATA / FILE", ':')
+		};
+		for (uint i = 0; i < ARRAYSIZE(paths); i++) {
+			TS_ASSERT(linear.hasFile(paths[i]));
+			TS_ASSERT(indexed.hasFile(paths[i]));
+			TS_ASSERT_EQUALS(readTag(indexed, paths[i]), 'm');
+		}
+#endif
+	}
+};
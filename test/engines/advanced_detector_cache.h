@@ -0,0 +1,103 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/fs.h"
+#include "common/savefile.h"
+
+#include "backends/saves/default/default-saves.h"
+#include "engines/advancedDetectorCache.h"
+
+#include "../system/null_osystem.h"
+
+class ADPersistentCacheTestSuite : public CxxTest::TestSuite {
+	// The cache is written to the working directory of the tests, and
+	// removed again through the save file manager once the test is done
+	static void removeCache(Common::SaveFileManager *saveFileMan) {
+		Common::StringArray lockedFiles;
+		saveFileMan->updateSavefilesList(lockedFiles);
+		if (saveFileMan->exists("detection-cache-test.txt"))
+			saveFileMan->removeSavefile("detection-cache-test.txt");
+	}
+
+	DefaultSaveFileManager *_saveFileMan;
+
+public:
+	void setUp() {
+		Common::install_null_g_system();
+		// The cloud sync code reaches the save file manager through g_system
+		_saveFileMan = new DefaultSaveFileManager(Common::Path("."));
+		Common::set_null_g_system_savefile_manager(_saveFileMan);
+		removeCache(_saveFileMan);
+	}
+
+	void tearDown() {
+		removeCache(_saveFileMan);
+	}
+
+	void test_round_trip() {
+		const Common::String md5("0123456789abcdef0123456789abcdef");
+		Common::String cachedMD5;
+		int64 cachedSize = 0;
+
+		ADPersistentCache cache;
+		cache.setPath(Common::Path("detection-cache-test.txt"));
+
+		TS_ASSERT(!cache.getMD5("md5:/games/a/data.000:5000", 1234, 5678, cachedMD5, cachedSize));
+		cache.setMD5("md5:/games/a/data.000:5000", 1234, 5678, md5, 5000);
+		cache.setMD5("md5:/games/a/data.001:5000", 4321, 8765, md5, 4321);
+		cache.flush(true);
+		TS_ASSERT(Common::FSNode(Common::Path("detection-cache-test.txt")).exists());
+
+		// Load the entries again from the file
+		cache.setPath(Common::Path("detection-cache-test.txt"));
+		TS_ASSERT(cache.getMD5("md5:/games/a/data.000:5000", 1234, 5678, cachedMD5, cachedSize));
+		TS_ASSERT_EQUALS(cachedMD5, md5);
+		TS_ASSERT_EQUALS(cachedSize, 5000);
+		TS_ASSERT(cache.getMD5("md5:/games/a/data.001:5000", 4321, 8765, cachedMD5, cachedSize));
+		TS_ASSERT_EQUALS(cachedSize, 4321);
+
+		// Entries are only used for the same key, and while the file keeps
+		// its size and modification time
+		TS_ASSERT(!cache.getMD5("md5:/games/a/data.000:1024", 1234, 5678, cachedMD5, cachedSize));
+		TS_ASSERT(!cache.getMD5("md5:/games/b/data.000:5000", 1234, 5678, cachedMD5, cachedSize));
+		TS_ASSERT(!cache.getMD5("md5:/games/a/data.000:5000", 1235, 5678, cachedMD5, cachedSize));
+		TS_ASSERT(!cache.getMD5("md5:/games/a/data.000:5000", 1234, 5679, cachedMD5, cachedSize));
+
+		// A changed file replaces its entry
+		cache.setMD5("md5:/games/a/data.000:5000", 1235, 5679, md5, 1235);
+		cache.flush(true);
+		cache.setPath(Common::Path("detection-cache-test.txt"));
+		TS_ASSERT(!cache.getMD5("md5:/games/a/data.000:5000", 1234, 5678, cachedMD5, cachedSize));
+		TS_ASSERT(cache.getMD5("md5:/games/a/data.000:5000", 1235, 5679, cachedMD5, cachedSize));
+		TS_ASSERT_EQUALS(cachedSize, 1235);
+	}
+
+	void test_size_limit() {
+		const Common::String md5("0123456789abcdef0123456789abcdef");
+		Common::String cachedMD5;
+		int64 cachedSize = 0;
+
+		ADPersistentCache cache;
+		cache.setPath(Common::Path("detection-cache-test.txt"));
+
+		// The entries used in an earlier session are dropped first
+		for (uint i = 0; i < 20000; i++)
+			cache.setMD5(Common::String::format("md5:/games/old/%u:5000", i), i, 0, md5, i);
+		cache.flush(true);
+
+		cache.setPath(Common::Path("detection-cache-test.txt"));
+		TS_ASSERT(cache.getMD5("md5:/games/old/0:5000", 0, 0, cachedMD5, cachedSize));
+		for (uint i = 0; i < 10; i++)
+			cache.setMD5(Common::String::format("md5:/games/new/%u:5000", i), i, 0, md5, i);
+		cache.flush(true);
+
+		cache.setPath(Common::Path("detection-cache-test.txt"));
+		TS_ASSERT(cache.getMD5("md5:/games/old/0:5000", 0, 0, cachedMD5, cachedSize));
+		for (uint i = 0; i < 10; i++)
+			TS_ASSERT(cache.getMD5(Common::String::format("md5:/games/new/%u:5000", i), i, 0, cachedMD5, cachedSize));
+
+		uint found = 0;
+		for (uint i = 0; i < 20000; i++)
+			found += cache.getMD5(Common::String::format("md5:/games/old/%u:5000", i), i, 0, cachedMD5, cachedSize);
+		TS_ASSERT_EQUALS(found, 20000u - 10u);
+	}
+};
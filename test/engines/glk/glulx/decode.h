@@ -0,0 +1,168 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/str.h"
+
+#include "engines/glk/glulx/decode.h"
+
+/**
+ * Test suite for the operand decoding shared by Glulx::parse_operands() and
+ * the cache of decoded ROM instructions, on a synthetic ROM covering every
+ * load and store mode.
+ */
+class GlulxDecodeTestSuite : public CxxTest::TestSuite {
+	typedef Glk::Glulx::operandlist_t operandlist_t;
+
+	static const uint kRamStart = 0x1000;
+
+	static const int _loads[8];
+	static const int _stores[8];
+	static const operandlist_t _loadList;
+	static const operandlist_t _storeList;
+
+	static void checkOperands(const byte *modes, const uint *values, const byte *expectedModes, const uint *expectedValues, int numops) {
+		for (int i = 0; i < numops; i++) {
+			TS_ASSERT_EQUALS(modes[i], expectedModes[i]);
+			TS_ASSERT_EQUALS(values[i], expectedValues[i]);
+		}
+	}
+
+public:
+	void test_opcode() {
+		const byte rom[] = { 0x10, 0x81, 0x23, 0xC0, 0x01, 0x23, 0x45 };
+		uint addr = 0;
+
+		TS_ASSERT_EQUALS(Glk::Glulx::decode_opcode(rom, addr), 0x10u);
+		TS_ASSERT_EQUALS(addr, 1u);
+		TS_ASSERT_EQUALS(Glk::Glulx::decode_opcode(rom, addr), 0x123u);
+		TS_ASSERT_EQUALS(addr, 3u);
+		TS_ASSERT_EQUALS(Glk::Glulx::decode_opcode(rom, addr), 0x12345u);
+		TS_ASSERT_EQUALS(addr, 7u);
+	}
+
+	void test_load_modes() {
+		using namespace Glk::Glulx;
+
+		const byte rom[] = {
+			// Modes 0, 1, 2, 3, 5, 6, 7, 8
+			0x10, 0x32, 0x65, 0x87,
+			0xFE,
+			0x81, 0x23,
+			0x12, 0x34, 0x56, 0x78,
+			0x40,
+			0x01, 0x23,
+			0x00, 0x00, 0x00, 0x44,
+			// Modes 9, 10, 11, 13, 14, 15, 1, 2
+			0xA9, 0xDB, 0xFE, 0x21,
+			0x08,
+			0x01, 0x00,
+			0x00, 0x00, 0x00, 0x0C,
+			0x10,
+			0x00, 0x20,
+			0x00, 0x00, 0x00, 0x30,
+			0x7F,
+			0x00, 0x80
+		};
+		const byte modes1[] = {
+			decodedmode_Const, decodedmode_Const, decodedmode_Const, decodedmode_Const,
+			decodedmode_Mem, decodedmode_Mem, decodedmode_Mem, decodedmode_Pop
+		};
+		const uint values1[] = { 0, 0xFFFFFFFE, 0xFFFF8123, 0x12345678, 0x40, 0x123, 0x44, 0 };
+		const byte modes2[] = {
+			decodedmode_Locals, decodedmode_Locals, decodedmode_Locals, decodedmode_Mem,
+			decodedmode_Mem, decodedmode_Mem, decodedmode_Const, decodedmode_Const
+		};
+		const uint values2[] = { 0x08, 0x100, 0x0C, kRamStart + 0x10, kRamStart + 0x20, kRamStart + 0x30, 0x7F, 0x80 };
+
+		byte modes[MAX_OPERANDS];
+		uint values[MAX_OPERANDS];
+		uint addr = 0;
+
+		TS_ASSERT(!decode_operands(rom, addr, sizeof(rom), kRamStart, &_loadList, modes, values));
+		TS_ASSERT_EQUALS(addr, 18u);
+		checkOperands(modes, values, modes1, values1, 8);
+
+		TS_ASSERT(!decode_operands(rom, addr, sizeof(rom), kRamStart, &_loadList, modes, values));
+		TS_ASSERT_EQUALS(addr, sizeof(rom));
+		checkOperands(modes, values, modes2, values2, 8);
+
+		// Operands which don't end before the limit, such as the end of ROM,
+		// are not decoded
+		addr = 0;
+		TS_ASSERT(decode_operands(rom, addr, 17, kRamStart, &_loadList, modes, values));
+		TS_ASSERT_EQUALS(addr, 0u);
+		TS_ASSERT(decode_operands(rom, addr, 3, kRamStart, &_loadList, modes, values));
+		TS_ASSERT_EQUALS(addr, 0u);
+	}
+
+	void test_store_modes() {
+		using namespace Glk::Glulx;
+
+		const byte rom[] = {
+			// Modes 0, 8, 5, 6, 7, 9, 10, 11
+			0x80, 0x65, 0x97, 0xBA,
+			0x40,
+			0x00, 0x50,
+			0x00, 0x00, 0x00, 0x60,
+			0x04,
+			0x00, 0x08,
+			0x00, 0x00, 0x00, 0x0C,
+			// Modes 13, 14, 15, 0, 0, 0, 0, 8
+			0xED, 0x0F, 0x00, 0x80,
+			0x10,
+			0x00, 0x20,
+			0x00, 0x00, 0x00, 0x30
+		};
+		// These are the desttypes of store_operand()
+		const byte modes1[] = { 0, 3, 1, 1, 1, 2, 2, 2 };
+		const uint values1[] = { 0, 0, 0x40, 0x50, 0x60, 0x04, 0x08, 0x0C };
+		const byte modes2[] = { 1, 1, 1, 0, 0, 0, 0, 3 };
+		const uint values2[] = { kRamStart + 0x10, kRamStart + 0x20, kRamStart + 0x30, 0, 0, 0, 0, 0 };
+
+		byte modes[MAX_OPERANDS];
+		uint values[MAX_OPERANDS];
+		uint addr = 0;
+
+		TS_ASSERT(!decode_operands(rom, addr, sizeof(rom), kRamStart, &_storeList, modes, values));
+		TS_ASSERT_EQUALS(addr, 18u);
+		checkOperands(modes, values, modes1, values1, 8);
+
+		TS_ASSERT(!decode_operands(rom, addr, sizeof(rom), kRamStart, &_storeList, modes, values));
+		TS_ASSERT_EQUALS(addr, sizeof(rom));
+		checkOperands(modes, values, modes2, values2, 8);
+	}
+
+	void test_invalid_modes() {
+		using namespace Glk::Glulx;
+
+		// Constants can't be stored to, and modes 4 and 12 don't exist
+		const byte constant[] = { 0x01, 0x00 };
+		const byte unknownLoad[] = { 0x04 };
+		const byte unknownStore[] = { 0x0C };
+		const int loadForms[] = { modeform_Load };
+		const int storeForms[] = { modeform_Store };
+		const operandlist_t loadList = { 1, 4, loadForms };
+		const operandlist_t storeList = { 1, 4, storeForms };
+
+		byte modes[MAX_OPERANDS];
+		uint values[MAX_OPERANDS];
+		uint addr = 0;
+
+		TS_ASSERT_EQUALS(Common::String(decode_operands(constant, addr, sizeof(constant), kRamStart, &storeList, modes, values)), "Constant addressing mode in store operand.");
+		TS_ASSERT_EQUALS(addr, 0u);
+		TS_ASSERT_EQUALS(Common::String(decode_operands(unknownLoad, addr, sizeof(unknownLoad), kRamStart, &loadList, modes, values)), "Unknown addressing mode in load operand.");
+		TS_ASSERT_EQUALS(addr, 0u);
+		TS_ASSERT_EQUALS(Common::String(decode_operands(unknownStore, addr, sizeof(unknownStore), kRamStart, &storeList, modes, values)), "Unknown addressing mode in store operand.");
+		TS_ASSERT_EQUALS(addr, 0u);
+	}
+};
+
+const int GlulxDecodeTestSuite::_loads[8] = {
+	Glk::Glulx::modeform_Load, Glk::Glulx::modeform_Load, Glk::Glulx::modeform_Load, Glk::Glulx::modeform_Load,
+	Glk::Glulx::modeform_Load, Glk::Glulx::modeform_Load, Glk::Glulx::modeform_Load, Glk::Glulx::modeform_Load
+};
+const int GlulxDecodeTestSuite::_stores[8] = {
+	Glk::Glulx::modeform_Store, Glk::Glulx::modeform_Store, Glk::Glulx::modeform_Store, Glk::Glulx::modeform_Store,
+	Glk::Glulx::modeform_Store, Glk::Glulx::modeform_Store, Glk::Glulx::modeform_Store, Glk::Glulx::modeform_Store
+};
+const Glk::Glulx::operandlist_t GlulxDecodeTestSuite::_loadList = { 8, 4, GlulxDecodeTestSuite::_loads };
+const Glk::Glulx::operandlist_t GlulxDecodeTestSuite::_storeList = { 8, 4, GlulxDecodeTestSuite::_stores };
@@ -0,0 +1,242 @@
+#include <cxxtest/TestSuite.h>
+#include "test/instrset_detect.h"
+
+#include "common/debug.h"
+#include "common/random.h"
+#include "common/system.h"
+
+#include "engines/scumm/imuse_digi/dimuse_engine.h"
+#include "engines/scumm/imuse_digi/dimuse_internalmixer.h"
+
+#include "../../system/benchmark.h"
+
+/**
+ * Test suite for the vectorized mixing of engines/scumm/imuse_digi/dimuse_internalmixer.cpp,
+ * which has to match the amplitude table lookups exactly.
+ */
+class IMuseDigiInternalMixerTestSuite : public CxxTest::TestSuite {
+	typedef Scumm::IMuseDigiInternalMixer Mixer;
+
+	static const int kMaxFrames = 1500;
+	static const int kMixBufSize = (kMaxFrames + 8) * 2 * sizeof(uint16);
+
+	uint8 _mixBuf[kMixBufSize];
+
+	// Sets the kernels like selectVectorFuncs() would, without going through
+	// OSystem::hasFeature(). Returns false if there aren't any.
+	static bool selectBestFuncs() {
+		Mixer::VectorFuncs funcs = { nullptr, nullptr };
+#ifdef SCUMMVM_NEON
+		funcs.mix = Mixer::mixNEON;
+		funcs.mixToStereo = Mixer::mixToStereoNEON;
+#endif
+#ifdef SCUMMVM_SSE2
+		if (instrset_detect() >= 2) {
+			funcs.mix = Mixer::mixSSE2;
+			funcs.mixToStereo = Mixer::mixToStereoSSE2;
+		}
+#endif
+#ifdef SCUMMVM_AVX2
+		if (instrset_detect() >= 8) {
+			funcs.mix = Mixer::mixAVX2;
+			funcs.mixToStereo = Mixer::mixToStereoAVX2;
+		}
+#endif
+		Mixer::_vectorFuncs = funcs;
+		Mixer::_vectorFuncsSelected = true;
+		return funcs.mix != nullptr;
+	}
+
+	static void selectTableLookups() {
+		Mixer::_vectorFuncs.mix = nullptr;
+		Mixer::_vectorFuncs.mixToStereo = nullptr;
+		Mixer::_vectorFuncsSelected = true;
+	}
+
+	Mixer *createMixer(int numChannels) {
+		// In low latency mode, nothing is sent to the mixer
+		Mixer *mixer = new Mixer(nullptr, 22050, false, true);
+		mixer->init(16, numChannels, _mixBuf, kMixBufSize, 0, DIMUSE_MAX_TRACKS);
+		return mixer;
+	}
+
+	static void fillRandom(uint8 *buf, int size, Common::RandomSource &rnd) {
+		for (int i = 0; i < size; i++)
+			buf[i] = (uint8)rnd.getRandomNumber(255);
+	}
+
+	void checkKernels(Mixer::MixFunc mix, Mixer::MixToStereoFunc mixToStereo) {
+		Common::RandomSource rnd("dimuse_internalmixer");
+
+		// Odd sizes exercise the scalar tails of the kernels
+		const int count = 131;
+		int16 samples[count];
+		uint16 expected[count * 2], actual[count * 2];
+
+		for (int shift = 0; shift <= 4; shift += 4) {
+			for (int i = 0; i < count; i++) {
+				// Without any shift, the samples are already 12-bit
+				samples[i] = (int16)rnd.getRandomNumber(65535);
+				if (!shift)
+					samples[i] >>= 4;
+			}
+			samples[0] = shift ? -32768 : -2048;
+			samples[1] = shift ? 32767 : 2047;
+
+			for (int leftVolume = 0; leftVolume <= 16; leftVolume++) {
+				int rightVolume = 16 - leftVolume;
+				int leftScale = Mixer::getAmpScale(leftVolume);
+				int rightScale = Mixer::getAmpScale(rightVolume);
+
+				fillRandom((uint8 *)expected, sizeof(expected), rnd);
+				memcpy(actual, expected, sizeof(actual));
+				for (int i = 0; i < count; i++)
+					expected[i] += Mixer::scaleSample(samples[i], shift, leftScale);
+				mix(actual, samples, count, shift, leftScale);
+				TS_ASSERT_SAME_DATA(expected, actual, sizeof(expected));
+
+				fillRandom((uint8 *)expected, sizeof(expected), rnd);
+				memcpy(actual, expected, sizeof(actual));
+				for (int i = 0; i < count; i++) {
+					expected[2 * i] += Mixer::scaleSample(samples[i], shift, leftScale);
+					expected[2 * i + 1] += Mixer::scaleSample(samples[i], shift, rightScale);
+				}
+				mixToStereo(actual, samples, count, shift, leftScale, rightScale);
+				TS_ASSERT_SAME_DATA(expected, actual, sizeof(expected));
+			}
+		}
+	}
+
+	// Mixes a track with the kernels and with the tables, and compares the results
+	void checkMix(Mixer *mixer, uint8 *src, int frames, int wordSize, int channelCount, int feedSize, int volume, int pan, bool ftIs11025Hz) {
+		uint8 expected[kMixBufSize];
+
+		mixer->clearMixerBuffer();
+		selectTableLookups();
+		mixer->mix(src, frames, wordSize, channelCount, feedSize, 3, volume, pan, ftIs11025Hz);
+		memcpy(expected, _mixBuf, kMixBufSize);
+
+		mixer->clearMixerBuffer();
+		selectBestFuncs();
+		mixer->mix(src, frames, wordSize, channelCount, feedSize, 3, volume, pan, ftIs11025Hz);
+
+		TS_ASSERT_SAME_DATA(expected, _mixBuf, kMixBufSize);
+	}
+
+public:
+	void test_amp_scale_matches_tables() {
+		Mixer *mixer = createMixer(2);
+
+		for (int volume = 0; volume <= 16; volume++) {
+			int scale = Mixer::getAmpScale(volume);
+			const int16 *amp8 = (const int16 *)&mixer->_amp8Table[volume * 128];
+			const int16 *amp12 = (const int16 *)&mixer->_amp12Table[volume * 2048];
+
+			for (int i = 0; i < 256; i++)
+				TS_ASSERT_EQUALS(Mixer::scaleSample((int16)((i - 128) * 16), 0, scale), amp8[i]);
+			for (int i = 0; i < 4096; i++)
+				TS_ASSERT_EQUALS(Mixer::scaleSample((int16)(i - 2048), 0, scale), amp12[i]);
+		}
+
+		delete mixer;
+	}
+
+	void test_kernels_match_scalar() {
+#ifdef SCUMMVM_NEON
+		checkKernels(Mixer::mixNEON, Mixer::mixToStereoNEON);
+#endif
+#ifdef SCUMMVM_SSE2
+		if (instrset_detect() >= 2)
+			checkKernels(Mixer::mixSSE2, Mixer::mixToStereoSSE2);
+#endif
+#ifdef SCUMMVM_AVX2
+		if (instrset_detect() >= 8)
+			checkKernels(Mixer::mixAVX2, Mixer::mixToStereoAVX2);
+#endif
+	}
+
+	void test_mix_matches_tables() {
+		if (!selectBestFuncs())
+			return;
+
+		Common::RandomSource rnd("dimuse_internalmixer");
+		uint8 src[kMaxFrames * 2 * 2];
+		fillRandom(src, sizeof(src), rnd);
+
+		const int wordSizes[] = { 8, 12, 16 };
+		const int frameCounts[] = { 1, 2, 37, 1024, kMaxFrames };
+
+		for (int outChannels = 1; outChannels <= 2; outChannels++) {
+			Mixer *mixer = createMixer(outChannels);
+
+			for (int channelCount = 1; channelCount <= 2; channelCount++) {
+				for (int w = 0; w < ARRAYSIZE(wordSizes); w++) {
+					for (int f = 0; f < ARRAYSIZE(frameCounts); f++) {
+						int frames = frameCounts[f];
+						int volume = rnd.getRandomNumber(127);
+						int pan = rnd.getRandomNumber(127);
+
+						checkMix(mixer, src, frames, wordSizes[w], channelCount, frames, volume, pan, false);
+						checkMix(mixer, src, frames, wordSizes[w], channelCount, frames, 127, 64, false);
+						checkMix(mixer, src, frames, wordSizes[w], channelCount, frames, 0, 0, false);
+
+						// Resampled tracks are left to the tables
+						if (frames > 1)
+							checkMix(mixer, src, frames / 2, wordSizes[w], channelCount, frames, volume, pan, false);
+					}
+				}
+			}
+
+			// Radio chatter and the early iMUSE 8-bit paths
+			mixer->setRadioChatter();
+			checkMix(mixer, src, 1024, 8, 1, 1024, 100, 20, false);
+			mixer->clearRadioChatter();
+
+			mixer->_isEarlyDiMUSE = true;
+			checkMix(mixer, src, 1024, 8, 1, 512, 100, 100, false);
+			checkMix(mixer, src, 512, 8, 1, 1024, 100, 100, true);
+			mixer->_isEarlyDiMUSE = false;
+
+			delete mixer;
+		}
+	}
+
+	void test_speed() {
+#if BENCHMARK_TESTS
+		Common::install_null_g_system();
+
+		// 16 tracks of 16-bit samples, half of them mono, mixed in stereo. The
+		// track count the mixer is set up with only matters for the output.
+		const int tracks = 16;
+		const int frames = 1024;
+		const int buffers = 1000;
+		Common::RandomSource rnd("dimuse_internalmixer");
+		uint8 *src = new uint8[tracks * frames * 4];
+		fillRandom(src, tracks * frames * 4, rnd);
+
+		Mixer *mixer = createMixer(2);
+		bool haveKernels = selectBestFuncs();
+
+		for (int pass = 0; pass < 2; pass++) {
+			if (pass == 0)
+				selectTableLookups();
+			else if (!haveKernels)
+				break;
+			else
+				selectBestFuncs();
+
+			Common::BenchmarkTimer timer;
+			for (int b = 0; b < buffers; b++) {
+				mixer->clearMixerBuffer();
+				for (int t = 0; t < tracks; t++)
+					mixer->mix(src + t * frames * 4, frames, 16, 1 + (t & 1), frames, 0, 8 * t, 4 * t, false);
+			}
+			debug("iMUSE internal mixer, %s: %d buffers of %d tracks in %u ms",
+				  pass == 0 ? "table lookups" : "vectorized", buffers, tracks, timer.elapsed());
+		}
+
+		delete mixer;
+		delete[] src;
+#endif
+	}
+};
@@ -0,0 +1,181 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/array.h"
+#include "common/random.h"
+#include "common/system.h"
+
+#include "engines/scumm/he/intern_he.h"
+#include "engines/scumm/he/wiz_he.h"
+
+#include "../../system/null_osystem.h"
+
+/**
+ * Test suite for the decoded TRLE states of engines/scumm/he/wizdecoded_he.cpp,
+ * which have to draw the same pixels as decoding the compressed data pixel
+ * by pixel.
+ */
+class WizDecodedStateTestSuite : public CxxTest::TestSuite {
+#ifdef ENABLE_HE
+	enum {
+		kBufferWidth = 48,
+		kBufferHeight = 40,
+		kTransparent = -1
+	};
+
+	// Encodes random runs of every kind, the last of a row may go past the
+	// width, and some rows are left empty
+	static void makeRandomImage(Common::RandomSource &rnd, int width, int height, bool uses16BitColor,
+								Common::Array<byte> &compData, Common::Array<int> &pixels) {
+		compData.clear();
+		pixels.resize(width * height);
+		for (uint i = 0; i < pixels.size(); i++)
+			pixels[i] = kTransparent;
+
+		for (int row = 0; row < height; row++) {
+			uint lineStart = compData.size();
+			compData.push_back(0);
+			compData.push_back(0);
+
+			int pos = rnd.getRandomNumber(7) ? 0 : width;
+			while (pos < width) {
+				int type = rnd.getRandomNumber(2);
+				int count = 1 + rnd.getRandomNumber(type ? 63 : 126);
+				int color = rnd.getRandomNumber(255);
+
+				if (type == 0) {
+					compData.push_back((count << 1) | 1);
+				} else if (type == 1) {
+					compData.push_back(((count - 1) << 2) | 2);
+					compData.push_back(color);
+				} else {
+					compData.push_back((count - 1) << 2);
+				}
+
+				for (int i = 0; i < count; i++) {
+					if (type == 2) {
+						color = rnd.getRandomNumber(255);
+						compData.push_back(color);
+					}
+					if (type && pos + i < width)
+						pixels[row * width + pos + i] = uses16BitColor ? color * 257 : color;
+				}
+				pos += count;
+			}
+
+			uint16 lineSize = compData.size() - lineStart - 2;
+			compData[lineStart] = lineSize & 0xff;
+			compData[lineStart + 1] = lineSize >> 8;
+		}
+	}
+
+	// Draws the opaque pixels one by one, with the conventions of the Wiz
+	// primitives: clipping rects include their right and bottom edges
+	static void drawReference(uint16 *buffer, const Common::Array<int> &pixels, int width, int height,
+							  int x, int y, const Common::Rect *clipRect, bool hFlip, bool vFlip) {
+		for (int srcY = 0; srcY < height; srcY++) {
+			for (int srcX = 0; srcX < width; srcX++) {
+				int color = pixels[srcY * width + srcX];
+				int dstX = hFlip ? x + width - 1 - srcX : x + srcX;
+				int dstY = vFlip ? y + height - 1 - srcY : y + srcY;
+
+				if (color == kTransparent || dstX < 0 || dstY < 0 || dstX >= kBufferWidth || dstY >= kBufferHeight)
+					continue;
+				if (clipRect && (dstX < clipRect->left || dstX > clipRect->right || dstY < clipRect->top || dstY > clipRect->bottom))
+					continue;
+				buffer[dstY * kBufferWidth + dstX] = color;
+			}
+		}
+	}
+
+	static void checkImage(Common::RandomSource &rnd, bool uses16BitColor) {
+		int width = 1 + rnd.getRandomNumber(39);
+		int height = 1 + rnd.getRandomNumber(29);
+
+		Common::Array<byte> compData;
+		Common::Array<int> pixels;
+		makeRandomImage(rnd, width, height, uses16BitColor, compData, pixels);
+
+		Scumm::WizDecodedState decoded;
+		decoded.compData = compData.begin();
+		decoded.width = width;
+		decoded.height = height;
+		decoded.uses16BitColor = uses16BitColor;
+
+		// The transparent pixels are left as they were decompressed, so
+		// they're filled with garbage
+		int pixelSize = uses16BitColor ? 2 : 1;
+		decoded.pixels = (byte *)malloc(width * height * pixelSize);
+		for (int i = 0; i < width * height; i++) {
+			int color = pixels[i] == kTransparent ? 0xcdcd : pixels[i];
+			if (uses16BitColor)
+				((uint16 *)decoded.pixels)[i] = color;
+			else
+				decoded.pixels[i] = color;
+		}
+
+		decoded.buildSpans();
+		TS_ASSERT_EQUALS(decoded.rowSpans.size(), (uint)height + 1);
+
+		uint16 expected[kBufferWidth * kBufferHeight];
+		uint16 buffer[kBufferWidth * kBufferHeight];
+		byte buffer8[kBufferWidth * kBufferHeight];
+
+		for (int i = 0; i < 8; i++) {
+			int x = (int)rnd.getRandomNumber(kBufferWidth + width) - width;
+			int y = (int)rnd.getRandomNumber(kBufferHeight + height) - height;
+			bool hFlip = (i & 1) != 0;
+			bool vFlip = (i & 2) != 0;
+
+			Common::Rect clipRect;
+			const Common::Rect *clipRectPtr = nullptr;
+			if (i & 4) {
+				clipRect.left = (int)rnd.getRandomNumber(kBufferWidth + 8) - 4;
+				clipRect.top = (int)rnd.getRandomNumber(kBufferHeight + 8) - 4;
+				clipRect.right = clipRect.left + rnd.getRandomNumber(kBufferWidth);
+				clipRect.bottom = clipRect.top + rnd.getRandomNumber(kBufferHeight);
+				clipRectPtr = &clipRect;
+			}
+
+			for (int j = 0; j < kBufferWidth * kBufferHeight; j++)
+				expected[j] = uses16BitColor ? 0xabab : 0xab;
+			drawReference(expected, pixels, width, height, x, y, clipRectPtr, hFlip, vFlip);
+
+			if (uses16BitColor) {
+				for (int j = 0; j < kBufferWidth * kBufferHeight; j++)
+					buffer[j] = 0xabab;
+				decoded.draw(buffer, kBufferWidth, kBufferHeight, x, y, clipRectPtr, hFlip, vFlip);
+			} else {
+				memset(buffer8, 0xab, sizeof(buffer8));
+				decoded.draw((Scumm::WizRawPixel *)buffer8, kBufferWidth, kBufferHeight, x, y, clipRectPtr, hFlip, vFlip);
+				for (int j = 0; j < kBufferWidth * kBufferHeight; j++)
+					buffer[j] = buffer8[j];
+			}
+
+			TS_ASSERT_SAME_DATA(buffer, expected, sizeof(expected));
+		}
+	}
+#endif
+
+public:
+	void test_draw_8bit() {
+#ifdef ENABLE_HE
+		Common::install_null_g_system();
+		Common::RandomSource rnd("wizcache");
+		rnd.setSeed(0x5eed);
+
+		for (int i = 0; i < 200; i++)
+			checkImage(rnd, false);
+#endif
+	}
+
+	void test_draw_16bit() {
+#ifdef ENABLE_HE
+		Common::install_null_g_system();
+		Common::RandomSource rnd("wizcache");
+		rnd.setSeed(0x5eed);
+
+		for (int i = 0; i < 200; i++)
+			checkImage(rnd, true);
+#endif
+	}
+};
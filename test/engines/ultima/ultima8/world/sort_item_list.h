@@ -0,0 +1,200 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/debug.h"
+#include "common/random.h"
+#include "common/system.h"
+
+#include "engines/ultima/ultima8/world/sort_item.h"
+#include "engines/ultima/ultima8/world/sort_item_list.h"
+
+#include "../../../../system/benchmark.h"
+
+/**
+ * Test suite for engines/ultima/ultima8/world/sort_item_list.h
+ *
+ * The list only compares the items whose screenspace rects overlap. The
+ * results are checked against comparing every item with every other one.
+ */
+class U8SortItemListTestSuite : public CxxTest::TestSuite {
+	typedef Ultima::Ultima8::SortItem SortItem;
+
+	// Display list made by comparing every pair of items
+	struct ReferenceList {
+		SortItem *_items;
+		SortItem *_itemsTail;
+		Common::Array<SortItem *> _all;
+
+		ReferenceList() : _items(nullptr), _itemsTail(nullptr) {}
+		~ReferenceList() {
+			for (uint i = 0; i < _all.size(); i++)
+				delete _all[i];
+		}
+
+		void add(SortItem *si) {
+			_all.push_back(si);
+
+			SortItem *addpoint = nullptr;
+			for (SortItem *si2 = _items; si2 != nullptr; si2 = si2->_next) {
+				if (!addpoint && si->listLessThan(*si2))
+					addpoint = si2;
+
+				if (si2->_occluded)
+					continue;
+
+				if (si->overlap(*si2)) {
+					if (si->below(*si2)) {
+						if (si2->_occl && si2->occludes(*si)) {
+							si->_occluded = true;
+							break;
+						} else {
+							si2->_depends.insert_sorted(si);
+						}
+					} else {
+						if (si->_occl && si->occludes(*si2)) {
+							si2->_occluded = true;
+						} else {
+							si->_depends.insert_sorted(si2);
+						}
+					}
+				}
+			}
+
+			if (addpoint) {
+				si->_next = addpoint;
+				si->_prev = addpoint->_prev;
+				addpoint->_prev = si;
+				if (si->_prev)
+					si->_prev->_next = si;
+				else
+					_items = si;
+			} else {
+				if (_itemsTail)
+					_itemsTail->_next = si;
+				if (!_items)
+					_items = si;
+				si->_next = nullptr;
+				si->_prev = _itemsTail;
+				_itemsTail = si;
+			}
+		}
+	};
+
+	// Items of a town-like scene: floors, walls, and things on them
+	static void makeItem(SortItem &si, Common::RandomSource &rnd, uint16 itemNum, int32 size) {
+		int32 x = rnd.getRandomNumber(size - 1) * 32;
+		int32 y = rnd.getRandomNumber(size - 1) * 32;
+		int32 z = rnd.getRandomNumber(4) * 8;
+		int32 xd = (rnd.getRandomNumber(3) + 1) * 32;
+		int32 yd = (rnd.getRandomNumber(3) + 1) * 32;
+		int32 zd = rnd.getRandomNumber(2) ? rnd.getRandomNumber(5) * 8 : 0;
+
+		si._itemNum = itemNum;
+		si._occl = rnd.getRandomNumber(3) == 0;
+		si._solid = rnd.getRandomNumber(1);
+		si._roof = rnd.getRandomNumber(7) == 0;
+		si._land = zd == 0 && rnd.getRandomNumber(1);
+		si._trans = rnd.getRandomNumber(15) == 0;
+		si._sprite = rnd.getRandomNumber(31) == 0;
+		si._occluded = false;
+		si.setBoxBounds(Ultima::Ultima8::Box(x, y, z, xd, yd, zd), 0, 0);
+
+		// Shape frames often go beyond the bounding box
+		si._sr.left -= rnd.getRandomNumber(8);
+		si._sr.top -= rnd.getRandomNumber(24);
+		si._sr.right += rnd.getRandomNumber(8);
+	}
+
+	static bool sameDepends(const SortItem *si1, const SortItem *si2) {
+		SortItem::DependsList::iterator it1 = si1->_depends.begin();
+		SortItem::DependsList::iterator it2 = si2->_depends.begin();
+		for (; it1 != si1->_depends.end() && it2 != si2->_depends.end(); ++it1, ++it2) {
+			if ((*it1)->_itemNum != (*it2)->_itemNum)
+				return false;
+		}
+		return !(it1 != si1->_depends.end()) && !(it2 != si2->_depends.end());
+	}
+
+	void checkScene(SortItem *items, const Common::Rect32 &clipWindow, uint32 seed, int count, int32 size) {
+		Ultima::Ultima8::SortItemList list;
+		list.clear(clipWindow);
+
+		Common::RandomSource rnd("sortitemlist");
+		rnd.setSeed(seed);
+		for (int i = 0; i < count; i++) {
+			items[i]._depends.clear();
+			makeItem(items[i], rnd, i + 1, size);
+			list.add(&items[i]);
+		}
+
+		ReferenceList reference;
+		rnd.setSeed(seed);
+		for (int i = 0; i < count; i++) {
+			SortItem *si = new SortItem();
+			makeItem(*si, rnd, i + 1, size);
+			reference.add(si);
+		}
+
+		const SortItem *si1 = list.getItems();
+		const SortItem *si2 = reference._items;
+		int pos = 0;
+		for (; si1 && si2; si1 = si1->_next, si2 = si2->_next, pos++) {
+			if (si1->_itemNum != si2->_itemNum || si1->_occluded != si2->_occluded || !sameDepends(si1, si2)) {
+				TS_FAIL(Common::String::format("Item %d at position %d differs, scene %u", si1->_itemNum, pos, seed).c_str());
+				return;
+			}
+		}
+		TS_ASSERT(!si1 && !si2);
+	}
+
+public:
+	void test_matches_comparing_all_items() {
+		SortItem *items = new SortItem[500];
+
+		// Large scenes, then a small clip window with items hanging out of it
+		for (uint32 seed = 1; seed <= 20; seed++)
+			checkScene(items, Common::Rect32(-400, -300, 400, 300), seed, 500, 24);
+		for (uint32 seed = 21; seed <= 40; seed++)
+			checkScene(items, Common::Rect32(-60, -20, 70, 90), seed, 100, 8);
+
+		delete[] items;
+	}
+
+	void test_speed() {
+#if BENCHMARK_TESTS
+		Common::install_null_g_system();
+
+		const int count = 2000;
+		const int frames = 10;
+		SortItem *items = new SortItem[count];
+		Ultima::Ultima8::SortItemList list;
+		Common::RandomSource rnd("sortitemlist");
+
+		// Items of a 1920x1080 view
+		Common::BenchmarkTimer timer;
+		for (int frame = 0; frame < frames; frame++) {
+			list.clear(Common::Rect32(-960, -540, 960, 540));
+			rnd.setSeed(frame);
+			for (int i = 0; i < count; i++) {
+				items[i]._depends.clear();
+				makeItem(items[i], rnd, i + 1, 160);
+				list.add(&items[i]);
+			}
+		}
+		debug("SortItemList: %d frames of %d items in %u ms", frames, count, timer.elapsed());
+
+		timer.restart();
+		for (int frame = 0; frame < frames; frame++) {
+			ReferenceList reference;
+			rnd.setSeed(frame);
+			for (int i = 0; i < count; i++) {
+				SortItem *si = new SortItem();
+				makeItem(*si, rnd, i + 1, 160);
+				reference.add(si);
+			}
+		}
+		debug("Comparing all items: %d frames of %d items in %u ms", frames, count, timer.elapsed());
+
+		delete[] items;
+#endif
+	}
+};
@@ -0,0 +1,225 @@
+#include <cxxtest/TestSuite.h>
+#include "test/instrset_detect.h"
+
+#include "common/random.h"
+#include "common/rect.h"
+#include "common/system.h"
+#include "common/textconsole.h"
+
+#include "graphics/blit.h"
+#include "graphics/blit/blit-scale.h"
+#include "graphics/surface.h"
+#include "graphics/transform_tools.h"
+
+#include "../system/benchmark.h"
+
+class BilinearBlitTestSuite : public CxxTest::TestSuite {
+	struct Kernels {
+		const char *name;
+		Graphics::BilinearBlit::ScaleRowFunc scaleRow;
+		Graphics::BilinearBlit::RotoscaleRowFunc rotoscaleRow;
+	};
+
+	// The row kernels the CPU can run, the generic code coming first
+	static Common::Array<Kernels> getKernels() {
+		Common::Array<Kernels> kernels;
+		Kernels generic = { "generic", nullptr, nullptr };
+		kernels.push_back(generic);
+#ifdef SCUMMVM_NEON
+		Kernels neon = { "NEON", Graphics::BilinearBlit::scaleRowNEON, Graphics::BilinearBlit::rotoscaleRowNEON };
+		kernels.push_back(neon);
+#endif
+#ifdef SCUMMVM_SSE2
+		if (instrset_detect() >= 2) {
+			Kernels sse2 = { "SSE2", Graphics::BilinearBlit::scaleRowSSE2, Graphics::BilinearBlit::rotoscaleRowSSE2 };
+			kernels.push_back(sse2);
+		}
+#endif
+#ifdef SCUMMVM_AVX2
+		if (instrset_detect() >= 8) {
+			Kernels avx2 = { "AVX2", Graphics::BilinearBlit::scaleRowAVX2, Graphics::BilinearBlit::rotoscaleRowAVX2 };
+			kernels.push_back(avx2);
+		}
+#endif
+		return kernels;
+	}
+
+	static void useKernels(const Kernels &kernels) {
+		Graphics::BilinearBlit::scaleRowFunc = kernels.scaleRow;
+		Graphics::BilinearBlit::rotoscaleRowFunc = kernels.rotoscaleRow;
+		Graphics::BilinearBlit::rowFuncsSelected = true;
+	}
+
+	static void fillRandom(Graphics::Surface &surface, Common::RandomSource &rnd) {
+		for (int y = 0; y < surface.h; y++) {
+			uint32 *p = (uint32 *)surface.getBasePtr(0, y);
+			for (int x = 0; x < surface.w; x++)
+				p[x] = rnd.getRandomNumber(0xffffffff);
+		}
+	}
+
+	static bool sameContents(const Graphics::Surface &a, const Graphics::Surface &b) {
+		for (int y = 0; y < a.h; y++) {
+			if (memcmp(a.getBasePtr(0, y), b.getBasePtr(0, y), a.w * a.format.bytesPerPixel))
+				return false;
+		}
+		return true;
+	}
+
+	static void scale(const Graphics::Surface &src, Graphics::Surface &dst, byte flip) {
+		Graphics::scaleBlitBilinear((byte *)dst.getPixels(), (const byte *)src.getPixels(), dst.pitch, src.pitch,
+		                            dst.w, dst.h, src.w, src.h, src.format, flip);
+	}
+
+	static void rotoscale(const Graphics::Surface &src, Graphics::Surface &dst, const Graphics::TransformStruct &transform, const Common::Point &hotspot) {
+		// Untouched pixels have to stay untouched
+		memset(dst.getPixels(), 0x5a, dst.pitch * dst.h);
+		Graphics::rotoscaleBlitBilinear((byte *)dst.getPixels(), (const byte *)src.getPixels(), dst.pitch, src.pitch,
+		                                dst.w, dst.h, src.w, src.h, src.format, transform, hotspot);
+	}
+
+	void checkScale(const Graphics::PixelFormat &format, int srcW, int srcH, int dstW, int dstH, byte flip) {
+		const Common::Array<Kernels> kernels = getKernels();
+		Common::RandomSource rnd("bilinear");
+
+		Graphics::Surface src, expected, actual;
+		src.create(srcW, srcH, format);
+		fillRandom(src, rnd);
+		expected.create(dstW, dstH, format);
+		actual.create(dstW, dstH, format);
+
+		useKernels(kernels[0]);
+		scale(src, expected, flip);
+
+		for (uint k = 1; k < kernels.size(); k++) {
+			useKernels(kernels[k]);
+			scale(src, actual, flip);
+			if (!sameContents(expected, actual))
+				TS_FAIL(Common::String::format("%s scale differs for %dx%d to %dx%d, flip %d, format %s",
+				                               kernels[k].name, srcW, srcH, dstW, dstH, flip, format.toString().c_str()).c_str());
+		}
+
+		src.free();
+		expected.free();
+		actual.free();
+	}
+
+	void checkRotoscale(const Graphics::PixelFormat &format, int srcW, int srcH, const Graphics::TransformStruct &transform) {
+		const Common::Array<Kernels> kernels = getKernels();
+		Common::RandomSource rnd("bilinear");
+
+		Common::Point hotspot;
+		Common::Rect rect = Graphics::TransformTools::newRect(Common::Rect(srcW, srcH), transform, &hotspot);
+
+		Graphics::Surface src, expected, actual;
+		src.create(srcW, srcH, format);
+		fillRandom(src, rnd);
+		expected.create(rect.width(), rect.height(), format);
+		actual.create(rect.width(), rect.height(), format);
+
+		useKernels(kernels[0]);
+		rotoscale(src, expected, transform, hotspot);
+
+		for (uint k = 1; k < kernels.size(); k++) {
+			useKernels(kernels[k]);
+			rotoscale(src, actual, transform, hotspot);
+			if (!sameContents(expected, actual))
+				TS_FAIL(Common::String::format("%s rotoscale differs for %dx%d, angle %d, flip %d, format %s",
+				                               kernels[k].name, srcW, srcH, transform._angle, transform._flip, format.toString().c_str()).c_str());
+		}
+
+		src.free();
+		expected.free();
+		actual.free();
+	}
+
+	static Common::Array<Graphics::PixelFormat> getFormats() {
+		Common::Array<Graphics::PixelFormat> formats;
+		formats.push_back(Graphics::PixelFormat(4, 8, 8, 8, 8, 24, 16, 8, 0));
+		formats.push_back(Graphics::PixelFormat(4, 8, 8, 8, 8, 0, 8, 16, 24));
+		// Not handled by the kernels, this has to keep using the generic code
+		formats.push_back(Graphics::PixelFormat(4, 8, 8, 8, 0, 16, 8, 0, 0));
+		return formats;
+	}
+
+public:
+	void tearDown() {
+		Graphics::BilinearBlit::rowFuncsSelected = false;
+		Graphics::BilinearBlit::scaleRowFunc = nullptr;
+		Graphics::BilinearBlit::rotoscaleRowFunc = nullptr;
+	}
+
+	void test_scale_matches_generic() {
+		const Common::Array<Graphics::PixelFormat> formats = getFormats();
+		const byte flips[] = { 0, Graphics::FLIP_H, Graphics::FLIP_V, Graphics::FLIP_HV };
+
+		for (uint f = 0; f < formats.size(); f++) {
+			for (uint i = 0; i < ARRAYSIZE(flips); i++) {
+				checkScale(formats[f], 64, 48, 157, 93, flips[i]);
+				checkScale(formats[f], 157, 93, 64, 48, flips[i]);
+				checkScale(formats[f], 3, 2, 11, 7, flips[i]);
+				checkScale(formats[f], 2, 2, 200, 3, flips[i]);
+			}
+		}
+	}
+
+	void test_rotoscale_matches_generic() {
+		const Common::Array<Graphics::PixelFormat> formats = getFormats();
+		const uint32 angles[] = { 1, 30, 45, 90, 135, 181, 270, 333 };
+
+		for (uint f = 0; f < formats.size(); f++) {
+			for (uint a = 0; a < ARRAYSIZE(angles); a++) {
+				for (int flip = 0; flip < 4; flip++) {
+					Graphics::TransformStruct transform(100, 100, angles[a], 20, 10);
+					transform._flip = flip;
+					checkRotoscale(formats[f], 61, 37, transform);
+
+					Graphics::TransformStruct zoomed(173, 62, angles[a], 0, 0);
+					zoomed._flip = flip;
+					checkRotoscale(formats[f], 61, 37, zoomed);
+				}
+			}
+		}
+	}
+
+	void test_bilinear_speed() {
+#if BENCHMARK_TESTS
+		Common::install_null_g_system();
+
+		const int frames = 100;
+		const Common::Array<Kernels> kernels = getKernels();
+		const Graphics::PixelFormat format(4, 8, 8, 8, 8, 24, 16, 8, 0);
+		Common::RandomSource rnd("bilinear");
+
+		Graphics::Surface src, scaled;
+		src.create(640, 480, format);
+		fillRandom(src, rnd);
+		scaled.create(1920, 1080, format);
+
+		Graphics::TransformStruct transform(100, 100, 45, 320, 240);
+		Common::Point hotspot;
+		Common::Rect rect = Graphics::TransformTools::newRect(Common::Rect(src.w, src.h), transform, &hotspot);
+		Graphics::Surface rotated;
+		rotated.create(rect.width(), rect.height(), format);
+
+		for (uint k = 0; k < kernels.size(); k++) {
+			useKernels(kernels[k]);
+
+			Common::BenchmarkTimer timer;
+			for (int i = 0; i < frames; i++)
+				scale(src, scaled, 0);
+			debug("640x480 to 1920x1080 bilinear scale with %s: %d frames in %u ms", kernels[k].name, frames, timer.elapsed());
+
+			timer.restart();
+			for (int i = 0; i < frames; i++)
+				rotoscale(src, rotated, transform, hotspot);
+			uint32 time = timer.elapsed();
+			debug("640x480 45 degree bilinear rotation with %s: %d frames in %u ms", kernels[k].name, frames, time);
+		}
+
+		src.free();
+		scaled.free();
+		rotated.free();
+#endif
+	}
+};
@@ -0,0 +1,192 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/random.h"
+#include "common/system.h"
+#include "common/textconsole.h"
+
+#include "graphics/scalerplugin.h"
+#include "graphics/surface.h"
+#include "graphics/scaler/dotmatrix.h"
+#include "graphics/scaler/normal.h"
+#include "graphics/scaler/pm.h"
+#include "graphics/scaler/sai.h"
+#include "graphics/scaler/scalebit.h"
+#include "graphics/scaler/tv.h"
+#ifdef USE_HQ_SCALERS
+#include "graphics/scaler/hq.h"
+#endif
+#ifdef USE_EDGE_SCALERS
+#include "graphics/scaler/edge.h"
+#endif
+
+#include "../system/benchmark.h"
+
+class ScalerBandsTestSuite : public CxxTest::TestSuite {
+	// Enough for every scaler
+	static const int kPadding = 4;
+
+	static Scaler *createScaler(int index, const Graphics::PixelFormat &format) {
+		switch (index) {
+		case 0:
+			return new NormalScaler(format);
+		case 1:
+			return new DotMatrixScaler(format);
+		case 2:
+			return new PMScaler(format);
+		case 3:
+			return new SAIScaler(format);
+		case 4:
+			return new SuperSAIScaler(format);
+		case 5:
+			return new SuperEagleScaler(format);
+		case 6:
+			return new AdvMameScaler(format);
+		case 7:
+			return new TVScaler(format);
+#ifdef USE_HQ_SCALERS
+		case 8:
+			return new HQScaler(format);
+#endif
+#ifdef USE_EDGE_SCALERS
+		case 9:
+			return new EdgeScaler(format);
+#endif
+		default:
+			return nullptr;
+		}
+	}
+
+	static const int kScalerCount = 10;
+
+	static void fillRandom(Graphics::Surface &surface, Common::RandomSource &rnd, int maxColor) {
+		// Few colors so the scalers find edges and unchanged areas
+		for (int y = 0; y < surface.h; y++) {
+			for (int x = 0; x < surface.w; x++) {
+				uint8 c = rnd.getRandomNumber(maxColor) * 255 / maxColor;
+				surface.setPixel(x, y, surface.format.RGBToColor(c, 255 - c, c / 2));
+			}
+		}
+	}
+
+	static bool sameContents(const Graphics::Surface &a, const Graphics::Surface &b) {
+		for (int y = 0; y < a.h; y++) {
+			if (memcmp(a.getBasePtr(0, y), b.getBasePtr(0, y), a.w * a.format.bytesPerPixel))
+				return false;
+		}
+		return true;
+	}
+
+	static void scaleRect(Scaler *scaler, const Graphics::Surface &src, Graphics::Surface &dst, const Common::Rect &r) {
+		uint factor = scaler->getFactor();
+		scaler->scale((const uint8 *)src.getBasePtr(r.left + kPadding, r.top + kPadding), src.pitch,
+		              (uint8 *)dst.getBasePtr(r.left * factor, r.top * factor), dst.pitch,
+		              r.width(), r.height(), r.left, r.top);
+	}
+
+	void checkScaler(int index, const Graphics::PixelFormat &format, int bandHeight) {
+		const int w = 80, h = 61;
+		Common::RandomSource rnd("scalerbands");
+
+		Scaler *whole = createScaler(index, format);
+		Scaler *banded = createScaler(index, format);
+		if (!whole)
+			return;
+		banded->setBandHeight(bandHeight);
+
+		Graphics::Surface src;
+		src.create(w + kPadding * 2, h + kPadding * 2, format);
+		fillRandom(src, rnd, 3);
+
+		bool useSource = dynamic_cast<SourceScaler *>(whole) != nullptr;
+		if (useSource) {
+			whole->setSource((const byte *)src.getPixels(), src.pitch, w, h, kPadding);
+			whole->enableSource(true);
+			banded->setSource((const byte *)src.getPixels(), src.pitch, w, h, kPadding);
+			banded->enableSource(true);
+		}
+
+		uint lastFactor = 0;
+		for (uint factor = whole->getFactor(); factor != lastFactor; lastFactor = factor, factor = whole->increaseFactor()) {
+			banded->setFactor(factor);
+
+			Graphics::Surface expected, actual;
+			expected.create(w * factor, h * factor, format);
+			actual.create(w * factor, h * factor, format);
+
+			// A full frame, then partial updates which rely on the old source
+			const Common::Rect rects[] = { Common::Rect(w, h), Common::Rect(5, 3, 60, 58), Common::Rect(0, 20, w, 29) };
+			for (int i = 0; i < ARRAYSIZE(rects); i++) {
+				if (i > 0) {
+					Graphics::Surface area = src.getSubArea(Common::Rect(kPadding + 10, kPadding + 10, kPadding + 50, kPadding + 40));
+					fillRandom(area, rnd, 3);
+
+					// Rows which changed right above unchanged ones, where a
+					// band could see the old source of the previous one
+					for (int y = i; y < h; y += 5)
+						src.hLine(kPadding, kPadding + y, kPadding + w - 1, format.RGBToColor(i * 40, 7, 99));
+				}
+
+				scaleRect(whole, src, expected, rects[i]);
+				scaleRect(banded, src, actual, rects[i]);
+				if (!sameContents(expected, actual))
+					TS_FAIL(Common::String::format("Scaler %d at %dx with bands of %d rows differs for rect %d, format %s",
+					                               index, factor, bandHeight, i, format.toString().c_str()).c_str());
+			}
+
+			expected.free();
+			actual.free();
+		}
+
+		src.free();
+		delete whole;
+		delete banded;
+	}
+
+public:
+	void test_bands_match_whole_rect() {
+		const Graphics::PixelFormat formats[] = {
+			Graphics::PixelFormat(2, 5, 6, 5, 0, 11, 5, 0, 0),
+			Graphics::PixelFormat(4, 8, 8, 8, 8, 24, 16, 8, 0)
+		};
+		const int bandHeights[] = { 4, 7, 16 };
+
+		for (int f = 0; f < ARRAYSIZE(formats); f++) {
+			for (int i = 0; i < kScalerCount; i++) {
+				for (int b = 0; b < ARRAYSIZE(bandHeights); b++)
+					checkScaler(i, formats[f], bandHeights[b]);
+			}
+		}
+	}
+
+	void test_bands_speed() {
+#if BENCHMARK_TESTS && defined(USE_HQ_SCALERS)
+		Common::install_null_g_system();
+
+		const int frames = 100;
+		const Graphics::PixelFormat format(4, 8, 8, 8, 8, 24, 16, 8, 0);
+		Common::RandomSource rnd("scalerbands");
+
+		Graphics::Surface src, dst;
+		src.create(640 + kPadding * 2, 480 + kPadding * 2, format);
+		fillRandom(src, rnd, 15);
+		dst.create(640 * 3, 480 * 3, format);
+
+		Scaler *scaler = new HQScaler(format);
+		scaler->setFactor(3);
+
+		const int bandHeights[] = { 0, 8, 32 };
+		for (int b = 0; b < ARRAYSIZE(bandHeights); b++) {
+			scaler->setBandHeight(bandHeights[b]);
+
+			Common::BenchmarkTimer timer;
+			for (int i = 0; i < frames; i++)
+				scaleRect(scaler, src, dst, Common::Rect(640, 480));
+			debug("640x480 HQ3x with bands of %d rows: %d frames in %u ms", bandHeights[b], frames, timer.elapsed());
+		}
+
+		delete scaler;
+		src.free();
+		dst.free();
+#endif
+	}
+};
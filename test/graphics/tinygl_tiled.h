@@ -0,0 +1,168 @@
+#include <cxxtest/TestSuite.h>
+
+#ifdef USE_TINYGL
+
+#include "graphics/tinygl/tinygl.h"
+
+// renders the same scene with and without tiled draw call execution
+// and checks that the frame buffers are identical
+
+class TinyGLTiledTestSuite : public CxxTest::TestSuite {
+	static const int kWidth = 61;
+	static const int kHeight = 47;
+
+	// Rotated, scaled and plain blits of a gradient, with a triangle drawn
+	// over them
+	void drawBlits(TinyGL::BlitImage *image, int frame) {
+		tglEnable(TGL_BLEND);
+		tglBlendFunc(TGL_SRC_ALPHA, TGL_ONE_MINUS_SRC_ALPHA);
+
+		TinyGL::BlitTransform rotated(20, 8);
+		rotated.rotate(30 + frame * 25, 6, 4);
+		rotated.tint(0.8f);
+		tglBlit(image, rotated);
+
+		// Scaled blits clipped by the screen edges read past their image,
+		// so this one is kept inside the screen
+		TinyGL::BlitTransform scaled(3, 30);
+		scaled.scale(40, 13);
+		tglBlit(image, scaled);
+
+		tglBlit(image, 35 + frame, 2);
+
+		tglDisable(TGL_DEPTH_TEST);
+		tglBegin(TGL_TRIANGLES);
+		tglColor4ub(255, 0, 255, 120); tglVertex2f(-0.3f, -0.9f);
+		tglColor4ub(0, 255, 255, 120); tglVertex2f(0.9f, 0.1f);
+		tglColor4ub(255, 255, 255, 120); tglVertex2f(-0.1f, 0.8f);
+		tglEnd();
+	}
+
+	void drawScene(int frame) {
+		tglViewport(0, 0, kWidth, kHeight);
+		tglClearColor(0.1f, 0.2f, 0.3f, 1.0f);
+		tglClearDepth(1.0f);
+		tglClear(TGL_COLOR_BUFFER_BIT | TGL_DEPTH_BUFFER_BIT);
+
+		tglMatrixMode(TGL_PROJECTION);
+		tglLoadIdentity();
+		tglMatrixMode(TGL_MODELVIEW);
+		tglLoadIdentity();
+
+		tglEnable(TGL_DEPTH_TEST);
+		tglDisable(TGL_BLEND);
+		tglShadeModel(TGL_SMOOTH);
+		tglBegin(TGL_TRIANGLES);
+		tglColor4ub(255, 0, 0, 255); tglVertex3f(-0.9f, -0.8f, 0.5f);
+		tglColor4ub(0, 255, 0, 255); tglVertex3f(0.7f + frame * 0.1f, -0.6f, -0.5f);
+		tglColor4ub(0, 0, 255, 255); tglVertex3f(-0.2f, 0.9f, 0.0f);
+		tglEnd();
+
+		tglBegin(TGL_QUADS);
+		tglColor4ub(255, 255, 0, 255);
+		tglVertex3f(-0.5f, -0.5f, 0.2f);
+		tglVertex3f(1.5f, -0.5f, -0.2f);
+		tglVertex3f(1.5f, 0.4f, 0.2f);
+		tglVertex3f(-0.5f, 0.4f, -0.2f);
+		tglEnd();
+
+		tglEnable(TGL_BLEND);
+		tglBlendFunc(TGL_SRC_ALPHA, TGL_ONE_MINUS_SRC_ALPHA);
+		tglDisable(TGL_DEPTH_TEST);
+		tglBegin(TGL_TRIANGLE_FAN);
+		tglColor4ub(255, 255, 255, 100); tglVertex2f(0.0f, 0.0f);
+		for (int i = 0; i <= 12; i++) {
+			float a = i * 3.14159265f / 6;
+			tglColor4ub(20 * i, 255 - 20 * i, 128, 180);
+			tglVertex2f(0.6f * cosf(a), 0.8f * sinf(a));
+		}
+		tglEnd();
+
+		tglBegin(TGL_LINES);
+		tglColor4ub(0, 0, 0, 255);
+		tglVertex2f(-1.0f, -1.0f); tglVertex2f(1.0f, 0.9f);
+		tglEnd();
+	}
+
+	void renderFrames(bool dirtyRects, bool blits, int tileSize, Graphics::Surface *frames, int frameCount) {
+		TinyGL::ContextHandle *context = TinyGL::createContext(kWidth, kHeight, Graphics::PixelFormat::createFormatARGB32(), 16, false, dirtyRects);
+		TinyGL::setContext(context);
+		TinyGL::setRenderTileSize(tileSize);
+
+		TinyGL::BlitImage *image = nullptr;
+		if (blits) {
+			Graphics::Surface gradient;
+			gradient.create(16, 12, Graphics::PixelFormat::createFormatARGB32());
+			for (int y = 0; y < gradient.h; y++) {
+				for (int x = 0; x < gradient.w; x++) {
+					gradient.setPixel(x, y, gradient.format.ARGBToColor(128 + x * 8, x * 16, y * 20, 255 - x * y));
+				}
+			}
+			image = tglGenBlitImage();
+			tglUploadBlitImage(image, gradient, 0, false);
+			gradient.free();
+		}
+
+		for (int frame = 0; frame < frameCount; frame++) {
+			drawScene(frame);
+			if (blits) {
+				drawBlits(image, frame);
+			}
+			TinyGL::presentBuffer();
+
+			Graphics::Surface surface;
+			TinyGL::getSurfaceRef(surface);
+			frames[frame].copyFrom(surface);
+		}
+
+		if (image) {
+			tglDeleteBlitImage(image);
+		}
+		TinyGL::destroyContext(context);
+	}
+
+	void checkTiling(bool dirtyRects, bool blits) {
+		static const int kFrames = 3;
+		static const int tileSizes[] = { 1, 7, 16, 64 };
+
+		Graphics::Surface reference[kFrames];
+		renderFrames(dirtyRects, blits, 0, reference, kFrames);
+
+		for (int t = 0; t < ARRAYSIZE(tileSizes); t++) {
+			Graphics::Surface tiled[kFrames];
+			renderFrames(dirtyRects, blits, tileSizes[t], tiled, kFrames);
+
+			for (int frame = 0; frame < kFrames; frame++) {
+				bool equal = true;
+				for (int y = 0; y < kHeight && equal; y++) {
+					equal = memcmp(reference[frame].getBasePtr(0, y), tiled[frame].getBasePtr(0, y), kWidth * 4) == 0;
+				}
+				TSM_ASSERT(Common::String::format("tile size %d, frame %d", tileSizes[t], frame).c_str(), equal);
+				tiled[frame].free();
+			}
+		}
+
+		for (int frame = 0; frame < kFrames; frame++) {
+			reference[frame].free();
+		}
+	}
+
+public:
+	void test_tiled_simple() {
+		checkTiling(false, false);
+	}
+
+	void test_tiled_dirty_rects() {
+		checkTiling(true, false);
+	}
+
+	void test_tiled_blits_simple() {
+		checkTiling(false, true);
+	}
+
+	void test_tiled_blits_dirty_rects() {
+		checkTiling(true, true);
+	}
+};
+
+#endif
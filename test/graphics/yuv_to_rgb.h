@@ -0,0 +1,229 @@
+#include <cxxtest/TestSuite.h>
+#include "test/instrset_detect.h"
+
+#include "common/random.h"
+#include "common/system.h"
+#include "common/textconsole.h"
+
+#include "graphics/surface.h"
+#include "graphics/yuv_to_rgb.h"
+#include "graphics/yuv_to_rgb_intern.h"
+
+#include "../system/benchmark.h"
+
+class YUVToRGBTestSuite : public CxxTest::TestSuite {
+	typedef Graphics::YUVToRGBRowFunc RowFunc;
+
+	struct Kernel {
+		const char *name;
+		RowFunc func;
+	};
+
+	// The row converters the CPU can run, the lookup tables coming first
+	static Common::Array<Kernel> getKernels() {
+		Common::Array<Kernel> kernels;
+		Kernel tables = { "tables", nullptr };
+		kernels.push_back(tables);
+#ifdef SCUMMVM_NEON
+		Kernel neon = { "NEON", Graphics::convertYUVToRGBRowNEON };
+		kernels.push_back(neon);
+#endif
+#ifdef SCUMMVM_SSE2
+		if (instrset_detect() >= 2) {
+			Kernel sse2 = { "SSE2", Graphics::convertYUVToRGBRowSSE2 };
+			kernels.push_back(sse2);
+		}
+#endif
+#ifdef SCUMMVM_AVX2
+		if (instrset_detect() >= 8) {
+			Kernel avx2 = { "AVX2", Graphics::convertYUVToRGBRowAVX2 };
+			kernels.push_back(avx2);
+		}
+#endif
+		return kernels;
+	}
+
+	static Common::Array<Graphics::PixelFormat> getFormats() {
+		Common::Array<Graphics::PixelFormat> formats;
+		formats.push_back(Graphics::PixelFormat(2, 5, 6, 5, 0, 11, 5, 0, 0));
+		formats.push_back(Graphics::PixelFormat(2, 4, 4, 4, 4, 12, 8, 4, 0));
+		formats.push_back(Graphics::PixelFormat(4, 8, 8, 8, 8, 24, 16, 8, 0));
+		formats.push_back(Graphics::PixelFormat(4, 8, 8, 8, 0, 0, 8, 16, 0));
+		return formats;
+	}
+
+	enum Layout {
+		kLayout444,
+		kLayout422,
+		kLayout420,
+		kLayout420Alpha,
+		kLayout410
+	};
+
+	struct Planes {
+		Common::Array<byte> y, u, v, a;
+		int width, height, yPitch, uvPitch;
+
+		Planes(int w, int h, int uvW, int uvH) : width(w), height(h), yPitch(w + 3), uvPitch(uvW + 5) {
+			y.resize(yPitch * h);
+			a.resize(yPitch * h);
+			u.resize(uvPitch * uvH);
+			v.resize(uvPitch * uvH);
+		}
+	};
+
+	static void convert(RowFunc func, Graphics::Surface &dst, Graphics::YUVToRGBManager::LuminanceScale scale, Layout layout, const Planes &p) {
+		YUVToRGBMan._convertRow = func;
+		YUVToRGBMan._convertRowSelected = true;
+
+		switch (layout) {
+		case kLayout444:
+			YUVToRGBMan.convert444(&dst, scale, p.y.data(), p.u.data(), p.v.data(), p.width, p.height, p.yPitch, p.uvPitch);
+			break;
+		case kLayout422:
+			YUVToRGBMan.convert422(&dst, scale, p.y.data(), p.u.data(), p.v.data(), p.width, p.height, p.yPitch, p.uvPitch);
+			break;
+		case kLayout420:
+			YUVToRGBMan.convert420(&dst, scale, p.y.data(), p.u.data(), p.v.data(), p.width, p.height, p.yPitch, p.uvPitch);
+			break;
+		case kLayout420Alpha:
+			YUVToRGBMan.convert420Alpha(&dst, scale, p.y.data(), p.u.data(), p.v.data(), p.a.data(), p.width, p.height, p.yPitch, p.uvPitch);
+			break;
+		case kLayout410:
+			YUVToRGBMan.convert410(&dst, scale, p.y.data(), p.u.data(), p.v.data(), p.width, p.height, p.yPitch, p.uvPitch);
+			break;
+		}
+	}
+
+	// Converts the planes with every kernel, and checks that they all produce
+	// the same pixels as the lookup tables
+	void checkKernels(Layout layout, const Planes &p) {
+		const Common::Array<Kernel> kernels = getKernels();
+		const Common::Array<Graphics::PixelFormat> formats = getFormats();
+		const Graphics::YUVToRGBManager::LuminanceScale scales[] = { Graphics::YUVToRGBManager::kScaleFull, Graphics::YUVToRGBManager::kScaleITU };
+
+		for (uint f = 0; f < formats.size(); f++) {
+			for (uint s = 0; s < ARRAYSIZE(scales); s++) {
+				Graphics::Surface expected;
+				expected.create(p.width, p.height, formats[f]);
+				convert(nullptr, expected, scales[s], layout, p);
+
+				for (uint k = 1; k < kernels.size(); k++) {
+					Graphics::Surface actual;
+					actual.create(p.width, p.height, formats[f]);
+					convert(kernels[k].func, actual, scales[s], layout, p);
+
+					bool same = true;
+					for (int h = 0; h < p.height && same; h++)
+						same = memcmp(expected.getBasePtr(0, h), actual.getBasePtr(0, h), p.width * formats[f].bytesPerPixel) == 0;
+
+					if (!same)
+						TS_FAIL(Common::String::format("%s differs for layout %d, format %s, scale %d", kernels[k].name, layout, formats[f].toString().c_str(), s).c_str());
+
+					actual.free();
+				}
+
+				expected.free();
+			}
+		}
+	}
+
+	static void fillRandom(Common::Array<byte> &plane, Common::RandomSource &rnd) {
+		for (uint i = 0; i < plane.size(); i++)
+			plane[i] = rnd.getRandomNumber(255);
+	}
+
+	static Planes makeRandomPlanes(Layout layout, int width, int height) {
+		Common::RandomSource rnd("yuv");
+		int uvWidth = width, uvHeight = height;
+
+		if (layout == kLayout422) {
+			uvWidth /= 2;
+		} else if (layout == kLayout420 || layout == kLayout420Alpha) {
+			uvWidth /= 2;
+			uvHeight /= 2;
+		} else if (layout == kLayout410) {
+			// With the extra row and column the interpolation reads from
+			uvWidth = width / 4 + 1;
+			uvHeight = height / 4 + 1;
+		}
+
+		Planes p(width, height, uvWidth, uvHeight);
+		fillRandom(p.y, rnd);
+		fillRandom(p.u, rnd);
+		fillRandom(p.v, rnd);
+		fillRandom(p.a, rnd);
+		return p;
+	}
+
+public:
+	void test_every_yuv_value() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		Common::install_null_g_system();
+
+		// One row per v value, every y value along each row, and the width
+		// is not a multiple of the vector sizes
+		for (int u = 0; u < 256; u += 15) {
+			Planes p(256 + 7, 256, 256 + 7, 256);
+			for (int h = 0; h < p.height; h++) {
+				for (int w = 0; w < p.width; w++) {
+					p.y[h * p.yPitch + w] = w & 0xFF;
+					p.u[h * p.uvPitch + w] = u;
+					p.v[h * p.uvPitch + w] = h;
+				}
+			}
+
+			checkKernels(kLayout444, p);
+		}
+#endif
+	}
+
+	void test_subsampled_layouts() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		Common::install_null_g_system();
+
+		const Layout layouts[] = { kLayout444, kLayout422, kLayout420, kLayout420Alpha, kLayout410 };
+		for (uint l = 0; l < ARRAYSIZE(layouts); l++) {
+			checkKernels(layouts[l], makeRandomPlanes(layouts[l], 100, 36));
+			checkKernels(layouts[l], makeRandomPlanes(layouts[l], 8, 4));
+		}
+
+		// Wider than the chunks 410 interpolates chroma in
+		checkKernels(kLayout410, makeRandomPlanes(kLayout410, 300, 8));
+#endif
+	}
+
+	void test_conversion_speed() {
+#if BENCHMARK_TESTS
+		Common::install_null_g_system();
+
+		const int frames = 500;
+		const Layout layouts[] = { kLayout420, kLayout444 };
+		const char *const layoutNames[] = { "420", "444" };
+		const Common::Array<Kernel> kernels = getKernels();
+		const Graphics::PixelFormat formats[] = { Graphics::PixelFormat(2, 5, 6, 5, 0, 11, 5, 0, 0), Graphics::PixelFormat(4, 8, 8, 8, 8, 24, 16, 8, 0) };
+
+		for (uint l = 0; l < ARRAYSIZE(layouts); l++) {
+			const Planes p = makeRandomPlanes(layouts[l], 1280, 720);
+
+			for (uint f = 0; f < ARRAYSIZE(formats); f++) {
+				Graphics::Surface dst;
+				dst.create(p.width, p.height, formats[f]);
+
+				for (uint k = 0; k < kernels.size(); k++) {
+					Common::BenchmarkTimer timer;
+					for (int i = 0; i < frames; i++)
+						convert(kernels[k].func, dst, Graphics::YUVToRGBManager::kScaleITU, layouts[l], p);
+					const uint32 time = timer.elapsed();
+
+					debug("YUV%s to %d bpp with %s: %d frames in %u ms (%f megapixels per second)",
+					      layoutNames[l], formats[f].bytesPerPixel * 8, kernels[k].name, frames, time,
+					      (double)p.width * p.height * frames / (time * 1000.0));
+				}
+
+				dst.free();
+			}
+		}
+#endif
+	}
+};
@@ -5,25 +5,38 @@
 #
 ######################################################################
 
-TESTS        := $(srcdir)/test/common/*.h $(srcdir)/test/common/formats/*.h $(srcdir)/test/audio/*.h $(srcdir)/test/math/*.h $(srcdir)/test/image/*.h
+TESTS        := $(srcdir)/test/common/*.h $(srcdir)/test/common/formats/*.h $(srcdir)/test/audio/*.h $(srcdir)/test/math/*.h $(srcdir)/test/image/*.h $(srcdir)/test/video/*.h $(srcdir)/test/graphics/yuv_to_rgb.h $(srcdir)/test/graphics/bilinear_blit.h
 TEST_LIBS    :=
 
 ifdef POSIX
+TESTS += $(srcdir)/test/backends/*.h $(srcdir)/test/engines/advanced_detector_cache.h
 TEST_LIBS += test/system/null_osystem.o \
 	backends/fs/posix/posix-fs-factory.o \
 	backends/fs/posix/posix-fs.o \
 	backends/fs/posix/posix-iostream.o \
+	backends/saves/default/default-saves.o \
+	backends/saves/savefile.o \
 	backends/fs/abstract-fs.o \
 	backends/fs/stdiostream.o \
-	backends/modular-backend.o
+	backends/mixer/null/null-mixer.o \
+	backends/timer/default/default-timer.o \
+	backends/modular-backend.o \
+	engines/advancedDetectorCache.o
+ifdef USE_CLOUD
+# The save file managers sync the saves through the cloud manager
+TEST_LIBS += backends/libbackends.a base/libbase.a
+endif
 endif
 
 ifdef WIN32
+TESTS += $(srcdir)/test/backends/default_timer.h
 TEST_LIBS += test/system/null_osystem.o \
 	backends/fs/windows/windows-fs-factory.o \
 	backends/fs/windows/windows-fs.o \
 	backends/fs/abstract-fs.o \
 	backends/fs/stdiostream.o \
+	backends/mixer/null/null-mixer.o \
+	backends/timer/default/default-timer.o \
 	backends/modular-backend.o \
 	backends/platform/sdl/win32/win32_wrapper.o
 endif
@@ -32,7 +45,11 @@ ifdef USE_TINYGL
 TESTS += $(srcdir)/test/graphics/tinygl*.h
 endif
 
-TEST_LIBS +=	audio/libaudio.a math/libmath.a common/formats/libformats.a common/compression/libcompression.a common/libcommon.a image/libimage.a graphics/libgraphics.a
+ifdef USE_SCALERS
+TESTS += $(srcdir)/test/graphics/scaler_bands.h
+endif
+
+TEST_LIBS +=	video/libvideo.a audio/libaudio.a math/libmath.a common/formats/libformats.a common/compression/libcompression.a common/libcommon.a image/libimage.a graphics/libgraphics.a
 
 ifeq ($(ENABLE_WINTERMUTE), STATIC_PLUGIN)
 	TESTS += $(srcdir)/test/engines/wintermute/*.h
@@ -49,11 +66,23 @@ endif
 	TEST_LIBS += engines/ultima/libultima.a
 endif
 
+ifeq ($(ENABLE_SCUMM), STATIC_PLUGIN)
+ifdef ENABLE_SCUMM_7_8
+	TESTS += $(srcdir)/test/engines/scumm/*.h
+	TEST_LIBS += engines/scumm/libscumm.a
+endif
+endif
+
 ifeq ($(ENABLE_TWINE), STATIC_PLUGIN)
 	TESTS += $(srcdir)/test/engines/twine/*.h
 	TEST_LIBS += engines/twine/libtwine.a
 endif
 
+ifeq ($(ENABLE_GLK), STATIC_PLUGIN)
+	TESTS += $(srcdir)/test/engines/glk/glulx/*.h
+	TEST_LIBS += engines/glk/libglk.a
+endif
+
 #
 TEST_FLAGS   := --runner=StdioPrinter --no-std --no-eh
 TEST_CFLAGS  := $(CFLAGS) -I$(srcdir)/test/cxxtest
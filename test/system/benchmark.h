@@ -0,0 +1,32 @@
+#ifndef TEST_BENCHMARK
+#define TEST_BENCHMARK 1
+
+#include "common/system.h"
+#include "common/util.h"
+
+#include "null_osystem.h"
+
+// The speed tests only run when built with SLOW_TESTS, and need the null
+// OSystem to measure time
+#if NULL_OSYSTEM_IS_AVAILABLE && defined(SLOW_TESTS)
+#define BENCHMARK_TESTS 1
+
+namespace Common {
+// Measures the time since it was started, in milliseconds. The time is at
+// least 1 ms, so that rates can be computed from it.
+class BenchmarkTimer {
+public:
+	BenchmarkTimer() { restart(); }
+
+	void restart() { _start = g_system->getMillis(); }
+	uint32 elapsed() const { return MAX<uint32>(g_system->getMillis() - _start, 1); }
+
+private:
+	uint32 _start;
+};
+}
+#else
+#define BENCHMARK_TESTS 0
+#endif
+
+#endif
@@ -15,6 +15,11 @@ void Common::install_null_g_system() {
 #endif
 
 	g_system = OSystem_NULL_create(silenceLogs);
+	g_system->initBackend();
+}
+
+void Common::set_null_g_system_savefile_manager(Common::SaveFileManager *saveFileMan) {
+	dynamic_cast<OSystem_NULL *>(g_system)->setSavefileManager(saveFileMan);
 }
 
 void OSystem_NULL::quit() {
@@ -3,6 +3,8 @@
 namespace Common {
 #if defined(POSIX) || defined(WIN32)
 void install_null_g_system();
+// Makes g_system use the given save file manager, which it then owns
+void set_null_g_system_savefile_manager(class SaveFileManager *saveFileMan);
 #define NULL_OSYSTEM_IS_AVAILABLE 1
 #else
 #define NULL_OSYSTEM_IS_AVAILABLE 0
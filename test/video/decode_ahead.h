@@ -0,0 +1,148 @@
+#include <cxxtest/TestSuite.h>
+
+#include "graphics/surface.h"
+#include "video/video_decoder.h"
+
+#include "../system/null_osystem.h"
+
+// A decoder playing a synthetic track
+class SyntheticDecoder : public Video::VideoDecoder {
+	// 10 frames per second of 4x4 CLUT8 frames filled with their number. The
+	// palette changes every third frame.
+	class SyntheticTrack : public FixedRateVideoTrack {
+	public:
+		SyntheticTrack(int frameCount) : _frameCount(frameCount), _curFrame(-1), _dirtyPalette(false) {
+			_surface.create(4, 4, Graphics::PixelFormat::createFormatCLUT8());
+			memset(_palette, 0, sizeof(_palette));
+		}
+
+		~SyntheticTrack() {
+			_surface.free();
+		}
+
+		uint16 getWidth() const override { return 4; }
+		uint16 getHeight() const override { return 4; }
+		Graphics::PixelFormat getPixelFormat() const override { return _surface.format; }
+		int getCurFrame() const override { return _curFrame; }
+		int getFrameCount() const override { return _frameCount; }
+
+		const Graphics::Surface *decodeNextFrame() override {
+			_curFrame++;
+			_surface.fillRect(Common::Rect(4, 4), _curFrame);
+
+			_dirtyPalette = _curFrame % 3 == 0;
+			if (_dirtyPalette) {
+				for (int i = 0; i < 256 * 3; i++)
+					_palette[i] = _curFrame + i;
+			}
+			return &_surface;
+		}
+
+		const byte *getPalette() const override {
+			_dirtyPalette = false;
+			return _palette;
+		}
+
+		bool hasDirtyPalette() const override { return _dirtyPalette; }
+
+		bool isRewindable() const override { return true; }
+
+		bool rewind() override {
+			_curFrame = -1;
+			return true;
+		}
+
+	protected:
+		Common::Rational getFrameRate() const override { return 10; }
+
+	private:
+		int _frameCount;
+		int _curFrame;
+		Graphics::Surface _surface;
+		byte _palette[256 * 3];
+		mutable bool _dirtyPalette;
+	};
+
+public:
+	SyntheticDecoder(int frameCount) {
+		addTrack(new SyntheticTrack(frameCount));
+	}
+
+	bool loadStream(Common::SeekableReadStream *stream) override { return false; }
+};
+
+class DecodeAheadTestSuite : public CxxTest::TestSuite {
+public:
+	// Compares a frame and the palette picked up with it with the ones of the
+	// decoder without a queue
+	void checkFrame(Video::VideoDecoder &decoder, Video::VideoDecoder &reference) {
+		const Graphics::Surface *frame = decoder.decodeNextFrame();
+		const Graphics::Surface *referenceFrame = reference.decodeNextFrame();
+		TS_ASSERT_EQUALS(frame != 0, referenceFrame != 0);
+		if (frame && referenceFrame)
+			TS_ASSERT_EQUALS(*(const byte *)frame->getPixels(), *(const byte *)referenceFrame->getPixels());
+
+		TS_ASSERT_EQUALS(decoder.getCurFrame(), reference.getCurFrame());
+		TS_ASSERT_EQUALS(decoder.hasDirtyPalette(), reference.hasDirtyPalette());
+		if (reference.hasDirtyPalette()) {
+			const byte *palette = decoder.getPalette();
+			const byte *referencePalette = reference.getPalette();
+			TS_ASSERT(palette);
+			if (palette && referencePalette)
+				TS_ASSERT_SAME_DATA(palette, referencePalette, 256 * 3);
+		}
+	}
+
+	void test_queue_matches_decoding_on_demand() {
+		Common::install_null_g_system();
+
+		SyntheticDecoder decoder(20), reference(20);
+		TS_ASSERT(decoder.setDecodeAhead(4));
+
+		// Fill the queue up, so the frames with a new palette are decoded
+		// long before they are returned
+		for (int i = 0; i < 20; i++) {
+			while (decoder.decodeAhead())
+				;
+			TS_ASSERT_LESS_THAN_EQUALS(decoder.getDecodeAheadStats().queuedFrames, 4u);
+			checkFrame(decoder, reference);
+		}
+		TS_ASSERT(decoder.endOfVideo());
+		TS_ASSERT_EQUALS(decoder.getDecodeAheadStats().underruns, 0u);
+
+		// Seeking flushes the queue
+		TS_ASSERT(decoder.rewind());
+		TS_ASSERT(reference.rewind());
+		TS_ASSERT_EQUALS(decoder.getDecodeAheadStats().queuedFrames, 0u);
+		for (int i = 0; i < 5; i++) {
+			decoder.decodeAhead();
+			checkFrame(decoder, reference);
+		}
+
+		// Frames asked for with an empty queue are decoded right away
+		uint32 underruns = decoder.getDecodeAheadStats().underruns;
+		checkFrame(decoder, reference);
+		TS_ASSERT_EQUALS(decoder.getDecodeAheadStats().underruns, underruns + 1);
+	}
+
+	void test_decode_past_end_time() {
+		Common::install_null_g_system();
+
+		SyntheticDecoder decoder(20), reference(20);
+		TS_ASSERT(decoder.setDecodeAhead(4));
+		decoder.setEndFrame(5);
+		reference.setEndFrame(5);
+		decoder.start();
+		reference.start();
+
+		// Nothing is queued past the end time, but the frames are still
+		// decoded when asked for
+		for (int i = 0; i < 8; i++) {
+			while (decoder.decodeAhead())
+				;
+			TS_ASSERT_LESS_THAN_EQUALS(decoder.getDecodeAheadStats().queuedFrames, 4u);
+			checkFrame(decoder, reference);
+		}
+		TS_ASSERT_EQUALS(decoder.getCurFrame(), 7);
+	}
+};
@@ -48,12 +48,20 @@ VideoDecoder::VideoDecoder() {
 	_canSetDither = true;
 	_canSetDefaultFormat = true;
 	_videoCodecAccuracy = Image::CodecAccuracy::Default;
+	_decodeAheadFrames = 0;
+	_decodeAheadHead = 0;
+	_decodeAheadCount = 0;
+	_decodeAheadCurFrame = -1;
+	resetDecodeAheadStats();
 }
 
 void VideoDecoder::close() {
 	if (isPlaying())
 		stop();
 
+	freeDecodeAhead();
+	_decodeAheadFrames = 0;
+
 	for (auto *track : _tracks)
 		delete track;
 
@@ -114,9 +122,16 @@ bool VideoDecoder::needsUpdate() const {
 }
 
 void VideoDecoder::delayMillis(uint msecs) {
-	if (!needsUpdate())
-		g_system->delayMillis(MIN<uint>(msecs, getTimeToNextFrame()));
-	else
+	if (!needsUpdate()) {
+		// Put the time until the next frame to use
+		uint32 start = g_system->getMillis();
+		while (g_system->getMillis() - start < msecs && getTimeToNextFrame() != 0 && decodeAhead())
+			;
+
+		uint32 elapsed = g_system->getMillis() - start;
+		if (elapsed < msecs)
+			g_system->delayMillis(MIN<uint>(msecs - elapsed, getTimeToNextFrame()));
+	} else
 		g_system->delayMillis(1); /* This is needed to keep the mixer and timers active */
 }
 
@@ -212,6 +227,162 @@ const Graphics::Surface *VideoDecoder::decodeNextFrame() {
 	_canSetDither = false;
 	_canSetDefaultFormat = false;
 
+	if (!_decodeAheadFrames)
+		return decodeFrameIntern();
+
+	if (_decodeAheadCount == 0) {
+		// Past the end time, frames are decoded like without the queue
+		if (!decodeAhead())
+			return decodeFrameIntern();
+
+		// That frame had to be decoded on demand
+		_decodeAheadStats.decodedAhead--;
+		_decodeAheadStats.underruns++;
+	}
+
+	DecodeAheadFrame &entry = _decodeAheadQueue[_decodeAheadHead];
+	_decodeAheadHead = (_decodeAheadHead + 1) % _decodeAheadQueue.size();
+	_decodeAheadCount--;
+	_decodeAheadStats.queuedFrames = _decodeAheadCount;
+	_decodeAheadCurFrame = entry.curFrame;
+
+	// The slot is reused once the next frame has been returned, so its
+	// palette is copied out of it
+	if (entry.hasPalette) {
+		memcpy(_decodeAheadPalette, entry.palette, sizeof(_decodeAheadPalette));
+		_palette = _decodeAheadPalette;
+	}
+	if (entry.dirtyPalette)
+		_dirtyPalette = true;
+
+	// The frame is late if the one after it should already be shown
+	if (isPlaying() && !isPaused() && _decodeAheadCount > 0 && getTime() >= _decodeAheadQueue[_decodeAheadHead].startTime)
+		_decodeAheadStats.lateFrames++;
+
+	return entry.hasSurface ? &entry.surface : 0;
+}
+
+bool VideoDecoder::setDecodeAhead(uint frames) {
+	freeDecodeAhead();
+	_decodeAheadFrames = 0;
+
+	if (!frames)
+		return true;
+
+	uint videoTracks = 0;
+	for (const auto &track : _tracks) {
+		if (track->getTrackType() == Track::kTrackTypeVideo) {
+			if (((VideoTrack *)track)->isReversed())
+				return false;
+			videoTracks++;
+		}
+	}
+
+	if (videoTracks != 1)
+		return false;
+
+	_decodeAheadFrames = frames;
+	_decodeAheadQueue.resize(frames + 1);
+	for (auto &entry : _decodeAheadQueue) {
+		entry.hasSurface = false;
+		entry.hasPalette = false;
+		entry.dirtyPalette = false;
+	}
+
+	return true;
+}
+
+bool VideoDecoder::decodeAhead() {
+	if (!_decodeAheadFrames || _decodeAheadCount >= _decodeAheadFrames || !_nextVideoTrack || _nextVideoTrack->isReversed())
+		return false;
+
+	// Do not decode past the end time, it could still change
+	const uint32 startTime = _nextVideoTrack->getNextFrameStartTime();
+	if (_endTimeSet && startTime >= (uint)_endTime.msecs())
+		return false;
+
+	if (_decodeAheadCount == 0)
+		_decodeAheadCurFrame = getCurFrame();
+
+	_canSetDither = false;
+	_canSetDefaultFormat = false;
+
+	// Keep the palette of the frames already returned
+	const bool dirtyPalette = _dirtyPalette;
+	const byte *palette = _palette;
+	_dirtyPalette = false;
+
+	VideoTrack *track = _nextVideoTrack;
+	const Graphics::Surface *frame = decodeFrameIntern();
+
+	DecodeAheadFrame &entry = _decodeAheadQueue[(_decodeAheadHead + _decodeAheadCount) % _decodeAheadQueue.size()];
+	entry.startTime = startTime;
+	entry.curFrame = track->getCurFrame();
+	entry.hasSurface = frame != 0;
+
+	if (frame) {
+		// Reuse the buffer of the slot when possible
+		if (entry.surface.w != frame->w || entry.surface.h != frame->h || entry.surface.format != frame->format)
+			entry.surface.create(frame->w, frame->h, frame->format);
+
+		entry.surface.copyRectToSurface(*frame, 0, 0, Common::Rect(frame->w, frame->h));
+	}
+
+	// Each frame keeps the palette it is shown with. decodeFrameIntern()
+	// picked up the palette of the frame if it changed, otherwise it is the
+	// one of the frame before.
+	const DecodeAheadFrame *previous = _decodeAheadCount ? &_decodeAheadQueue[(_decodeAheadHead + _decodeAheadCount - 1) % _decodeAheadQueue.size()] : 0;
+	entry.dirtyPalette = _dirtyPalette;
+	if (_dirtyPalette) {
+		entry.hasPalette = true;
+		memcpy(entry.palette, _palette, sizeof(entry.palette));
+	} else if (previous) {
+		entry.hasPalette = previous->hasPalette;
+		memcpy(entry.palette, previous->palette, sizeof(entry.palette));
+	} else {
+		entry.hasPalette = palette != 0;
+		if (palette)
+			memcpy(entry.palette, palette, sizeof(entry.palette));
+	}
+
+	_dirtyPalette = dirtyPalette;
+	_palette = palette;
+
+	_decodeAheadCount++;
+	_decodeAheadStats.decodedAhead++;
+	_decodeAheadStats.queuedFrames = _decodeAheadCount;
+	_decodeAheadStats.maxQueuedFrames = MAX(_decodeAheadStats.maxQueuedFrames, _decodeAheadCount);
+	return true;
+}
+
+void VideoDecoder::resetDecodeAheadStats() {
+	_decodeAheadStats.queuedFrames = _decodeAheadCount;
+	_decodeAheadStats.maxQueuedFrames = _decodeAheadCount;
+	_decodeAheadStats.decodedAhead = 0;
+	_decodeAheadStats.underruns = 0;
+	_decodeAheadStats.lateFrames = 0;
+}
+
+bool VideoDecoder::decodeAheadEndReached() const {
+	return isPlaying() && _endTimeSet && _decodeAheadQueue[_decodeAheadHead].startTime >= (uint)_endTime.msecs();
+}
+
+void VideoDecoder::flushDecodeAhead() {
+	_decodeAheadHead = 0;
+	_decodeAheadCount = 0;
+	_decodeAheadStats.queuedFrames = 0;
+}
+
+void VideoDecoder::freeDecodeAhead() {
+	flushDecodeAhead();
+
+	for (auto &entry : _decodeAheadQueue)
+		entry.surface.free();
+
+	_decodeAheadQueue.clear();
+}
+
+const Graphics::Surface *VideoDecoder::decodeFrameIntern() {
 	readNextPacket();
 
 	// If we have no next video track at this point, there shouldn't be
@@ -237,6 +408,10 @@ bool VideoDecoder::setReverse(bool reverse) {
 	if (reverse && hasAudio())
 		return false;
 
+	// The decode-ahead queue only works forward
+	if (reverse && _decodeAheadFrames)
+		return false;
+
 	// Attempt to make sure all the tracks are in the requested direction
 	for (auto &track : _tracks) {
 		if (track->getTrackType() == Track::kTrackTypeVideo && ((VideoTrack *)track)->isReversed() != reverse) {
@@ -257,6 +432,10 @@ const byte *VideoDecoder::getPalette() {
 }
 
 int VideoDecoder::getCurFrame() const {
+	// The tracks are ahead of the frames returned so far
+	if (_decodeAheadCount)
+		return _decodeAheadCurFrame;
+
 	int32 frame = -1;
 
 	for (const auto &track : _tracks)
@@ -309,10 +488,20 @@ uint32 VideoDecoder::getTime() const {
 }
 
 uint32 VideoDecoder::getTimeToNextFrame() const {
-	if (endOfVideo() || _needsUpdate || !_nextVideoTrack)
+	if (endOfVideo() || _needsUpdate)
 		return 0;
 
 	uint32 currentTime = getTime();
+
+	// Queued frames are always played forward
+	if (_decodeAheadCount) {
+		uint32 nextFrameStartTime = _decodeAheadQueue[_decodeAheadHead].startTime;
+		return nextFrameStartTime <= currentTime ? 0 : nextFrameStartTime - currentTime;
+	}
+
+	if (!_nextVideoTrack)
+		return 0;
+
 	uint32 nextFrameStartTime = _nextVideoTrack->getNextFrameStartTime();
 
 	if (_nextVideoTrack->isReversed()) {
@@ -332,6 +521,12 @@ uint32 VideoDecoder::getTimeToNextFrame() const {
 
 bool VideoDecoder::endOfVideo() const {
 	for (const auto &track : _tracks) {
+		if (_decodeAheadCount && track->getTrackType() == Track::kTrackTypeVideo) {
+			if (!decodeAheadEndReached())
+				return false;
+			continue;
+		}
+
 		bool videoEndTimeReached = _endTimeSet && track->getTrackType() == Track::kTrackTypeVideo && ((const VideoTrack *)track)->getNextFrameStartTime() >= (uint)_endTime.msecs();
 		bool endReached = track->endOfTrack() || (isPlaying() && videoEndTimeReached);
 		if (!endReached)
@@ -360,6 +555,8 @@ bool VideoDecoder::rewind() {
 	if (isPlaying())
 		stopAudio();
 
+	flushDecodeAhead();
+
 	for (auto &track : _tracks)
 		if (!track->rewind())
 			return false;
@@ -394,6 +591,8 @@ bool VideoDecoder::seek(const Audio::Timestamp &time) {
 	if (isPlaying())
 		stopAudio();
 
+	flushDecodeAhead();
+
 	// Do the actual seeking
 	if (!seekIntern(time))
 		return false;
@@ -1047,6 +1246,12 @@ bool VideoDecoder::hasFramesLeft() const {
 		if (track->getTrackType() != Track::kTrackTypeVideo)
 			continue;
 
+		if (_decodeAheadCount) {
+			if (!decodeAheadEndReached())
+				return true;
+			continue;
+		}
+
 		const VideoTrack *videoTrack = (const VideoTrack *)track;
 
 		bool videoEndTimeReached = _endTimeSet && videoTrack->getNextFrameStartTime() >= (uint)_endTime.msecs();
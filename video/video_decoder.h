@@ -29,6 +29,7 @@
 #include "common/rational.h"
 #include "common/str.h"
 #include "graphics/pixelformat.h"
+#include "graphics/surface.h"
 #include "image/codec-options.h"
 
 namespace Audio {
@@ -41,10 +42,6 @@ namespace Common {
 class SeekableReadStream;
 }
 
-namespace Graphics {
-struct Surface;
-}
-
 namespace Video {
 
 /**
@@ -371,6 +368,62 @@ public:
 	 */
 	virtual const Graphics::Surface *decodeNextFrame();
 
+	/**
+	 * Statistics about the decode-ahead queue.
+	 *
+	 * @see setDecodeAhead()
+	 */
+	struct DecodeAheadStats {
+		uint queuedFrames;    ///< Frames currently waiting in the queue
+		uint maxQueuedFrames; ///< Highest number of frames ever queued
+		uint32 decodedAhead;  ///< Frames decoded before they were requested
+		uint32 underruns;     ///< Frames requested while the queue was empty
+		uint32 lateFrames;    ///< Frames returned after the following frame was already due
+	};
+
+	/**
+	 * Decode up to the given number of frames ahead of playback.
+	 *
+	 * Frames are then decoded whenever there is time to spare, i.e. from
+	 * delayMillis() or decodeAhead(), and stored in a queue of copies whose
+	 * buffers are reused. decodeNextFrame() returns the oldest queued frame,
+	 * and only decodes on demand when the queue is empty. Seeking and
+	 * rewinding flush the queue.
+	 *
+	 * This should be called after loadStream(). It is only supported for
+	 * videos with a single video track, played forward, and whose
+	 * decodeNextFrame() override (if any) only post-processes the frame
+	 * returned by this class.
+	 *
+	 * @param frames The number of frames to decode ahead, 0 to disable
+	 * @return true on success, false otherwise
+	 */
+	bool setDecodeAhead(uint frames);
+
+	/**
+	 * Get the number of frames decoded ahead, as set by setDecodeAhead().
+	 */
+	uint getDecodeAhead() const { return _decodeAheadFrames; }
+
+	/**
+	 * Decode one frame ahead of playback, if the decode-ahead queue is not
+	 * full yet. Callers with their own wait loops can use this to put idle
+	 * time to use.
+	 *
+	 * @return true if a frame was queued, false otherwise
+	 */
+	bool decodeAhead();
+
+	/**
+	 * Get the statistics of the decode-ahead queue.
+	 */
+	const DecodeAheadStats &getDecodeAheadStats() const { return _decodeAheadStats; }
+
+	/**
+	 * Reset the counters of the decode-ahead statistics.
+	 */
+	void resetDecodeAheadStats();
+
 	/**
 	 * Set the video to decode frames in reverse.
 	 *
@@ -1029,6 +1082,32 @@ private:
 	bool _canSetDither;
 	bool _canSetDefaultFormat;
 
+	// A frame decoded ahead of playback
+	struct DecodeAheadFrame {
+		Graphics::Surface surface;
+		bool hasSurface;
+		uint32 startTime;
+		int curFrame;
+		bool hasPalette;
+		bool dirtyPalette;
+		byte palette[256 * 3];
+	};
+
+	// Decode-ahead queue. It has one more slot than frames to decode ahead,
+	// so that the frame last returned stays valid until the next one is.
+	uint _decodeAheadFrames;
+	Common::Array<DecodeAheadFrame> _decodeAheadQueue;
+	uint _decodeAheadHead;
+	uint _decodeAheadCount;
+	int _decodeAheadCurFrame;
+	DecodeAheadStats _decodeAheadStats;
+	byte _decodeAheadPalette[256 * 3];
+
+	const Graphics::Surface *decodeFrameIntern();
+	bool decodeAheadEndReached() const;
+	void flushDecodeAhead();
+	void freeDecodeAhead();
+
 protected:
 	// Internal helper functions
 	void stopAudio();